@@ -306,6 +306,14 @@ namespace EE::Resource
                 return Resource::CompilationResult::Failure;
             }
 
+            // The transitive install dependencies are stored in the resource header, so any change to them requires a recompile
+            m_pCompileContext->m_transitiveInstallDependencies.clear();
+            GetTransitiveInstallDependencies( m_pCompileContext->m_resourceID, m_pCompileContext->m_transitiveInstallDependencies );
+            for ( auto const& dependencyResourceID : m_pCompileContext->m_transitiveInstallDependencies )
+            {
+                m_compileDependencyTreeRoot.m_combinedHash += dependencyResourceID.GetPathID();
+            }
+
             m_pCompileContext->m_sourceResourceHash = m_compileDependencyTreeRoot.m_combinedHash;
             requiresCompilation = !m_compileDependencyTreeRoot.IsUpToDate();
         }
@@ -430,6 +438,61 @@ namespace EE::Resource
         return true;
     }
 
+    void ResourceCompilerApplication::GetTransitiveInstallDependencies( ResourceID const& resourceID, TVector<ResourceID>& outDependencies ) const
+    {
+        EE_ASSERT( resourceID.IsValid() );
+
+        // Entity descriptors only report their referenced resources for packaging, they have no actual install dependencies
+        if ( EntityModel::IsResourceAnEntityDescriptor( resourceID.GetResourceTypeID() ) )
+        {
+            return;
+        }
+
+        Compiler const* pCompiler = m_pCompilerRegistry->GetCompilerForResourceType( resourceID.GetResourceTypeID() );
+        if ( pCompiler == nullptr )
+        {
+            return;
+        }
+
+        TVector<ResourceID> visitedResources;
+        if ( !pCompiler->GetInstallDependencies( resourceID, visitedResources ) )
+        {
+            return;
+        }
+
+        // Breadth first, so that the closest dependencies are requested first
+        // Any failures are ignored here, since they will be reported when that dependency is compiled
+        for ( size_t i = 0; i < visitedResources.size(); i++ )
+        {
+            ResourceID const dependencyResourceID = visitedResources[i];
+            if ( !dependencyResourceID.IsValid() )
+            {
+                continue;
+            }
+
+            Compiler const* pDependencyCompiler = m_pCompilerRegistry->GetCompilerForResourceType( dependencyResourceID.GetResourceTypeID() );
+            if ( pDependencyCompiler == nullptr )
+            {
+                continue;
+            }
+
+            TVector<ResourceID> dependencyInstallDependencies;
+            if ( !pDependencyCompiler->GetInstallDependencies( dependencyResourceID, dependencyInstallDependencies ) )
+            {
+                continue;
+            }
+
+            for ( auto const& transitiveResourceID : dependencyInstallDependencies )
+            {
+                if ( transitiveResourceID.IsValid() && transitiveResourceID != resourceID && !VectorContains( visitedResources, transitiveResourceID ) )
+                {
+                    visitedResources.emplace_back( transitiveResourceID );
+                    outDependencies.emplace_back( transitiveResourceID );
+                }
+            }
+        }
+    }
+
     bool ResourceCompilerApplication::FillCompileDependencyNode( CompileDependencyNode* pNode, DataPath const& resourcePath )
     {
         EE_ASSERT( pNode != nullptr );
@@ -73,6 +73,9 @@ namespace EE::Resource
         bool TryReadCompileDependencies( ResourceID const& resourceID, TVector<DataPath>& outDependencies );
         bool FillCompileDependencyNode( CompileDependencyNode* pNode, DataPath const& resourceID );
 
+        // Get the install dependencies of the install dependencies of a resource (all the way down), ordered by depth
+        void GetTransitiveInstallDependencies( ResourceID const& resourceID, TVector<ResourceID>& outDependencies ) const;
+
     private:
 
         TypeSystem::TypeRegistry                m_typeRegistry;
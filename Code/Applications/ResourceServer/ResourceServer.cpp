@@ -8,6 +8,9 @@
 #include "Engine/Entity/EntityDescriptors.h"
 #include "Engine/_Module/EngineModule.h"
 #include "Base/Resource/ResourceProviders/ResourceNetworkMessages.h"
+#include "Base/Resource/ResourceProviders/ArchiveResourceProvider.h"
+#include "Base/Resource/ResourceArchive.h"
+#include "Base/Resource/ResourcePrefetchManifest.h"
 #include "Base/Settings/IniFile.h"
 #include "Base/FileSystem/FileSystem.h"
 #include "Base/FileSystem/FileSystemUtils.h"
@@ -238,6 +241,127 @@ namespace EE::Resource
 
     //-------------------------------------------------------------------------
 
+    // Packs all the compiled packaging results into archives
+    class ArchivingTask final : public ITaskSet
+    {
+    public:
+
+        // Optional load order profile, one resource path per line, resources are written to the archives in this order
+        constexpr static char const* const s_loadOrderProfileFilename = "LoadOrderProfile.txt";
+
+    public:
+
+        ArchivingTask( ResourceGlobalSettings const& settings, TVector<ResourceID> const& packagedMaps, TVector<CompilationRequest const*> const& packagingRequests )
+            : ITaskSet( 1 )
+            , m_settings( settings )
+            , m_packagedMaps( packagedMaps )
+            , m_packagingRequests( packagingRequests )
+        {}
+
+        inline bool WasSuccessful() const { return m_wasSuccessful; }
+
+    private:
+
+        virtual void ExecuteRange( TaskSetPartition range, uint32_t threadnum ) override final
+        {
+            FileSystem::Path const& packagedDirectoryPath = m_settings.m_packagedBuildCompiledResourceDirectoryPath;
+
+            // Read the load order profile
+            //-------------------------------------------------------------------------
+
+            TVector<ResourceID> loadOrder;
+            String profileData;
+            if ( FileSystem::ReadTextFile( packagedDirectoryPath + s_loadOrderProfileFilename, profileData ) )
+            {
+                TVector<String> lines;
+                StringUtils::Split( profileData, lines, "\r\n" );
+                for ( auto const& line : lines )
+                {
+                    if ( DataPath::IsValidPath( line ) )
+                    {
+                        loadOrder.emplace_back( ResourceID( line ) );
+                    }
+                }
+            }
+
+            // Add the recorded prefetch manifests for the packaged maps
+            //-------------------------------------------------------------------------
+            // The manifests are also copied to the packaged build, so that the runtime prefetch reads the archives in file order
+
+            for ( auto const& mapResourceID : m_packagedMaps )
+            {
+                FileSystem::Path const manifestFilePath = PrefetchManifest::GetManifestFilePath( m_settings.m_compiledResourceDirectoryPath, mapResourceID );
+                if ( !PrefetchManifest::ReadManifest( manifestFilePath, loadOrder ) )
+                {
+                    continue;
+                }
+
+                FileSystem::Path const packagedManifestFilePath = PrefetchManifest::GetManifestFilePath( packagedDirectoryPath, mapResourceID );
+                if ( !FileSystem::EnsureDirectoryExists( packagedManifestFilePath.GetParentDirectory() ) || !FileSystem::CopyExistingFile( manifestFilePath, packagedManifestFilePath ) )
+                {
+                    EE_LOG_WARNING( "Resource Server", "Packaging", "Failed to copy prefetch manifest: %s", manifestFilePath.c_str() );
+                }
+            }
+
+            // Add all successfully compiled resources, profiled/prefetched resources first and then in packaging (i.e. dependency discovery) order
+            //-------------------------------------------------------------------------
+
+            THashMap<ResourceID, FileSystem::Path> compiledResources;
+            for ( auto pRequest : m_packagingRequests )
+            {
+                if ( pRequest->HasSucceeded() )
+                {
+                    compiledResources.insert( TPair<ResourceID, FileSystem::Path>( pRequest->GetResourceID(), pRequest->GetDestinationFilePath() ) );
+                }
+            }
+
+            bool addedAllResources = true;
+            ResourceArchiveWriter writer;
+            for ( auto const& resourceID : loadOrder )
+            {
+                auto const foundIter = compiledResources.find( resourceID );
+                if ( foundIter != compiledResources.end() )
+                {
+                    if ( !writer.AddResource( resourceID, foundIter->second ) )
+                    {
+                        addedAllResources = false;
+                    }
+                }
+            }
+
+            for ( auto pRequest : m_packagingRequests )
+            {
+                if ( pRequest->HasSucceeded() )
+                {
+                    if ( !writer.AddResource( pRequest->GetResourceID(), pRequest->GetDestinationFilePath() ) )
+                    {
+                        addedAllResources = false;
+                    }
+                }
+            }
+
+            // Dont write incomplete archives, the runtime would fail to find the missing resources
+            if ( !addedAllResources )
+            {
+                m_wasSuccessful = false;
+                return;
+            }
+
+            //-------------------------------------------------------------------------
+
+            m_wasSuccessful = writer.Write( packagedDirectoryPath, ArchiveResourceProvider::s_archiveName );
+        }
+
+    private:
+
+        ResourceGlobalSettings const&               m_settings;
+        TVector<ResourceID> const&                  m_packagedMaps;
+        TVector<CompilationRequest const*> const&   m_packagingRequests;
+        bool                                        m_wasSuccessful = false;
+    };
+
+    //-------------------------------------------------------------------------
+
     ResourceServer::ResourceServer()
         : m_settingsRegistry( m_typeRegistry )
     {}
@@ -338,6 +462,12 @@ namespace EE::Resource
             EE::Delete( m_pPackagingTask );
         }
 
+        if ( m_pArchivingTask != nullptr )
+        {
+            EE_ASSERT( m_pArchivingTask->GetIsComplete() );
+            EE::Delete( m_pArchivingTask );
+        }
+
         // Unregister File Watcher
         //-------------------------------------------------------------------------
 
@@ -433,8 +563,26 @@ namespace EE::Resource
 
             if ( isComplete )
             {
+                m_pArchivingTask = EE::New<ArchivingTask>( *m_pSettings, m_mapsToBePackaged, m_packagingRequests );
+                m_taskSystem.ScheduleTask( m_pArchivingTask );
+                m_packagingStage = PackagingStage::Archiving;
+            }
+        }
+        else if ( m_packagingStage == PackagingStage::Archiving )
+        {
+            EE_ASSERT( m_pArchivingTask != nullptr );
+
+            if ( m_pArchivingTask->GetIsComplete() )
+            {
+                bool const wasSuccessful = m_pArchivingTask->WasSuccessful();
+                if ( !wasSuccessful )
+                {
+                    EE_LOG_ERROR( "Resource Server", "Packaging", "Failed to create resource archives!" );
+                }
+
+                EE::Delete( m_pArchivingTask );
                 m_packagingRequests.clear();
-                m_packagingStage = PackagingStage::Complete;
+                m_packagingStage = wasSuccessful ? PackagingStage::Complete : PackagingStage::Failed;
             }
         }
 
@@ -774,7 +922,7 @@ namespace EE::Resource
 
     bool ResourceServer::CanStartPackaging() const
     {
-        return ( m_packagingStage == PackagingStage::None || m_packagingStage == PackagingStage::Complete ) && !m_mapsToBePackaged.empty();
+        return !IsPackaging() && !m_mapsToBePackaged.empty();
     }
 
     void ResourceServer::StartPackaging()
@@ -814,11 +962,18 @@ namespace EE::Resource
                 }
 
                 float const percentageComplete = numComplete / m_packagingRequests.size();
-                return 0.05f + ( 0.95f * percentageComplete );
+                return 0.05f + ( 0.90f * percentageComplete );
+            }
+            break;
+
+            case PackagingStage::Archiving:
+            {
+                return 0.95f;
             }
             break;
 
             case PackagingStage::Complete:
+            case PackagingStage::Failed:
             {
                 return 1.0f;
             }
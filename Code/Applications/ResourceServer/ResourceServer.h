@@ -22,6 +22,7 @@ namespace EE::Resource
 {
     class CompilationTask;
     class PackagingTask;
+    class ArchivingTask;
 
     //-------------------------------------------------------------------------
 
@@ -41,7 +42,9 @@ namespace EE::Resource
             None, // Not Packaging
             Preparing,
             Packaging,
-            Complete
+            Archiving,
+            Complete,
+            Failed
         };
 
     public:
@@ -94,7 +97,7 @@ namespace EE::Resource
         TVector<ResourceID> const& GetMapsQueuedForPackaging() const { return m_mapsToBePackaged; }
 
         // Are we currently packaging a map
-        inline bool IsPackaging() const { return m_packagingStage != PackagingStage::None && m_packagingStage != PackagingStage::Complete; }
+        inline bool IsPackaging() const { return m_packagingStage != PackagingStage::None && m_packagingStage != PackagingStage::Complete && m_packagingStage != PackagingStage::Failed; }
 
         // Get the current stage of packaging
         PackagingStage GetPackagingStage() const { return m_packagingStage; }
@@ -159,6 +162,7 @@ namespace EE::Resource
         TVector<ResourceID>                                         m_mapsToBePackaged;
         TVector<CompilationRequest const*>                          m_packagingRequests;
         PackagingTask*                                              m_pPackagingTask = nullptr;
+        ArchivingTask*                                              m_pArchivingTask = nullptr;
         PackagingStage                                              m_packagingStage = PackagingStage::None;
 
         // File System Watcher
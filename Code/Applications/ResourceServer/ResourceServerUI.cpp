@@ -576,7 +576,7 @@ namespace EE::Resource
             // Packaging UI
             //-------------------------------------------------------------------------
 
-            bool const disablePackagingUI = ( packagingStage == ResourceServer::PackagingStage::Preparing ) || ( packagingStage == ResourceServer::PackagingStage::Packaging );
+            bool const disablePackagingUI = ( packagingStage == ResourceServer::PackagingStage::Preparing ) || ( packagingStage == ResourceServer::PackagingStage::Packaging ) || ( packagingStage == ResourceServer::PackagingStage::Archiving );
             ImGui::BeginDisabled( disablePackagingUI );
             {
                 InlineString previewStr;
@@ -662,11 +662,7 @@ namespace EE::Resource
 
                 ImGui::SeparatorText( "Progress" );
 
-                if ( packagingStage != ResourceServer::PackagingStage::Complete )
-                {
-                    ImGuiX::DrawSpinner( "##Packaging" );
-                }
-                else
+                if ( packagingStage == ResourceServer::PackagingStage::Complete )
                 {
                     ImGuiX::ScopedFont const sf( ImGuiX::Font::Medium, Colors::Lime );
                     ImGui::AlignTextToFramePadding();
@@ -674,6 +670,18 @@ namespace EE::Resource
                     ImGui::Text( EE_ICON_CHECK_BOLD );
                     ImGui::Unindent( 4.0f );
                 }
+                else if ( packagingStage == ResourceServer::PackagingStage::Failed )
+                {
+                    ImGuiX::ScopedFont const sf( ImGuiX::Font::Medium, Colors::Red );
+                    ImGui::AlignTextToFramePadding();
+                    ImGui::Indent( 4.0f );
+                    ImGui::Text( EE_ICON_CLOSE_THICK );
+                    ImGui::Unindent( 4.0f );
+                }
+                else
+                {
+                    ImGuiX::DrawSpinner( "##Packaging" );
+                }
 
                 ImGui::SameLine( 36 );
 
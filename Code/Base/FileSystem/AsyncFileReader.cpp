@@ -0,0 +1,175 @@
+#include "AsyncFileReader.h"
+#include "FileSystem.h"
+#include "ReadBufferPool.h"
+#include "Base/Math/Math.h"
+#include "Base/Profiling.h"
+#include <fstream>
+
+//-------------------------------------------------------------------------
+
+namespace EE::FileSystem
+{
+    AsyncFileReader::AsyncFileReader( int32_t numIOThreads )
+    {
+        EE_ASSERT( numIOThreads > 0 );
+
+        for ( int32_t i = 0; i < numIOThreads; i++ )
+        {
+            m_IOThreads.emplace_back( [this, i] ()
+            {
+                TInlineString<32> const threadName( TInlineString<32>::CtorSprintf(), "IO Thread %d", i );
+                Threading::SetCurrentThreadName( threadName.c_str() );
+                ProcessReads();
+            } );
+        }
+    }
+
+    AsyncFileReader::~AsyncFileReader()
+    {
+        WaitForAllReads();
+
+        {
+            Threading::ScopeLock lock( m_wakeMutex );
+            m_isExiting = true;
+        }
+        m_wakeCondition.notify_all();
+
+        for ( auto& thread : m_IOThreads )
+        {
+            thread.join();
+        }
+    }
+
+    //-------------------------------------------------------------------------
+
+    void AsyncFileReader::Submit( ReadRequest&& request )
+    {
+        EE_ASSERT( request.IsValid() );
+
+        m_numPendingReads++;
+        m_queuedReads.enqueue( EE::New<ReadRequest>( eastl::move( request ) ) );
+
+        {
+            Threading::ScopeLock lock( m_wakeMutex );
+        }
+        m_wakeCondition.notify_one();
+    }
+
+    void AsyncFileReader::Submit( TVector<ReadRequest>& requests )
+    {
+        if ( requests.empty() )
+        {
+            return;
+        }
+
+        TInlineVector<ReadRequest*, 32> allocatedRequests;
+        for ( auto& request : requests )
+        {
+            EE_ASSERT( request.IsValid() );
+            allocatedRequests.emplace_back( EE::New<ReadRequest>( eastl::move( request ) ) );
+        }
+        requests.clear();
+
+        m_numPendingReads += (int32_t) allocatedRequests.size();
+        m_queuedReads.enqueue_bulk( allocatedRequests.data(), allocatedRequests.size() );
+
+        {
+            Threading::ScopeLock lock( m_wakeMutex );
+        }
+        m_wakeCondition.notify_all();
+    }
+
+    void AsyncFileReader::WaitForAllReads()
+    {
+        while ( m_numPendingReads > 0 )
+        {
+            Threading::Sleep( 1 );
+        }
+    }
+
+    //-------------------------------------------------------------------------
+
+    void AsyncFileReader::ProcessReads()
+    {
+        ReadRequest* pRequest = nullptr;
+
+        while ( true )
+        {
+            if ( m_queuedReads.try_dequeue( pRequest ) )
+            {
+                ExecuteRead( *pRequest );
+                EE::Delete( pRequest );
+                m_numPendingReads--;
+                continue;
+            }
+
+            // Nothing to do, so sleep until we get new reads
+            Threading::Lock lock( m_wakeMutex );
+            if ( m_isExiting )
+            {
+                break;
+            }
+
+            m_wakeCondition.wait( lock, [this] () { return m_isExiting || m_queuedReads.size_approx() > 0; } );
+        }
+    }
+
+    void AsyncFileReader::ExecuteRead( ReadRequest& request )
+    {
+        EE_PROFILE_SCOPE_IO( "Async File Read" );
+        EE_PROFILE_TAG( "filename", request.m_filePath.GetFilename().c_str() );
+
+        bool wasSuccessful = false;
+        uint64_t numBytesRead = 0;
+
+        // Whole file reads into a blob
+        //-------------------------------------------------------------------------
+
+        if ( request.m_pDestinationBlob != nullptr && request.m_pBufferPool == nullptr && request.m_offset == 0 && request.m_size == 0 )
+        {
+            wasSuccessful = ReadBinaryFile( request.m_filePath, *request.m_pDestinationBlob );
+            numBytesRead = wasSuccessful ? request.m_pDestinationBlob->size() : 0;
+        }
+
+        // Ranged reads
+        //-------------------------------------------------------------------------
+
+        else
+        {
+            std::ifstream fileStream( request.m_filePath.c_str(), std::ios::in | std::ios::binary | std::ios::ate );
+            if ( fileStream.is_open() )
+            {
+                uint64_t const fileSize = (uint64_t) fileStream.tellg();
+                uint64_t const readSize = ( request.m_size == 0 ) ? ( fileSize - Math::Min( request.m_offset, fileSize ) ) : request.m_size;
+
+                if ( request.m_offset + readSize <= fileSize )
+                {
+                    void* pDestination = request.m_pDestinationBuffer;
+                    if ( request.m_pDestinationBlob != nullptr )
+                    {
+                        if ( request.m_pBufferPool != nullptr && request.m_pDestinationBlob->capacity() < readSize )
+                        {
+                            request.m_pBufferPool->Release( eastl::move( *request.m_pDestinationBlob ) );
+                            *request.m_pDestinationBlob = request.m_pBufferPool->Acquire( readSize );
+                        }
+
+                        request.m_pDestinationBlob->resize( readSize );
+                        pDestination = request.m_pDestinationBlob->data();
+                    }
+
+                    fileStream.seekg( request.m_offset, std::ios::beg );
+                    fileStream.read( (char*) pDestination, readSize );
+                    wasSuccessful = fileStream.good();
+                    numBytesRead = wasSuccessful ? readSize : 0;
+                }
+            }
+        }
+
+        //-------------------------------------------------------------------------
+
+        if ( request.m_completionFunction != nullptr )
+        {
+            request.m_completionFunction( wasSuccessful, numBytesRead );
+        }
+    }
+}
@@ -0,0 +1,81 @@
+#pragma once
+
+#include "FileSystemPath.h"
+#include "Base/Threading/Threading.h"
+#include "Base/Types/Function.h"
+#include "Base/Types/Arrays.h"
+#include <atomic>
+
+//-------------------------------------------------------------------------
+// Async File Reader
+//-------------------------------------------------------------------------
+// Performs file reads on a set of dedicated IO threads so that the calling threads never block on IO
+//
+// * Reads are submitted in batches to minimize the synchronization cost per read
+// * Reads can target a caller-provided buffer or a blob that will be resized to fit, blob storage can be provided by a read buffer pool
+// * The completion function is called from an IO thread once the read completes, it must be threadsafe and cheap
+// * All the memory referenced by a read request must remain valid until the completion function has been called
+//-------------------------------------------------------------------------
+
+namespace EE::FileSystem
+{
+    class ReadBufferPool;
+
+    //-------------------------------------------------------------------------
+
+    class EE_BASE_API AsyncFileReader
+    {
+    public:
+
+        using CompletionFunction = TFunction<void( bool wasSuccessful, uint64_t numBytesRead )>;
+
+        struct ReadRequest
+        {
+            inline bool IsValid() const { return m_filePath.IsValid() && ( ( m_pDestinationBlob != nullptr ) != ( m_pDestinationBuffer != nullptr ) ) && ( m_pDestinationBuffer == nullptr || m_size > 0 ); }
+
+        public:
+
+            Path                                    m_filePath;
+            uint64_t                                m_offset = 0;
+            uint64_t                                m_size = 0;                     // Zero means read until the end of the file, only supported for blob destinations
+            Blob*                                   m_pDestinationBlob = nullptr;   // Resized to the size of the read
+            void*                                   m_pDestinationBuffer = nullptr; // Caller-provided memory, needs to be at least m_size bytes
+            ReadBufferPool*                         m_pBufferPool = nullptr;        // Optional pool used to provide the storage for empty destination blobs
+            CompletionFunction                      m_completionFunction;
+        };
+
+    public:
+
+        AsyncFileReader( int32_t numIOThreads = 2 );
+        ~AsyncFileReader();
+
+        AsyncFileReader( AsyncFileReader const& ) = delete;
+        AsyncFileReader& operator=( AsyncFileReader const& ) = delete;
+
+        // Submit a single read
+        void Submit( ReadRequest&& request );
+
+        // Submit a batch of reads, the requests are moved out of the supplied array
+        void Submit( TVector<ReadRequest>& requests );
+
+        // The number of reads that have been submitted but not yet completed
+        inline int32_t GetNumPendingReads() const { return m_numPendingReads; }
+
+        // Blocking wait for all pending reads to complete
+        void WaitForAllReads();
+
+    private:
+
+        void ProcessReads();
+        static void ExecuteRead( ReadRequest& request );
+
+    private:
+
+        TInlineVector<Threading::Thread, 4>                 m_IOThreads;
+        Threading::LockFreeQueue<ReadRequest*>              m_queuedReads;
+        Threading::Mutex                                    m_wakeMutex;
+        Threading::ConditionVariable                        m_wakeCondition;
+        std::atomic<int32_t>                                m_numPendingReads = 0;
+        std::atomic<bool>                                   m_isExiting = false;
+    };
+}
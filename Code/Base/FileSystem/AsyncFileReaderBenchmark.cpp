@@ -0,0 +1,169 @@
+#include "AsyncFileReaderBenchmark.h"
+
+#if EE_DEVELOPMENT_TOOLS
+#include "AsyncFileReader.h"
+#include "ReadBufferPool.h"
+#include "FileSystem.h"
+#include "FileSystemUtils.h"
+#include "Base/Time/Timers.h"
+#include <atomic>
+
+//-------------------------------------------------------------------------
+
+namespace EE::FileSystem
+{
+    void AsyncFileReaderBenchmarkResults::Log() const
+    {
+        EE_LOG_INFO( "FileSystem", "Async File Reader Benchmark", "%d files, %.2fMB, %d IO threads", m_numFiles, m_numBytes / ( 1024.0f * 1024.0f ), m_numIOThreads );
+        EE_LOG_INFO( "FileSystem", "Async File Reader Benchmark", "Synchronous: %.2fms, Single: %.2fms, Batched: %.2fms, Batched (Pooled): %.2fms", m_synchronousReadTime.ToFloat(), m_singleReadTime.ToFloat(), m_batchedReadTime.ToFloat(), m_pooledBatchedReadTime.ToFloat() );
+
+        if ( m_numFailedReads > 0 )
+        {
+            EE_LOG_WARNING( "FileSystem", "Async File Reader Benchmark", "%d reads failed, the results are not comparable!", m_numFailedReads );
+        }
+    }
+
+    AsyncFileReaderBenchmarkResults RunAsyncFileReaderBenchmark( Path const& directoryPath, int32_t maxNumFiles, int32_t numIOThreads )
+    {
+        EE_ASSERT( directoryPath.IsValid() && maxNumFiles > 0 && numIOThreads > 0 );
+
+        AsyncFileReaderBenchmarkResults results;
+        results.m_numIOThreads = numIOThreads;
+
+        // Get files
+        //-------------------------------------------------------------------------
+
+        TVector<Path> filePaths;
+        if ( !GetDirectoryContents( directoryPath, filePaths, DirectoryReaderOutput::OnlyFiles ) )
+        {
+            EE_LOG_ERROR( "FileSystem", "Async File Reader Benchmark", "Failed to read directory: %s", directoryPath.c_str() );
+            return results;
+        }
+
+        if ( (int32_t) filePaths.size() > maxNumFiles )
+        {
+            filePaths.resize( maxNumFiles );
+        }
+
+        int32_t const numFiles = (int32_t) filePaths.size();
+        results.m_numFiles = numFiles;
+
+        TVector<Blob> fileData;
+        fileData.resize( numFiles );
+
+        auto FreeFileData = [&fileData] ()
+        {
+            for ( auto& data : fileData )
+            {
+                Blob().swap( data );
+            }
+        };
+
+        // Warm the file cache, this also gives us the total size
+        //-------------------------------------------------------------------------
+
+        for ( int32_t i = 0; i < numFiles; i++ )
+        {
+            if ( ReadBinaryFile( filePaths[i], fileData[i] ) )
+            {
+                results.m_numBytes += fileData[i].size();
+            }
+            else
+            {
+                results.m_numFailedReads++;
+            }
+        }
+
+        FreeFileData();
+
+        // Synchronous
+        //-------------------------------------------------------------------------
+
+        Timer<PlatformClock> timer;
+        timer.Start();
+        for ( int32_t i = 0; i < numFiles; i++ )
+        {
+            ReadBinaryFile( filePaths[i], fileData[i] );
+        }
+        results.m_synchronousReadTime = timer.GetElapsedTimeMilliseconds();
+
+        FreeFileData();
+
+        // Async
+        //-------------------------------------------------------------------------
+
+        AsyncFileReader fileReader( numIOThreads );
+        std::atomic<int32_t> numFailedAsyncReads = 0;
+
+        auto CreateReadRequest = [&] ( int32_t fileIdx, ReadBufferPool* pBufferPool )
+        {
+            AsyncFileReader::ReadRequest request;
+            request.m_filePath = filePaths[fileIdx];
+            request.m_pDestinationBlob = &fileData[fileIdx];
+            request.m_pBufferPool = pBufferPool;
+            request.m_completionFunction = [&numFailedAsyncReads] ( bool wasSuccessful, uint64_t numBytesRead )
+            {
+                if ( !wasSuccessful )
+                {
+                    numFailedAsyncReads++;
+                }
+            };
+            return request;
+        };
+
+        auto ReadBatched = [&] ( ReadBufferPool* pBufferPool )
+        {
+            TVector<AsyncFileReader::ReadRequest> requests;
+            requests.reserve( numFiles );
+            for ( int32_t i = 0; i < numFiles; i++ )
+            {
+                requests.emplace_back( CreateReadRequest( i, pBufferPool ) );
+            }
+
+            fileReader.Submit( requests );
+            fileReader.WaitForAllReads();
+        };
+
+        // Single
+        timer.Start();
+        for ( int32_t i = 0; i < numFiles; i++ )
+        {
+            fileReader.Submit( CreateReadRequest( i, nullptr ) );
+        }
+        fileReader.WaitForAllReads();
+        results.m_singleReadTime = timer.GetElapsedTimeMilliseconds();
+
+        FreeFileData();
+
+        // Batched
+        timer.Start();
+        ReadBatched( nullptr );
+        results.m_batchedReadTime = timer.GetElapsedTimeMilliseconds();
+
+        FreeFileData();
+
+        // Batched (Pooled) - the first untimed pass fills the pool, the same way it would be filled during regular loading
+        {
+            ReadBufferPool bufferPool( results.m_numBytes * 2 );
+
+            ReadBatched( &bufferPool );
+            for ( auto& data : fileData )
+            {
+                bufferPool.Release( eastl::move( data ) );
+            }
+
+            timer.Start();
+            ReadBatched( &bufferPool );
+            results.m_pooledBatchedReadTime = timer.GetElapsedTimeMilliseconds();
+
+            for ( auto& data : fileData )
+            {
+                bufferPool.Release( eastl::move( data ) );
+            }
+        }
+
+        results.m_numFailedReads += numFailedAsyncReads;
+        return results;
+    }
+}
+#endif
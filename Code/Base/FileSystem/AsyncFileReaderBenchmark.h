@@ -0,0 +1,42 @@
+#pragma once
+
+#include "FileSystemPath.h"
+#include "Base/Time/Time.h"
+
+//-------------------------------------------------------------------------
+// Async File Reader Benchmark
+//-------------------------------------------------------------------------
+// Compares the read throughput of the different read paths on the same set of files
+// All files are read once before timing, so all timed passes read from the OS file cache and we measure the per-read overhead
+// rather than the disk. Each pass reads every file into its own blob:
+//
+// * Synchronous: each file is read on the calling thread (the previous resource loading path)
+// * Single: each read is submitted to the async file reader individually
+// * Batched: all reads are submitted to the async file reader in a single batch
+// * Batched (Pooled): same as batched but the blob storage comes from a pre-warmed read buffer pool
+
+#if EE_DEVELOPMENT_TOOLS
+namespace EE::FileSystem
+{
+    struct EE_BASE_API AsyncFileReaderBenchmarkResults
+    {
+        // Log the results to the system log
+        void Log() const;
+
+    public:
+
+        int32_t         m_numFiles = 0;
+        int32_t         m_numIOThreads = 0;
+        uint64_t        m_numBytes = 0;
+        int32_t         m_numFailedReads = 0;
+
+        Milliseconds    m_synchronousReadTime = 0.0f;
+        Milliseconds    m_singleReadTime = 0.0f;
+        Milliseconds    m_batchedReadTime = 0.0f;
+        Milliseconds    m_pooledBatchedReadTime = 0.0f;
+    };
+
+    // Run the benchmark on the files in the specified directory (recursive), only the first 'maxNumFiles' files found are read
+    EE_BASE_API AsyncFileReaderBenchmarkResults RunAsyncFileReaderBenchmark( Path const& directoryPath, int32_t maxNumFiles = 1000, int32_t numIOThreads = 2 );
+}
+#endif
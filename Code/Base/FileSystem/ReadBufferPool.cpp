@@ -0,0 +1,127 @@
+#include "ReadBufferPool.h"
+#include "Base/Math/Math.h"
+
+//-------------------------------------------------------------------------
+
+namespace EE::FileSystem
+{
+    ReadBufferPool::ReadBufferPool( size_t maxRetainedBytes )
+        : m_maxRetainedBytes( maxRetainedBytes )
+    {}
+
+    //-------------------------------------------------------------------------
+
+    int32_t ReadBufferPool::GetSizeClassForSize( size_t size )
+    {
+        for ( int32_t i = 0; i < s_numSizeClasses; i++ )
+        {
+            if ( size <= GetSizeClassSize( i ) )
+            {
+                return i;
+            }
+        }
+
+        return InvalidIndex;
+    }
+
+    int32_t ReadBufferPool::GetSizeClassForCapacity( size_t capacity )
+    {
+        // Buffers are filed under the largest class they can fully serve
+        for ( int32_t i = s_numSizeClasses - 1; i >= 0; i-- )
+        {
+            if ( capacity >= GetSizeClassSize( i ) )
+            {
+                return i;
+            }
+        }
+
+        return InvalidIndex;
+    }
+
+    //-------------------------------------------------------------------------
+
+    Blob ReadBufferPool::Acquire( size_t size )
+    {
+        int32_t const sizeClass = GetSizeClassForSize( size );
+
+        // Oversized reads are never pooled
+        if ( sizeClass == InvalidIndex )
+        {
+            Blob buffer;
+            buffer.reserve( size );
+            return buffer;
+        }
+
+        //-------------------------------------------------------------------------
+
+        {
+            Threading::ScopeLock lock( m_mutex );
+
+            auto& freeBuffers = m_freeBuffers[sizeClass];
+            if ( !freeBuffers.empty() )
+            {
+                Blob buffer = eastl::move( freeBuffers.back() );
+                freeBuffers.pop_back();
+                m_stats.m_retainedBytes -= buffer.capacity();
+                m_stats.m_numHits++;
+                return buffer;
+            }
+
+            m_stats.m_numMisses++;
+        }
+
+        // Allocate outside the lock, always allocate the full size class so the buffer can be reused for any read in this class
+        Blob buffer;
+        buffer.reserve( GetSizeClassSize( sizeClass ) );
+        return buffer;
+    }
+
+    void ReadBufferPool::Release( Blob&& buffer )
+    {
+        size_t const capacity = buffer.capacity();
+        int32_t const sizeClass = GetSizeClassForCapacity( capacity );
+        if ( sizeClass == InvalidIndex )
+        {
+            // Moved-from or tiny buffers, nothing to retain
+            return;
+        }
+
+        buffer.clear();
+
+        {
+            Threading::ScopeLock lock( m_mutex );
+
+            if ( m_stats.m_retainedBytes + capacity <= m_maxRetainedBytes )
+            {
+                m_freeBuffers[sizeClass].emplace_back( eastl::move( buffer ) );
+                m_stats.m_retainedBytes += capacity;
+                m_stats.m_peakRetainedBytes = Math::Max( m_stats.m_peakRetainedBytes, m_stats.m_retainedBytes );
+                return;
+            }
+
+            m_stats.m_numDiscards++;
+        }
+
+        // Over the cap, free the memory outside of the lock
+        Blob discardedBuffer = eastl::move( buffer );
+    }
+
+    void ReadBufferPool::Clear()
+    {
+        Threading::ScopeLock lock( m_mutex );
+
+        for ( auto& freeBuffers : m_freeBuffers )
+        {
+            freeBuffers.clear();
+            freeBuffers.shrink_to_fit();
+        }
+
+        m_stats.m_retainedBytes = 0;
+    }
+
+    ReadBufferPool::Stats ReadBufferPool::GetStats() const
+    {
+        Threading::ScopeLock lock( m_mutex );
+        return m_stats;
+    }
+}
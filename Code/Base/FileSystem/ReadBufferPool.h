@@ -0,0 +1,68 @@
+#pragma once
+
+#include "Base/_Module/API.h"
+#include "Base/Threading/Threading.h"
+#include "Base/Types/Arrays.h"
+
+//-------------------------------------------------------------------------
+// Read Buffer Pool
+//-------------------------------------------------------------------------
+// A threadsafe pool of recyclable read buffers, used to avoid allocating and freeing a new blob for every file read
+//
+// * Buffers are bucketed into power of two size classes, reads larger than the largest size class are not pooled
+// * Released buffers are only retained while the total retained size is below the supplied cap, any excess is freed
+// * Anyone can take ownership of an acquired buffer by simply moving it out, a moved-from buffer is ignored on release
+//-------------------------------------------------------------------------
+
+namespace EE::FileSystem
+{
+    class EE_BASE_API ReadBufferPool
+    {
+        constexpr static size_t const s_smallestSizeClass = 64 * 1024;
+        constexpr static int32_t const s_numSizeClasses = 12; // 64KB -> 128MB
+
+    public:
+
+        struct Stats
+        {
+            size_t                                      m_retainedBytes = 0;
+            size_t                                      m_peakRetainedBytes = 0;
+            uint64_t                                    m_numHits = 0;
+            uint64_t                                    m_numMisses = 0;
+            uint64_t                                    m_numDiscards = 0;
+        };
+
+    public:
+
+        ReadBufferPool( size_t maxRetainedBytes );
+        ~ReadBufferPool() { Clear(); }
+
+        ReadBufferPool( ReadBufferPool const& ) = delete;
+        ReadBufferPool& operator=( ReadBufferPool const& ) = delete;
+
+        // Get an empty buffer with at least the requested capacity
+        Blob Acquire( size_t size );
+
+        // Return a buffer to the pool, the buffer will be freed if the pool is over its retention cap
+        void Release( Blob&& buffer );
+
+        // Free all retained buffers
+        void Clear();
+
+        inline size_t GetMaxRetainedBytes() const { return m_maxRetainedBytes; }
+        Stats GetStats() const;
+
+    private:
+
+        static int32_t GetSizeClassForSize( size_t size );
+        static int32_t GetSizeClassForCapacity( size_t capacity );
+        inline static size_t GetSizeClassSize( int32_t sizeClass ) { return s_smallestSizeClass << sizeClass; }
+
+    private:
+
+        size_t const                                    m_maxRetainedBytes;
+        mutable Threading::Mutex                        m_mutex;
+        TVector<Blob>                                   m_freeBuffers[s_numSizeClasses];
+        Stats                                           m_stats;
+    };
+}
@@ -1,4 +1,6 @@
 #include "AABBTree.h"
+#include "Base/Math/ViewVolume.h"
+#include "Base/Math/Line.h"
 #include "Base/Types/Color.h"
 #include "Base/Drawing/DebugDrawing.h"
 
@@ -6,6 +8,30 @@
 
 namespace EE::Math
 {
+    // The traversal stack is inline allocated, so this should cover the depth of most trees
+    using TraversalStack = TInlineVector<int32_t, 64>;
+
+    static bool DoesSphereOverlapBox( Vector const& sphereCenter, float sphereRadiusSq, AABB const& box )
+    {
+        Vector const delta = Vector::Max( ( sphereCenter - box.GetCenter() ).Abs() - box.GetExtents(), Vector::Zero );
+        return delta.GetLengthSquared3() <= sphereRadiusSq;
+    }
+
+    // Slab test, the inverse direction components are allowed to be infinite
+    static bool DoesRayIntersectBox( Vector const& rayStart, Vector const& invRayDirection, float maxDistance, AABB const& box )
+    {
+        Vector const t0 = ( box.GetMin() - rayStart ) * invRayDirection;
+        Vector const t1 = ( box.GetMax() - rayStart ) * invRayDirection;
+        Vector const tMin = Vector::Min( t0, t1 );
+        Vector const tMax = Vector::Max( t0, t1 );
+
+        float const tEnter = Math::Max( Math::Max( tMin.GetX(), tMin.GetY() ), Math::Max( tMin.GetZ(), 0.0f ) );
+        float const tExit = Math::Min( Math::Min( tMax.GetX(), tMax.GetY() ), Math::Min( tMax.GetZ(), maxDistance ) );
+        return tEnter <= tExit;
+    }
+
+    //-------------------------------------------------------------------------
+
     AABBTree::AABBTree()
     {
         m_nodes.resize( 100 );
@@ -65,23 +91,7 @@ namespace EE::Math
         auto const Comparator = [] ( Node const& node, uint64_t userData ) { return !node.m_isFree && node.IsLeafNode() && node.m_userData == userData; };
         EE_ASSERT( userData != 0 && !VectorContains( m_nodes, userData, Comparator ) );
 
-        // First box
-        if ( m_rootNodeIdx == InvalidIndex )
-        {
-            RequestNode( newBox, userData );
-            m_rootNodeIdx = 0;
-        }
-        // If the root node is a leaf, the new box is a sibling
-        else if ( m_nodes[m_rootNodeIdx].IsLeafNode() )
-        {
-            InsertNode( m_rootNodeIdx, newBox, userData );
-        }
-        else // Find the best leaf node to create a sibling to
-        {
-            uint32_t bestNodeIdx = FindBestLeafNodeToCreateSiblingFor( m_rootNodeIdx, newBox );
-            EE_ASSERT( bestNodeIdx != InvalidIndex );
-            InsertNode( bestNodeIdx, newBox, userData );
-        }
+        InsertLeaf( RequestNode( newBox, userData ) );
     }
 
     void AABBTree::UpdateBranchNodeBounds( int32_t nodeIdx )
@@ -91,29 +101,49 @@ namespace EE::Math
 
         currentNode.m_bounds = AABB::GetCombinedBox( m_nodes[currentNode.m_leftNodeIdx].m_bounds, m_nodes[currentNode.m_rightNodeIdx].m_bounds );
         currentNode.m_volume = currentNode.m_bounds.GetVolume();
+        currentNode.m_layerMask = m_nodes[currentNode.m_leftNodeIdx].m_layerMask | m_nodes[currentNode.m_rightNodeIdx].m_layerMask;
     }
 
-    void AABBTree::InsertNode( int32_t originalLeafNodeIdx, AABB const& newSiblingBox, uint64_t userData )
+    void AABBTree::UpdateAncestorBounds( int32_t nodeIdx )
     {
-        EE_ASSERT( newSiblingBox.IsValid() );
+        int32_t parentIndex = nodeIdx;
+        while ( parentIndex != InvalidIndex )
+        {
+            UpdateBranchNodeBounds( parentIndex );
+            parentIndex = m_nodes[parentIndex].m_parentNodeIdx;
+        }
+    }
 
-        auto const& originalLeafNode = m_nodes[originalLeafNodeIdx];
-        int32_t const grandparentIdx = originalLeafNode.m_parentNodeIdx;
+    void AABBTree::InsertLeaf( int32_t newLeafNodeIdx )
+    {
+        EE_ASSERT( m_nodes[newLeafNodeIdx].IsLeafNode() && m_nodes[newLeafNodeIdx].m_bounds.IsValid() );
+
+        // First box
+        if ( m_rootNodeIdx == InvalidIndex )
+        {
+            m_nodes[newLeafNodeIdx].m_parentNodeIdx = InvalidIndex;
+            m_rootNodeIdx = newLeafNodeIdx;
+            return;
+        }
+
+        // If the root node is a leaf, the new box is a sibling, otherwise find the best leaf node to create a sibling to
+        int32_t const originalLeafNodeIdx = m_nodes[m_rootNodeIdx].IsLeafNode() ? m_rootNodeIdx : FindBestLeafNodeToCreateSiblingFor( m_rootNodeIdx, m_nodes[newLeafNodeIdx].m_bounds );
+        EE_ASSERT( originalLeafNodeIdx != InvalidIndex );
+        int32_t const grandparentIdx = m_nodes[originalLeafNodeIdx].m_parentNodeIdx;
 
         //-------------------------------------------------------------------------
 
-        // Create new branch node
-        int32_t const newBranchNodeIdx = RequestNode( newSiblingBox );
+        // Create new branch node, this may reallocate the node storage
+        int32_t const newBranchNodeIdx = RequestNode( m_nodes[newLeafNodeIdx].m_bounds );
         m_nodes[newBranchNodeIdx].m_parentNodeIdx = grandparentIdx;
 
         // Set left child to original leaf node
         m_nodes[newBranchNodeIdx].m_leftNodeIdx = originalLeafNodeIdx;
-        m_nodes[m_nodes[newBranchNodeIdx].m_leftNodeIdx].m_parentNodeIdx = newBranchNodeIdx;
+        m_nodes[originalLeafNodeIdx].m_parentNodeIdx = newBranchNodeIdx;
 
-        // Create the sibling node and set it as the right child
-        int32_t const newSiblingNodeIdx = RequestNode( newSiblingBox, userData );
-        m_nodes[newBranchNodeIdx].m_rightNodeIdx = newSiblingNodeIdx;
-        m_nodes[m_nodes[newBranchNodeIdx].m_rightNodeIdx].m_parentNodeIdx = newBranchNodeIdx;
+        // Set the new leaf as the right child
+        m_nodes[newBranchNodeIdx].m_rightNodeIdx = newLeafNodeIdx;
+        m_nodes[newLeafNodeIdx].m_parentNodeIdx = newBranchNodeIdx;
 
         // Update the bounds of the new branch node
         UpdateBranchNodeBounds( newBranchNodeIdx );
@@ -136,12 +166,7 @@ namespace EE::Math
         }
 
         // Propagate changes up the hierarchy
-        int32_t parentIndex = grandparentIdx;
-        while ( parentIndex != InvalidIndex )
-        {
-            UpdateBranchNodeBounds( parentIndex );
-            parentIndex = m_nodes[parentIndex].m_parentNodeIdx;
-        }
+        UpdateAncestorBounds( grandparentIdx );
     }
 
     void AABBTree::RemoveBox( uint64_t userData )
@@ -153,52 +178,100 @@ namespace EE::Math
 
     void AABBTree::RemoveNode( int32_t nodeToRemoveIdx )
     {
+        RemoveLeaf( nodeToRemoveIdx );
+        ReleaseNode( nodeToRemoveIdx );
+    }
+
+    void AABBTree::RemoveLeaf( int32_t leafNodeIdx )
+    {
+        EE_ASSERT( m_nodes[leafNodeIdx].IsLeafNode() );
+
         // Check if we are the root node
-        int32_t const parentNodeIdx = m_nodes[nodeToRemoveIdx].m_parentNodeIdx;
+        int32_t const parentNodeIdx = m_nodes[leafNodeIdx].m_parentNodeIdx;
         if ( parentNodeIdx == InvalidIndex )
         {
-            EE_ASSERT( m_rootNodeIdx == nodeToRemoveIdx );
+            EE_ASSERT( m_rootNodeIdx == leafNodeIdx );
             m_rootNodeIdx = InvalidIndex;
-            ReleaseNode( nodeToRemoveIdx );
+            return;
         }
-        else // Replace the parent branch node with our sibling
-        {
-            int32_t const siblingIdx = ( m_nodes[parentNodeIdx].m_leftNodeIdx == nodeToRemoveIdx ) ? m_nodes[parentNodeIdx].m_rightNodeIdx : m_nodes[parentNodeIdx].m_leftNodeIdx;
 
-            // If we dont have a grandparent then the parent branch was the root
-            int32_t const grandparentNodeIdx = m_nodes[parentNodeIdx].m_parentNodeIdx;
-            if ( grandparentNodeIdx == InvalidIndex )
+        // Replace the parent branch node with our sibling
+        //-------------------------------------------------------------------------
+
+        int32_t const siblingIdx = ( m_nodes[parentNodeIdx].m_leftNodeIdx == leafNodeIdx ) ? m_nodes[parentNodeIdx].m_rightNodeIdx : m_nodes[parentNodeIdx].m_leftNodeIdx;
+
+        // If we dont have a grandparent then the parent branch was the root
+        int32_t const grandparentNodeIdx = m_nodes[parentNodeIdx].m_parentNodeIdx;
+        if ( grandparentNodeIdx == InvalidIndex )
+        {
+            EE_ASSERT( m_rootNodeIdx == parentNodeIdx );
+            m_nodes[siblingIdx].m_parentNodeIdx = InvalidIndex;
+            m_rootNodeIdx = siblingIdx;
+        }
+        else // Set indices so that sibling is a child of the grandparent
+        {
+            if ( m_nodes[grandparentNodeIdx].m_leftNodeIdx == parentNodeIdx )
             {
-                EE_ASSERT( m_rootNodeIdx == parentNodeIdx );
-                m_nodes[siblingIdx].m_parentNodeIdx = InvalidIndex;
-                m_rootNodeIdx = siblingIdx;
+                m_nodes[grandparentNodeIdx].m_leftNodeIdx = siblingIdx;
             }
-            else // Set indices so that sibling is a child of the grandparent
+            else
             {
-                if ( m_nodes[grandparentNodeIdx].m_leftNodeIdx == parentNodeIdx )
-                {
-                    m_nodes[grandparentNodeIdx].m_leftNodeIdx = siblingIdx;
-                }
-                else
-                {
-                    m_nodes[grandparentNodeIdx].m_rightNodeIdx = siblingIdx;
-                }
+                m_nodes[grandparentNodeIdx].m_rightNodeIdx = siblingIdx;
+            }
 
-                m_nodes[siblingIdx].m_parentNodeIdx = grandparentNodeIdx;
+            m_nodes[siblingIdx].m_parentNodeIdx = grandparentNodeIdx;
 
-                // Propagate changes up the hierarchy
-                int32_t parentIndex = grandparentNodeIdx;
-                while ( parentIndex != InvalidIndex )
-                {
-                    UpdateBranchNodeBounds( parentIndex );
-                    parentIndex = m_nodes[parentIndex].m_parentNodeIdx;
-                }
-            }
+            // Propagate changes up the hierarchy
+            UpdateAncestorBounds( grandparentNodeIdx );
+        }
+
+        // Release the parent and detach the leaf
+        ReleaseNode( parentNodeIdx );
+        m_nodes[leafNodeIdx].m_parentNodeIdx = InvalidIndex;
+    }
+
+    //-------------------------------------------------------------------------
+
+    int32_t AABBTree::CreateProxy( AABB const& aabb, uint64_t userData, uint32_t layerMask, float margin )
+    {
+        EE_ASSERT( aabb.IsValid() && margin >= 0.0f && layerMask != 0 );
+
+        AABB enlargedBox = aabb;
+        enlargedBox.Grow( Vector( margin ) );
 
-            // Release nodes and set free node index
-            ReleaseNode( parentNodeIdx );
-            ReleaseNode( nodeToRemoveIdx );
+        int32_t const proxyIdx = RequestNode( enlargedBox, userData );
+        m_nodes[proxyIdx].m_layerMask = layerMask;
+        InsertLeaf( proxyIdx );
+        return proxyIdx;
+    }
+
+    void AABBTree::DestroyProxy( int32_t proxyIdx )
+    {
+        EE_ASSERT( IsValidProxy( proxyIdx ) );
+        RemoveNode( proxyIdx );
+    }
+
+    bool AABBTree::MoveProxy( int32_t proxyIdx, AABB const& aabb, float margin )
+    {
+        EE_ASSERT( IsValidProxy( proxyIdx ) && aabb.IsValid() && margin >= 0.0f );
+
+        // Nothing to do if we are still within the enlarged box
+        AABB const& currentBox = m_nodes[proxyIdx].m_bounds;
+        if ( currentBox.GetMin().IsLessThanEqual3( aabb.GetMin() ) && aabb.GetMax().IsLessThanEqual3( currentBox.GetMax() ) )
+        {
+            return false;
         }
+
+        // Reinsert the leaf, this keeps the proxy idx unchanged
+        RemoveLeaf( proxyIdx );
+
+        AABB enlargedBox = aabb;
+        enlargedBox.Grow( Vector( margin ) );
+        m_nodes[proxyIdx].m_bounds = enlargedBox;
+        m_nodes[proxyIdx].m_volume = enlargedBox.GetVolume();
+
+        InsertLeaf( proxyIdx );
+        return true;
     }
 
     //-------------------------------------------------------------------------
@@ -240,25 +313,112 @@ namespace EE::Math
 
     //-------------------------------------------------------------------------
 
-    void AABBTree::FindAllOverlappingLeafNodes( int32_t currentNodeIdx, AABB const& queryBox, TVector<uint64_t>& outResults ) const
+    void AABBTree::AddAllLeafNodes( int32_t startNodeIdx, uint32_t layerMask, TVector<uint64_t>& outResults ) const
     {
-        Node const& currentNode = m_nodes[currentNodeIdx];
-        if ( currentNode.IsLeafNode() )
+        TraversalStack stack;
+        stack.emplace_back( startNodeIdx );
+
+        while ( !stack.empty() )
         {
-            if ( currentNode.m_bounds.Overlaps( queryBox ) )
+            Node const& currentNode = m_nodes[stack.back()];
+            stack.pop_back();
+
+            if ( ( currentNode.m_layerMask & layerMask ) == 0 )
+            {
+                continue;
+            }
+
+            if ( currentNode.IsLeafNode() )
             {
                 EE_ASSERT( currentNode.m_userData != 0 );
                 outResults.push_back( currentNode.m_userData );
             }
+            else
+            {
+                stack.emplace_back( currentNode.m_rightNodeIdx );
+                stack.emplace_back( currentNode.m_leftNodeIdx );
+            }
         }
-        else
+    }
+
+    bool AABBTree::FindOverlaps( AABB const& queryBox, TVector<uint64_t>& outResults, uint32_t layerMask ) const
+    {
+        outResults.clear();
+
+        if ( m_rootNodeIdx == InvalidIndex )
+        {
+            return false;
+        }
+
+        TraversalStack stack;
+        stack.emplace_back( m_rootNodeIdx );
+
+        while ( !stack.empty() )
+        {
+            Node const& currentNode = m_nodes[stack.back()];
+            stack.pop_back();
+
+            if ( ( currentNode.m_layerMask & layerMask ) == 0 || !currentNode.m_bounds.Overlaps( queryBox ) )
+            {
+                continue;
+            }
+
+            if ( currentNode.IsLeafNode() )
+            {
+                EE_ASSERT( currentNode.m_userData != 0 );
+                outResults.push_back( currentNode.m_userData );
+            }
+            else
+            {
+                stack.emplace_back( currentNode.m_rightNodeIdx );
+                stack.emplace_back( currentNode.m_leftNodeIdx );
+            }
+        }
+
+        return outResults.size() > 0;
+    }
+
+    bool AABBTree::FindOverlaps( Vector const& sphereCenter, float sphereRadius, TVector<uint64_t>& outResults, uint32_t layerMask ) const
+    {
+        EE_ASSERT( sphereRadius >= 0.0f );
+        outResults.clear();
+
+        if ( m_rootNodeIdx == InvalidIndex )
+        {
+            return false;
+        }
+
+        float const sphereRadiusSq = sphereRadius * sphereRadius;
+
+        TraversalStack stack;
+        stack.emplace_back( m_rootNodeIdx );
+
+        while ( !stack.empty() )
         {
-            FindAllOverlappingLeafNodes( currentNode.m_leftNodeIdx, queryBox, outResults );
-            FindAllOverlappingLeafNodes( currentNode.m_rightNodeIdx, queryBox, outResults );
+            Node const& currentNode = m_nodes[stack.back()];
+            stack.pop_back();
+
+            if ( ( currentNode.m_layerMask & layerMask ) == 0 || !DoesSphereOverlapBox( sphereCenter, sphereRadiusSq, currentNode.m_bounds ) )
+            {
+                continue;
+            }
+
+            if ( currentNode.IsLeafNode() )
+            {
+                EE_ASSERT( currentNode.m_userData != 0 );
+                outResults.push_back( currentNode.m_userData );
+            }
+            else
+            {
+                stack.emplace_back( currentNode.m_rightNodeIdx );
+                stack.emplace_back( currentNode.m_leftNodeIdx );
+            }
         }
+
+        return outResults.size() > 0;
     }
 
-    bool AABBTree::FindOverlaps( AABB const& queryBox, TVector<uint64_t>& outResults ) const
+    bool AABBTree::FindOverlaps( ViewVolume const& viewVolume, TVector<uint64_t>& outResults, uint32_t layerMask ) const
     {
         outResults.clear();
 
@@ -267,10 +427,160 @@ namespace EE::Math
             return false;
         }
 
-        FindAllOverlappingLeafNodes( m_rootNodeIdx, queryBox, outResults );
+        TraversalStack stack;
+        stack.emplace_back( m_rootNodeIdx );
+
+        while ( !stack.empty() )
+        {
+            int32_t const currentNodeIdx = stack.back();
+            stack.pop_back();
+
+            Node const& currentNode = m_nodes[currentNodeIdx];
+            if ( ( currentNode.m_layerMask & layerMask ) == 0 )
+            {
+                continue;
+            }
+
+            ViewVolume::IntersectionResult const result = viewVolume.Intersect( currentNode.m_bounds );
+            if ( result == ViewVolume::IntersectionResult::FullyOutside )
+            {
+                continue;
+            }
+
+            // Everything below a fully contained node is visible, so we can skip any further tests
+            if ( result == ViewVolume::IntersectionResult::FullyInside || currentNode.IsLeafNode() )
+            {
+                AddAllLeafNodes( currentNodeIdx, layerMask, outResults );
+            }
+            else
+            {
+                stack.emplace_back( currentNode.m_rightNodeIdx );
+                stack.emplace_back( currentNode.m_leftNodeIdx );
+            }
+        }
+
         return outResults.size() > 0;
     }
 
+    bool AABBTree::FindIntersections( Ray const& ray, float maxDistance, TVector<uint64_t>& outResults, uint32_t layerMask ) const
+    {
+        EE_ASSERT( maxDistance >= 0.0f );
+        outResults.clear();
+
+        if ( m_rootNodeIdx == InvalidIndex )
+        {
+            return false;
+        }
+
+        Vector const rayStart = ray.GetStartPoint();
+        Vector const invRayDirection = ray.GetDirection().GetReciprocal();
+
+        TraversalStack stack;
+        stack.emplace_back( m_rootNodeIdx );
+
+        while ( !stack.empty() )
+        {
+            Node const& currentNode = m_nodes[stack.back()];
+            stack.pop_back();
+
+            if ( ( currentNode.m_layerMask & layerMask ) == 0 || !DoesRayIntersectBox( rayStart, invRayDirection, maxDistance, currentNode.m_bounds ) )
+            {
+                continue;
+            }
+
+            if ( currentNode.IsLeafNode() )
+            {
+                EE_ASSERT( currentNode.m_userData != 0 );
+                outResults.push_back( currentNode.m_userData );
+            }
+            else
+            {
+                stack.emplace_back( currentNode.m_rightNodeIdx );
+                stack.emplace_back( currentNode.m_leftNodeIdx );
+            }
+        }
+
+        return outResults.size() > 0;
+    }
+
+    void AABBTree::FindOverlaps( AABB const* pQueryBoxes, int32_t numQueries, TVector<uint64_t>* pOutResults, uint32_t layerMask ) const
+    {
+        EE_ASSERT( numQueries >= 0 && ( numQueries == 0 || ( pQueryBoxes != nullptr && pOutResults != nullptr ) ) );
+
+        for ( int32_t i = 0; i < numQueries; i++ )
+        {
+            pOutResults[i].clear();
+        }
+
+        if ( m_rootNodeIdx == InvalidIndex )
+        {
+            return;
+        }
+
+        // Queries are processed in groups of 64, each stack entry tracks which queries in the group still overlap the node
+        struct StackEntry
+        {
+            int32_t     m_nodeIdx;
+            uint64_t    m_activeQueries;
+        };
+
+        TInlineVector<StackEntry, 64> stack;
+
+        for ( int32_t groupStartIdx = 0; groupStartIdx < numQueries; groupStartIdx += 64 )
+        {
+            int32_t const numQueriesInGroup = Math::Min( numQueries - groupStartIdx, 64 );
+            AABB const* pGroupBoxes = pQueryBoxes + groupStartIdx;
+            TVector<uint64_t>* pGroupResults = pOutResults + groupStartIdx;
+
+            uint64_t const allQueriesInGroup = ( numQueriesInGroup == 64 ) ? 0xFFFFFFFFFFFFFFFF : ( ( 1ull << numQueriesInGroup ) - 1 );
+            stack.push_back( { m_rootNodeIdx, allQueriesInGroup } );
+
+            while ( !stack.empty() )
+            {
+                StackEntry const entry = stack.back();
+                stack.pop_back();
+
+                Node const& currentNode = m_nodes[entry.m_nodeIdx];
+                if ( ( currentNode.m_layerMask & layerMask ) == 0 )
+                {
+                    continue;
+                }
+
+                // Test the node against each of the queries that overlapped the parent
+                uint64_t overlappingQueries = 0;
+                for ( uint64_t remainingQueries = entry.m_activeQueries; remainingQueries != 0; remainingQueries &= ( remainingQueries - 1 ) )
+                {
+                    int32_t const queryIdx = Math::GetLeastSignificantBit( remainingQueries );
+                    if ( currentNode.m_bounds.Overlaps( pGroupBoxes[queryIdx] ) )
+                    {
+                        overlappingQueries |= ( 1ull << queryIdx );
+                    }
+                }
+
+                if ( overlappingQueries == 0 )
+                {
+                    continue;
+                }
+
+                //-------------------------------------------------------------------------
+
+                if ( currentNode.IsLeafNode() )
+                {
+                    EE_ASSERT( currentNode.m_userData != 0 );
+                    for ( ; overlappingQueries != 0; overlappingQueries &= ( overlappingQueries - 1 ) )
+                    {
+                        pGroupResults[Math::GetLeastSignificantBit( overlappingQueries )].push_back( currentNode.m_userData );
+                    }
+                }
+                else
+                {
+                    stack.push_back( { currentNode.m_rightNodeIdx, overlappingQueries } );
+                    stack.push_back( { currentNode.m_leftNodeIdx, overlappingQueries } );
+                }
+            }
+        }
+    }
+
     //-------------------------------------------------------------------------
 
     #if EE_DEVELOPMENT_TOOLS
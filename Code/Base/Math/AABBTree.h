@@ -5,14 +5,30 @@
 
 //-------------------------------------------------------------------------
 
+namespace EE { class Ray; }
 namespace EE::Drawing { class DrawContext; }
+namespace EE::Math { class ViewVolume; }
 
 //-------------------------------------------------------------------------
 
 namespace EE::Math
 {
+    //-------------------------------------------------------------------------
+    // Dynamic AABB Tree
+    //-------------------------------------------------------------------------
+    // Boxes can either be added by user data (which needs to be unique) or as proxies which are referred to by their leaf node index.
+    // Proxies can be cheaply moved and removed, and are optionally enlarged by a margin so that small movements dont modify the tree.
+    // Each box has a layer mask which can be used to filter queries, the branch nodes store the combined masks of their children.
+    // All queries return the user data of the overlapping leaves, proxy queries are conservative as they use the enlarged boxes.
+
     class EE_BASE_API AABBTree
     {
+    public:
+
+        constexpr static uint32_t const s_allLayers = 0xFFFFFFFF;
+
+    private:
+
         struct Node
         {
         public:
@@ -31,6 +47,7 @@ namespace EE::Math
             int32_t         m_rightNodeIdx = InvalidIndex;
             int32_t         m_parentNodeIdx = InvalidIndex;
             float           m_volume = 0;
+            uint32_t        m_layerMask = s_allLayers;
 
             uint64_t        m_userData = 0xFFFFFFFFFFFFFFFF;
             bool            m_isFree = true;
@@ -48,12 +65,58 @@ namespace EE::Math
         EE_FORCE_INLINE void InsertBox( AABB const& aabb, void* pUserData ) { InsertBox( aabb, reinterpret_cast<uint64_t>( pUserData ) ); }
         EE_FORCE_INLINE void RemoveBox( void* pUserData ) { RemoveBox( reinterpret_cast<uint64_t>( pUserData ) ); }
 
-        bool FindOverlaps( AABB const& queryBox, TVector<uint64_t>& outResults ) const;
+        // Proxies
+        //-------------------------------------------------------------------------
+
+        // Add a box and return the proxy index for it, this index is stable until the proxy is destroyed
+        int32_t CreateProxy( AABB const& aabb, uint64_t userData, uint32_t layerMask = s_allLayers, float margin = 0.0f );
+
+        EE_FORCE_INLINE int32_t CreateProxy( AABB const& aabb, void* pUserData, uint32_t layerMask = s_allLayers, float margin = 0.0f ) { return CreateProxy( aabb, reinterpret_cast<uint64_t>( pUserData ), layerMask, margin ); }
+
+        // Remove a proxy from the tree
+        void DestroyProxy( int32_t proxyIdx );
+
+        // Update the box for a proxy, this will only modify the tree if the new box is not contained within the current enlarged box
+        // Returns true if the tree was modified
+        bool MoveProxy( int32_t proxyIdx, AABB const& aabb, float margin = 0.0f );
+
+        inline AABB const& GetProxyBounds( int32_t proxyIdx ) const { EE_ASSERT( IsValidProxy( proxyIdx ) ); return m_nodes[proxyIdx].m_bounds; }
+        inline uint64_t GetProxyUserData( int32_t proxyIdx ) const { EE_ASSERT( IsValidProxy( proxyIdx ) ); return m_nodes[proxyIdx].m_userData; }
+
+        // Queries
+        //-------------------------------------------------------------------------
+        // The output arrays are cleared before the query is run, the return value is whether any results were found
+
+        bool FindOverlaps( AABB const& queryBox, TVector<uint64_t>& outResults, uint32_t layerMask = s_allLayers ) const;
+        bool FindOverlaps( Vector const& sphereCenter, float sphereRadius, TVector<uint64_t>& outResults, uint32_t layerMask = s_allLayers ) const;
+        bool FindOverlaps( ViewVolume const& viewVolume, TVector<uint64_t>& outResults, uint32_t layerMask = s_allLayers ) const;
+        bool FindIntersections( Ray const& ray, float maxDistance, TVector<uint64_t>& outResults, uint32_t layerMask = s_allLayers ) const;
+
+        // Run multiple box queries with a single traversal of the tree, there needs to be a result array per query box
+        void FindOverlaps( AABB const* pQueryBoxes, int32_t numQueries, TVector<uint64_t>* pOutResults, uint32_t layerMask = s_allLayers ) const;
 
         template<typename T>
-        bool FindOverlaps( AABB const& queryBox, TVector<T*>& outResults ) const
+        bool FindOverlaps( AABB const& queryBox, TVector<T*>& outResults, uint32_t layerMask = s_allLayers ) const
         {
-            return FindOverlaps( queryBox, reinterpret_cast<TVector<uint64_t>&>( outResults ) );
+            return FindOverlaps( queryBox, reinterpret_cast<TVector<uint64_t>&>( outResults ), layerMask );
+        }
+
+        template<typename T>
+        bool FindOverlaps( Vector const& sphereCenter, float sphereRadius, TVector<T*>& outResults, uint32_t layerMask = s_allLayers ) const
+        {
+            return FindOverlaps( sphereCenter, sphereRadius, reinterpret_cast<TVector<uint64_t>&>( outResults ), layerMask );
+        }
+
+        template<typename T>
+        bool FindOverlaps( ViewVolume const& viewVolume, TVector<T*>& outResults, uint32_t layerMask = s_allLayers ) const
+        {
+            return FindOverlaps( viewVolume, reinterpret_cast<TVector<uint64_t>&>( outResults ), layerMask );
+        }
+
+        template<typename T>
+        bool FindIntersections( Ray const& ray, float maxDistance, TVector<T*>& outResults, uint32_t layerMask = s_allLayers ) const
+        {
+            return FindIntersections( ray, maxDistance, reinterpret_cast<TVector<uint64_t>&>( outResults ), layerMask );
         }
 
         #if EE_DEVELOPMENT_TOOLS
@@ -62,16 +125,20 @@ namespace EE::Math
 
     private:
 
-        void InsertNode( int32_t leafNodeIdx, AABB const& newSiblingBox, uint64_t userData );
+        inline bool IsValidProxy( int32_t proxyIdx ) const { return proxyIdx >= 0 && proxyIdx < (int32_t) m_nodes.size() && !m_nodes[proxyIdx].m_isFree && m_nodes[proxyIdx].IsLeafNode(); }
+
+        void InsertLeaf( int32_t leafNodeIdx );
+        void RemoveLeaf( int32_t leafNodeIdx );
         void RemoveNode( int32_t nodeToRemoveIdx );
         void UpdateBranchNodeBounds( int32_t nodeIdx );
+        void UpdateAncestorBounds( int32_t nodeIdx );
 
         int32_t RequestNode( AABB const& box, uint64_t userData = 0 );
         void ReleaseNode( int32_t nodeIdx );
 
         int32_t FindBestLeafNodeToCreateSiblingFor( int32_t startNodeIdx, AABB const& newBox ) const;
-        void FindAllOverlappingLeafNodes( int32_t currentNodeIdx, AABB const& queryBox, TVector<uint64_t>& outResults ) const;
         void FindAllOverlappingLeafNodes( int32_t currentNodeIdx, OBB const& queryBox, TVector<uint64_t>& outResults ) const;
+        void AddAllLeafNodes( int32_t currentNodeIdx, uint32_t layerMask, TVector<uint64_t>& outResults ) const;
 
         #if EE_DEVELOPMENT_TOOLS
         void DrawBranch( Drawing::DrawContext& drawingContext, int32_t nodeIdx ) const;
@@ -0,0 +1,160 @@
+#include "AABBTreeBenchmark.h"
+
+#if EE_DEVELOPMENT_TOOLS
+#include "AABBTree.h"
+#include "WideAABBTree.h"
+#include "MathRandom.h"
+#include "Base/Time/Timers.h"
+
+//-------------------------------------------------------------------------
+
+namespace EE::Math
+{
+    constexpr static float const g_worldHalfSize = 500.0f;
+    constexpr static float const g_maxBoxHalfSize = 2.5f;
+    constexpr static float const g_queryHalfSize = 10.0f;
+    constexpr static float const g_maxMoveDistance = 0.5f;
+    constexpr static float const g_proxyMargin = 0.1f;
+
+    static AABB CreateRandomBox( RNG const& rng, float maxHalfSize )
+    {
+        Vector const center( rng.GetFloat( -g_worldHalfSize, g_worldHalfSize ), rng.GetFloat( -g_worldHalfSize, g_worldHalfSize ), rng.GetFloat( -g_worldHalfSize, g_worldHalfSize ) );
+        Vector const halfExtents( rng.GetFloat( 0.1f, maxHalfSize ), rng.GetFloat( 0.1f, maxHalfSize ), rng.GetFloat( 0.1f, maxHalfSize ) );
+        return AABB( center, halfExtents );
+    }
+
+    //-------------------------------------------------------------------------
+
+    void AABBTreeBenchmarkResults::Log() const
+    {
+        EE_LOG_INFO( "Math", "AABB Tree Benchmark", "%d boxes, %d queries", m_numBoxes, m_numQueries );
+        EE_LOG_INFO( "Math", "AABB Tree Benchmark", "Binary - Insert: %.2fms, Move: %.2fms, Query: %.2fms (%lld results)", m_binaryInsertTime.ToFloat(), m_binaryMoveTime.ToFloat(), m_binaryQueryTime.ToFloat(), m_binaryNumResults );
+        EE_LOG_INFO( "Math", "AABB Tree Benchmark", "Wide - Insert: %.2fms, Build: %.2fms, Move: %.2fms, Refit: %.2fms, Query: %.2fms (%lld results)", m_wideInsertTime.ToFloat(), m_wideBuildTime.ToFloat(), m_wideMoveTime.ToFloat(), m_wideRefitTime.ToFloat(), m_wideQueryTime.ToFloat(), m_wideNumResults );
+    }
+
+    AABBTreeBenchmarkResults RunAABBTreeBenchmark( int32_t numBoxes, int32_t numQueries, uint32_t seed )
+    {
+        EE_ASSERT( numBoxes > 0 && numQueries > 0 );
+
+        AABBTreeBenchmarkResults results;
+        results.m_numBoxes = numBoxes;
+        results.m_numQueries = numQueries;
+
+        // Generate scene
+        //-------------------------------------------------------------------------
+
+        RNG rng( seed );
+
+        TVector<AABB> boxes;
+        TVector<AABB> movedBoxes;
+        TVector<uint64_t> userData;
+        boxes.reserve( numBoxes );
+        movedBoxes.reserve( numBoxes );
+        userData.reserve( numBoxes );
+
+        for ( int32_t i = 0; i < numBoxes; i++ )
+        {
+            AABB const& box = boxes.emplace_back( CreateRandomBox( rng, g_maxBoxHalfSize ) );
+
+            AABB movedBox = box;
+            movedBox.Translate( Vector( rng.GetFloat( -g_maxMoveDistance, g_maxMoveDistance ), rng.GetFloat( -g_maxMoveDistance, g_maxMoveDistance ), rng.GetFloat( -g_maxMoveDistance, g_maxMoveDistance ) ) );
+            movedBoxes.emplace_back( movedBox );
+
+            userData.emplace_back( i + 1 );
+        }
+
+        TVector<AABB> queries;
+        queries.reserve( numQueries );
+        for ( int32_t i = 0; i < numQueries; i++ )
+        {
+            queries.emplace_back( CreateRandomBox( rng, g_queryHalfSize ) );
+        }
+
+        TVector<int32_t> proxies;
+        proxies.resize( numBoxes );
+        TVector<uint64_t> queryResults;
+
+        // Binary tree
+        //-------------------------------------------------------------------------
+
+        {
+            AABBTree tree;
+
+            Timer<PlatformClock> timer;
+            timer.Start();
+            for ( int32_t i = 0; i < numBoxes; i++ )
+            {
+                proxies[i] = tree.CreateProxy( boxes[i], userData[i], AABBTree::s_allLayers, g_proxyMargin );
+            }
+            results.m_binaryInsertTime = timer.GetElapsedTimeMilliseconds();
+
+            timer.Start();
+            for ( int32_t i = 0; i < numBoxes; i++ )
+            {
+                tree.MoveProxy( proxies[i], movedBoxes[i], g_proxyMargin );
+            }
+            results.m_binaryMoveTime = timer.GetElapsedTimeMilliseconds();
+
+            timer.Start();
+            for ( int32_t i = 0; i < numQueries; i++ )
+            {
+                tree.FindOverlaps( queries[i], queryResults );
+                results.m_binaryNumResults += queryResults.size();
+            }
+            results.m_binaryQueryTime = timer.GetElapsedTimeMilliseconds();
+        }
+
+        // Wide tree
+        //-------------------------------------------------------------------------
+
+        {
+            WideAABBTree tree;
+
+            Timer<PlatformClock> timer;
+            timer.Start();
+            for ( int32_t i = 0; i < numBoxes; i++ )
+            {
+                proxies[i] = tree.CreateProxy( boxes[i], userData[i], WideAABBTree::s_allLayers, g_proxyMargin );
+            }
+            results.m_wideInsertTime = timer.GetElapsedTimeMilliseconds();
+
+            timer.Start();
+            for ( int32_t i = 0; i < numBoxes; i++ )
+            {
+                tree.MoveProxy( proxies[i], movedBoxes[i], g_proxyMargin );
+            }
+            results.m_wideMoveTime = timer.GetElapsedTimeMilliseconds();
+
+            // Rebuild the tree with the moved boxes and refit back to the original boxes, so that the query is run on the same scene
+            timer.Start();
+            tree.Build( movedBoxes.data(), userData.data(), nullptr, numBoxes, g_proxyMargin );
+            results.m_wideBuildTime = timer.GetElapsedTimeMilliseconds();
+
+            timer.Start();
+            for ( int32_t i = 0; i < numBoxes; i++ )
+            {
+                AABB enlargedBox = boxes[i];
+                enlargedBox.Grow( Vector( g_proxyMargin ) );
+                tree.RefitProxy( i, enlargedBox );
+            }
+            results.m_wideRefitTime = timer.GetElapsedTimeMilliseconds();
+
+            // Query the moved scene
+            for ( int32_t i = 0; i < numBoxes; i++ )
+            {
+                tree.MoveProxy( i, movedBoxes[i], g_proxyMargin );
+            }
+
+            timer.Start();
+            for ( int32_t i = 0; i < numQueries; i++ )
+            {
+                tree.FindOverlaps( queries[i], queryResults );
+                results.m_wideNumResults += queryResults.size();
+            }
+            results.m_wideQueryTime = timer.GetElapsedTimeMilliseconds();
+        }
+
+        return results;
+    }
+}
+#endif
@@ -0,0 +1,41 @@
+#pragma once
+
+#include "Base/_Module/API.h"
+#include "Base/Time/Time.h"
+
+//-------------------------------------------------------------------------
+// AABB Tree Benchmark
+//-------------------------------------------------------------------------
+// Compares the binary AABB tree against the wide AABB tree on the same randomly generated scene
+// The scene is a set of small boxes scattered through a large cube, all boxes are moved by a small amount once and then queried
+
+#if EE_DEVELOPMENT_TOOLS
+namespace EE::Math
+{
+    struct EE_BASE_API AABBTreeBenchmarkResults
+    {
+        // Log the results to the system log
+        void Log() const;
+
+    public:
+
+        int32_t         m_numBoxes = 0;
+        int32_t         m_numQueries = 0;
+
+        Milliseconds    m_binaryInsertTime = 0.0f;
+        Milliseconds    m_binaryMoveTime = 0.0f;
+        Milliseconds    m_binaryQueryTime = 0.0f;
+        int64_t         m_binaryNumResults = 0;
+
+        Milliseconds    m_wideInsertTime = 0.0f;
+        Milliseconds    m_wideBuildTime = 0.0f;
+        Milliseconds    m_wideMoveTime = 0.0f;
+        Milliseconds    m_wideRefitTime = 0.0f;
+        Milliseconds    m_wideQueryTime = 0.0f;
+        int64_t         m_wideNumResults = 0;
+    };
+
+    // Run the benchmark, this is deterministic for a given seed so the result counts of both trees should match
+    EE_BASE_API AABBTreeBenchmarkResults RunAABBTreeBenchmark( int32_t numBoxes = 10000, int32_t numQueries = 10000, uint32_t seed = 0 );
+}
+#endif
@@ -18,4 +18,19 @@ namespace EE::Math
         _BitScanReverse64( &index, (unsigned long) value );
         return index;
     }
+
+    EE_FORCE_INLINE uint32_t GetLeastSignificantBit( uint64_t value )
+    {
+        // The intrinsic produces an undefined value if the input is 0, so we need to handle it explicitly
+        if ( value == 0 )
+        {
+            return 0;
+        }
+
+        //-------------------------------------------------------------------------
+
+        unsigned long index = 0;
+        _BitScanForward64( &index, value );
+        return index;
+    }
 }
\ No newline at end of file
@@ -0,0 +1,1062 @@
+#include "WideAABBTree.h"
+#include "Base/Math/ViewVolume.h"
+#include "Base/Math/Line.h"
+#include "Base/Types/Color.h"
+#include "Base/Drawing/DebugDrawing.h"
+
+//-------------------------------------------------------------------------
+
+namespace EE::Math
+{
+    // The traversal stack is inline allocated, so this should cover the depth of most trees
+    using TraversalStack = TInlineVector<int32_t, 64>;
+
+    constexpr static int32_t const g_numSAHBins = 16;
+
+    // Proportional to the surface area, which is all we need for comparisons
+    EE_FORCE_INLINE static float GetCost( AABB const& box )
+    {
+        Vector const extents = box.GetExtents();
+        float const x = extents.GetX();
+        float const y = extents.GetY();
+        float const z = extents.GetZ();
+        return ( x * y ) + ( y * z ) + ( z * x );
+    }
+
+    // Returns a bit per child slot for all the children that are on at least one of the requested layers
+    template<typename NodeType>
+    EE_FORCE_INLINE static uint32_t GetChildrenOnLayers( NodeType const& node, __m128i layerMask )
+    {
+        __m128i const childLayers = _mm_and_si128( _mm_load_si128( reinterpret_cast<__m128i const*>( node.m_layerMasks ) ), layerMask );
+        return ~(uint32_t) _mm_movemask_ps( _mm_castsi128_ps( _mm_cmpeq_epi32( childLayers, _mm_setzero_si128() ) ) ) & 0xF;
+    }
+
+    // Returns a bit per child slot for all the children that overlap the query box
+    template<typename NodeType>
+    EE_FORCE_INLINE static uint32_t GetChildrenOverlappingBox( NodeType const& node, __m128 const queryMin[3], __m128 const queryMax[3] )
+    {
+        __m128 overlap = _mm_and_ps( _mm_cmple_ps( _mm_load_ps( node.m_minX ), queryMax[0] ), _mm_cmpge_ps( _mm_load_ps( node.m_maxX ), queryMin[0] ) );
+        overlap = _mm_and_ps( overlap, _mm_and_ps( _mm_cmple_ps( _mm_load_ps( node.m_minY ), queryMax[1] ), _mm_cmpge_ps( _mm_load_ps( node.m_maxY ), queryMin[1] ) ) );
+        overlap = _mm_and_ps( overlap, _mm_and_ps( _mm_cmple_ps( _mm_load_ps( node.m_minZ ), queryMax[2] ), _mm_cmpge_ps( _mm_load_ps( node.m_maxZ ), queryMin[2] ) ) );
+        return (uint32_t) _mm_movemask_ps( overlap );
+    }
+
+    EE_FORCE_INLINE static void SplatBox( AABB const& box, __m128 outMin[3], __m128 outMax[3] )
+    {
+        Vector const min = box.GetMin();
+        Vector const max = box.GetMax();
+        outMin[0] = _mm_set1_ps( min.GetX() );
+        outMin[1] = _mm_set1_ps( min.GetY() );
+        outMin[2] = _mm_set1_ps( min.GetZ() );
+        outMax[0] = _mm_set1_ps( max.GetX() );
+        outMax[1] = _mm_set1_ps( max.GetY() );
+        outMax[2] = _mm_set1_ps( max.GetZ() );
+    }
+
+    //-------------------------------------------------------------------------
+
+    void WideAABBTree::Clear()
+    {
+        m_nodes.clear();
+        m_leaves.clear();
+        m_rootNodeIdx = InvalidIndex;
+        m_freeNodeIdx = InvalidIndex;
+        m_freeLeafIdx = InvalidIndex;
+        m_numProxies = 0;
+    }
+
+    //-------------------------------------------------------------------------
+
+    int32_t WideAABBTree::RequestNode()
+    {
+        int32_t nodeIdx = m_freeNodeIdx;
+        if ( nodeIdx != InvalidIndex )
+        {
+            m_freeNodeIdx = m_nodes[nodeIdx].m_nextFreeIdx;
+        }
+        else
+        {
+            nodeIdx = (int32_t) m_nodes.size();
+            m_nodes.emplace_back();
+        }
+
+        Node& node = m_nodes[nodeIdx];
+        node.m_parentNodeIdx = InvalidIndex;
+        node.m_parentSlot = InvalidIndex;
+        node.m_numChildren = 0;
+        node.m_nextFreeIdx = InvalidIndex;
+
+        for ( int32_t i = 0; i < s_branchingFactor; i++ )
+        {
+            ClearChild( nodeIdx, i );
+        }
+
+        return nodeIdx;
+    }
+
+    void WideAABBTree::ReleaseNode( int32_t nodeIdx )
+    {
+        EE_ASSERT( nodeIdx >= 0 && nodeIdx < (int32_t) m_nodes.size() );
+        m_nodes[nodeIdx].m_nextFreeIdx = m_freeNodeIdx;
+        m_nodes[nodeIdx].m_numChildren = 0;
+        m_freeNodeIdx = nodeIdx;
+    }
+
+    int32_t WideAABBTree::RequestLeaf( AABB const& box, uint64_t userData, uint32_t layerMask )
+    {
+        EE_ASSERT( box.IsValid() && layerMask != 0 );
+
+        int32_t leafIdx = m_freeLeafIdx;
+        if ( leafIdx != InvalidIndex )
+        {
+            m_freeLeafIdx = m_leaves[leafIdx].m_nextFreeIdx;
+        }
+        else
+        {
+            leafIdx = (int32_t) m_leaves.size();
+            m_leaves.emplace_back();
+        }
+
+        Leaf& leaf = m_leaves[leafIdx];
+        leaf.m_bounds = box;
+        leaf.m_userData = userData;
+        leaf.m_layerMask = layerMask;
+        leaf.m_nodeIdx = InvalidIndex;
+        leaf.m_slot = InvalidIndex;
+        leaf.m_nextFreeIdx = InvalidIndex;
+        leaf.m_isFree = false;
+
+        m_numProxies++;
+        return leafIdx;
+    }
+
+    void WideAABBTree::ReleaseLeaf( int32_t leafIdx )
+    {
+        EE_ASSERT( IsValidProxy( leafIdx ) );
+        m_leaves[leafIdx].m_isFree = true;
+        m_leaves[leafIdx].m_nextFreeIdx = m_freeLeafIdx;
+        m_freeLeafIdx = leafIdx;
+        m_numProxies--;
+    }
+
+    //-------------------------------------------------------------------------
+
+    AABB WideAABBTree::GetChildBounds( int32_t nodeIdx, int32_t slot ) const
+    {
+        Node const& node = m_nodes[nodeIdx];
+        EE_ASSERT( slot >= 0 && slot < node.m_numChildren );
+        Vector const min( node.m_minX[slot], node.m_minY[slot], node.m_minZ[slot] );
+        Vector const max( node.m_maxX[slot], node.m_maxY[slot], node.m_maxZ[slot] );
+        return AABB::FromMinMax( min, max );
+    }
+
+    AABB WideAABBTree::GetNodeBounds( int32_t nodeIdx ) const
+    {
+        Node const& node = m_nodes[nodeIdx];
+        EE_ASSERT( node.m_numChildren > 0 );
+
+        float minX = node.m_minX[0], minY = node.m_minY[0], minZ = node.m_minZ[0];
+        float maxX = node.m_maxX[0], maxY = node.m_maxY[0], maxZ = node.m_maxZ[0];
+        for ( int32_t i = 1; i < node.m_numChildren; i++ )
+        {
+            minX = Math::Min( minX, node.m_minX[i] );
+            minY = Math::Min( minY, node.m_minY[i] );
+            minZ = Math::Min( minZ, node.m_minZ[i] );
+            maxX = Math::Max( maxX, node.m_maxX[i] );
+            maxY = Math::Max( maxY, node.m_maxY[i] );
+            maxZ = Math::Max( maxZ, node.m_maxZ[i] );
+        }
+
+        return AABB::FromMinMax( Vector( minX, minY, minZ ), Vector( maxX, maxY, maxZ ) );
+    }
+
+    uint32_t WideAABBTree::GetNodeLayerMask( int32_t nodeIdx ) const
+    {
+        Node const& node = m_nodes[nodeIdx];
+        return node.m_layerMasks[0] | node.m_layerMasks[1] | node.m_layerMasks[2] | node.m_layerMasks[3];
+    }
+
+    void WideAABBTree::SetChildBounds( int32_t nodeIdx, int32_t slot, AABB const& bounds )
+    {
+        Node& node = m_nodes[nodeIdx];
+        Vector const min = bounds.GetMin();
+        Vector const max = bounds.GetMax();
+        node.m_minX[slot] = min.GetX();
+        node.m_minY[slot] = min.GetY();
+        node.m_minZ[slot] = min.GetZ();
+        node.m_maxX[slot] = max.GetX();
+        node.m_maxY[slot] = max.GetY();
+        node.m_maxZ[slot] = max.GetZ();
+    }
+
+    void WideAABBTree::SetChild( int32_t nodeIdx, int32_t slot, int32_t child, AABB const& bounds )
+    {
+        EE_ASSERT( child != s_emptyChild );
+
+        m_nodes[nodeIdx].m_children[slot] = child;
+        SetChildBounds( nodeIdx, slot, bounds );
+
+        // Update the layers and back references
+        if ( IsLeafChild( child ) )
+        {
+            Leaf& leaf = m_leaves[DecodeLeaf( child )];
+            leaf.m_nodeIdx = nodeIdx;
+            leaf.m_slot = slot;
+            m_nodes[nodeIdx].m_layerMasks[slot] = leaf.m_layerMask;
+        }
+        else
+        {
+            m_nodes[child].m_parentNodeIdx = nodeIdx;
+            m_nodes[child].m_parentSlot = slot;
+            m_nodes[nodeIdx].m_layerMasks[slot] = GetNodeLayerMask( child );
+        }
+    }
+
+    void WideAABBTree::ClearChild( int32_t nodeIdx, int32_t slot )
+    {
+        Node& node = m_nodes[nodeIdx];
+        node.m_children[slot] = s_emptyChild;
+        node.m_layerMasks[slot] = 0;
+        node.m_minX[slot] = node.m_minY[slot] = node.m_minZ[slot] = Math::Infinity;
+        node.m_maxX[slot] = node.m_maxY[slot] = node.m_maxZ[slot] = -Math::Infinity;
+    }
+
+    void WideAABBTree::RefitChildNode( int32_t nodeIdx )
+    {
+        Node const& node = m_nodes[nodeIdx];
+        EE_ASSERT( node.m_parentNodeIdx != InvalidIndex );
+        SetChildBounds( node.m_parentNodeIdx, node.m_parentSlot, GetNodeBounds( nodeIdx ) );
+        m_nodes[node.m_parentNodeIdx].m_layerMasks[node.m_parentSlot] = GetNodeLayerMask( nodeIdx );
+    }
+
+    //-------------------------------------------------------------------------
+
+    void WideAABBTree::InsertLeaf( int32_t leafIdx )
+    {
+        AABB const box = m_leaves[leafIdx].m_bounds;
+
+        if ( m_rootNodeIdx == InvalidIndex )
+        {
+            m_rootNodeIdx = RequestNode();
+            SetChild( m_rootNodeIdx, 0, EncodeLeaf( leafIdx ), box );
+            m_nodes[m_rootNodeIdx].m_numChildren = 1;
+            return;
+        }
+
+        // Descend the tree, choosing the child with the lowest cost increase at each level
+        //-------------------------------------------------------------------------
+
+        int32_t nodeIdx = m_rootNodeIdx;
+        while ( true )
+        {
+            // Space left in this node
+            int32_t const numChildren = m_nodes[nodeIdx].m_numChildren;
+            if ( numChildren < s_branchingFactor )
+            {
+                SetChild( nodeIdx, numChildren, EncodeLeaf( leafIdx ), box );
+                m_nodes[nodeIdx].m_numChildren++;
+                break;
+            }
+
+            // Pairing with a leaf creates a new node, so that costs the full area of the combined box
+            int32_t bestSlot = 0;
+            float bestCost = FLT_MAX;
+            for ( int32_t i = 0; i < s_branchingFactor; i++ )
+            {
+                AABB const childBounds = GetChildBounds( nodeIdx, i );
+                float const combinedCost = GetCost( AABB::GetCombinedBox( childBounds, box ) );
+                float const cost = IsLeafChild( m_nodes[nodeIdx].m_children[i] ) ? combinedCost : combinedCost - GetCost( childBounds );
+                if ( cost < bestCost )
+                {
+                    bestCost = cost;
+                    bestSlot = i;
+                }
+            }
+
+            int32_t const bestChild = m_nodes[nodeIdx].m_children[bestSlot];
+            if ( !IsLeafChild( bestChild ) )
+            {
+                nodeIdx = bestChild;
+                continue;
+            }
+
+            // Replace the leaf with a new node containing both leaves
+            AABB const siblingBounds = GetChildBounds( nodeIdx, bestSlot );
+            int32_t const newNodeIdx = RequestNode();
+            SetChild( newNodeIdx, 0, bestChild, siblingBounds );
+            SetChild( newNodeIdx, 1, EncodeLeaf( leafIdx ), box );
+            m_nodes[newNodeIdx].m_numChildren = 2;
+            SetChild( nodeIdx, bestSlot, newNodeIdx, AABB::GetCombinedBox( siblingBounds, box ) );
+            nodeIdx = newNodeIdx;
+            break;
+        }
+
+        RefitAncestors( nodeIdx, true );
+    }
+
+    void WideAABBTree::RemoveLeaf( int32_t leafIdx )
+    {
+        Leaf& leaf = m_leaves[leafIdx];
+        int32_t const nodeIdx = leaf.m_nodeIdx;
+        int32_t const slot = leaf.m_slot;
+        EE_ASSERT( nodeIdx != InvalidIndex && m_nodes[nodeIdx].m_children[slot] == EncodeLeaf( leafIdx ) );
+
+        leaf.m_nodeIdx = InvalidIndex;
+        leaf.m_slot = InvalidIndex;
+
+        // Keep the children packed by moving the last child into the free slot
+        int32_t const lastSlot = m_nodes[nodeIdx].m_numChildren - 1;
+        if ( slot != lastSlot )
+        {
+            SetChild( nodeIdx, slot, m_nodes[nodeIdx].m_children[lastSlot], GetChildBounds( nodeIdx, lastSlot ) );
+        }
+        ClearChild( nodeIdx, lastSlot );
+        m_nodes[nodeIdx].m_numChildren--;
+
+        // Collapse nodes that only have a single child left
+        //-------------------------------------------------------------------------
+
+        int32_t const numChildren = m_nodes[nodeIdx].m_numChildren;
+        int32_t const parentNodeIdx = m_nodes[nodeIdx].m_parentNodeIdx;
+
+        if ( parentNodeIdx == InvalidIndex )
+        {
+            EE_ASSERT( nodeIdx == m_rootNodeIdx );
+
+            if ( numChildren == 0 )
+            {
+                ReleaseNode( nodeIdx );
+                m_rootNodeIdx = InvalidIndex;
+            }
+            else if ( numChildren == 1 && !IsLeafChild( m_nodes[nodeIdx].m_children[0] ) )
+            {
+                m_rootNodeIdx = m_nodes[nodeIdx].m_children[0];
+                m_nodes[m_rootNodeIdx].m_parentNodeIdx = InvalidIndex;
+                m_nodes[m_rootNodeIdx].m_parentSlot = InvalidIndex;
+                ReleaseNode( nodeIdx );
+            }
+        }
+        else if ( numChildren == 1 )
+        {
+            SetChild( parentNodeIdx, m_nodes[nodeIdx].m_parentSlot, m_nodes[nodeIdx].m_children[0], GetChildBounds( nodeIdx, 0 ) );
+            ReleaseNode( nodeIdx );
+            RefitAncestors( parentNodeIdx, true );
+        }
+        else
+        {
+            RefitAncestors( nodeIdx, true );
+        }
+    }
+
+    void WideAABBTree::RefitAncestors( int32_t nodeIdx, bool tryRotations )
+    {
+        while ( nodeIdx != InvalidIndex )
+        {
+            int32_t const parentNodeIdx = m_nodes[nodeIdx].m_parentNodeIdx;
+            if ( parentNodeIdx == InvalidIndex )
+            {
+                break;
+            }
+
+            RefitChildNode( nodeIdx );
+
+            if ( tryRotations )
+            {
+                TryRotate( nodeIdx );
+            }
+
+            nodeIdx = parentNodeIdx;
+        }
+    }
+
+    void WideAABBTree::TryRotate( int32_t nodeIdx )
+    {
+        int32_t const parentNodeIdx = m_nodes[nodeIdx].m_parentNodeIdx;
+        int32_t const parentSlot = m_nodes[nodeIdx].m_parentSlot;
+        EE_ASSERT( parentNodeIdx != InvalidIndex );
+
+        Node const& node = m_nodes[nodeIdx];
+        Node const& parentNode = m_nodes[parentNodeIdx];
+
+        AABB childBounds[s_branchingFactor];
+        for ( int32_t i = 0; i < node.m_numChildren; i++ )
+        {
+            childBounds[i] = GetChildBounds( nodeIdx, i );
+        }
+
+        // Find the swap between one of our children and one of our siblings that results in the smallest node
+        // The parent bounds are not affected by this
+        //-------------------------------------------------------------------------
+
+        float bestCost = GetCost( GetChildBounds( parentNodeIdx, parentSlot ) );
+        int32_t bestChildSlot = InvalidIndex;
+        int32_t bestSiblingSlot = InvalidIndex;
+
+        for ( int32_t siblingSlot = 0; siblingSlot < parentNode.m_numChildren; siblingSlot++ )
+        {
+            if ( siblingSlot == parentSlot )
+            {
+                continue;
+            }
+
+            AABB const siblingBounds = GetChildBounds( parentNodeIdx, siblingSlot );
+
+            for ( int32_t childSlot = 0; childSlot < node.m_numChildren; childSlot++ )
+            {
+                AABB newBounds = siblingBounds;
+                for ( int32_t i = 0; i < node.m_numChildren; i++ )
+                {
+                    if ( i != childSlot )
+                    {
+                        newBounds = AABB::GetCombinedBox( newBounds, childBounds[i] );
+                    }
+                }
+
+                float const cost = GetCost( newBounds );
+                if ( cost < bestCost )
+                {
+                    bestCost = cost;
+                    bestChildSlot = childSlot;
+                    bestSiblingSlot = siblingSlot;
+                }
+            }
+        }
+
+        //-------------------------------------------------------------------------
+
+        if ( bestChildSlot != InvalidIndex )
+        {
+            int32_t const child = node.m_children[bestChildSlot];
+            int32_t const sibling = parentNode.m_children[bestSiblingSlot];
+            AABB const siblingBounds = GetChildBounds( parentNodeIdx, bestSiblingSlot );
+
+            SetChild( parentNodeIdx, bestSiblingSlot, child, childBounds[bestChildSlot] );
+            SetChild( nodeIdx, bestChildSlot, sibling, siblingBounds );
+            RefitChildNode( nodeIdx );
+        }
+    }
+
+    //-------------------------------------------------------------------------
+
+    int32_t WideAABBTree::CreateProxy( AABB const& aabb, uint64_t userData, uint32_t layerMask, float margin )
+    {
+        EE_ASSERT( aabb.IsValid() && margin >= 0.0f && layerMask != 0 );
+
+        AABB enlargedBox = aabb;
+        enlargedBox.Grow( Vector( margin ) );
+
+        int32_t const proxyIdx = RequestLeaf( enlargedBox, userData, layerMask );
+        InsertLeaf( proxyIdx );
+        return proxyIdx;
+    }
+
+    void WideAABBTree::DestroyProxy( int32_t proxyIdx )
+    {
+        EE_ASSERT( IsValidProxy( proxyIdx ) );
+        RemoveLeaf( proxyIdx );
+        ReleaseLeaf( proxyIdx );
+    }
+
+    bool WideAABBTree::MoveProxy( int32_t proxyIdx, AABB const& aabb, float margin )
+    {
+        EE_ASSERT( IsValidProxy( proxyIdx ) && aabb.IsValid() && margin >= 0.0f );
+
+        // Nothing to do if we are still within the enlarged box
+        AABB const& currentBox = m_leaves[proxyIdx].m_bounds;
+        if ( currentBox.GetMin().IsLessThanEqual3( aabb.GetMin() ) && aabb.GetMax().IsLessThanEqual3( currentBox.GetMax() ) )
+        {
+            return false;
+        }
+
+        RemoveLeaf( proxyIdx );
+
+        AABB enlargedBox = aabb;
+        enlargedBox.Grow( Vector( margin ) );
+        m_leaves[proxyIdx].m_bounds = enlargedBox;
+
+        InsertLeaf( proxyIdx );
+        return true;
+    }
+
+    void WideAABBTree::RefitProxy( int32_t proxyIdx, AABB const& aabb )
+    {
+        EE_ASSERT( IsValidProxy( proxyIdx ) && aabb.IsValid() );
+
+        Leaf& leaf = m_leaves[proxyIdx];
+        leaf.m_bounds = aabb;
+        SetChildBounds( leaf.m_nodeIdx, leaf.m_slot, aabb );
+        RefitAncestors( leaf.m_nodeIdx, false );
+    }
+
+    //-------------------------------------------------------------------------
+
+    void WideAABBTree::Build( AABB const* pBoxes, uint64_t const* pUserData, uint32_t const* pLayerMasks, int32_t numBoxes, float margin )
+    {
+        EE_ASSERT( numBoxes >= 0 && ( numBoxes == 0 || ( pBoxes != nullptr && pUserData != nullptr ) ) );
+        EE_ASSERT( margin >= 0.0f );
+
+        Clear();
+
+        if ( numBoxes == 0 )
+        {
+            return;
+        }
+
+        // Each node has at least two children, so we will never need more nodes than leaves
+        m_nodes.reserve( numBoxes );
+        m_leaves.reserve( numBoxes );
+
+        TVector<int32_t> leafIndices;
+        leafIndices.reserve( numBoxes );
+
+        for ( int32_t i = 0; i < numBoxes; i++ )
+        {
+            AABB enlargedBox = pBoxes[i];
+            enlargedBox.Grow( Vector( margin ) );
+            leafIndices.emplace_back( RequestLeaf( enlargedBox, pUserData[i], ( pLayerMasks != nullptr ) ? pLayerMasks[i] : s_allLayers ) );
+        }
+
+        m_rootNodeIdx = BuildNode( leafIndices.data(), numBoxes );
+    }
+
+    int32_t WideAABBTree::BuildNode( int32_t* pLeafIndices, int32_t numLeaves )
+    {
+        EE_ASSERT( numLeaves > 0 );
+
+        // Split the leaves into (up to) four groups by splitting twice
+        //-------------------------------------------------------------------------
+
+        int32_t groupStarts[s_branchingFactor] = { 0 };
+        int32_t groupSizes[s_branchingFactor] = { 0 };
+        int32_t numGroups = 0;
+
+        if ( numLeaves <= s_branchingFactor )
+        {
+            for ( int32_t i = 0; i < numLeaves; i++ )
+            {
+                groupStarts[numGroups] = i;
+                groupSizes[numGroups] = 1;
+                numGroups++;
+            }
+        }
+        else
+        {
+            int32_t const numLeft = PartitionLeaves( pLeafIndices, numLeaves );
+            int32_t const halfStarts[2] = { 0, numLeft };
+            int32_t const halfSizes[2] = { numLeft, numLeaves - numLeft };
+
+            for ( int32_t half = 0; half < 2; half++ )
+            {
+                if ( halfSizes[half] == 1 )
+                {
+                    groupStarts[numGroups] = halfStarts[half];
+                    groupSizes[numGroups] = 1;
+                    numGroups++;
+                }
+                else
+                {
+                    int32_t const numQuarterLeft = PartitionLeaves( pLeafIndices + halfStarts[half], halfSizes[half] );
+                    groupStarts[numGroups] = halfStarts[half];
+                    groupSizes[numGroups] = numQuarterLeft;
+                    numGroups++;
+                    groupStarts[numGroups] = halfStarts[half] + numQuarterLeft;
+                    groupSizes[numGroups] = halfSizes[half] - numQuarterLeft;
+                    numGroups++;
+                }
+            }
+        }
+
+        // Create the node, the child nodes are built first so that we dont hold onto a node reference
+        //-------------------------------------------------------------------------
+
+        int32_t children[s_branchingFactor];
+        AABB childBounds[s_branchingFactor];
+
+        for ( int32_t i = 0; i < numGroups; i++ )
+        {
+            if ( groupSizes[i] == 1 )
+            {
+                int32_t const leafIdx = pLeafIndices[groupStarts[i]];
+                children[i] = EncodeLeaf( leafIdx );
+                childBounds[i] = m_leaves[leafIdx].m_bounds;
+            }
+            else
+            {
+                children[i] = BuildNode( pLeafIndices + groupStarts[i], groupSizes[i] );
+                childBounds[i] = GetNodeBounds( children[i] );
+            }
+        }
+
+        int32_t const nodeIdx = RequestNode();
+        for ( int32_t i = 0; i < numGroups; i++ )
+        {
+            SetChild( nodeIdx, i, children[i], childBounds[i] );
+        }
+        m_nodes[nodeIdx].m_numChildren = numGroups;
+
+        return nodeIdx;
+    }
+
+    int32_t WideAABBTree::PartitionLeaves( int32_t* pLeafIndices, int32_t numLeaves ) const
+    {
+        EE_ASSERT( numLeaves >= 2 );
+
+        // Pick the axis with the largest centroid extent
+        //-------------------------------------------------------------------------
+
+        AABB centroidBounds( m_leaves[pLeafIndices[0]].m_bounds.GetCenter() );
+        for ( int32_t i = 1; i < numLeaves; i++ )
+        {
+            centroidBounds.AddPoint( m_leaves[pLeafIndices[i]].m_bounds.GetCenter() );
+        }
+
+        Vector const centroidExtents = centroidBounds.GetExtents();
+        int32_t axis = 0;
+        if ( centroidExtents.GetY() > centroidExtents.GetX() )
+        {
+            axis = 1;
+        }
+        if ( centroidExtents.GetZ() > centroidExtents[axis] )
+        {
+            axis = 2;
+        }
+
+        float const axisMin = centroidBounds.GetMin()[axis];
+        float const axisLength = centroidExtents[axis] * 2.0f;
+
+        // All centroids are in the same place, so just split by count
+        if ( axisLength <= Math::Epsilon )
+        {
+            return numLeaves / 2;
+        }
+
+        // Bin the leaves
+        //-------------------------------------------------------------------------
+
+        struct Bin
+        {
+            AABB        m_bounds;
+            int32_t     m_count = 0;
+        };
+
+        Bin bins[g_numSAHBins];
+        float const binScale = g_numSAHBins / axisLength;
+
+        auto GetBinIdx = [&] ( int32_t leafIdx )
+        {
+            float const centroid = m_leaves[leafIdx].m_bounds.GetCenter()[axis];
+            return Math::Clamp( (int32_t) ( ( centroid - axisMin ) * binScale ), 0, g_numSAHBins - 1 );
+        };
+
+        for ( int32_t i = 0; i < numLeaves; i++ )
+        {
+            Bin& bin = bins[GetBinIdx( pLeafIndices[i] )];
+            AABB const& leafBounds = m_leaves[pLeafIndices[i]].m_bounds;
+            bin.m_bounds = ( bin.m_count == 0 ) ? leafBounds : AABB::GetCombinedBox( bin.m_bounds, leafBounds );
+            bin.m_count++;
+        }
+
+        // Evaluate the split after each bin, sweeping from the right first so we only need a single pass from the left
+        //-------------------------------------------------------------------------
+
+        float rightCosts[g_numSAHBins] = { 0 };
+        {
+            AABB rightBounds;
+            int32_t rightCount = 0;
+            for ( int32_t i = g_numSAHBins - 1; i > 0; i-- )
+            {
+                if ( bins[i].m_count > 0 )
+                {
+                    rightBounds = ( rightCount == 0 ) ? bins[i].m_bounds : AABB::GetCombinedBox( rightBounds, bins[i].m_bounds );
+                    rightCount += bins[i].m_count;
+                }
+
+                rightCosts[i] = ( rightCount > 0 ) ? GetCost( rightBounds ) * rightCount : 0.0f;
+            }
+        }
+
+        int32_t bestSplitBin = InvalidIndex;
+        float bestCost = FLT_MAX;
+        {
+            AABB leftBounds;
+            int32_t leftCount = 0;
+            for ( int32_t i = 0; i < g_numSAHBins - 1; i++ )
+            {
+                if ( bins[i].m_count > 0 )
+                {
+                    leftBounds = ( leftCount == 0 ) ? bins[i].m_bounds : AABB::GetCombinedBox( leftBounds, bins[i].m_bounds );
+                    leftCount += bins[i].m_count;
+                }
+
+                // Split between bin i and i + 1
+                if ( leftCount > 0 && leftCount < numLeaves )
+                {
+                    float const cost = ( GetCost( leftBounds ) * leftCount ) + rightCosts[i + 1];
+                    if ( cost < bestCost )
+                    {
+                        bestCost = cost;
+                        bestSplitBin = i;
+                    }
+                }
+            }
+        }
+
+        if ( bestSplitBin == InvalidIndex )
+        {
+            return numLeaves / 2;
+        }
+
+        // Partition the indices
+        //-------------------------------------------------------------------------
+
+        int32_t numLeft = 0;
+        for ( int32_t i = 0; i < numLeaves; i++ )
+        {
+            if ( GetBinIdx( pLeafIndices[i] ) <= bestSplitBin )
+            {
+                eastl::swap( pLeafIndices[i], pLeafIndices[numLeft] );
+                numLeft++;
+            }
+        }
+
+        EE_ASSERT( numLeft > 0 && numLeft < numLeaves );
+        return numLeft;
+    }
+
+    //-------------------------------------------------------------------------
+
+    void WideAABBTree::AddAllLeaves( int32_t child, uint32_t layerMask, AddResultFunction addResultFunction, void* pResults ) const
+    {
+        if ( IsLeafChild( child ) )
+        {
+            Leaf const& leaf = m_leaves[DecodeLeaf( child )];
+            if ( ( leaf.m_layerMask & layerMask ) != 0 )
+            {
+                addResultFunction( pResults, 0, leaf.m_userData );
+            }
+            return;
+        }
+
+        __m128i const queryLayers = _mm_set1_epi32( (int32_t) layerMask );
+
+        TraversalStack stack;
+        stack.emplace_back( child );
+
+        while ( !stack.empty() )
+        {
+            Node const& node = m_nodes[stack.back()];
+            stack.pop_back();
+
+            for ( uint32_t hitMask = GetChildrenOnLayers( node, queryLayers ); hitMask != 0; hitMask &= ( hitMask - 1 ) )
+            {
+                int32_t const childToAdd = node.m_children[Math::GetLeastSignificantBit( hitMask )];
+                if ( IsLeafChild( childToAdd ) )
+                {
+                    addResultFunction( pResults, 0, m_leaves[DecodeLeaf( childToAdd )].m_userData );
+                }
+                else
+                {
+                    stack.emplace_back( childToAdd );
+                }
+            }
+        }
+    }
+
+    void WideAABBTree::QueryBox( AABB const& queryBox, uint32_t layerMask, AddResultFunction addResultFunction, void* pResults ) const
+    {
+        if ( m_rootNodeIdx == InvalidIndex )
+        {
+            return;
+        }
+
+        __m128 queryMin[3], queryMax[3];
+        SplatBox( queryBox, queryMin, queryMax );
+        __m128i const queryLayers = _mm_set1_epi32( (int32_t) layerMask );
+
+        TraversalStack stack;
+        stack.emplace_back( m_rootNodeIdx );
+
+        while ( !stack.empty() )
+        {
+            Node const& node = m_nodes[stack.back()];
+            stack.pop_back();
+
+            // Test all children at once
+            uint32_t const overlapMask = GetChildrenOverlappingBox( node, queryMin, queryMax ) & GetChildrenOnLayers( node, queryLayers );
+            for ( uint32_t hitMask = overlapMask; hitMask != 0; hitMask &= ( hitMask - 1 ) )
+            {
+                int32_t const child = node.m_children[Math::GetLeastSignificantBit( hitMask )];
+                if ( IsLeafChild( child ) )
+                {
+                    addResultFunction( pResults, 0, m_leaves[DecodeLeaf( child )].m_userData );
+                }
+                else
+                {
+                    stack.emplace_back( child );
+                }
+            }
+        }
+    }
+
+    void WideAABBTree::QuerySphere( Vector const& sphereCenter, float sphereRadius, uint32_t layerMask, AddResultFunction addResultFunction, void* pResults ) const
+    {
+        EE_ASSERT( sphereRadius >= 0.0f );
+        if ( m_rootNodeIdx == InvalidIndex )
+        {
+            return;
+        }
+
+        __m128 const centerX = _mm_set1_ps( sphereCenter.GetX() );
+        __m128 const centerY = _mm_set1_ps( sphereCenter.GetY() );
+        __m128 const centerZ = _mm_set1_ps( sphereCenter.GetZ() );
+        __m128 const radiusSq = _mm_set1_ps( sphereRadius * sphereRadius );
+        __m128i const queryLayers = _mm_set1_epi32( (int32_t) layerMask );
+
+        TraversalStack stack;
+        stack.emplace_back( m_rootNodeIdx );
+
+        while ( !stack.empty() )
+        {
+            Node const& node = m_nodes[stack.back()];
+            stack.pop_back();
+
+            // Distance from the center to each child box, this is zero along any axis where the center is within the box
+            // Empty slots have infinite distances so they will always fail this test
+            __m128 const dx = _mm_max_ps( _mm_max_ps( _mm_sub_ps( _mm_load_ps( node.m_minX ), centerX ), _mm_sub_ps( centerX, _mm_load_ps( node.m_maxX ) ) ), _mm_setzero_ps() );
+            __m128 const dy = _mm_max_ps( _mm_max_ps( _mm_sub_ps( _mm_load_ps( node.m_minY ), centerY ), _mm_sub_ps( centerY, _mm_load_ps( node.m_maxY ) ) ), _mm_setzero_ps() );
+            __m128 const dz = _mm_max_ps( _mm_max_ps( _mm_sub_ps( _mm_load_ps( node.m_minZ ), centerZ ), _mm_sub_ps( centerZ, _mm_load_ps( node.m_maxZ ) ) ), _mm_setzero_ps() );
+            __m128 const distanceSq = _mm_add_ps( _mm_add_ps( _mm_mul_ps( dx, dx ), _mm_mul_ps( dy, dy ) ), _mm_mul_ps( dz, dz ) );
+
+            uint32_t const overlapMask = (uint32_t) _mm_movemask_ps( _mm_cmple_ps( distanceSq, radiusSq ) ) & GetChildrenOnLayers( node, queryLayers );
+            for ( uint32_t hitMask = overlapMask; hitMask != 0; hitMask &= ( hitMask - 1 ) )
+            {
+                int32_t const child = node.m_children[Math::GetLeastSignificantBit( hitMask )];
+                if ( IsLeafChild( child ) )
+                {
+                    addResultFunction( pResults, 0, m_leaves[DecodeLeaf( child )].m_userData );
+                }
+                else
+                {
+                    stack.emplace_back( child );
+                }
+            }
+        }
+    }
+
+    void WideAABBTree::QueryViewVolume( ViewVolume const& viewVolume, uint32_t layerMask, AddResultFunction addResultFunction, void* pResults ) const
+    {
+        if ( m_rootNodeIdx == InvalidIndex )
+        {
+            return;
+        }
+
+        __m128i const queryLayers = _mm_set1_epi32( (int32_t) layerMask );
+
+        TraversalStack stack;
+        stack.emplace_back( m_rootNodeIdx );
+
+        while ( !stack.empty() )
+        {
+            int32_t const nodeIdx = stack.back();
+            stack.pop_back();
+
+            Node const& node = m_nodes[nodeIdx];
+            for ( uint32_t layerHitMask = GetChildrenOnLayers( node, queryLayers ); layerHitMask != 0; layerHitMask &= ( layerHitMask - 1 ) )
+            {
+                int32_t const slot = Math::GetLeastSignificantBit( layerHitMask );
+                int32_t const child = node.m_children[slot];
+
+                ViewVolume::IntersectionResult const result = viewVolume.Intersect( GetChildBounds( nodeIdx, slot ) );
+                if ( result == ViewVolume::IntersectionResult::FullyOutside )
+                {
+                    continue;
+                }
+
+                // Everything below a fully contained child is visible, so we can skip any further tests
+                if ( result == ViewVolume::IntersectionResult::FullyInside || IsLeafChild( child ) )
+                {
+                    AddAllLeaves( child, layerMask, addResultFunction, pResults );
+                }
+                else
+                {
+                    stack.emplace_back( child );
+                }
+            }
+        }
+    }
+
+    void WideAABBTree::QueryRay( Ray const& ray, float maxDistance, uint32_t layerMask, AddResultFunction addResultFunction, void* pResults ) const
+    {
+        EE_ASSERT( maxDistance >= 0.0f );
+        if ( m_rootNodeIdx == InvalidIndex )
+        {
+            return;
+        }
+
+        Vector const rayStart = ray.GetStartPoint();
+        Vector const invRayDirection = ray.GetDirection().GetReciprocal();
+        __m128 const startX = _mm_set1_ps( rayStart.GetX() );
+        __m128 const startY = _mm_set1_ps( rayStart.GetY() );
+        __m128 const startZ = _mm_set1_ps( rayStart.GetZ() );
+        __m128 const invDirX = _mm_set1_ps( invRayDirection.GetX() );
+        __m128 const invDirY = _mm_set1_ps( invRayDirection.GetY() );
+        __m128 const invDirZ = _mm_set1_ps( invRayDirection.GetZ() );
+        __m128 const minT = _mm_setzero_ps();
+        __m128 const maxT = _mm_set1_ps( maxDistance );
+        __m128i const queryLayers = _mm_set1_epi32( (int32_t) layerMask );
+
+        TraversalStack stack;
+        stack.emplace_back( m_rootNodeIdx );
+
+        while ( !stack.empty() )
+        {
+            Node const& node = m_nodes[stack.back()];
+            stack.pop_back();
+
+            // Slab test against all children at once
+            __m128 const tx0 = _mm_mul_ps( _mm_sub_ps( _mm_load_ps( node.m_minX ), startX ), invDirX );
+            __m128 const tx1 = _mm_mul_ps( _mm_sub_ps( _mm_load_ps( node.m_maxX ), startX ), invDirX );
+            __m128 const ty0 = _mm_mul_ps( _mm_sub_ps( _mm_load_ps( node.m_minY ), startY ), invDirY );
+            __m128 const ty1 = _mm_mul_ps( _mm_sub_ps( _mm_load_ps( node.m_maxY ), startY ), invDirY );
+            __m128 const tz0 = _mm_mul_ps( _mm_sub_ps( _mm_load_ps( node.m_minZ ), startZ ), invDirZ );
+            __m128 const tz1 = _mm_mul_ps( _mm_sub_ps( _mm_load_ps( node.m_maxZ ), startZ ), invDirZ );
+
+            __m128 const tEnter = _mm_max_ps( _mm_max_ps( _mm_min_ps( tx0, tx1 ), _mm_min_ps( ty0, ty1 ) ), _mm_max_ps( _mm_min_ps( tz0, tz1 ), minT ) );
+            __m128 const tExit = _mm_min_ps( _mm_min_ps( _mm_max_ps( tx0, tx1 ), _mm_max_ps( ty0, ty1 ) ), _mm_min_ps( _mm_max_ps( tz0, tz1 ), maxT ) );
+
+            // Empty slots are on no layers, which excludes them explicitly as their inverted bounds are not guaranteed to fail the slab test
+            uint32_t const intersectionMask = (uint32_t) _mm_movemask_ps( _mm_cmple_ps( tEnter, tExit ) ) & GetChildrenOnLayers( node, queryLayers );
+            for ( uint32_t hitMask = intersectionMask; hitMask != 0; hitMask &= ( hitMask - 1 ) )
+            {
+                int32_t const child = node.m_children[Math::GetLeastSignificantBit( hitMask )];
+                if ( IsLeafChild( child ) )
+                {
+                    addResultFunction( pResults, 0, m_leaves[DecodeLeaf( child )].m_userData );
+                }
+                else
+                {
+                    stack.emplace_back( child );
+                }
+            }
+        }
+    }
+
+    void WideAABBTree::QueryBoxes( AABB const* pQueryBoxes, int32_t numQueries, uint32_t layerMask, AddResultFunction addResultFunction, void* pResults ) const
+    {
+        if ( m_rootNodeIdx == InvalidIndex )
+        {
+            return;
+        }
+
+        __m128i const queryLayers = _mm_set1_epi32( (int32_t) layerMask );
+
+        // Queries are processed in groups of 64, each stack entry tracks which queries in the group still overlap the node
+        struct StackEntry
+        {
+            int32_t     m_nodeIdx;
+            uint64_t    m_activeQueries;
+        };
+
+        TInlineVector<StackEntry, 64> stack;
+        TInlineVector<__m128, 64 * 6> splattedBoxes;
+
+        for ( int32_t groupStartIdx = 0; groupStartIdx < numQueries; groupStartIdx += 64 )
+        {
+            int32_t const numQueriesInGroup = Math::Min( numQueries - groupStartIdx, 64 );
+
+            splattedBoxes.resize( numQueriesInGroup * 6 );
+            for ( int32_t i = 0; i < numQueriesInGroup; i++ )
+            {
+                SplatBox( pQueryBoxes[groupStartIdx + i], &splattedBoxes[i * 6], &splattedBoxes[i * 6 + 3] );
+            }
+
+            uint64_t const allQueriesInGroup = ( numQueriesInGroup == 64 ) ? 0xFFFFFFFFFFFFFFFF : ( ( 1ull << numQueriesInGroup ) - 1 );
+            stack.push_back( { m_rootNodeIdx, allQueriesInGroup } );
+
+            while ( !stack.empty() )
+            {
+                StackEntry const entry = stack.back();
+                stack.pop_back();
+
+                Node const& node = m_nodes[entry.m_nodeIdx];
+                uint32_t const childrenOnLayers = GetChildrenOnLayers( node, queryLayers );
+                if ( childrenOnLayers == 0 )
+                {
+                    continue;
+                }
+
+                // Test all children against each of the queries that overlapped the node
+                uint64_t childQueries[s_branchingFactor] = { 0 };
+                for ( uint64_t remainingQueries = entry.m_activeQueries; remainingQueries != 0; remainingQueries &= ( remainingQueries - 1 ) )
+                {
+                    int32_t const queryIdx = Math::GetLeastSignificantBit( remainingQueries );
+                    uint32_t const overlapMask = GetChildrenOverlappingBox( node, &splattedBoxes[queryIdx * 6], &splattedBoxes[queryIdx * 6 + 3] ) & childrenOnLayers;
+                    for ( uint32_t hitMask = overlapMask; hitMask != 0; hitMask &= ( hitMask - 1 ) )
+                    {
+                        childQueries[Math::GetLeastSignificantBit( hitMask )] |= ( 1ull << queryIdx );
+                    }
+                }
+
+                //-------------------------------------------------------------------------
+
+                for ( int32_t slot = 0; slot < node.m_numChildren; slot++ )
+                {
+                    uint64_t overlappingQueries = childQueries[slot];
+                    if ( overlappingQueries == 0 )
+                    {
+                        continue;
+                    }
+
+                    int32_t const child = node.m_children[slot];
+                    if ( IsLeafChild( child ) )
+                    {
+                        uint64_t const userData = m_leaves[DecodeLeaf( child )].m_userData;
+                        for ( ; overlappingQueries != 0; overlappingQueries &= ( overlappingQueries - 1 ) )
+                        {
+                            addResultFunction( pResults, groupStartIdx + (int32_t) Math::GetLeastSignificantBit( overlappingQueries ), userData );
+                        }
+                    }
+                    else
+                    {
+                        stack.push_back( { child, overlappingQueries } );
+                    }
+                }
+            }
+        }
+    }
+
+    //-------------------------------------------------------------------------
+
+    #if EE_DEVELOPMENT_TOOLS
+    void WideAABBTree::DrawDebug( Drawing::DrawContext& drawingContext ) const
+    {
+        if ( m_rootNodeIdx == InvalidIndex )
+        {
+            return;
+        }
+
+        TraversalStack stack;
+        stack.emplace_back( m_rootNodeIdx );
+
+        while ( !stack.empty() )
+        {
+            int32_t const nodeIdx = stack.back();
+            stack.pop_back();
+
+            Node const& node = m_nodes[nodeIdx];
+            for ( int32_t i = 0; i < node.m_numChildren; i++ )
+            {
+                if ( IsLeafChild( node.m_children[i] ) )
+                {
+                    drawingContext.DrawWireBox( GetChildBounds( nodeIdx, i ), Colors::Green, 2.0f, Drawing::DepthTest::Enable );
+                }
+                else
+                {
+                    drawingContext.DrawWireBox( GetChildBounds( nodeIdx, i ), Colors::Cyan, 1.0f, Drawing::DepthTest::Enable );
+                    stack.emplace_back( node.m_children[i] );
+                }
+            }
+        }
+    }
+    #endif
+}
@@ -0,0 +1,238 @@
+#pragma once
+
+#include "Base/Math/BoundingVolumes.h"
+#include "Base/Types/Arrays.h"
+
+//-------------------------------------------------------------------------
+
+namespace EE { class Ray; }
+namespace EE::Math { class ViewVolume; }
+namespace EE::Drawing { class DrawContext; }
+
+//-------------------------------------------------------------------------
+
+namespace EE::Math
+{
+    //-------------------------------------------------------------------------
+    // Wide AABB Tree
+    //-------------------------------------------------------------------------
+    // A dynamic 4-wide BVH, each node stores the bounds of its children in SoA form so that all four can be tested at once with SSE
+    //
+    // Boxes are referred to by stable proxy indices. Insertion descends the tree using the surface area heuristic and any modified
+    // branches are then locally optimized by swapping children with their parent's siblings (tree rotations).
+    //
+    // Moving proxies can either be reinserted (MoveProxy) or refit in place (RefitProxy). Refitting is much cheaper but does not
+    // change the tree structure so the tree quality will degrade if objects move far from where they were inserted.
+    //
+    // Each proxy has a layer mask and each node stores the combined layer masks of its children's subtrees, so that queries for a
+    // specific set of layers can skip entire branches.
+
+    class EE_BASE_API WideAABBTree
+    {
+    public:
+
+        constexpr static int32_t const s_branchingFactor = 4;
+        constexpr static uint32_t const s_allLayers = 0xFFFFFFFF;
+
+    private:
+
+        // Child references: >= 0 is a node index, -1 is an empty slot and anything below that is an encoded leaf index
+        constexpr static int32_t const s_emptyChild = -1;
+
+        EE_FORCE_INLINE static bool IsLeafChild( int32_t child ) { return child < s_emptyChild; }
+        EE_FORCE_INLINE static int32_t EncodeLeaf( int32_t leafIdx ) { return -2 - leafIdx; }
+        EE_FORCE_INLINE static int32_t DecodeLeaf( int32_t child ) { return -2 - child; }
+
+        // 144 bytes, empty slots have inverted bounds and no layers so that they can never pass an overlap test
+        struct alignas( 16 ) Node
+        {
+            float           m_minX[s_branchingFactor];
+            float           m_minY[s_branchingFactor];
+            float           m_minZ[s_branchingFactor];
+            float           m_maxX[s_branchingFactor];
+            float           m_maxY[s_branchingFactor];
+            float           m_maxZ[s_branchingFactor];
+            uint32_t        m_layerMasks[s_branchingFactor];
+            int32_t         m_children[s_branchingFactor];
+            int32_t         m_parentNodeIdx = InvalidIndex;
+            int32_t         m_parentSlot = InvalidIndex;
+            int32_t         m_numChildren = 0;
+            int32_t         m_nextFreeIdx = InvalidIndex;
+        };
+
+        struct Leaf
+        {
+            AABB            m_bounds;
+            uint64_t        m_userData = 0;
+            uint32_t        m_layerMask = s_allLayers;
+            int32_t         m_nodeIdx = InvalidIndex;
+            int32_t         m_slot = InvalidIndex;
+            int32_t         m_nextFreeIdx = InvalidIndex;
+            bool            m_isFree = true;
+        };
+
+    public:
+
+        WideAABBTree() = default;
+
+        inline bool IsEmpty() const { return m_rootNodeIdx == InvalidIndex; }
+        inline int32_t GetNumProxies() const { return m_numProxies; }
+
+        // Remove all proxies
+        void Clear();
+
+        // Replace the contents of the tree with a top-down build of the supplied boxes, this produces a much better tree than inserting them one by one
+        // The proxy index for each box is its index in the supplied array, if no layer masks are supplied all proxies will be on all layers
+        void Build( AABB const* pBoxes, uint64_t const* pUserData, uint32_t const* pLayerMasks, int32_t numBoxes, float margin = 0.0f );
+
+        // Proxies
+        //-------------------------------------------------------------------------
+
+        // Add a box and return the proxy index for it, this index is stable until the proxy is destroyed
+        int32_t CreateProxy( AABB const& aabb, uint64_t userData, uint32_t layerMask = s_allLayers, float margin = 0.0f );
+
+        EE_FORCE_INLINE int32_t CreateProxy( AABB const& aabb, void* pUserData, uint32_t layerMask = s_allLayers, float margin = 0.0f ) { return CreateProxy( aabb, reinterpret_cast<uint64_t>( pUserData ), layerMask, margin ); }
+
+        // Remove a proxy from the tree
+        void DestroyProxy( int32_t proxyIdx );
+
+        // Update the box for a proxy, this will only reinsert the proxy if the new box is not contained within the current enlarged box
+        // Returns true if the tree was modified
+        bool MoveProxy( int32_t proxyIdx, AABB const& aabb, float margin = 0.0f );
+
+        // Update the box for a proxy without changing the tree structure, only the bounds of the proxy's ancestors are updated
+        void RefitProxy( int32_t proxyIdx, AABB const& aabb );
+
+        inline AABB const& GetProxyBounds( int32_t proxyIdx ) const { EE_ASSERT( IsValidProxy( proxyIdx ) ); return m_leaves[proxyIdx].m_bounds; }
+        inline uint64_t GetProxyUserData( int32_t proxyIdx ) const { EE_ASSERT( IsValidProxy( proxyIdx ) ); return m_leaves[proxyIdx].m_userData; }
+
+        // Queries
+        //-------------------------------------------------------------------------
+        // The output arrays are cleared before the query is run, the return value is whether any results were found
+        // Only proxies on at least one of the layers in the supplied mask are returned
+
+        // The result type can either be the raw user data (uint64_t) or the pointer type the user data was created from
+
+        template<typename T>
+        bool FindOverlaps( AABB const& queryBox, TVector<T>& outResults, uint32_t layerMask = s_allLayers ) const
+        {
+            outResults.clear();
+            QueryBox( queryBox, layerMask, &AddResult<T>, &outResults );
+            return !outResults.empty();
+        }
+
+        template<typename T>
+        bool FindOverlaps( Vector const& sphereCenter, float sphereRadius, TVector<T>& outResults, uint32_t layerMask = s_allLayers ) const
+        {
+            outResults.clear();
+            QuerySphere( sphereCenter, sphereRadius, layerMask, &AddResult<T>, &outResults );
+            return !outResults.empty();
+        }
+
+        template<typename T>
+        bool FindOverlaps( ViewVolume const& viewVolume, TVector<T>& outResults, uint32_t layerMask = s_allLayers ) const
+        {
+            outResults.clear();
+            QueryViewVolume( viewVolume, layerMask, &AddResult<T>, &outResults );
+            return !outResults.empty();
+        }
+
+        template<typename T>
+        bool FindIntersections( Ray const& ray, float maxDistance, TVector<T>& outResults, uint32_t layerMask = s_allLayers ) const
+        {
+            outResults.clear();
+            QueryRay( ray, maxDistance, layerMask, &AddResult<T>, &outResults );
+            return !outResults.empty();
+        }
+
+        // Run multiple box queries with a single traversal, there needs to be a result array per query box
+        template<typename T>
+        void FindOverlaps( AABB const* pQueryBoxes, int32_t numQueries, TVector<T>* pOutResults, uint32_t layerMask = s_allLayers ) const
+        {
+            EE_ASSERT( numQueries >= 0 && ( numQueries == 0 || ( pQueryBoxes != nullptr && pOutResults != nullptr ) ) );
+
+            for ( int32_t i = 0; i < numQueries; i++ )
+            {
+                pOutResults[i].clear();
+            }
+
+            QueryBoxes( pQueryBoxes, numQueries, layerMask, &AddResult<T>, pOutResults );
+        }
+
+        #if EE_DEVELOPMENT_TOOLS
+        void DrawDebug( Drawing::DrawContext& drawingContext ) const;
+        #endif
+
+    private:
+
+        // The traversals add their results through this, so that they dont need to be templated on the result type
+        // The results ptr is an array of result vectors, with a vector per query
+        using AddResultFunction = void (*)( void* pResults, int32_t queryIdx, uint64_t userData );
+
+        template<typename T>
+        static void AddResult( void* pResults, int32_t queryIdx, uint64_t userData )
+        {
+            static_assert( std::is_pointer<T>::value || std::is_same<T, uint64_t>::value, "Results can only be the raw user data or a ptr" );
+
+            TVector<T>* pResultArrays = static_cast<TVector<T>*>( pResults );
+            if constexpr ( std::is_pointer<T>::value )
+            {
+                pResultArrays[queryIdx].push_back( reinterpret_cast<T>( userData ) );
+            }
+            else
+            {
+                pResultArrays[queryIdx].push_back( userData );
+            }
+        }
+
+        void QueryBox( AABB const& queryBox, uint32_t layerMask, AddResultFunction addResultFunction, void* pResults ) const;
+        void QuerySphere( Vector const& sphereCenter, float sphereRadius, uint32_t layerMask, AddResultFunction addResultFunction, void* pResults ) const;
+        void QueryViewVolume( ViewVolume const& viewVolume, uint32_t layerMask, AddResultFunction addResultFunction, void* pResults ) const;
+        void QueryRay( Ray const& ray, float maxDistance, uint32_t layerMask, AddResultFunction addResultFunction, void* pResults ) const;
+        void QueryBoxes( AABB const* pQueryBoxes, int32_t numQueries, uint32_t layerMask, AddResultFunction addResultFunction, void* pResults ) const;
+
+        inline bool IsValidProxy( int32_t proxyIdx ) const { return proxyIdx >= 0 && proxyIdx < (int32_t) m_leaves.size() && !m_leaves[proxyIdx].m_isFree; }
+
+        int32_t RequestNode();
+        void ReleaseNode( int32_t nodeIdx );
+        int32_t RequestLeaf( AABB const& box, uint64_t userData, uint32_t layerMask );
+        void ReleaseLeaf( int32_t leafIdx );
+
+        AABB GetChildBounds( int32_t nodeIdx, int32_t slot ) const;
+        AABB GetNodeBounds( int32_t nodeIdx ) const;
+        uint32_t GetNodeLayerMask( int32_t nodeIdx ) const;
+        void SetChildBounds( int32_t nodeIdx, int32_t slot, AABB const& bounds );
+        void SetChild( int32_t nodeIdx, int32_t slot, int32_t child, AABB const& bounds );
+        void ClearChild( int32_t nodeIdx, int32_t slot );
+
+        // Update the bounds and layers stored in the parent for the specified node
+        void RefitChildNode( int32_t nodeIdx );
+
+        void InsertLeaf( int32_t leafIdx );
+        void RemoveLeaf( int32_t leafIdx );
+
+        // Update the bounds of all ancestors of the specified node, optionally trying to improve the tree along the way
+        void RefitAncestors( int32_t nodeIdx, bool tryRotations );
+
+        // Try to reduce the surface area of a node by swapping one of its children with one of its siblings
+        void TryRotate( int32_t nodeIdx );
+
+        // Add all the leaves in the subtree of the specified child that are on the requested layers
+        void AddAllLeaves( int32_t child, uint32_t layerMask, AddResultFunction addResultFunction, void* pResults ) const;
+
+        // Build a node for the supplied leaves, returns the node idx
+        int32_t BuildNode( int32_t* pLeafIndices, int32_t numLeaves );
+
+        // Split the leaves in two using a binned SAH, returns the number of leaves in the first half
+        int32_t PartitionLeaves( int32_t* pLeafIndices, int32_t numLeaves ) const;
+
+    private:
+
+        TVector<Node>           m_nodes;
+        TVector<Leaf>           m_leaves;
+        int32_t                 m_rootNodeIdx = InvalidIndex;
+        int32_t                 m_freeNodeIdx = InvalidIndex;
+        int32_t                 m_freeLeafIdx = InvalidIndex;
+        int32_t                 m_numProxies = 0;
+    };
+}
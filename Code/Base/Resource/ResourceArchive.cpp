@@ -0,0 +1,301 @@
+#include "ResourceArchive.h"
+#include "Base/FileSystem/FileSystem.h"
+#include "Base/FileSystem/FileSystemUtils.h"
+#include "Base/Memory/Memory.h"
+#include "Base/Math/Math.h"
+#include "Base/Profiling.h"
+#include "EASTL/sort.h"
+
+//-------------------------------------------------------------------------
+
+namespace EE::Resource
+{
+    bool ResourceArchive::Open( FileSystem::Path const& archivePath )
+    {
+        EE_ASSERT( !IsOpen() );
+        EE_ASSERT( archivePath.IsValid() && archivePath.IsFilePath() );
+
+        m_fileStream.open( archivePath.c_str(), std::ios::in | std::ios::binary );
+        if ( !m_fileStream.is_open() )
+        {
+            EE_LOG_ERROR( "Resource", "Resource Archive", "Failed to open archive: %s", archivePath.c_str() );
+            return false;
+        }
+
+        m_filePath = archivePath;
+
+        // Read header
+        //-------------------------------------------------------------------------
+
+        Header header;
+        m_fileStream.read( (char*) &header, sizeof( Header ) );
+        if ( !m_fileStream.good() || header.m_magic != s_archiveMagic )
+        {
+            EE_LOG_ERROR( "Resource", "Resource Archive", "Invalid archive file: %s", archivePath.c_str() );
+            Close();
+            return false;
+        }
+
+        if ( header.m_version != s_archiveVersion )
+        {
+            EE_LOG_ERROR( "Resource", "Resource Archive", "Archive version mismatch (expected %u, got %u): %s", s_archiveVersion, header.m_version, archivePath.c_str() );
+            Close();
+            return false;
+        }
+
+        // Read table of contents
+        //-------------------------------------------------------------------------
+
+        m_entries.resize( header.m_numEntries );
+        m_fileStream.read( (char*) m_entries.data(), sizeof( Entry ) * header.m_numEntries );
+        if ( !m_fileStream.good() )
+        {
+            EE_LOG_ERROR( "Resource", "Resource Archive", "Failed to read archive table of contents: %s", archivePath.c_str() );
+            Close();
+            return false;
+        }
+
+        return true;
+    }
+
+    void ResourceArchive::Close()
+    {
+        if ( m_fileStream.is_open() )
+        {
+            m_fileStream.close();
+        }
+
+        m_entries.clear();
+        m_filePath.Clear();
+    }
+
+    ResourceArchive::Entry const* ResourceArchive::FindEntry( ResourceID const& resourceID ) const
+    {
+        uint32_t const pathID = resourceID.GetPathID();
+        auto const foundIter = eastl::lower_bound( m_entries.begin(), m_entries.end(), pathID, [] ( Entry const& entry, uint32_t ID ) { return entry.m_resourcePathID < ID; } );
+        if ( foundIter != m_entries.end() && foundIter->m_resourcePathID == pathID )
+        {
+            return foundIter;
+        }
+
+        return nullptr;
+    }
+
+    bool ResourceArchive::ReadEntry( Entry const& entry, Blob& outData ) const
+    {
+        EE_PROFILE_SCOPE_IO( "Read Archive Entry" );
+        EE_ASSERT( IsOpen() );
+
+        if ( entry.IsCompressed() )
+        {
+            EE_LOG_ERROR( "Resource", "Resource Archive", "Unsupported compression type (%u) in archive: %s", (uint32_t) entry.m_compressionType, m_filePath.c_str() );
+            return false;
+        }
+
+        outData.resize( entry.m_size );
+
+        Threading::ScopeLock lock( m_readMutex );
+        m_fileStream.seekg( entry.m_offset, std::ios::beg );
+        m_fileStream.read( (char*) outData.data(), entry.m_size );
+        if ( !m_fileStream.good() )
+        {
+            m_fileStream.clear();
+            return false;
+        }
+
+        return true;
+    }
+
+    //-------------------------------------------------------------------------
+    // Archive Writer
+    //-------------------------------------------------------------------------
+
+    #if EE_DEVELOPMENT_TOOLS
+    bool ResourceArchiveWriter::AddResource( ResourceID const& resourceID, FileSystem::Path const& compiledFilePath )
+    {
+        EE_ASSERT( resourceID.IsValid() );
+
+        // Ensure that we dont have any path ID collisions since the table of contents is keyed on the path ID
+        auto const foundIter = m_addedResourceIDs.find( resourceID.GetPathID() );
+        if ( foundIter != m_addedResourceIDs.end() )
+        {
+            if ( foundIter->second != resourceID )
+            {
+                EE_LOG_ERROR( "Resource", "Resource Archive", "Resource path ID collision between '%s' and '%s'", resourceID.c_str(), foundIter->second.c_str() );
+                return false;
+            }
+
+            return true;
+        }
+
+        // Get compiled file size
+        std::ifstream fileStream( compiledFilePath.c_str(), std::ios::in | std::ios::binary | std::ios::ate );
+        if ( !fileStream.is_open() )
+        {
+            EE_LOG_ERROR( "Resource", "Resource Archive", "Failed to open compiled resource file: %s", compiledFilePath.c_str() );
+            return false;
+        }
+
+        auto& pendingResource = m_resources.emplace_back();
+        pendingResource.m_resourceID = resourceID;
+        pendingResource.m_compiledFilePath = compiledFilePath;
+        pendingResource.m_size = (uint64_t) fileStream.tellg();
+        m_addedResourceIDs.insert( TPair<uint32_t, ResourceID>( resourceID.GetPathID(), resourceID ) );
+        return true;
+    }
+
+    bool ResourceArchiveWriter::Write( FileSystem::Path const& outputDirectoryPath, char const* pArchiveName, uint64_t maxArchiveSize, uint32_t entryAlignment ) const
+    {
+        EE_PROFILE_FUNCTION();
+        EE_ASSERT( outputDirectoryPath.IsValid() && outputDirectoryPath.IsDirectoryPath() );
+        EE_ASSERT( pArchiveName != nullptr );
+        EE_ASSERT( entryAlignment > 0 && Math::IsPowerOf2( (int32_t) entryAlignment ) );
+
+        if ( !FileSystem::EnsureDirectoryExists( outputDirectoryPath ) )
+        {
+            EE_LOG_ERROR( "Resource", "Resource Archive", "Failed to create archive directory: %s", outputDirectoryPath.c_str() );
+            return false;
+        }
+
+        // Remove stale archives
+        //-------------------------------------------------------------------------
+
+        TVector<FileSystem::Path> existingArchives;
+        FileSystem::GetDirectoryContents( outputDirectoryPath, existingArchives, FileSystem::DirectoryReaderOutput::OnlyFiles, FileSystem::DirectoryReaderMode::NoRecursion, { ResourceArchive::s_archiveExtension } );
+        for ( auto const& archivePath : existingArchives )
+        {
+            FileSystem::EraseFile( archivePath );
+        }
+
+        // Split resources into archives
+        //-------------------------------------------------------------------------
+        // A single resource larger than the max size will get an archive to itself
+
+        int32_t archiveIdx = 0;
+        TVector<PendingResource const*> archiveResources;
+        uint64_t currentArchiveSize = 0;
+
+        auto WriteCurrentArchive = [&] ()
+        {
+            InlineString archiveFilename( InlineString::CtorSprintf(), "%s_%03d.%s", pArchiveName, archiveIdx, ResourceArchive::s_archiveExtension );
+            bool const result = WriteArchive( outputDirectoryPath + archiveFilename.c_str(), archiveResources, entryAlignment );
+            archiveResources.clear();
+            currentArchiveSize = 0;
+            archiveIdx++;
+            return result;
+        };
+
+        for ( auto const& resource : m_resources )
+        {
+            uint64_t const alignedSize = resource.m_size + Memory::CalculatePaddingForAlignment( resource.m_size, entryAlignment );
+            if ( !archiveResources.empty() && ( currentArchiveSize + alignedSize ) > maxArchiveSize )
+            {
+                if ( !WriteCurrentArchive() )
+                {
+                    return false;
+                }
+            }
+
+            archiveResources.emplace_back( &resource );
+            currentArchiveSize += alignedSize;
+        }
+
+        if ( !archiveResources.empty() )
+        {
+            if ( !WriteCurrentArchive() )
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    bool ResourceArchiveWriter::WriteArchive( FileSystem::Path const& archivePath, TVector<PendingResource const*> const& resources, uint32_t entryAlignment ) const
+    {
+        EE_PROFILE_FUNCTION();
+
+        std::ofstream archiveStream( archivePath.c_str(), std::ios::out | std::ios::binary | std::ios::trunc );
+        if ( !archiveStream.is_open() )
+        {
+            EE_LOG_ERROR( "Resource", "Resource Archive", "Failed to create archive: %s", archivePath.c_str() );
+            return false;
+        }
+
+        // Create the table of contents, entry data is laid out in the order the resources were added
+        //-------------------------------------------------------------------------
+
+        ResourceArchive::Header header;
+        header.m_numEntries = (uint32_t) resources.size();
+        header.m_entryAlignment = entryAlignment;
+
+        uint64_t dataOffset = sizeof( ResourceArchive::Header ) + ( sizeof( ResourceArchive::Entry ) * resources.size() );
+        dataOffset += Memory::CalculatePaddingForAlignment( dataOffset, entryAlignment );
+
+        TVector<ResourceArchive::Entry> entries;
+        entries.resize( resources.size() );
+        for ( size_t i = 0; i < resources.size(); i++ )
+        {
+            entries[i].m_resourcePathID = resources[i]->m_resourceID.GetPathID();
+            entries[i].m_offset = dataOffset;
+            entries[i].m_size = resources[i]->m_size;
+            entries[i].m_uncompressedSize = resources[i]->m_size;
+
+            dataOffset += resources[i]->m_size;
+            dataOffset += Memory::CalculatePaddingForAlignment( dataOffset, entryAlignment );
+        }
+
+        // The table of contents is sorted by ID for lookups
+        TVector<ResourceArchive::Entry> sortedEntries = entries;
+        eastl::sort( sortedEntries.begin(), sortedEntries.end(), [] ( ResourceArchive::Entry const& a, ResourceArchive::Entry const& b ) { return a.m_resourcePathID < b.m_resourcePathID; } );
+
+        archiveStream.write( (char const*) &header, sizeof( ResourceArchive::Header ) );
+        archiveStream.write( (char const*) sortedEntries.data(), sizeof( ResourceArchive::Entry ) * sortedEntries.size() );
+
+        // Write entry data
+        //-------------------------------------------------------------------------
+
+        static uint8_t const paddingBytes[4096] = { 0 };
+        auto WritePadding = [&archiveStream] ( uint64_t targetOffset )
+        {
+            uint64_t remainingPadding = targetOffset - (uint64_t) archiveStream.tellp();
+            while ( remainingPadding > 0 )
+            {
+                uint64_t const numBytesToWrite = Math::Min( remainingPadding, (uint64_t) sizeof( paddingBytes ) );
+                archiveStream.write( (char const*) paddingBytes, numBytesToWrite );
+                remainingPadding -= numBytesToWrite;
+            }
+        };
+
+        Blob fileData;
+        for ( size_t i = 0; i < resources.size(); i++ )
+        {
+            if ( !FileSystem::ReadBinaryFile( resources[i]->m_compiledFilePath, fileData ) || fileData.size() != resources[i]->m_size )
+            {
+                EE_LOG_ERROR( "Resource", "Resource Archive", "Failed to read compiled resource file: %s", resources[i]->m_compiledFilePath.c_str() );
+                archiveStream.close();
+                FileSystem::EraseFile( archivePath );
+                return false;
+            }
+
+            WritePadding( entries[i].m_offset );
+            archiveStream.write( (char const*) fileData.data(), fileData.size() );
+        }
+
+        WritePadding( dataOffset );
+
+        //-------------------------------------------------------------------------
+
+        if ( !archiveStream.good() )
+        {
+            EE_LOG_ERROR( "Resource", "Resource Archive", "Failed to write archive: %s", archivePath.c_str() );
+            archiveStream.close();
+            FileSystem::EraseFile( archivePath );
+            return false;
+        }
+
+        archiveStream.close();
+        return true;
+    }
+    #endif
+}
@@ -0,0 +1,130 @@
+#pragma once
+
+#include "ResourceID.h"
+#include "Base/FileSystem/FileSystemPath.h"
+#include "Base/Threading/Threading.h"
+#include "Base/Types/HashMap.h"
+#include <fstream>
+
+//-------------------------------------------------------------------------
+// Resource Archive
+//-------------------------------------------------------------------------
+// A packed file containing many compiled resources, used by packaged builds to avoid opening thousands of small files
+//
+// Layout:  [Header][Table Of Contents][Entry Data]...
+//
+// * The table of contents is sorted by resource path ID so that lookups are a binary search
+// * Entry data is ordered by the load order provided when the archive was written (i.e. a recorded load profile)
+// * Each entry's data is aligned to the archive alignment so it can be read directly (unbuffered) or memory mapped
+// * Each entry has a compression type, only uncompressed entries are currently supported
+//-------------------------------------------------------------------------
+
+namespace EE::Resource
+{
+    class EE_BASE_API ResourceArchive
+    {
+    public:
+
+        constexpr static char const* const s_archiveExtension = "eear";
+        constexpr static uint32_t const s_archiveMagic = 'EEAR';
+        constexpr static uint32_t const s_archiveVersion = 1;
+        constexpr static uint32_t const s_defaultEntryAlignment = 4096;
+
+        enum class CompressionType : uint16_t
+        {
+            None = 0,
+        };
+
+        struct Header
+        {
+            uint32_t                    m_magic = s_archiveMagic;
+            uint32_t                    m_version = s_archiveVersion;
+            uint32_t                    m_numEntries = 0;
+            uint32_t                    m_entryAlignment = s_defaultEntryAlignment;
+        };
+
+        struct Entry
+        {
+            inline bool IsCompressed() const { return m_compressionType != CompressionType::None; }
+
+        public:
+
+            uint32_t                    m_resourcePathID = 0;
+            CompressionType             m_compressionType = CompressionType::None;
+            uint16_t                    m_padding = 0;
+            uint64_t                    m_offset = 0;
+            uint64_t                    m_size = 0;
+            uint64_t                    m_uncompressedSize = 0;
+        };
+
+        static_assert( sizeof( Header ) == 16, "Archive header layout changed, bump the archive version!" );
+        static_assert( sizeof( Entry ) == 32, "Archive entry layout changed, bump the archive version!" );
+
+    public:
+
+        ResourceArchive() = default;
+        ResourceArchive( ResourceArchive const& ) = delete;
+        ~ResourceArchive() { Close(); }
+
+        ResourceArchive& operator=( ResourceArchive const& ) = delete;
+
+        bool Open( FileSystem::Path const& archivePath );
+        void Close();
+
+        inline bool IsOpen() const { return m_fileStream.is_open(); }
+        inline FileSystem::Path const& GetFilePath() const { return m_filePath; }
+        inline TVector<Entry> const& GetEntries() const { return m_entries; }
+
+        // Find the table of contents entry for a resource, returns nullptr if the resource isn't in this archive
+        Entry const* FindEntry( ResourceID const& resourceID ) const;
+
+        // Read an entry's data, this is threadsafe
+        bool ReadEntry( Entry const& entry, Blob& outData ) const;
+
+    private:
+
+        FileSystem::Path                m_filePath;
+        TVector<Entry>                  m_entries;
+        mutable std::ifstream           m_fileStream;
+        mutable Threading::Mutex        m_readMutex;
+    };
+
+    //-------------------------------------------------------------------------
+    // Archive Writer
+    //-------------------------------------------------------------------------
+    // Packs compiled resource files into one or more archives
+    // Entries are written in the order they are added, so add them in expected load order
+
+    #if EE_DEVELOPMENT_TOOLS
+    class EE_BASE_API ResourceArchiveWriter
+    {
+    public:
+
+        // Add a compiled resource file to be packed, adding an already added resource does nothing
+        // Returns false if the compiled file cant be read or the resource's path ID collides with a different resource
+        bool AddResource( ResourceID const& resourceID, FileSystem::Path const& compiledFilePath );
+
+        inline int32_t GetNumResources() const { return (int32_t) m_resources.size(); }
+
+        // Write all added resources into archives in the specified directory, a new archive is started once an archive exceeds the max archive size
+        // Any pre-existing archives in the directory are deleted
+        bool Write( FileSystem::Path const& outputDirectoryPath, char const* pArchiveName, uint64_t maxArchiveSize = 2ull * 1024 * 1024 * 1024, uint32_t entryAlignment = ResourceArchive::s_defaultEntryAlignment ) const;
+
+    private:
+
+        struct PendingResource
+        {
+            ResourceID                  m_resourceID;
+            FileSystem::Path            m_compiledFilePath;
+            uint64_t                    m_size = 0;
+        };
+
+        bool WriteArchive( FileSystem::Path const& archivePath, TVector<PendingResource const*> const& resources, uint32_t entryAlignment ) const;
+
+    private:
+
+        TVector<PendingResource>        m_resources;
+        THashMap<uint32_t, ResourceID>  m_addedResourceIDs;
+    };
+    #endif
+}
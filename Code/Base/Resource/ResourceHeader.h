@@ -10,7 +10,7 @@ namespace EE::Resource
     // Describes the contents of a resource, every resource has a header
     struct ResourceHeader
     {
-        EE_SERIALIZE( m_version, m_resourceType, m_installDependencies, m_sourceResourceHash );
+        EE_SERIALIZE( m_version, m_resourceType, m_installDependencies, m_transitiveInstallDependencies, m_sourceResourceHash );
 
     public:
 
@@ -29,11 +29,25 @@ namespace EE::Resource
 
         void AddInstallDependency( ResourceID resourceID ) { m_installDependencies.push_back( resourceID ); }
 
+        // Set the install dependencies of our install dependencies (all the way down), this needs to be called after all the direct install dependencies have been added
+        void SetTransitiveInstallDependencies( TVector<ResourceID> const& transitiveInstallDependencies )
+        {
+            m_transitiveInstallDependencies.clear();
+            for ( auto const& resourceID : transitiveInstallDependencies )
+            {
+                if ( !VectorContains( m_installDependencies, resourceID ) )
+                {
+                    VectorEmplaceBackUnique( m_transitiveInstallDependencies, resourceID );
+                }
+            }
+        }
+
     public:
 
         int32_t                 m_version = -1;
         ResourceTypeID          m_resourceType;
         TVector<ResourceID>     m_installDependencies;
+        TVector<ResourceID>     m_transitiveInstallDependencies; // Only used to request the whole dependency tree up-front, installation is still driven by the direct install dependencies
         uint64_t                m_sourceResourceHash = 0;
         uint64_t                m_advancedUpToDateHash = 0;
     };
@@ -9,14 +9,14 @@
 
 namespace EE::Resource
 {
-    ResourceLoader::LoadResult ResourceLoader::Load( ResourceID const& resourceID, FileSystem::Path const& resourcePath, ResourceRecord* pResourceRecord ) const
+    ResourceLoader::LoadResult ResourceLoader::Load( ResourceID const& resourceID, FileSystem::Path const& resourcePath, Blob& rawResourceData, ResourceRecord* pResourceRecord ) const
     {
         // Read file and create archive
         //-------------------------------------------------------------------------
 
-        Blob rawResourceData;
         Serialization::BinaryInputArchive archive;
 
+        if ( rawResourceData.empty() )
         {
             EE_PROFILE_SCOPE_IO( "Read File" );
 
@@ -29,10 +29,11 @@ namespace EE::Resource
                 EE_LOG_ERROR( "Resource", "Resource Loader", "Failed to read resource file (%s)", resourceID.c_str() );
                 return LoadResult::Failed;
             }
-
-            archive.ReadFromBlob( rawResourceData );
         }
 
+        pResourceRecord->m_residentSize = rawResourceData.size();
+        archive.ReadFromBlob( rawResourceData );
+
         // Load contents from raw file data
         //-------------------------------------------------------------------------
 
@@ -57,8 +58,10 @@ namespace EE::Resource
                 pResourceRecord->m_installDependencyResourceIDs.push_back( depResourceID );
             }
 
+            pResourceRecord->m_transitiveInstallDependencyResourceIDs = eastl::move( header.m_transitiveInstallDependencies );
+
             // Perform resource load
-            LoadResult loadResult = Load( resourceID, resourcePath, pResourceRecord, archive );
+            LoadResult loadResult = Load( resourceID, resourcePath, pResourceRecord, archive, rawResourceData );
             if ( loadResult == LoadResult::Failed )
             {
                 EE_LOG_ERROR( "Resource", "Resource Loader", "Failed to load resource: %s", resourceID.c_str() );
@@ -88,6 +91,7 @@ namespace EE::Resource
         EE::Delete( pData );
         pResourceRecord->SetResourceData( nullptr );
         pResourceRecord->m_installDependencyResourceIDs.clear();
+        pResourceRecord->m_transitiveInstallDependencyResourceIDs.clear();
     }
 
     ResourceLoader::LoadResult ResourceLoader::Install( ResourceID const& resourceID, InstallDependencyList const& installDependencies, ResourceRecord* pResourceRecord ) const
@@ -65,7 +65,9 @@ namespace EE::Resource
         virtual bool CanProceedWithFailedInstallDependency() const { return false; }
 
         // This function loads is responsible to deserialize the compiled resource data, read the resource header for install dependencies and to create the new runtime resource object
-        LoadResult Load( ResourceID const& resourceID, FileSystem::Path const& resourcePath, ResourceRecord* pResourceRecord ) const;
+        // If the raw resource data has already been read by the resource provider it will be used directly, otherwise it will be read from the resource path
+        // The raw resource data is a pooled buffer that is recycled after the load, it is passed on to the derived loader (see below)
+        LoadResult Load( ResourceID const& resourceID, FileSystem::Path const& resourcePath, Blob& rawResourceData, ResourceRecord* pResourceRecord ) const;
 
         // This function is only called if the initial load return "LoadResult::InProgress". This is necessary for any multi-stage loads i.e. anything that requires RHI alloc/transfer/etc...
         // This function will continue being called until either "LoadResult::Succeeded" or "LoadResult::Failed" is returned
@@ -89,8 +91,10 @@ namespace EE::Resource
     protected:
 
         // (Required) Override this function to implement you custom deserialization and creation logic, resource header has already been read at this point
+        // The archive reads directly from the raw resource data, resources that want to reference that data in-place can take ownership of it by moving it out
+        // Moving the blob doesn't move its memory, so the archive remains valid. Anything left in the blob is returned to the read buffer pool after the load
         // Return "LoadResult::InProgress" if you require a multi-stage load
-        virtual LoadResult Load( ResourceID const& resourceID, FileSystem::Path const& resourcePath, ResourceRecord* pResourceRecord, Serialization::BinaryInputArchive& archive ) const = 0;
+        virtual LoadResult Load( ResourceID const& resourceID, FileSystem::Path const& resourcePath, ResourceRecord* pResourceRecord, Serialization::BinaryInputArchive& archive, Blob& rawResourceData ) const = 0;
 
     protected:
 
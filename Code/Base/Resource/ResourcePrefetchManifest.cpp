@@ -0,0 +1,112 @@
+#include "ResourcePrefetchManifest.h"
+#include "Base/FileSystem/FileSystem.h"
+#include "Base/FileSystem/DataPath.h"
+
+//-------------------------------------------------------------------------
+
+namespace EE::Resource
+{
+    FileSystem::Path PrefetchManifest::GetManifestFilePath( FileSystem::Path const& compiledResourceDirectoryPath, ResourceID const& mapResourceID )
+    {
+        EE_ASSERT( compiledResourceDirectoryPath.IsDirectoryPath() && mapResourceID.IsValid() );
+
+        // Include the path ID so that maps with the same name in different directories dont share a manifest
+        String const manifestFilename( String::CtorSprintf(), "%s_%08X.txt", mapResourceID.GetFilenameWithoutExtension().c_str(), mapResourceID.GetPathID() );
+        return compiledResourceDirectoryPath.GetAppended( s_directoryName, true ) + manifestFilename;
+    }
+
+    bool PrefetchManifest::ReadManifest( FileSystem::Path const& manifestFilePath, TVector<ResourceID>& outResourceIDs )
+    {
+        String manifestData;
+        if ( !FileSystem::ReadTextFile( manifestFilePath, manifestData ) )
+        {
+            return false;
+        }
+
+        TVector<String> lines;
+        StringUtils::Split( manifestData, lines, "\r\n" );
+        for ( auto& line : lines )
+        {
+            // Only the path is needed for prefetching/ordering, the rest of the line is purely informational
+            size_t const separatorIdx = line.find( s_separator );
+            if ( separatorIdx != String::npos )
+            {
+                line.resize( separatorIdx );
+            }
+
+            if ( DataPath::IsValidPath( line ) )
+            {
+                outResourceIDs.emplace_back( ResourceID( line ) );
+            }
+        }
+
+        return true;
+    }
+
+    bool PrefetchManifest::WriteManifest( FileSystem::Path const& manifestFilePath, TVector<Entry> const& entries )
+    {
+        if ( !FileSystem::EnsureDirectoryExists( manifestFilePath.GetParentDirectory() ) )
+        {
+            return false;
+        }
+
+        String manifestData;
+        for ( auto const& entry : entries )
+        {
+            manifestData.append_sprintf( "%s%c%.3f%c%llu%c%llu\n", entry.m_resourceID.c_str(), s_separator, entry.m_requestTime.ToFloat(), s_separator, entry.m_requesterID, s_separator, entry.m_size );
+        }
+
+        return FileSystem::WriteTextFile( manifestFilePath, manifestData );
+    }
+
+    //-------------------------------------------------------------------------
+
+    #if EE_DEVELOPMENT_TOOLS
+    void ResourceLoadRecorder::Begin( ResourceID const& recordedResourceID )
+    {
+        EE_ASSERT( !IsRecording() && recordedResourceID.IsValid() );
+        m_recordedResourceID = recordedResourceID;
+        m_startTime = PlatformClock::GetTime();
+    }
+
+    bool ResourceLoadRecorder::End( FileSystem::Path const& manifestFilePath )
+    {
+        EE_ASSERT( IsRecording() );
+        bool const result = PrefetchManifest::WriteManifest( manifestFilePath, m_entries );
+        Cancel();
+        return result;
+    }
+
+    void ResourceLoadRecorder::Cancel()
+    {
+        m_recordedResourceID.Clear();
+        m_entries.clear();
+        m_entryIndices.clear();
+    }
+
+    void ResourceLoadRecorder::OnResourceRequested( ResourceID const& resourceID, ResourceRequesterID const& requesterID )
+    {
+        EE_ASSERT( IsRecording() );
+
+        if ( m_entryIndices.find( resourceID ) != m_entryIndices.end() )
+        {
+            return;
+        }
+
+        Milliseconds const requestTime = ( PlatformClock::GetTime() - m_startTime ).ToMilliseconds();
+        m_entryIndices.insert( TPair<ResourceID, int32_t>( resourceID, (int32_t) m_entries.size() ) );
+        m_entries.emplace_back( resourceID, requestTime, requesterID );
+    }
+
+    void ResourceLoadRecorder::OnResourceLoaded( ResourceID const& resourceID, uint64_t size )
+    {
+        EE_ASSERT( IsRecording() );
+
+        auto const foundIter = m_entryIndices.find( resourceID );
+        if ( foundIter != m_entryIndices.end() )
+        {
+            m_entries[foundIter->second].m_size = size;
+        }
+    }
+    #endif
+}
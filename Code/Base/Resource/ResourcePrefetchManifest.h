@@ -0,0 +1,94 @@
+#pragma once
+
+#include "ResourceRequesterID.h"
+#include "Base/FileSystem/FileSystemPath.h"
+#include "Base/Types/HashMap.h"
+#include "Base/Time/Time.h"
+
+//-------------------------------------------------------------------------
+// Resource Prefetch Manifest
+//-------------------------------------------------------------------------
+// A per-map list of all the resources that were loaded while loading that map, in the order they were requested
+//
+// * Manifests are recorded in development builds and stored alongside the compiled resources
+// * At load time the manifest is replayed so all reads are issued up-front instead of waiting for dependency discovery
+// * Packaging writes the manifest resources first and in manifest order, so replaying a manifest reads the archives in file order
+//
+// Format: one resource per line - "<resource path>|<request time (ms)>|<requester ID>|<size (bytes)>", only the path is required
+//-------------------------------------------------------------------------
+
+namespace EE::Resource
+{
+    class EE_BASE_API PrefetchManifest
+    {
+    public:
+
+        constexpr static char const* const s_directoryName = "PrefetchManifests";
+        constexpr static char const s_separator = '|';
+
+        struct Entry
+        {
+            Entry() = default;
+            Entry( ResourceID const& resourceID, Milliseconds requestTime, ResourceRequesterID const& requesterID )
+                : m_resourceID( resourceID )
+                , m_requestTime( requestTime )
+                , m_requesterID( requesterID.GetID() )
+            {}
+
+            ResourceID                                  m_resourceID;
+            Milliseconds                                m_requestTime = 0;
+            uint64_t                                    m_requesterID = 0;
+            uint64_t                                    m_size = 0;
+        };
+
+    public:
+
+        // Get the path of the manifest for a given map, relative to the supplied compiled resource directory
+        static FileSystem::Path GetManifestFilePath( FileSystem::Path const& compiledResourceDirectoryPath, ResourceID const& mapResourceID );
+
+        // Read all the valid resource IDs from a manifest, in manifest order
+        static bool ReadManifest( FileSystem::Path const& manifestFilePath, TVector<ResourceID>& outResourceIDs );
+
+        // Write a recorded manifest, this will create the manifest directory if needed
+        static bool WriteManifest( FileSystem::Path const& manifestFilePath, TVector<Entry> const& entries );
+    };
+
+    //-------------------------------------------------------------------------
+    // Resource Load Recorder
+    //-------------------------------------------------------------------------
+    // Records the time, requester and size of every resource loaded during a single recording session (i.e. a map load)
+    // Not threadsafe, only used from the main thread
+
+    #if EE_DEVELOPMENT_TOOLS
+    class EE_BASE_API ResourceLoadRecorder
+    {
+    public:
+
+        inline bool IsRecording() const { return m_recordedResourceID.IsValid(); }
+        inline ResourceID const& GetRecordedResourceID() const { return m_recordedResourceID; }
+        inline int32_t GetNumRecordedResources() const { return (int32_t) m_entries.size(); }
+
+        // Start a new recording session for the specified (map) resource
+        void Begin( ResourceID const& recordedResourceID );
+
+        // End the session and write the manifest
+        bool End( FileSystem::Path const& manifestFilePath );
+
+        // End the session without writing anything
+        void Cancel();
+
+        // Called when a resource load is requested, only the first request for each resource is recorded
+        void OnResourceRequested( ResourceID const& resourceID, ResourceRequesterID const& requesterID );
+
+        // Called once a recorded resource has been loaded
+        void OnResourceLoaded( ResourceID const& resourceID, uint64_t size );
+
+    private:
+
+        ResourceID                                      m_recordedResourceID;
+        Nanoseconds                                     m_startTime = 0;
+        TVector<PrefetchManifest::Entry>                m_entries;
+        THashMap<ResourceID, int32_t>                   m_entryIndices;
+    };
+    #endif
+}
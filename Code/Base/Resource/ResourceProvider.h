@@ -37,6 +37,9 @@ namespace EE::Resource
         // The resource provider update function
         virtual void Update() {};
 
+        // Can raw resource requests be issued from multiple threads at once, if not the resource system will serialize all calls to the provider
+        virtual bool SupportsConcurrentRequests() const { return false; }
+
         // Request a resource to be loaded
         virtual void RequestRawResource( ResourceRequest* pRequest ) = 0;
 
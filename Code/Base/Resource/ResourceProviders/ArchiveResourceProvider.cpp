@@ -0,0 +1,95 @@
+#include "ArchiveResourceProvider.h"
+#include "Base/Resource/ResourceRequest.h"
+#include "Base/Resource/Settings/GlobalSettings_Resource.h"
+#include "Base/FileSystem/FileSystemUtils.h"
+
+//-------------------------------------------------------------------------
+
+namespace EE::Resource
+{
+    static bool GetArchivePaths( ResourceGlobalSettings const& settings, TVector<FileSystem::Path>& outArchivePaths )
+    {
+        outArchivePaths.clear();
+        FileSystem::GetDirectoryContents( settings.m_compiledResourceDirectoryPath, outArchivePaths, FileSystem::DirectoryReaderOutput::OnlyFiles, FileSystem::DirectoryReaderMode::NoRecursion, { ResourceArchive::s_archiveExtension } );
+        return !outArchivePaths.empty();
+    }
+
+    bool ArchiveResourceProvider::AreArchivesAvailable( ResourceGlobalSettings const& settings )
+    {
+        TVector<FileSystem::Path> archivePaths;
+        return GetArchivePaths( settings, archivePaths );
+    }
+
+    //-------------------------------------------------------------------------
+
+    bool ArchiveResourceProvider::Initialize()
+    {
+        TVector<FileSystem::Path> archivePaths;
+        if ( !GetArchivePaths( m_settings, archivePaths ) )
+        {
+            EE_LOG_ERROR( "Resource", "Archive Resource Provider", "No resource archives found in: %s", m_settings.m_compiledResourceDirectoryPath.c_str() );
+            return false;
+        }
+
+        for ( auto const& archivePath : archivePaths )
+        {
+            auto pArchive = EE::New<ResourceArchive>();
+            if ( !pArchive->Open( archivePath ) )
+            {
+                EE::Delete( pArchive );
+                Shutdown();
+                return false;
+            }
+
+            m_archives.emplace_back( pArchive );
+
+            // Build the global lookup table
+            for ( auto const& entry : pArchive->GetEntries() )
+            {
+                auto const foundIter = m_entries.find( entry.m_resourcePathID );
+                if ( foundIter != m_entries.end() )
+                {
+                    EE_LOG_WARNING( "Resource", "Archive Resource Provider", "Resource (%u) exists in multiple archives (%s and %s), using the first one", entry.m_resourcePathID, foundIter->second.m_pArchive->GetFilePath().c_str(), archivePath.c_str() );
+                    continue;
+                }
+
+                m_entries.insert( TPair<uint32_t, ArchiveEntry>( entry.m_resourcePathID, ArchiveEntry{ pArchive, &entry } ) );
+            }
+        }
+
+        return true;
+    }
+
+    void ArchiveResourceProvider::Shutdown()
+    {
+        m_entries.clear();
+
+        for ( auto pArchive : m_archives )
+        {
+            EE::Delete( pArchive );
+        }
+        m_archives.clear();
+    }
+
+    void ArchiveResourceProvider::RequestRawResource( ResourceRequest* pRequest )
+    {
+        ResourceID const& resourceID = pRequest->GetResourceID();
+
+        auto const foundIter = m_entries.find( resourceID.GetPathID() );
+        if ( foundIter == m_entries.end() )
+        {
+            pRequest->OnRawResourceRequestComplete( String(), "Resource not found in any archive" );
+            return;
+        }
+
+        // Archived data is uncompressed, so the request can read the entry directly via the async reader into a pooled buffer
+        ArchiveEntry const& archiveEntry = foundIter->second;
+        EE_ASSERT( !archiveEntry.m_pEntry->IsCompressed() );
+        pRequest->OnRawResourceRequestComplete( archiveEntry.m_pArchive->GetFilePath(), archiveEntry.m_pEntry->m_offset, archiveEntry.m_pEntry->m_size );
+    }
+
+    void ArchiveResourceProvider::CancelRequest( ResourceRequest* pRequest )
+    {
+        // Do Nothing
+    }
+}
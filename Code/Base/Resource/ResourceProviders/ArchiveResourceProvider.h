@@ -0,0 +1,51 @@
+#pragma once
+
+#include "Base/Resource/ResourceProvider.h"
+#include "Base/Resource/ResourceArchive.h"
+#include "Base/Types/HashMap.h"
+
+//-------------------------------------------------------------------------
+// Reads resources from the packed archives created when packaging a build
+//-------------------------------------------------------------------------
+
+namespace EE::Resource
+{
+    class ResourceGlobalSettings;
+
+    //-------------------------------------------------------------------------
+
+    class EE_BASE_API ArchiveResourceProvider final : public ResourceProvider
+    {
+        struct ArchiveEntry
+        {
+            ResourceArchive const*                          m_pArchive = nullptr;
+            ResourceArchive::Entry const*                   m_pEntry = nullptr;
+        };
+
+    public:
+
+        // The name used for the archive files i.e. "Resources_000.eear"
+        constexpr static char const* const s_archiveName = "Resources";
+
+        // Are there any archives in the compiled resource directory?
+        static bool AreArchivesAvailable( ResourceGlobalSettings const& settings );
+
+    public:
+
+        ArchiveResourceProvider( ResourceGlobalSettings const& settings ) : ResourceProvider( settings ) {}
+        virtual bool IsReady() const override final { return !m_archives.empty(); }
+        virtual bool SupportsConcurrentRequests() const override final { return true; }
+
+    private:
+
+        virtual bool Initialize() override final;
+        virtual void Shutdown() override final;
+        virtual void RequestRawResource( ResourceRequest* pRequest ) override;
+        virtual void CancelRequest( ResourceRequest* pRequest ) override;
+
+    private:
+
+        TVector<ResourceArchive*>                           m_archives;
+        THashMap<uint32_t, ArchiveEntry>                    m_entries;
+    };
+}
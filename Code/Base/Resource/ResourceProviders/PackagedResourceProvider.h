@@ -17,6 +17,7 @@ namespace EE::Resource
 
         PackagedResourceProvider( ResourceGlobalSettings const& settings ) : ResourceProvider( settings ) {}
         virtual bool IsReady() const override final;
+        virtual bool SupportsConcurrentRequests() const override final { return true; }
 
     private:
 
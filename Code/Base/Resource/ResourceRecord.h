@@ -11,6 +11,8 @@
 
 namespace EE::Resource
 {
+    class ResourceRequest;
+
     //-------------------------------------------------------------------------
     // A unique record for each requested resource
     //-------------------------------------------------------------------------
@@ -22,6 +24,7 @@ namespace EE::Resource
         friend class ResourceRequest;
         friend class ResourceLoader;
         friend class ResourceDebugView;
+        friend class ResourceResidencyCache;
 
     public:
 
@@ -49,6 +52,13 @@ namespace EE::Resource
         inline void AddReference( ResourceRequesterID const& requesterID )
         {
             m_references.emplace_back( requesterID );
+
+            #if EE_DEVELOPMENT_TOOLS
+            if ( requesterID.IsInstallDependencyRequest() )
+            {
+                m_installDependentPathIDs.emplace_back( requesterID.GetInstallDependencyResourcePathID() );
+            }
+            #endif
         }
 
         inline void RemoveReference( ResourceRequesterID const& requesterID )
@@ -56,6 +66,15 @@ namespace EE::Resource
             auto iter = eastl::find( m_references.begin(), m_references.end(), requesterID );
             EE_ASSERT( iter != m_references.end() );
             m_references.erase_unsorted( iter );
+
+            #if EE_DEVELOPMENT_TOOLS
+            if ( requesterID.IsInstallDependencyRequest() )
+            {
+                auto dependentIter = eastl::find( m_installDependentPathIDs.begin(), m_installDependentPathIDs.end(), requesterID.GetInstallDependencyResourcePathID() );
+                EE_ASSERT( dependentIter != m_installDependentPathIDs.end() );
+                m_installDependentPathIDs.erase_unsorted( dependentIter );
+            }
+            #endif
         }
 
         //-------------------------------------------------------------------------
@@ -68,9 +87,57 @@ namespace EE::Resource
 
         inline TInlineVector<ResourceID, 4> const& GetInstallDependencies() const { return m_installDependencyResourceIDs; }
 
+        // The approximate memory cost of keeping this resource loaded (the size of the compiled resource data)
+        inline size_t GetResidentSize() const { return m_residentSize; }
+
+        // Scheduling
+        //-------------------------------------------------------------------------
+
+        inline RequestPriority GetRequestPriority() const { return m_requestPriority; }
+        inline Nanoseconds GetRequestTime() const { return m_requestTime; }
+        inline Nanoseconds GetRequestDeadline() const { return m_requestDeadline; }
+        inline bool HasRequestDeadline() const { return m_requestDeadline != 0; }
+
+        // Get the priority to schedule this record's request with, requests that have missed their deadline are always treated as critical
+        inline RequestPriority GetEffectiveRequestPriority( Nanoseconds currentTime ) const
+        {
+            return ( HasRequestDeadline() && currentTime >= m_requestDeadline ) ? RequestPriority::Critical : m_requestPriority;
+        }
+
+        // Start a new request, this resets any previous scheduling state
+        inline void ResetRequestScheduling( RequestPriority priority, Nanoseconds deadline )
+        {
+            m_requestPriority = priority;
+            m_requestDeadline = deadline;
+            m_requestTime = PlatformClock::GetTime();
+        }
+
+        // Raise the priority and/or tighten the deadline of an in-flight request, returns true if anything changed
+        inline bool EscalateRequestScheduling( RequestPriority priority, Nanoseconds deadline )
+        {
+            bool wasEscalated = false;
+
+            if ( priority > m_requestPriority )
+            {
+                m_requestPriority = priority;
+                wasEscalated = true;
+            }
+
+            if ( deadline != 0 && ( m_requestDeadline == 0 || deadline < m_requestDeadline ) )
+            {
+                m_requestDeadline = deadline;
+                wasEscalated = true;
+            }
+
+            return wasEscalated;
+        }
+
         //-------------------------------------------------------------------------
 
         #if EE_DEVELOPMENT_TOOLS
+        // The path IDs of all the resources that have requested this resource as an install dependency (one entry per reference)
+        inline TInlineVector<uint32_t, 4> const& GetInstallDependents() const { return m_installDependentPathIDs; }
+
         inline Milliseconds GetFileReadTime() const { return m_fileReadTime; }
         inline Milliseconds GetLoadTime() const { return m_loadTime; }
         inline Milliseconds GetDependenciesWaitTime() const { return m_waitForDependenciesTime; }
@@ -88,9 +155,21 @@ namespace EE::Resource
         std::atomic<LoadingStatus>              m_loadingStatus = LoadingStatus::Unloaded;      // The state of this resource (atomic since it will be modify by resource requests which run across multiple frames)
         TVector<ResourceRequesterID>            m_references;                                   // The list of references to this resources
         TInlineVector<ResourceID, 4>            m_installDependencyResourceIDs;                 // The list of resources that need to be loaded and installed before we can install this resource
+        TVector<ResourceID>                     m_transitiveInstallDependencyResourceIDs;       // The install dependencies of our install dependencies, only set between loading the resource and requesting its dependencies
+        Nanoseconds                             m_requestTime = 0;                              // When the current request for this resource was made (used to keep requests of the same priority in FIFO order)
+        Nanoseconds                             m_requestDeadline = 0;                          // The platform time by which the current request needs to complete, zero if there is no deadline
+        RequestPriority                         m_requestPriority = RequestPriority::Normal;    // The highest priority any requester has asked for this resource with
+        ResourceRequest*                        m_pActiveRequest = nullptr;                     // The request currently operating on this record (main thread only)
+        int32_t                                 m_pendingRequestIdx = InvalidIndex;             // The index of the gathered pending request for this record (main thread only)
+        int32_t                                 m_numQueuedRequests = 0;                        // The number of queued requests for this record that have not been gathered yet (guarded by the record shard lock)
+        size_t                                  m_residentSize = 0;                             // The approximate memory cost of this resource, set when the resource is loaded
+        ResourceRecord*                         m_pPrevResident = nullptr;                      // Residency cache LRU links (main thread only)
+        ResourceRecord*                         m_pNextResident = nullptr;
+        bool                                    m_isResidentInCache = false;                    // Is this resource being kept loaded by the residency cache (main thread only)
 
         #if EE_DEVELOPMENT_TOOLS
         uint64_t                                m_sourceResourceHash = 0;
+        TInlineVector<uint32_t, 4>              m_installDependentPathIDs;                      // Reverse install dependency index, kept in sync with the install dependency references (guarded by the record shard lock)
         Milliseconds                            m_fileReadTime = 0;
         Milliseconds                            m_loadTime = 0;
         Milliseconds                            m_waitForDependenciesTime = 0;
@@ -1,5 +1,6 @@
 #include "ResourceRequest.h"
 #include "Base/FileSystem/FileSystem.h"
+#include "Base/FileSystem/ReadBufferPool.h"
 #include "Base/Profiling.h"
 #include "Base/Threading/Threading.h"
 
@@ -60,10 +61,21 @@ namespace EE::Resource
         else // Continue the load operation
         {
             m_rawResourcePath = filePath;
-            m_stage = ResourceRequest::Stage::LoadResource;
+            m_rawResourceOffset = 0;
+            m_rawResourceSize = 0;
+            m_stage = ResourceRequest::Stage::ReadRawResource;
         }
     }
 
+    void ResourceRequest::OnRawResourceRequestComplete( FileSystem::Path const& sourceFilePath, uint64_t offset, uint64_t size )
+    {
+        EE_ASSERT( sourceFilePath.IsValid() && size > 0 );
+        m_rawResourcePath = sourceFilePath;
+        m_rawResourceOffset = offset;
+        m_rawResourceSize = size;
+        m_stage = ResourceRequest::Stage::ReadRawResource;
+    }
+
     void ResourceRequest::SwitchToLoadTask()
     {
         EE_ASSERT( m_type == Type::Unload );
@@ -101,6 +113,12 @@ namespace EE::Resource
             }
             break;
 
+            case Stage::CancelRawResourceRead:
+            {
+                m_stage = Stage::WaitForRawResourceRead;
+            }
+            break;
+
             default:
             EE_HALT();
             break;
@@ -126,8 +144,16 @@ namespace EE::Resource
             }
             break;
 
+            case Stage::WaitForRawResourceRead:
+            {
+                m_stage = Stage::CancelRawResourceRead;
+            }
+            break;
+
+            case Stage::ReadRawResource:
             case Stage::LoadResource:
             {
+                m_rawResourceData.clear();
                 m_stage = Stage::Complete;
                 m_pResourceRecord->SetLoadingStatus( LoadingStatus::Unloaded );
             }
@@ -181,6 +207,18 @@ namespace EE::Resource
             }
             break;
 
+            case ResourceRequest::Stage::ReadRawResource:
+            {
+                ReadRawResource( requestContext );
+            }
+            break;
+
+            case ResourceRequest::Stage::WaitForRawResourceRead:
+            {
+                WaitForRawResourceRead( requestContext );
+            }
+            break;
+
             case ResourceRequest::Stage::LoadResource:
             {
                 LoadResource( requestContext );
@@ -236,6 +274,7 @@ namespace EE::Resource
             case ResourceRequest::Stage::CancelWaitForInstallDependencies:
             {
                 // Execute all unload operations immediately
+                ReleaseTransitiveInstallDependencies( requestContext );
                 m_pendingInstallDependencies.clear();
                 m_installDependencies.clear();
                 m_stage = Stage::UnloadResource;
@@ -249,6 +288,19 @@ namespace EE::Resource
             }
             break;
 
+            case ResourceRequest::Stage::CancelRawResourceRead:
+            {
+                // We cant release the destination memory until the IO thread is done with it
+                if ( m_readStatus != ReadStatus::InProgress )
+                {
+                    m_readStatus = ReadStatus::None;
+                    ReleaseRawResourceData( requestContext );
+                    m_pResourceRecord->SetLoadingStatus( LoadingStatus::Unloaded );
+                    m_stage = Stage::Complete;
+                }
+            }
+            break;
+
             default:
             {
                 EE_UNREACHABLE_CODE();
@@ -277,6 +329,65 @@ namespace EE::Resource
         requestContext.m_createRawRequestRequestFunction( this );
     }
 
+    void ResourceRequest::ReadRawResource( RequestContext& requestContext )
+    {
+        EE_PROFILE_FUNCTION_RESOURCE();
+        EE_ASSERT( m_stage == ResourceRequest::Stage::ReadRawResource );
+        EE_ASSERT( m_rawResourcePath.IsValid() );
+        EE_ASSERT( m_readStatus != ReadStatus::InProgress );
+
+        #if EE_DEVELOPMENT_TOOLS
+        m_readTimer.Start();
+        #endif
+
+        // The read is performed on the IO threads, the completion function only flags the result and the request picks it up on its next update
+        FileSystem::AsyncFileReader::ReadRequest readRequest;
+        readRequest.m_filePath = m_rawResourcePath;
+        readRequest.m_offset = m_rawResourceOffset;
+        readRequest.m_size = m_rawResourceSize;
+        readRequest.m_pDestinationBlob = &m_rawResourceData;
+        readRequest.m_pBufferPool = requestContext.m_pReadBufferPool;
+        readRequest.m_completionFunction = [this] ( bool wasSuccessful, uint64_t numBytesRead )
+        {
+            m_readStatus = wasSuccessful ? ReadStatus::Succeeded : ReadStatus::Failed;
+        };
+
+        m_readStatus = ReadStatus::InProgress;
+        m_stage = ResourceRequest::Stage::WaitForRawResourceRead;
+        requestContext.m_readFileFunction( eastl::move( readRequest ) );
+    }
+
+    void ResourceRequest::WaitForRawResourceRead( RequestContext& requestContext )
+    {
+        EE_PROFILE_FUNCTION_RESOURCE();
+        EE_ASSERT( m_stage == ResourceRequest::Stage::WaitForRawResourceRead );
+
+        ReadStatus const readStatus = m_readStatus;
+        if ( readStatus == ReadStatus::InProgress )
+        {
+            return;
+        }
+
+        m_readStatus = ReadStatus::None;
+
+        #if EE_DEVELOPMENT_TOOLS
+        m_pResourceRecord->m_fileReadTime = m_readTimer.GetElapsedTimeMilliseconds();
+        #endif
+
+        if ( readStatus == ReadStatus::Failed )
+        {
+            EE_LOG_ERROR( "Resource", "Resource Request", "Failed to read resource file (%s)", m_pResourceRecord->GetResourceID().c_str() );
+            ReleaseRawResourceData( requestContext );
+            m_pResourceRecord->SetLoadingStatus( LoadingStatus::Failed );
+            m_stage = ResourceRequest::Stage::Complete;
+            return;
+        }
+
+        // Immediately perform the load, no need to wait for another update
+        m_stage = ResourceRequest::Stage::LoadResource;
+        LoadResource( requestContext );
+    }
+
     void ResourceRequest::LoadResource( RequestContext& requestContext )
     {
         EE_PROFILE_FUNCTION_RESOURCE();
@@ -298,7 +409,8 @@ namespace EE::Resource
             EE_PROFILE_TAG( "Loader", resTypeID );
             #endif
 
-            loadResult = m_pResourceLoader->Load( GetResourceID(), m_rawResourcePath, m_pResourceRecord );
+            loadResult = m_pResourceLoader->Load( GetResourceID(), m_rawResourcePath, m_rawResourceData, m_pResourceRecord );
+            ReleaseRawResourceData( requestContext );
             if ( loadResult == ResourceLoader::LoadResult::Failed )
             {
                 EE_LOG_ERROR( "Resource", "Resource Request", "Failed to load compiled resource data (%s)", m_pResourceRecord->GetResourceID().c_str() );
@@ -325,6 +437,21 @@ namespace EE::Resource
             requestContext.m_loadResourceFunction( installDependencyRequesterID, m_pendingInstallDependencies[i] );
         }
 
+        // Request the rest of the dependency tree immediately, rather than discovering it one level at a time as each dependency is loaded
+        // Installation still happens in dependency order, since each dependency waits for its own direct install dependencies
+        // These use a separate prefetch requester ID since we are not an install dependent of our transitive dependencies
+        ResourceRequesterID const prefetchRequesterID = ResourceRequesterID::DependencyPrefetch( m_pResourceRecord->GetResourceID() );
+        uint32_t const numTransitiveInstallDependencies = (uint32_t) m_pResourceRecord->m_transitiveInstallDependencyResourceIDs.size();
+        m_transitiveInstallDependencies.resize( numTransitiveInstallDependencies );
+        for ( uint32_t i = 0; i < numTransitiveInstallDependencies; i++ )
+        {
+            m_transitiveInstallDependencies[i] = ResourcePtr( m_pResourceRecord->m_transitiveInstallDependencyResourceIDs[i] );
+            requestContext.m_loadResourceFunction( prefetchRequesterID, m_transitiveInstallDependencies[i] );
+        }
+
+        m_pResourceRecord->m_transitiveInstallDependencyResourceIDs.clear();
+        m_pResourceRecord->m_transitiveInstallDependencyResourceIDs.shrink_to_fit();
+
         // Set new stage
         //-------------------------------------------------------------------------
 
@@ -470,6 +597,7 @@ namespace EE::Resource
 
             m_pendingInstallDependencies.clear();
             m_installDependencies.clear();
+            ReleaseTransitiveInstallDependencies( requestContext );
             m_pResourceRecord->SetLoadingStatus( LoadingStatus::Failed );
             m_pResourceLoader->Unload( GetResourceID(), m_pResourceRecord );
             m_stage = ResourceRequest::Stage::Complete;
@@ -478,6 +606,7 @@ namespace EE::Resource
         else if ( status == InstallStatus::ShouldProceed )
         {
             EE_ASSERT( m_pendingInstallDependencies.empty() );
+            ReleaseTransitiveInstallDependencies( requestContext );
             m_stage = ResourceRequest::Stage::InstallResource;
 
             #if EE_DEVELOPMENT_TOOLS
@@ -620,6 +749,9 @@ namespace EE::Resource
             requestContext.m_unloadResourceFunction( installDependencyRequesterID, m_pendingInstallDependencies[i] );
         }
 
+        // We might be cancelling a load that is still waiting on its dependencies
+        ReleaseTransitiveInstallDependencies( requestContext );
+
         // Unload resource
         //-------------------------------------------------------------------------
 
@@ -663,4 +795,31 @@ namespace EE::Resource
         m_pResourceRecord->SetLoadingStatus( LoadingStatus::Unloaded );
         m_stage = ResourceRequest::Stage::Complete;
     }
+
+    void ResourceRequest::ReleaseTransitiveInstallDependencies( RequestContext& requestContext )
+    {
+        if ( m_transitiveInstallDependencies.empty() )
+        {
+            return;
+        }
+
+        ResourceRequesterID const prefetchRequesterID = ResourceRequesterID::DependencyPrefetch( m_pResourceRecord->GetResourceID() );
+        for ( auto& dependency : m_transitiveInstallDependencies )
+        {
+            requestContext.m_unloadResourceFunction( prefetchRequesterID, dependency );
+        }
+
+        m_transitiveInstallDependencies.clear();
+    }
+
+    void ResourceRequest::ReleaseRawResourceData( RequestContext& requestContext )
+    {
+        if ( requestContext.m_pReadBufferPool != nullptr )
+        {
+            requestContext.m_pReadBufferPool->Release( eastl::move( m_rawResourceData ) );
+        }
+
+        m_rawResourceData.clear();
+        m_rawResourceData.shrink_to_fit();
+    }
 }
\ No newline at end of file
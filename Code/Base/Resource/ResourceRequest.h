@@ -5,6 +5,7 @@
 #include "Base/Types/Function.h"
 #include "Base/Time/Timers.h"
 #include "ResourceHeader.h"
+#include "Base/FileSystem/AsyncFileReader.h"
 
 //-------------------------------------------------------------------------
 
@@ -21,6 +22,8 @@ namespace EE::Resource
             // Load Stages
             RequestRawResource,
             WaitForRawResourceRequest,
+            ReadRawResource,
+            WaitForRawResourceRead,
             LoadResource,
             LoadingResource,
 
@@ -37,6 +40,7 @@ namespace EE::Resource
             // Special Cases
             CancelWaitForInstallDependencies, // This stage is needed so we can resume correctly when going from load -> unload -> load
             CancelRawResourceRequest,
+            CancelRawResourceRead,
 
             Complete,
         };
@@ -62,6 +66,16 @@ namespace EE::Resource
             TFunction<void( ResourceRequest* )> m_cancelRawRequestRequestFunction;
             TFunction<void( ResourceRequesterID const&, ResourcePtr& )> m_loadResourceFunction;
             TFunction<void( ResourceRequesterID const&, ResourcePtr& )> m_unloadResourceFunction;
+            TFunction<void( FileSystem::AsyncFileReader::ReadRequest&& )> m_readFileFunction;
+            FileSystem::ReadBufferPool*                                     m_pReadBufferPool = nullptr;
+        };
+
+        enum class ReadStatus : uint8_t
+        {
+            None,
+            InProgress,
+            Succeeded,
+            Failed,
         };
 
     public:
@@ -77,7 +91,13 @@ namespace EE::Resource
 
         inline Stage GetStage() const { return m_stage; }
 
+        // Will the next update of this request perform file IO
+        inline bool IsPerformingIO() const { return m_stage == Stage::RequestRawResource || m_stage == Stage::ReadRawResource; }
+        inline bool IsWaitingForRawResourceRead() const { return m_stage == Stage::WaitForRawResourceRead; }
+
         inline ResourceRecord const* GetResourceRecord() const { return m_pResourceRecord; }
+        inline ResourceRecord* GetResourceRecord() { return m_pResourceRecord; }
+        inline InstallDependencyList const& GetPendingInstallDependencies() const { return m_pendingInstallDependencies; }
         inline ResourceID const& GetResourceID() const { return m_pResourceRecord->GetResourceID(); }
         inline ResourceTypeID GetResourceTypeID() const { return m_pResourceRecord->GetResourceTypeID(); }
         inline LoadingStatus GetLoadingStatus() const { return m_pResourceRecord->GetLoadingStatus(); }
@@ -93,6 +113,9 @@ namespace EE::Resource
         // Called by the resource provider once the request operation completes and provides the raw resource data
         void OnRawResourceRequestComplete( String const& filePath, String const& log );
 
+        // Called by the resource provider once the request operation completes, for providers where the raw resource data is a range within a larger file (e.g. an archive)
+        void OnRawResourceRequestComplete( FileSystem::Path const& sourceFilePath, uint64_t offset, uint64_t size );
+
         // This will interrupt a load task and convert it into an unload task
         void SwitchToLoadTask();
 
@@ -102,6 +125,8 @@ namespace EE::Resource
         //-------------------------------------------------------------------------
 
         void RequestRawResource( RequestContext& requestContext );
+        void ReadRawResource( RequestContext& requestContext );
+        void WaitForRawResourceRead( RequestContext& requestContext );
         void LoadResource( RequestContext& requestContext );
         void UpdateLoadingResource( RequestContext& requestContext );
         void UnloadResource( RequestContext& requestContext );
@@ -114,20 +139,32 @@ namespace EE::Resource
 
         void CancelRawRequestRequest( RequestContext& requestContext );
 
+        // Release the references to the transitive install dependencies, once our direct install dependencies are loaded they will keep these loaded
+        void ReleaseTransitiveInstallDependencies( RequestContext& requestContext );
+
+        // Return the raw resource data buffer to the pool, if the loader took ownership of the data this does nothing
+        void ReleaseRawResourceData( RequestContext& requestContext );
+
     private:
 
         ResourceRequesterID                     m_requesterID;
         ResourceRecord*                         m_pResourceRecord = nullptr;
         ResourceLoader*                         m_pResourceLoader = nullptr;
         FileSystem::Path                        m_rawResourcePath;
+        uint64_t                                m_rawResourceOffset = 0;
+        uint64_t                                m_rawResourceSize = 0; // Zero means the whole file
+        Blob                                    m_rawResourceData;
+        std::atomic<ReadStatus>                 m_readStatus = ReadStatus::None; // Set from the IO thread when the raw resource read completes
         InstallDependencyList                   m_pendingInstallDependencies;
         InstallDependencyList                   m_installDependencies;
+        TVector<ResourcePtr>                    m_transitiveInstallDependencies;
         Type                                    m_type = Type::Invalid;
         Stage                                   m_stage = Stage::None;
         bool                                    m_isReloadRequest = false;
 
         #if EE_DEVELOPMENT_TOOLS
         Timer<PlatformClock>                    m_stageTimer;
+        Timer<PlatformClock>                    m_readTimer;
         #endif
     };
 }
\ No newline at end of file
@@ -6,24 +6,46 @@
 
 namespace EE::Resource
 {
+    // Higher priority requests are scheduled (IO, load and install) before lower priority ones
+    enum class RequestPriority : uint8_t
+    {
+        Background = 0,
+        Normal,
+        High,
+        Critical,
+    };
+
+    //-------------------------------------------------------------------------
+
     class ResourceRequesterID
     {
         static constexpr uint64_t s_manualRequestID = 0x0;
         static constexpr uint64_t s_toolsRequestID = 0xFFFFFFFFFFFFFFFF;
+        static constexpr uint64_t s_dependencyPrefetchFlag = 1ull << 32; // Keeps prefetch IDs distinct from the install dependency ID of the same resource
 
     public:
 
-        static inline ResourceRequesterID ManualRequest() { return ResourceRequesterID( s_manualRequestID ); }
+        static inline ResourceRequesterID ManualRequest( RequestPriority priority = RequestPriority::Normal ) { return ResourceRequesterID( s_manualRequestID, priority ); }
         static inline ResourceRequesterID ToolRequest() { return ResourceRequesterID( s_toolsRequestID ); }
 
+        // Prefetch of a transitive install dependency of another resource, these are not install dependents of the prefetching resource
+        static inline ResourceRequesterID DependencyPrefetch( ResourceID dependentResourceID )
+        {
+            EE_ASSERT( dependentResourceID.IsValid() );
+            ResourceRequesterID requesterID( s_dependencyPrefetchFlag | dependentResourceID.GetPathID() );
+            requesterID.m_isDependencyPrefetch = true;
+            return requesterID;
+        }
+
     public:
 
         // No ID - manual request
         ResourceRequesterID() = default;
 
         // Explicit 64bit ID - generally refers to an entity ID
-        explicit ResourceRequesterID( uint64_t requesterID )
+        explicit ResourceRequesterID( uint64_t requesterID, RequestPriority priority = RequestPriority::Normal )
             : m_ID( requesterID )
+            , m_priority( priority )
         {}
 
         // Explicit install dependency based on another dependent resource
@@ -51,7 +73,7 @@ namespace EE::Resource
         // A normal request via the entity system
         inline bool IsNormalRequest() const
         {
-            return m_ID > 0 && !m_isInstallDependency;
+            return m_ID > 0 && !m_isInstallDependency && !m_isDependencyPrefetch;
         }
 
         // A install dependency request, coming from the resource system as part of resource loading
@@ -60,15 +82,24 @@ namespace EE::Resource
             return m_isInstallDependency;
         }
 
+        // A transitive install dependency prefetch, coming from the resource system as part of resource loading
+        inline bool IsDependencyPrefetchRequest() const
+        {
+            return m_isDependencyPrefetch;
+        }
+
         //-------------------------------------------------------------------------
 
         // Get the requester ID
         inline uint64_t GetID() const { return m_ID; }
 
-        // Get the ID for the data path for install dependencies, used for reverse look ups
+        // Get the scheduling priority for requests made by this requester, install dependencies inherit the priority of the resource that depends on them
+        inline RequestPriority GetPriority() const { return m_priority; }
+
+        // Get the ID for the data path of the resource that depends on us (install dependencies and prefetches), used for reverse look ups
         inline uint32_t GetInstallDependencyResourcePathID() const
         {
-            EE_ASSERT( m_isInstallDependency );
+            EE_ASSERT( m_isInstallDependency || m_isDependencyPrefetch );
             return (uint32_t) m_ID;
         }
 
@@ -79,7 +110,9 @@ namespace EE::Resource
 
     private:
 
-        uint64_t    m_ID = 0;
-        bool        m_isInstallDependency = false;
+        uint64_t            m_ID = 0;
+        bool                m_isInstallDependency = false;
+        bool                m_isDependencyPrefetch = false;
+        RequestPriority     m_priority = RequestPriority::Normal; // Scheduling hint only, not part of the requester's identity
     };
 }
\ No newline at end of file
@@ -0,0 +1,179 @@
+#include "ResourceResidencyCache.h"
+
+//-------------------------------------------------------------------------
+
+namespace EE::Resource
+{
+    void ResourceResidencyCache::SetBudget( ResourceTypeID resourceTypeID, size_t budgetBytes )
+    {
+        EE_ASSERT( resourceTypeID.IsValid() );
+
+        // Over budget resources will be evicted on the next update
+        m_typeCaches[resourceTypeID].m_budget = budgetBytes;
+    }
+
+    bool ResourceResidencyCache::IsCachedType( ResourceTypeID resourceTypeID ) const
+    {
+        auto const foundIter = m_typeCaches.find( resourceTypeID );
+        return foundIter != m_typeCaches.end() && foundIter->second.m_budget > 0;
+    }
+
+    bool ResourceResidencyCache::IsEmpty() const
+    {
+        for ( auto const& typeCachePair : m_typeCaches )
+        {
+            if ( typeCachePair.second.m_numResident > 0 )
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    //-------------------------------------------------------------------------
+
+    void ResourceResidencyCache::Unlink( TypeCache& typeCache, ResourceRecord* pRecord )
+    {
+        EE_ASSERT( pRecord->m_isResidentInCache );
+
+        if ( pRecord->m_pPrevResident != nullptr )
+        {
+            pRecord->m_pPrevResident->m_pNextResident = pRecord->m_pNextResident;
+        }
+        else
+        {
+            typeCache.m_pMostRecent = pRecord->m_pNextResident;
+        }
+
+        if ( pRecord->m_pNextResident != nullptr )
+        {
+            pRecord->m_pNextResident->m_pPrevResident = pRecord->m_pPrevResident;
+        }
+        else
+        {
+            typeCache.m_pLeastRecent = pRecord->m_pPrevResident;
+        }
+
+        pRecord->m_pPrevResident = nullptr;
+        pRecord->m_pNextResident = nullptr;
+        pRecord->m_isResidentInCache = false;
+
+        EE_ASSERT( typeCache.m_usedBytes >= pRecord->m_residentSize && typeCache.m_numResident > 0 );
+        typeCache.m_usedBytes -= pRecord->m_residentSize;
+        typeCache.m_numResident--;
+    }
+
+    bool ResourceResidencyCache::TryAdd( ResourceRecord* pRecord )
+    {
+        EE_ASSERT( pRecord != nullptr && pRecord->IsLoaded() && !pRecord->HasReferences() );
+
+        auto foundIter = m_typeCaches.find( pRecord->GetResourceTypeID() );
+        if ( foundIter == m_typeCaches.end() || foundIter->second.m_budget == 0 )
+        {
+            return false;
+        }
+
+        // Resources that could never fit are not worth caching
+        TypeCache& typeCache = foundIter->second;
+        if ( pRecord->m_residentSize > typeCache.m_budget )
+        {
+            return false;
+        }
+
+        // Re-adding a resident resource just marks it as the most recently used
+        if ( pRecord->m_isResidentInCache )
+        {
+            Unlink( typeCache, pRecord );
+        }
+
+        pRecord->m_pNextResident = typeCache.m_pMostRecent;
+        if ( typeCache.m_pMostRecent != nullptr )
+        {
+            typeCache.m_pMostRecent->m_pPrevResident = pRecord;
+        }
+        typeCache.m_pMostRecent = pRecord;
+
+        if ( typeCache.m_pLeastRecent == nullptr )
+        {
+            typeCache.m_pLeastRecent = pRecord;
+        }
+
+        pRecord->m_isResidentInCache = true;
+        typeCache.m_usedBytes += pRecord->m_residentSize;
+        typeCache.m_numResident++;
+        return true;
+    }
+
+    void ResourceResidencyCache::OnHit( ResourceRecord* pRecord )
+    {
+        auto foundIter = m_typeCaches.find( pRecord->GetResourceTypeID() );
+        EE_ASSERT( foundIter != m_typeCaches.end() );
+        Unlink( foundIter->second, pRecord );
+        foundIter->second.m_numHits++;
+    }
+
+    void ResourceResidencyCache::OnMiss( ResourceTypeID resourceTypeID )
+    {
+        auto foundIter = m_typeCaches.find( resourceTypeID );
+        if ( foundIter != m_typeCaches.end() && foundIter->second.m_budget > 0 )
+        {
+            foundIter->second.m_numMisses++;
+        }
+    }
+
+    void ResourceResidencyCache::Remove( ResourceRecord* pRecord )
+    {
+        auto foundIter = m_typeCaches.find( pRecord->GetResourceTypeID() );
+        EE_ASSERT( foundIter != m_typeCaches.end() );
+        Unlink( foundIter->second, pRecord );
+    }
+
+    void ResourceResidencyCache::GetResourcesToEvict( TVector<ResourceRecord*>& outRecordsToEvict )
+    {
+        for ( auto& typeCachePair : m_typeCaches )
+        {
+            TypeCache& typeCache = typeCachePair.second;
+            while ( typeCache.m_usedBytes > typeCache.m_budget || ( typeCache.m_budget == 0 && typeCache.m_numResident > 0 ) )
+            {
+                ResourceRecord* pRecordToEvict = typeCache.m_pLeastRecent;
+                Unlink( typeCache, pRecordToEvict );
+                typeCache.m_numEvictions++;
+                outRecordsToEvict.emplace_back( pRecordToEvict );
+            }
+        }
+    }
+
+    void ResourceResidencyCache::GetAllResources( TVector<ResourceRecord*>& outRecords )
+    {
+        for ( auto& typeCachePair : m_typeCaches )
+        {
+            TypeCache& typeCache = typeCachePair.second;
+            while ( typeCache.m_pLeastRecent != nullptr )
+            {
+                ResourceRecord* pRecord = typeCache.m_pLeastRecent;
+                Unlink( typeCache, pRecord );
+                outRecords.emplace_back( pRecord );
+            }
+        }
+    }
+
+    void ResourceResidencyCache::GetStats( TVector<TypeStats>& outStats ) const
+    {
+        outStats.clear();
+
+        for ( auto const& typeCachePair : m_typeCaches )
+        {
+            TypeCache const& typeCache = typeCachePair.second;
+
+            TypeStats& stats = outStats.emplace_back();
+            stats.m_resourceTypeID = typeCachePair.first;
+            stats.m_budget = typeCache.m_budget;
+            stats.m_usedBytes = typeCache.m_usedBytes;
+            stats.m_numResident = typeCache.m_numResident;
+            stats.m_numHits = typeCache.m_numHits;
+            stats.m_numMisses = typeCache.m_numMisses;
+            stats.m_numEvictions = typeCache.m_numEvictions;
+        }
+    }
+}
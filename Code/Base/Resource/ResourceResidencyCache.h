@@ -0,0 +1,92 @@
+#pragma once
+
+#include "ResourceRecord.h"
+#include "Base/Types/HashMap.h"
+
+//-------------------------------------------------------------------------
+// Resource Residency Cache
+//-------------------------------------------------------------------------
+// Keeps unreferenced (but loaded) resources resident so that re-requests dont need to go back to disk
+//
+// * Only resource types with a budget are cached, the budget is the max resident size of all cached resources of that type
+// * When a type goes over budget, the least recently released resources are evicted first
+// * The cache only tracks records, the resource system is responsible for actually unloading evicted resources
+// * Not threadsafe, only used from the main thread
+//-------------------------------------------------------------------------
+
+namespace EE::Resource
+{
+    class EE_BASE_API ResourceResidencyCache
+    {
+        struct TypeCache
+        {
+            ResourceRecord*                         m_pMostRecent = nullptr;
+            ResourceRecord*                         m_pLeastRecent = nullptr;
+            size_t                                  m_budget = 0;
+            size_t                                  m_usedBytes = 0;
+            int32_t                                 m_numResident = 0;
+            uint64_t                                m_numHits = 0;
+            uint64_t                                m_numMisses = 0;
+            uint64_t                                m_numEvictions = 0;
+        };
+
+    public:
+
+        struct TypeStats
+        {
+            ResourceTypeID                          m_resourceTypeID;
+            size_t                                  m_budget = 0;
+            size_t                                  m_usedBytes = 0;
+            int32_t                                 m_numResident = 0;
+            uint64_t                                m_numHits = 0;
+            uint64_t                                m_numMisses = 0;
+            uint64_t                                m_numEvictions = 0;
+
+            inline float GetHitRate() const { uint64_t const numRequests = m_numHits + m_numMisses; return ( numRequests > 0 ) ? float( m_numHits ) / numRequests : 0.0f; }
+        };
+
+    public:
+
+        ~ResourceResidencyCache() { EE_ASSERT( IsEmpty() ); }
+
+        // Set the residency budget for a resource type, a budget of zero disables caching for that type
+        void SetBudget( ResourceTypeID resourceTypeID, size_t budgetBytes );
+
+        // Is this resource type cached at all
+        bool IsCachedType( ResourceTypeID resourceTypeID ) const;
+
+        // Are there any cached resources
+        bool IsEmpty() const;
+
+        // Is this record currently held resident by the cache
+        inline bool IsResident( ResourceRecord const* pRecord ) const { return pRecord->m_isResidentInCache; }
+
+        // Try to keep an unreferenced loaded resource resident, returns false if this type is not cached
+        bool TryAdd( ResourceRecord* pRecord );
+
+        // Called when a resident resource is requested again
+        void OnHit( ResourceRecord* pRecord );
+
+        // Called when we need to load a resource of a cached type from disk
+        void OnMiss( ResourceTypeID resourceTypeID );
+
+        // Remove a resource from the cache, without counting it as a hit or eviction
+        void Remove( ResourceRecord* pRecord );
+
+        // Remove the least recently used resources from all over-budget types
+        void GetResourcesToEvict( TVector<ResourceRecord*>& outRecordsToEvict );
+
+        // Remove all resident resources
+        void GetAllResources( TVector<ResourceRecord*>& outRecords );
+
+        void GetStats( TVector<TypeStats>& outStats ) const;
+
+    private:
+
+        void Unlink( TypeCache& typeCache, ResourceRecord* pRecord );
+
+    private:
+
+        THashMap<ResourceTypeID, TypeCache>         m_typeCaches;
+    };
+}
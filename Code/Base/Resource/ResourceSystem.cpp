@@ -2,6 +2,8 @@
 #include "ResourceProvider.h"
 #include "ResourceRequest.h"
 #include "Base/Profiling.h"
+#include <EASTL/sort.h>
+#include <EASTL/algorithm.h>
 
 //-------------------------------------------------------------------------
 
@@ -9,12 +11,22 @@ namespace EE::Resource
 {
     ResourceSystem::ResourceSystem( TaskSystem& taskSystem )
         : m_taskSystem( taskSystem )
-        , m_asyncProcessingTask( [this] ( TaskSetPartition range, uint32_t threadnum ) { ProcessResourceRequests(); } )
-    {}
+        , m_asyncProcessingTask( [this] ( TaskSetPartition range, uint32_t threadnum ) { ProcessResourceRequests( range ); } )
+        , m_readBufferPool( s_maxRetainedReadBufferBytes )
+    {
+        m_asyncProcessingTask.m_MinRange = 1;
+    }
 
     ResourceSystem::~ResourceSystem()
     {
-        EE_ASSERT( m_pResourceProvider == nullptr && !IsBusy() && m_resourceRecords.empty() );
+        EE_ASSERT( m_pResourceProvider == nullptr && !IsBusy() );
+
+        #if EE_DEVELOPMENT_TOOLS
+        for ( auto const& shard : m_recordShards )
+        {
+            EE_ASSERT( shard.m_records.empty() );
+        }
+        #endif
     }
 
     ResourceGlobalSettings const& ResourceSystem::GetSettings() const
@@ -26,11 +38,38 @@ namespace EE::Resource
     {
         EE_ASSERT( pResourceProvider != nullptr && pResourceProvider->IsReady() );
         m_pResourceProvider = pResourceProvider;
+        m_isShuttingDown = false;
+
+        for ( auto const& budget : m_pResourceProvider->GetSettings().m_residencyBudgets )
+        {
+            SetResidencyBudget( budget.first, budget.second );
+        }
     }
 
     void ResourceSystem::Shutdown()
     {
+        // Unloading resident resources releases their install dependencies, which must not be cached again
+        m_isShuttingDown = true;
+
+        #if EE_DEVELOPMENT_TOOLS
+        if ( m_loadOrderRecorder.IsRecording() )
+        {
+            m_loadOrderRecorder.Cancel();
+        }
+        #endif
+
+        while ( !m_prefetchedResources.empty() )
+        {
+            ReleasePrefetchedResources( m_prefetchedResources.begin()->first );
+        }
+
         WaitForAllRequestsToComplete();
+
+        // Resident resources are still loaded, so we need to explicitly unload them
+        ClearResidencyCache();
+        WaitForAllRequestsToComplete();
+
+        m_readBufferPool.Clear();
         m_pResourceProvider = nullptr;
     }
 
@@ -46,7 +85,7 @@ namespace EE::Resource
             return true;
         }
 
-        if ( !m_pendingRequests.empty() )
+        if ( !m_pendingRequests.empty() || m_queuedRequests.size_approx() > 0 )
         {
             return true;
         }
@@ -54,57 +93,35 @@ namespace EE::Resource
         return false;
     }
 
-    //-------------------------------------------------------------------------
-
-    void ResourceSystem::GetUsersForResource( ResourceRecord const* pResourceRecord, TInlineVector<ResourceRequesterID, 20>& userIDs ) const
+    ResourceSystem::LockContentionStats ResourceSystem::GetLockContentionStats() const
     {
-        EE_ASSERT( pResourceRecord != nullptr );
-        Threading::RecursiveScopeLock lock( m_accessLock );
-
-        for ( auto const& requesterID : pResourceRecord->m_references )
+        LockContentionStats stats;
+        uint64_t contendedWaitTime = 0;
+        for ( auto const& shard : m_recordShards )
         {
-            // Internal user i.e. install dependency
-            if ( requesterID.IsInstallDependencyRequest() )
-            {
-                uint32_t const resourcePathID( requesterID.GetInstallDependencyResourcePathID() );
-                auto const dependentRecordIter = m_resourceRecords.find_as( resourcePathID );
-                EE_ASSERT( dependentRecordIter != m_resourceRecords.end() );
-
-                ResourceRecord* pFoundDependentRecord = dependentRecordIter->second;
-                GetUsersForResource( pFoundDependentRecord, userIDs );
-            }
-            else // Actual external user
-            {
-                // Skip manual requests
-                if ( requesterID.IsManualRequest() )
-                {
-                    continue;
-                }
-
-                // Add unique users to the list
-                VectorEmplaceBackUnique( userIDs, requesterID );
-            }
+            stats.m_numLocks += shard.m_numLocks;
+            stats.m_numContendedLocks += shard.m_numContendedLocks;
+            contendedWaitTime += shard.m_contendedWaitTime;
         }
+
+        stats.m_contendedWaitTime = contendedWaitTime;
+        return stats;
     }
 
-    void ResourceSystem::GetDependentResourcesForResource( ResourceRecord const* pResourceRecord, TInlineVector<ResourceID, 20>& dependentResources ) const
+    Threading::Lock ResourceSystem::LockRecordShard( RecordShard const& shard ) const
     {
-        EE_ASSERT( pResourceRecord != nullptr );
-        Threading::RecursiveScopeLock lock( m_accessLock );
-
-        for ( auto const& requesterID : pResourceRecord->m_references )
+        // Only time the lock acquisition if we actually have to wait for it
+        Threading::Lock lock( shard.m_mutex, std::try_to_lock );
+        if ( !lock.owns_lock() )
         {
-            if ( requesterID.IsInstallDependencyRequest() )
-            {
-                uint32_t const resourcePathID( requesterID.GetInstallDependencyResourcePathID() );
-                auto const dependentRecordIter = m_resourceRecords.find_as( resourcePathID );
-                EE_ASSERT( dependentRecordIter != m_resourceRecords.end() );
-
-                ResourceRecord* pFoundDependentRecord = dependentRecordIter->second;
-                dependentResources.emplace_back( pFoundDependentRecord->m_resourceID );
-                GetDependentResourcesForResource( pFoundDependentRecord, dependentResources );
-            }
+            Nanoseconds const startTime = PlatformClock::GetTime();
+            lock.lock();
+            shard.m_contendedWaitTime += ( PlatformClock::GetTime() - startTime ).ToU64();
+            shard.m_numContendedLocks++;
         }
+
+        shard.m_numLocks++;
+        return lock;
     }
 
     //-------------------------------------------------------------------------
@@ -133,17 +150,16 @@ namespace EE::Resource
 
     //-------------------------------------------------------------------------
 
-    ResourceRecord* ResourceSystem::FindOrCreateResourceRecord( ResourceID const& resourceID )
+    ResourceRecord* ResourceSystem::FindOrCreateResourceRecord( RecordShard& shard, ResourceID const& resourceID )
     {
         EE_ASSERT( resourceID.IsValid() );
-        Threading::RecursiveScopeLock lock( m_accessLock );
 
         ResourceRecord* pRecord = nullptr;
-        auto const recordIter = m_resourceRecords.find( resourceID );
-        if ( recordIter == m_resourceRecords.end() )
+        auto const recordIter = shard.m_records.find( resourceID );
+        if ( recordIter == shard.m_records.end() )
         {
             pRecord = EE::New<ResourceRecord>( resourceID );
-            m_resourceRecords[resourceID] = pRecord;
+            shard.m_records[resourceID] = pRecord;
         }
         else
         {
@@ -153,29 +169,83 @@ namespace EE::Resource
         return pRecord;
     }
 
-    ResourceRecord* ResourceSystem::FindExistingResourceRecord( ResourceID const& resourceID )
+    ResourceRecord* ResourceSystem::FindExistingResourceRecord( RecordShard& shard, ResourceID const& resourceID )
     {
         EE_ASSERT( resourceID.IsValid() );
-        Threading::RecursiveScopeLock lock( m_accessLock );
 
-        auto const recordIter = m_resourceRecords.find( resourceID );
-        EE_ASSERT( recordIter != m_resourceRecords.end() );
+        auto const recordIter = shard.m_records.find( resourceID );
+        EE_ASSERT( recordIter != shard.m_records.end() );
         return recordIter->second;
     }
 
-    void ResourceSystem::LoadResource( ResourcePtr& resourcePtr, ResourceRequesterID const& requesterID )
+    ResourceRecord* ResourceSystem::TryFindResourceRecord( RecordShard const& shard, uint32_t resourcePathID ) const
     {
-        Threading::RecursiveScopeLock lock( m_accessLock );
+        auto const recordIter = shard.m_records.find_as( resourcePathID );
+        return ( recordIter != shard.m_records.end() ) ? recordIter->second : nullptr;
+    }
 
-        // Immediately update the resource ptr
-        auto pRecord = FindOrCreateResourceRecord( resourcePtr.GetResourceID() );
-        resourcePtr.m_pResourceRecord = pRecord;
+    void ResourceSystem::TryDestroyResourceRecord( ResourceID const& resourceID )
+    {
+        EE_ASSERT( Threading::IsMainThread() );
+
+        RecordShard& shard = GetRecordShard( resourceID.GetPathID() );
+        auto lock = LockRecordShard( shard );
+
+        auto recordIter = shard.m_records.find( resourceID );
+        EE_ASSERT( recordIter != shard.m_records.end() );
+
+        // The record can be re-requested at any time from other threads, so only remove it if no one is using it
+        ResourceRecord* pRecord = recordIter->second;
+        if ( pRecord->HasReferences() || pRecord->m_numQueuedRequests > 0 || pRecord->m_pendingRequestIdx != InvalidIndex || pRecord->m_pActiveRequest != nullptr )
+        {
+            return;
+        }
 
+        EE::Delete( pRecord );
+        shard.m_records.erase( recordIter );
+    }
+
+    void ResourceSystem::LoadResource( ResourcePtr& resourcePtr, ResourceRequesterID const& requesterID, Milliseconds deadline )
+    {
+        ResourceID const& resourceID = resourcePtr.GetResourceID();
+
+        // Get scheduling info, install dependencies are scheduled with the same priority/deadline as the resource that depends on them
         //-------------------------------------------------------------------------
 
+        RequestPriority priority = requesterID.GetPriority();
+        Nanoseconds absoluteDeadline = ( deadline > 0 ) ? PlatformClock::GetTime() + deadline.ToNanoseconds() : Nanoseconds( 0 );
+
+        if ( requesterID.IsInstallDependencyRequest() || requesterID.IsDependencyPrefetchRequest() )
+        {
+            uint32_t const dependentResourcePathID = requesterID.GetInstallDependencyResourcePathID();
+            RecordShard const& dependentShard = GetRecordShard( dependentResourcePathID );
+            auto lock = LockRecordShard( dependentShard );
+            if ( ResourceRecord const* pDependentRecord = TryFindResourceRecord( dependentShard, dependentResourcePathID ) )
+            {
+                priority = pDependentRecord->GetRequestPriority();
+                absoluteDeadline = pDependentRecord->GetRequestDeadline();
+            }
+        }
+
+        //-------------------------------------------------------------------------
+
+        RecordShard& shard = GetRecordShard( resourceID.GetPathID() );
+        auto lock = LockRecordShard( shard );
+
+        // Immediately update the resource ptr
+        auto pRecord = FindOrCreateResourceRecord( shard, resourceID );
+        resourcePtr.m_pResourceRecord = pRecord;
+
         if ( !pRecord->HasReferences() )
         {
-            AddPendingRequest( PendingRequest( PendingRequest::Type::Load, pRecord, requesterID ) );
+            pRecord->ResetRequestScheduling( priority, absoluteDeadline );
+            pRecord->m_numQueuedRequests++;
+            QueuePendingRequest( PendingRequest( PendingRequest::Type::Load, pRecord, requesterID ) );
+        }
+        else if ( !pRecord->IsLoaded() )
+        {
+            // Escalate the in-flight request, the active request picks this up when it is next scheduled
+            pRecord->EscalateRequestScheduling( priority, absoluteDeadline );
         }
 
         pRecord->AddReference( requesterID );
@@ -183,64 +253,395 @@ namespace EE::Resource
 
     void ResourceSystem::UnloadResource( ResourcePtr& resourcePtr, ResourceRequesterID const& requesterID )
     {
-        Threading::RecursiveScopeLock lock( m_accessLock );
+        RecordShard& shard = GetRecordShard( resourcePtr.GetResourceID().GetPathID() );
+        auto lock = LockRecordShard( shard );
 
         // Immediately update the resource ptr
         resourcePtr.m_pResourceRecord = nullptr;
 
         //-------------------------------------------------------------------------
 
-        auto pRecord = FindExistingResourceRecord( resourcePtr.GetResourceID() );
+        auto pRecord = FindExistingResourceRecord( shard, resourcePtr.GetResourceID() );
         pRecord->RemoveReference( requesterID );
 
         if ( !pRecord->HasReferences() )
         {
-            AddPendingRequest( PendingRequest( PendingRequest::Type::Unload, pRecord, requesterID ) );
+            pRecord->m_numQueuedRequests++;
+            QueuePendingRequest( PendingRequest( PendingRequest::Type::Unload, pRecord, requesterID ) );
+        }
+    }
+
+    //-------------------------------------------------------------------------
+
+    void ResourceSystem::PrefetchResources( ResourceID const& mapResourceID )
+    {
+        EE_PROFILE_FUNCTION_RESOURCE();
+        EE_ASSERT( Threading::IsMainThread() );
+        EE_ASSERT( mapResourceID.IsValid() );
+
+        // Dont prefetch while recording, otherwise we would just be recording the existing manifest
+        #if EE_DEVELOPMENT_TOOLS
+        if ( m_isLoadOrderRecordingEnabled )
+        {
+            return;
+        }
+        #endif
+
+        if ( m_prefetchedResources.find( mapResourceID ) != m_prefetchedResources.end() )
+        {
+            return;
+        }
+
+        TVector<ResourceID> manifestResourceIDs;
+        if ( !PrefetchManifest::ReadManifest( PrefetchManifest::GetManifestFilePath( GetSettings().m_compiledResourceDirectoryPath, mapResourceID ), manifestResourceIDs ) )
+        {
+            return;
+        }
+
+        // Requests are issued in manifest order which (for packaged builds) is also the order the resources are stored in the archives
+        auto& prefetchedResources = m_prefetchedResources[mapResourceID];
+        prefetchedResources.reserve( manifestResourceIDs.size() );
+        for ( auto const& resourceID : manifestResourceIDs )
+        {
+            // Manifests can be out of date, so skip any resources we can no longer load
+            if ( m_resourceLoaders.find( resourceID.GetResourceTypeID() ) == m_resourceLoaders.end() )
+            {
+                continue;
+            }
+
+            ResourcePtr& resourcePtr = prefetchedResources.emplace_back( resourceID );
+            LoadResource( resourcePtr, ResourceRequesterID::ManualRequest() );
+        }
+    }
+
+    void ResourceSystem::ReleasePrefetchedResources( ResourceID const& mapResourceID )
+    {
+        EE_ASSERT( Threading::IsMainThread() );
+
+        auto foundIter = m_prefetchedResources.find( mapResourceID );
+        if ( foundIter == m_prefetchedResources.end() )
+        {
+            return;
+        }
+
+        for ( auto& resourcePtr : foundIter->second )
+        {
+            UnloadResource( resourcePtr, ResourceRequesterID::ManualRequest() );
+        }
+
+        m_prefetchedResources.erase( foundIter );
+    }
+
+    //-------------------------------------------------------------------------
+
+    #if EE_DEVELOPMENT_TOOLS
+    void ResourceSystem::SetLoadOrderRecordingEnabled( bool isEnabled )
+    {
+        EE_ASSERT( Threading::IsMainThread() );
+        m_isLoadOrderRecordingEnabled = isEnabled;
+
+        if ( !m_isLoadOrderRecordingEnabled && m_loadOrderRecorder.IsRecording() )
+        {
+            m_loadOrderRecorder.Cancel();
+        }
+    }
+
+    void ResourceSystem::BeginLoadOrderRecording( ResourceID const& mapResourceID )
+    {
+        EE_ASSERT( Threading::IsMainThread() );
+
+        if ( !m_isLoadOrderRecordingEnabled || m_loadOrderRecorder.IsRecording() )
+        {
+            return;
+        }
+
+        m_loadOrderRecorder.Begin( mapResourceID );
+    }
+
+    void ResourceSystem::EndLoadOrderRecording( ResourceID const& mapResourceID, bool wasSuccessful )
+    {
+        EE_ASSERT( Threading::IsMainThread() );
+
+        if ( !m_loadOrderRecorder.IsRecording() || m_loadOrderRecorder.GetRecordedResourceID() != mapResourceID )
+        {
+            return;
+        }
+
+        if ( !wasSuccessful )
+        {
+            m_loadOrderRecorder.Cancel();
+            return;
+        }
+
+        int32_t const numRecordedResources = m_loadOrderRecorder.GetNumRecordedResources();
+        FileSystem::Path const manifestFilePath = PrefetchManifest::GetManifestFilePath( GetSettings().m_compiledResourceDirectoryPath, mapResourceID );
+        if ( m_loadOrderRecorder.End( manifestFilePath ) )
+        {
+            EE_LOG_INFO( "Resource", "Load Order Recording", "Saved prefetch manifest (%d resources): %s", numRecordedResources, manifestFilePath.c_str() );
+        }
+        else
+        {
+            EE_LOG_ERROR( "Resource", "Load Order Recording", "Failed to save prefetch manifest: %s", manifestFilePath.c_str() );
+        }
+    }
+    #endif
+
+    //-------------------------------------------------------------------------
+
+    void ResourceSystem::SetResidencyBudget( ResourceTypeID resourceTypeID, size_t budgetBytes )
+    {
+        EE_ASSERT( Threading::IsMainThread() );
+        m_residencyCache.SetBudget( resourceTypeID, budgetBytes );
+    }
+
+    bool ResourceSystem::TryKeepResident( ResourceRecord* pRecord )
+    {
+        EE_ASSERT( Threading::IsMainThread() );
+        EE_ASSERT( pRecord != nullptr && pRecord->m_pActiveRequest == nullptr );
+
+        // Already resident resources get re-added as the most recently used
+        if ( m_residencyCache.IsResident( pRecord ) )
+        {
+            m_residencyCache.Remove( pRecord );
+        }
+
+        if ( m_isShuttingDown || !pRecord->IsLoaded() || !m_residencyCache.IsCachedType( pRecord->GetResourceTypeID() ) )
+        {
+            return false;
+        }
+
+        #if EE_DEVELOPMENT_TOOLS
+        if ( VectorContains( m_externallyUpdatedResources, pRecord->GetResourceID() ) )
+        {
+            return false;
+        }
+        #endif
+
+        auto lock = LockRecordShard( GetRecordShard( pRecord->GetResourceID().GetPathID() ) );
+        if ( pRecord->HasReferences() || pRecord->m_numQueuedRequests > 0 )
+        {
+            return false;
         }
+
+        return m_residencyCache.TryAdd( pRecord );
     }
 
-    void ResourceSystem::AddPendingRequest( PendingRequest&& request )
+    void ResourceSystem::UnloadResidentResource( ResourceRecord* pRecord )
     {
-        Threading::RecursiveScopeLock lock( m_accessLock );
+        EE_ASSERT( Threading::IsMainThread() && !m_isAsyncTaskRunning );
+        EE_ASSERT( pRecord != nullptr && !m_residencyCache.IsResident( pRecord ) );
+
+        auto lock = LockRecordShard( GetRecordShard( pRecord->GetResourceID().GetPathID() ) );
+
+        // If this resource has been requested again, then it is no longer our responsibility
+        if ( pRecord->HasReferences() || pRecord->m_numQueuedRequests > 0 || pRecord->m_pendingRequestIdx != InvalidIndex )
+        {
+            return;
+        }
+
+        EE_ASSERT( pRecord->IsLoaded() && pRecord->m_pActiveRequest == nullptr );
+        auto loaderIter = m_resourceLoaders.find( pRecord->GetResourceTypeID() );
+        EE_ASSERT( loaderIter != m_resourceLoaders.end() );
+        pRecord->m_pActiveRequest = m_activeRequests.emplace_back( EE::New<ResourceRequest>( ResourceRequesterID(), ResourceRequest::Type::Unload, pRecord, loaderIter->second ) );
+    }
+
+    void ResourceSystem::EvictResidentResources()
+    {
+        EE_PROFILE_FUNCTION_RESOURCE();
 
-        // Try find a pending request for this resource ID
-        auto predicate = [] ( PendingRequest const& request, ResourceID const& resourceID ) { return request.m_pRecord->GetResourceID() == resourceID; };
-        int32_t const foundIdx = VectorFindIndex( m_pendingRequests, request.m_pRecord->GetResourceID(), predicate );
+        TVector<ResourceRecord*> recordsToEvict;
+        m_residencyCache.GetResourcesToEvict( recordsToEvict );
 
-        // If we dont have a request for this resource ID create one
-        if ( foundIdx == InvalidIndex )
+        // Never keep stale resources around
+        #if EE_DEVELOPMENT_TOOLS
+        for ( auto const& resourceID : m_externallyUpdatedResources )
         {
-            m_pendingRequests.emplace_back( eastl::move( request ) );
+            RecordShard const& shard = GetRecordShard( resourceID.GetPathID() );
+            ResourceRecord* pRecord = nullptr;
+            {
+                auto lock = LockRecordShard( shard );
+                pRecord = TryFindResourceRecord( shard, resourceID.GetPathID() );
+            }
+
+            if ( pRecord != nullptr && m_residencyCache.IsResident( pRecord ) )
+            {
+                m_residencyCache.Remove( pRecord );
+                recordsToEvict.emplace_back( pRecord );
+            }
         }
-        else // Overwrite exiting request - we deal with whether we have to register a task or not in the update
+        #endif
+
+        for ( auto pRecord : recordsToEvict )
+        {
+            UnloadResidentResource( pRecord );
+        }
+    }
+
+    void ResourceSystem::ClearResidencyCache()
+    {
+        TVector<ResourceRecord*> residentRecords;
+        m_residencyCache.GetAllResources( residentRecords );
+        for ( auto pRecord : residentRecords )
         {
-            m_pendingRequests[foundIdx] = request;
+            UnloadResidentResource( pRecord );
         }
     }
 
-    ResourceRequest* ResourceSystem::TryFindActiveRequest( ResourceRecord const* pResourceRecord ) const
+    //-------------------------------------------------------------------------
+
+    void ResourceSystem::QueuePendingRequest( PendingRequest&& request )
     {
-        EE_ASSERT( pResourceRecord != nullptr );
+        m_queuedRequests.enqueue( eastl::move( request ) );
+    }
+
+    void ResourceSystem::GatherPendingRequests()
+    {
+        EE_PROFILE_FUNCTION_RESOURCE();
+        EE_ASSERT( Threading::IsMainThread() );
+
+        PendingRequest request;
+        while ( m_queuedRequests.try_dequeue( request ) )
+        {
+            ResourceRecord* pRecord = request.m_pRecord;
+
+            // The record is now protected from destruction by its pending request index
+            // The queue doesn't preserve the order of requests queued from different threads, so a load and unload of the same record can be dequeued in
+            // either order. Every transition to/from being referenced queues a request under the shard lock, so the record's current state is always correct
+            {
+                auto lock = LockRecordShard( GetRecordShard( pRecord->GetResourceID().GetPathID() ) );
+                EE_ASSERT( pRecord->m_numQueuedRequests > 0 );
+                pRecord->m_numQueuedRequests--;
+                request.m_type = pRecord->HasReferences() ? PendingRequest::Type::Load : PendingRequest::Type::Unload;
+            }
+
+            // If we dont have a request for this resource create one
+            if ( pRecord->m_pendingRequestIdx == InvalidIndex )
+            {
+                pRecord->m_pendingRequestIdx = (int32_t) m_pendingRequests.size();
+                m_pendingRequests.emplace_back( request );
+            }
+            else // Overwrite exiting request - we deal with whether we have to register a task or not in the update
+            {
+                m_pendingRequests[pRecord->m_pendingRequestIdx] = request;
+            }
+        }
+    }
+
+    //-------------------------------------------------------------------------
+
+    void ResourceSystem::ScheduleActiveRequests()
+    {
+        EE_PROFILE_FUNCTION_RESOURCE();
         EE_ASSERT( !m_isAsyncTaskRunning );
 
-        Threading::RecursiveScopeLock lock( m_accessLock );
-        auto predicate = [] ( ResourceRequest const* pRequest, ResourceRecord const* pResourceRecord ) { return pRequest->GetResourceRecord() == pResourceRecord; };
-        int32_t const foundIdx = VectorFindIndex( m_activeRequests, pResourceRecord, predicate );
+        // Propagate any escalations to the install dependencies we are still waiting on
+        //-------------------------------------------------------------------------
+
+        for ( auto pRequest : m_activeRequests )
+        {
+            if ( pRequest->GetPendingInstallDependencies().empty() )
+            {
+                continue;
+            }
+
+            ResourceRecord const* pRecord = pRequest->GetResourceRecord();
+            RequestPriority priority;
+            Nanoseconds deadline;
+            {
+                auto lock = LockRecordShard( GetRecordShard( pRecord->GetResourceID().GetPathID() ) );
+                priority = pRecord->GetRequestPriority();
+                deadline = pRecord->GetRequestDeadline();
+            }
+
+            for ( auto const& dependencyPtr : pRequest->GetPendingInstallDependencies() )
+            {
+                if ( dependencyPtr.m_pResourceRecord != nullptr && !dependencyPtr.m_pResourceRecord->IsLoaded() )
+                {
+                    auto lock = LockRecordShard( GetRecordShard( dependencyPtr.GetResourceID().GetPathID() ) );
+                    dependencyPtr.m_pResourceRecord->EscalateRequestScheduling( priority, deadline );
+                }
+            }
+        }
+
+        // Sort by priority, then by deadline and then by request time
+        //-------------------------------------------------------------------------
+        // The scheduling state can be escalated from other threads at any time, so we sort a snapshot of it taken under the record locks
+
+        Nanoseconds const currentTime = PlatformClock::GetTime();
+
+        m_requestSortKeys.clear();
+        m_requestSortKeys.reserve( m_activeRequests.size() );
+        for ( auto pRequest : m_activeRequests )
+        {
+            ResourceRecord const* pRecord = pRequest->GetResourceRecord();
+            auto lock = LockRecordShard( GetRecordShard( pRecord->GetResourceID().GetPathID() ) );
+
+            RequestSortKey& sortKey = m_requestSortKeys.emplace_back();
+            sortKey.m_pRequest = pRequest;
+            sortKey.m_priority = pRecord->GetEffectiveRequestPriority( currentTime );
+            sortKey.m_deadline = pRecord->HasRequestDeadline() ? pRecord->GetRequestDeadline().ToU64() : UINT64_MAX; // Requests without a deadline go after any requests with one
+            sortKey.m_requestTime = pRecord->GetRequestTime().ToU64();
+        }
+
+        auto comparator = [] ( RequestSortKey const& keyA, RequestSortKey const& keyB )
+        {
+            if ( keyA.m_priority != keyB.m_priority )
+            {
+                return keyA.m_priority > keyB.m_priority;
+            }
+
+            if ( keyA.m_deadline != keyB.m_deadline )
+            {
+                return keyA.m_deadline < keyB.m_deadline;
+            }
+
+            return keyA.m_requestTime < keyB.m_requestTime;
+        };
 
-        if ( foundIdx != InvalidIndex )
+        eastl::sort( m_requestSortKeys.begin(), m_requestSortKeys.end(), comparator );
+
+        for ( size_t i = 0; i < m_requestSortKeys.size(); i++ )
         {
-            return m_activeRequests[foundIdx];
+            m_activeRequests[i] = m_requestSortKeys[i].m_pRequest;
         }
 
-        return nullptr;
+        // Select requests to update
+        //-------------------------------------------------------------------------
+        // IO slots are handed out in priority order, requests that dont get a slot will be retried on the next update
+
+        m_scheduledRequests.clear();
+
+        int32_t numAvailableIOSlots = s_maxInFlightIORequests - m_numInFlightIORequests;
+        for ( auto pRequest : m_activeRequests )
+        {
+            if ( !pRequest->IsActive() )
+            {
+                continue;
+            }
+
+            if ( pRequest->IsPerformingIO() )
+            {
+                if ( numAvailableIOSlots <= 0 )
+                {
+                    continue;
+                }
+
+                numAvailableIOSlots--;
+                m_numInFlightIORequests++;
+            }
+
+            m_scheduledRequests.emplace_back( pRequest );
+        }
     }
 
     //-------------------------------------------------------------------------
 
     void ResourceSystem::UpdateResourceProvider()
     {
-        Threading::RecursiveScopeLock lock( m_accessLock );
-        m_pResourceProvider->Update();
+        {
+            Threading::ScopeLock providerLock( m_providerLock );
+            m_pResourceProvider->Update();
+        }
 
         //-------------------------------------------------------------------------
 
@@ -249,6 +650,8 @@ namespace EE::Resource
         {
             RequestResourceHotReload( updatedResourceID );
         }
+
+        ResolveHotReloadRequests();
         #endif
     }
 
@@ -284,16 +687,78 @@ namespace EE::Resource
         //-------------------------------------------------------------------------
 
         {
-            Threading::RecursiveScopeLock lock( m_accessLock );
+            // Gather completed requests, we need to process and remove completed requests at this stage since unload tasks may have queued unload requests which refer to the request's allocated memory
+            for ( int32_t i = (int32_t) m_activeRequests.size() - 1; i >= 0; i-- )
+            {
+                if ( m_activeRequests[i]->IsComplete() )
+                {
+                    EE_ASSERT( m_activeRequests[i]->GetResourceRecord()->m_pActiveRequest == m_activeRequests[i] );
+                    m_activeRequests[i]->GetResourceRecord()->m_pActiveRequest = nullptr;
+                    m_completedRequests.emplace_back( m_activeRequests[i] );
+                    m_activeRequests.erase_unsorted( m_activeRequests.begin() + i );
+                }
+            }
+
+            GatherPendingRequests();
+
+            // Process completed requests
+            //-------------------------------------------------------------------------
+            // This needs to happen before we process the pending requests since pending requests can destroy records
+
+            for ( auto pCompletedRequest : m_completedRequests )
+            {
+                ResourceID const resourceID = pCompletedRequest->GetResourceID();
+                EE_ASSERT( pCompletedRequest->IsComplete() );
+
+                #if EE_DEVELOPMENT_TOOLS
+                m_history.emplace_back( CompletedRequestLog( pCompletedRequest->IsLoadRequest() ? PendingRequest::Type::Load : PendingRequest::Type::Unload, resourceID ) );
+
+                if ( m_loadOrderRecorder.IsRecording() && pCompletedRequest->IsLoadRequest() )
+                {
+                    m_loadOrderRecorder.OnResourceLoaded( resourceID, pCompletedRequest->GetResourceRecord()->GetResidentSize() );
+                }
+                #endif
+
+                bool const wasUnloadRequest = pCompletedRequest->IsUnloadRequest();
+
+                // Delete request
+                EE::Delete( pCompletedRequest );
+
+                // Check if we can remove the record, we may have had a load request for it in the meantime
+                if ( wasUnloadRequest )
+                {
+                    TryDestroyResourceRecord( resourceID );
+                }
+            }
+
+            m_completedRequests.clear();
+
+            // Process pending requests
+            //-------------------------------------------------------------------------
 
             for ( auto& pendingRequest : m_pendingRequests )
             {
+                ResourceRecord* pRecord = pendingRequest.m_pRecord;
+                EE_ASSERT( pRecord->m_pendingRequestIdx != InvalidIndex );
+                pRecord->m_pendingRequestIdx = InvalidIndex;
+
                 // Get existing active request
-                auto pActiveRequest = TryFindActiveRequest( pendingRequest.m_pRecord );
+                ResourceRequest* pActiveRequest = pRecord->m_pActiveRequest;
 
                 // Load request
                 if ( pendingRequest.m_type == PendingRequest::Type::Load )
                 {
+                    #if EE_DEVELOPMENT_TOOLS
+                    if ( m_loadOrderRecorder.IsRecording() )
+                    {
+                        m_loadOrderRecorder.OnResourceRequested( pRecord->GetResourceID(), pendingRequest.m_requesterID );
+                        if ( pRecord->IsLoaded() )
+                        {
+                            m_loadOrderRecorder.OnResourceLoaded( pRecord->GetResourceID(), pRecord->GetResidentSize() );
+                        }
+                    }
+                    #endif
+
                     if ( pActiveRequest != nullptr )
                     {
                         if ( pActiveRequest->IsUnloadRequest() )
@@ -301,15 +766,20 @@ namespace EE::Resource
                             pActiveRequest->SwitchToLoadTask();
                         }
                     }
-                    else if ( pendingRequest.m_pRecord->IsLoaded() ) // Can occur due to multiple requests for the same resource in the same frame
+                    else if ( pRecord->IsLoaded() ) // Can occur due to multiple requests for the same resource in the same frame or if the resource was resident
                     {
-                        // Do Nothing
+                        if ( m_residencyCache.IsResident( pRecord ) )
+                        {
+                            m_residencyCache.OnHit( pRecord );
+                        }
                     }
                     else // Create new request
                     {
-                        auto loaderIter = m_resourceLoaders.find( pendingRequest.m_pRecord->GetResourceTypeID() );
+                        m_residencyCache.OnMiss( pRecord->GetResourceTypeID() );
+
+                        auto loaderIter = m_resourceLoaders.find( pRecord->GetResourceTypeID() );
                         EE_ASSERT( loaderIter != m_resourceLoaders.end() );
-                        m_activeRequests.emplace_back( EE::New<ResourceRequest>( pendingRequest.m_requesterID, ResourceRequest::Type::Load, pendingRequest.m_pRecord, loaderIter->second ) );
+                        pRecord->m_pActiveRequest = m_activeRequests.emplace_back( EE::New<ResourceRequest>( pendingRequest.m_requesterID, ResourceRequest::Type::Load, pRecord, loaderIter->second ) );
                     }
                 }
                 else // Unload request
@@ -321,67 +791,37 @@ namespace EE::Resource
                             pActiveRequest->SwitchToUnloadTask();
                         }
                     }
-                    else if ( pendingRequest.m_pRecord->IsUnloaded() ) // Can occur due to multiple requests for the same resource in the same frame
+                    else if ( pRecord->IsUnloaded() ) // Can occur due to multiple requests for the same resource in the same frame
                     {
-                        if ( !pendingRequest.m_pRecord->HasReferences() )
-                        {
-                            auto recordIter = m_resourceRecords.find( pendingRequest.m_pRecord->m_resourceID );
-                            EE_ASSERT( recordIter != m_resourceRecords.end() );
-                            EE_ASSERT( recordIter->second == pendingRequest.m_pRecord );
-
-                            EE::Delete( pendingRequest.m_pRecord );
-                            m_resourceRecords.erase( recordIter );
-                        }
+                        TryDestroyResourceRecord( pRecord->GetResourceID() );
+                    }
+                    else if ( TryKeepResident( pRecord ) )
+                    {
+                        // Do Nothing
                     }
                     else // Create new request
                     {
-                        auto loaderIter = m_resourceLoaders.find( pendingRequest.m_pRecord->GetResourceTypeID() );
+                        auto loaderIter = m_resourceLoaders.find( pRecord->GetResourceTypeID() );
                         EE_ASSERT( loaderIter != m_resourceLoaders.end() );
-                        m_activeRequests.emplace_back( EE::New<ResourceRequest>( pendingRequest.m_requesterID, ResourceRequest::Type::Unload, pendingRequest.m_pRecord, loaderIter->second ) );
+                        pRecord->m_pActiveRequest = m_activeRequests.emplace_back( EE::New<ResourceRequest>( pendingRequest.m_requesterID, ResourceRequest::Type::Unload, pRecord, loaderIter->second ) );
                     }
                 }
             }
 
             m_pendingRequests.clear();
 
-            // Process completed requests
-            //-------------------------------------------------------------------------
-
-            for ( auto pCompletedRequest : m_completedRequests )
-            {
-                ResourceID const resourceID = pCompletedRequest->GetResourceID();
-                EE_ASSERT( pCompletedRequest->IsComplete() );
-
-                #if EE_DEVELOPMENT_TOOLS
-                m_history.emplace_back( CompletedRequestLog( pCompletedRequest->IsLoadRequest() ? PendingRequest::Type::Load : PendingRequest::Type::Unload, resourceID ) );
-                #endif
-
-                if ( pCompletedRequest->IsUnloadRequest() )
-                {
-                    // Check if we can remove the record, we may have had a load request for it in the meantime
-                    if ( !pCompletedRequest->GetResourceRecord()->HasReferences() )
-                    {
-                        auto recordIter = m_resourceRecords.find( resourceID );
-                        EE_ASSERT( recordIter != m_resourceRecords.end() );
-                        EE_ASSERT( recordIter->second == pCompletedRequest->GetResourceRecord() );
-
-                        EE::Delete( recordIter->second );
-                        m_resourceRecords.erase( recordIter );
-                    }
-                }
-
-                // Delete request
-                EE::Delete( pCompletedRequest );
-            }
-
-            m_completedRequests.clear();
+            EvictResidentResources();
         }
 
         // Kick off new async task
         //-------------------------------------------------------------------------
 
-        if ( !m_activeRequests.empty() )
+        ScheduleActiveRequests();
+
+        if ( !m_scheduledRequests.empty() )
         {
+            // Each scheduled request is updated independently so we can go wide
+            m_asyncProcessingTask.m_SetSize = (uint32_t) m_scheduledRequests.size();
             m_taskSystem.ScheduleTask( &m_asyncProcessingTask );
             m_isAsyncTaskRunning = true;
         }
@@ -395,44 +835,87 @@ namespace EE::Resource
         }
     }
 
-    void ResourceSystem::ProcessResourceRequests()
+    void ResourceSystem::ProcessResourceRequests( TaskSetPartition const& range )
     {
         EE_PROFILE_FUNCTION_RESOURCE();
 
-        //-------------------------------------------------------------------------
+        bool const serializeProviderAccess = !m_pResourceProvider->SupportsConcurrentRequests();
 
-        // We dont have to worry about this loop even if the m_activeRequests array is modified from another thread since we only access the array in 2 places and both use locks
-        for ( int32_t i = (int32_t) m_activeRequests.size() - 1; i >= 0; i-- )
+        ResourceRequest::RequestContext context;
+        context.m_createRawRequestRequestFunction = [this, serializeProviderAccess] ( ResourceRequest* pRequest )
         {
-            ResourceRequest::RequestContext context;
-            context.m_createRawRequestRequestFunction = [this] ( ResourceRequest* pRequest ) { m_pResourceProvider->RequestRawResource( pRequest ); };
-            context.m_cancelRawRequestRequestFunction = [this] ( ResourceRequest* pRequest ) { m_pResourceProvider->CancelRequest( pRequest ); };
-            context.m_loadResourceFunction = [this] ( ResourceRequesterID const& requesterID, ResourcePtr& resourcePtr ) { LoadResource( resourcePtr, requesterID ); };
-            context.m_unloadResourceFunction = [this] ( ResourceRequesterID const& requesterID, ResourcePtr& resourcePtr ) { UnloadResource( resourcePtr, requesterID ); };
-
-            //-------------------------------------------------------------------------
-
-            bool isRequestComplete = false;
+            if ( serializeProviderAccess )
+            {
+                Threading::ScopeLock providerLock( m_providerLock );
+                m_pResourceProvider->RequestRawResource( pRequest );
+            }
+            else
+            {
+                m_pResourceProvider->RequestRawResource( pRequest );
+            }
+        };
 
-            ResourceRequest* pRequest = m_activeRequests[i];
-            if ( pRequest->IsActive() )
+        context.m_cancelRawRequestRequestFunction = [this, serializeProviderAccess] ( ResourceRequest* pRequest )
+        {
+            if ( serializeProviderAccess )
             {
-                isRequestComplete = pRequest->Update( context );
+                Threading::ScopeLock providerLock( m_providerLock );
+                m_pResourceProvider->CancelRequest( pRequest );
             }
             else
             {
-                isRequestComplete = true;
+                m_pResourceProvider->CancelRequest( pRequest );
             }
+        };
 
-            //-------------------------------------------------------------------------
+        context.m_loadResourceFunction = [this] ( ResourceRequesterID const& requesterID, ResourcePtr& resourcePtr ) { LoadResource( resourcePtr, requesterID ); };
+        context.m_unloadResourceFunction = [this] ( ResourceRequesterID const& requesterID, ResourcePtr& resourcePtr ) { UnloadResource( resourcePtr, requesterID ); };
+
+        // File reads are batched and submitted to the IO threads once we have updated the whole range
+        // The IO slot acquired by the request is only released once the read completes
+        TVector<FileSystem::AsyncFileReader::ReadRequest> batchedReads;
+        context.m_pReadBufferPool = &m_readBufferPool;
+        context.m_readFileFunction = [this, &batchedReads] ( FileSystem::AsyncFileReader::ReadRequest&& readRequest )
+        {
+            readRequest.m_completionFunction = [this, requestCompletionFunction = eastl::move( readRequest.m_completionFunction )] ( bool wasSuccessful, uint64_t numBytesRead )
+            {
+                requestCompletionFunction( wasSuccessful, numBytesRead );
+                m_numInFlightIORequests--;
+            };
 
-            if ( isRequestComplete )
+            batchedReads.emplace_back( eastl::move( readRequest ) );
+        };
+
+        //-------------------------------------------------------------------------
+
+        // The scheduled request list is only modified on the main thread while this task is not running, so each request is only ever accessed by a single worker
+        // Completed requests are removed in the next update
+        for ( uint32_t i = range.start; i < range.end; i++ )
+        {
+            ResourceRequest* pRequest = m_scheduledRequests[i];
+            if ( !pRequest->IsActive() )
             {
-                // We need to process and remove completed requests at the next update stage since unload task may have queued unload requests which refer to the request's allocated memory
-                m_completedRequests.emplace_back( pRequest );
-                m_activeRequests.erase_unsorted( m_activeRequests.begin() + i );
+                continue;
+            }
+
+            // Requests performing IO have already been given an IO slot when they were scheduled
+            if ( pRequest->IsPerformingIO() )
+            {
+                pRequest->Update( context );
+
+                // Async reads hold onto their IO slot until they complete
+                if ( !pRequest->IsWaitingForRawResourceRead() )
+                {
+                    m_numInFlightIORequests--;
+                }
+            }
+            else
+            {
+                pRequest->Update( context );
             }
         }
+
+        m_fileReader.Submit( batchedReads );
     }
 
     //-------------------------------------------------------------------------
@@ -440,34 +923,125 @@ namespace EE::Resource
     #if EE_DEVELOPMENT_TOOLS
     void ResourceSystem::RequestResourceHotReload( ResourceID const& resourceID )
     {
-        Threading::RecursiveScopeLock lock( m_accessLock );
+        EE_ASSERT( Threading::IsMainThread() );
+        VectorEmplaceBackUnique( m_hotReloadRequests, resourceID );
+    }
 
-        // If the resource is not currently in use then just early-out
-        auto const recordIter = m_resourceRecords.find( resourceID );
-        if ( recordIter == m_resourceRecords.end() )
+    void ResourceSystem::ResolveHotReloadRequests()
+    {
+        EE_PROFILE_FUNCTION_RESOURCE();
+        EE_ASSERT( Threading::IsMainThread() );
+
+        if ( m_hotReloadRequests.empty() )
         {
             return;
         }
 
-        // Generate a list of users for this resource
-        ResourceRecord* pRecord = recordIter->second;
-        GetUsersForResource( pRecord, m_usersThatRequireReload );
+        // Each affected resource is only visited once, no matter how many paths there are to it in the dependency graph
+        //-------------------------------------------------------------------------
+
+        struct AffectedResource
+        {
+            ResourceID                                          m_resourceID;
+            TInlineVector<uint32_t, 4>                          m_dependentPathIDs;
+            int32_t                                             m_nextDependentIdx = 0;
+        };
 
-        // Get the list of dependent resources that we also need to reload
-        TInlineVector<ResourceID, 20> dependentResources;
-        GetDependentResourcesForResource( pRecord, dependentResources );
-        for ( auto const& dependentResourceID : dependentResources )
+        TVector<AffectedResource> affectedResources;
+        THashMap<uint32_t, int32_t> affectedResourceIndices;
+        TVector<ResourceRequesterID> users;
+
+        // Returns the index of the newly visited resource, or InvalidIndex if it was already visited (or is not currently in use)
+        auto VisitResource = [&] ( uint32_t resourcePathID ) -> int32_t
         {
-            RequestResourceHotReload( dependentResourceID );
+            if ( affectedResourceIndices.find( resourcePathID ) != affectedResourceIndices.end() )
+            {
+                return InvalidIndex;
+            }
+
+            RecordShard const& shard = GetRecordShard( resourcePathID );
+            auto lock = LockRecordShard( shard );
+
+            ResourceRecord const* pRecord = TryFindResourceRecord( shard, resourcePathID );
+            if ( pRecord == nullptr )
+            {
+                return InvalidIndex;
+            }
+
+            int32_t const affectedResourceIdx = (int32_t) affectedResources.size();
+            affectedResourceIndices.insert( TPair<uint32_t, int32_t>( resourcePathID, affectedResourceIdx ) );
+
+            AffectedResource& affectedResource = affectedResources.emplace_back();
+            affectedResource.m_resourceID = pRecord->GetResourceID();
+            affectedResource.m_dependentPathIDs = pRecord->GetInstallDependents();
+
+            // Internal users (install dependencies) are covered by the dependents, dependency prefetches are released once the
+            // prefetching resource is installed (or reloaded via its direct dependencies), manual requests are never reloaded
+            for ( auto const& requesterID : pRecord->m_references )
+            {
+                if ( !requesterID.IsInstallDependencyRequest() && !requesterID.IsDependencyPrefetchRequest() && !requesterID.IsManualRequest() )
+                {
+                    users.emplace_back( requesterID );
+                }
+            }
+
+            return affectedResourceIdx;
+        };
+
+        // Depth-first walk of the dependents, the reversed post-order lists each resource before any of its dependents
+        //-------------------------------------------------------------------------
+
+        TVector<int32_t> postOrder;
+        TVector<int32_t> stack;
+
+        for ( auto const& resourceID : m_hotReloadRequests )
+        {
+            int32_t const rootIdx = VisitResource( resourceID.GetPathID() );
+            if ( rootIdx == InvalidIndex )
+            {
+                continue;
+            }
+
+            stack.emplace_back( rootIdx );
+            while ( !stack.empty() )
+            {
+                AffectedResource& affectedResource = affectedResources[stack.back()];
+                if ( affectedResource.m_nextDependentIdx < (int32_t) affectedResource.m_dependentPathIDs.size() )
+                {
+                    // Visiting can grow the affected resource list so dont use the reference after this
+                    uint32_t const dependentPathID = affectedResource.m_dependentPathIDs[affectedResource.m_nextDependentIdx++];
+                    int32_t const dependentIdx = VisitResource( dependentPathID );
+                    if ( dependentIdx != InvalidIndex )
+                    {
+                        stack.emplace_back( dependentIdx );
+                    }
+                }
+                else
+                {
+                    postOrder.emplace_back( stack.back() );
+                    stack.pop_back();
+                }
+            }
+        }
+
+        m_hotReloadRequests.clear();
+
+        //-------------------------------------------------------------------------
+
+        for ( auto iter = postOrder.rbegin(); iter != postOrder.rend(); ++iter )
+        {
+            VectorEmplaceBackUnique( m_externallyUpdatedResources, affectedResources[*iter].m_resourceID );
         }
 
-        // Add to list of resources to be reloaded
-        VectorEmplaceBackUnique( m_externallyUpdatedResources, resourceID );
+        // Entities commonly reference the same resource many times, so remove duplicates in one go
+        m_usersThatRequireReload.insert( m_usersThatRequireReload.end(), users.begin(), users.end() );
+        eastl::sort( m_usersThatRequireReload.begin(), m_usersThatRequireReload.end(), [] ( ResourceRequesterID const& a, ResourceRequesterID const& b ) { return a.GetID() < b.GetID(); } );
+        m_usersThatRequireReload.erase( eastl::unique( m_usersThatRequireReload.begin(), m_usersThatRequireReload.end() ), m_usersThatRequireReload.end() );
     }
 
     void ResourceSystem::ClearHotReloadRequests()
     {
-        Threading::RecursiveScopeLock lock( m_accessLock );
+        EE_ASSERT( Threading::IsMainThread() );
         m_usersThatRequireReload.clear(); 
         m_externallyUpdatedResources.clear();
     }
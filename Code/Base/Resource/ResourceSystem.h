@@ -2,8 +2,12 @@
 
 #include "Base/_Module/API.h"
 #include "ResourcePtr.h"
+#include "ResourceResidencyCache.h"
+#include "ResourcePrefetchManifest.h"
 #include "Base/Threading/Threading.h"
 #include "Base/Threading/TaskSystem.h"
+#include "Base/FileSystem/AsyncFileReader.h"
+#include "Base/FileSystem/ReadBufferPool.h"
 #include "Base/Systems.h"
 #include "Base/Types/Event.h"
 #include "Base/Time/TimeStamp.h"
@@ -49,6 +53,27 @@ namespace EE::Resource
             Type                    m_type = Type::Load;
         };
 
+        // A snapshot of a request's scheduling state, used to sort the active requests
+        struct RequestSortKey
+        {
+            ResourceRequest*        m_pRequest = nullptr;
+            uint64_t                m_deadline = 0;
+            uint64_t                m_requestTime = 0;
+            RequestPriority         m_priority = RequestPriority::Normal;
+        };
+
+        // The record map is sharded by resource path ID so that concurrent loads/unloads of different resources rarely contend
+        constexpr static uint32_t const s_numRecordShards = 32;
+
+        struct alignas( 64 ) RecordShard
+        {
+            THashMap<ResourceID, ResourceRecord*>               m_records;
+            mutable Threading::Mutex                            m_mutex;
+            mutable std::atomic<uint64_t>                       m_numLocks = 0;
+            mutable std::atomic<uint64_t>                       m_numContendedLocks = 0;
+            mutable std::atomic<uint64_t>                       m_contendedWaitTime = 0; // Nanoseconds
+        };
+
         #if EE_DEVELOPMENT_TOOLS
         struct CompletedRequestLog
         {
@@ -64,6 +89,21 @@ namespace EE::Resource
 
         EE_SYSTEM( ResourceSystem );
 
+        struct LockContentionStats
+        {
+            uint64_t                                            m_numLocks = 0;
+            uint64_t                                            m_numContendedLocks = 0;
+            Nanoseconds                                         m_contendedWaitTime = 0;
+        };
+
+    public:
+
+        // The max number of requests that are allowed to perform file IO at the same time
+        constexpr static int32_t const s_maxInFlightIORequests = 16;
+
+        // The max amount of memory the pooled read buffers are allowed to retain between loads
+        constexpr static size_t const s_maxRetainedReadBufferBytes = 256 * 1024 * 1024;
+
     public:
 
         ResourceSystem( TaskSystem& taskSystem );
@@ -83,6 +123,20 @@ namespace EE::Resource
         // Blocking wait for all requests to be completed
         void WaitForAllRequestsToComplete();
 
+        // Get the accumulated contention stats for the resource record locks
+        LockContentionStats GetLockContentionStats() const;
+
+        // Residency Cache
+        //-------------------------------------------------------------------------
+        // Unreferenced resources of types with a budget are kept loaded (up to the budget) in case they get requested again
+
+        // Set the max resident size of unreferenced resources for a given type, zero disables caching for the type
+        // The initial budgets are read from the resource settings ("Resource:ResidencyBudgets")
+        void SetResidencyBudget( ResourceTypeID resourceTypeID, size_t budgetBytes );
+
+        // Get the per-type residency budget usage and hit rates
+        inline void GetResidencyStats( TVector<ResourceResidencyCache::TypeStats>& outStats ) const { m_residencyCache.GetStats( outStats ); }
+
         // Resource Loaders
         //-------------------------------------------------------------------------
 
@@ -93,20 +147,50 @@ namespace EE::Resource
         //-------------------------------------------------------------------------
 
         // Request a load of a resource, can optionally provide a ResourceRequesterID for identification of the request source
-        void LoadResource( ResourcePtr& resourcePtr, ResourceRequesterID const& requesterID = ResourceRequesterID() );
+        // The request is scheduled with the requester's priority, and an optional deadline (time from now) can be set for resources needed by a specific time
+        // If the resource is already being loaded, its request will be escalated to the higher priority/earlier deadline
+        void LoadResource( ResourcePtr& resourcePtr, ResourceRequesterID const& requesterID = ResourceRequesterID(), Milliseconds deadline = 0 );
 
         // Request an unload of a resource, can optionally provide a ResourceRequesterID for identification of the request source
         void UnloadResource( ResourcePtr& resourcePtr, ResourceRequesterID const& requesterID = ResourceRequesterID() );
 
         template<typename T>
-        inline void LoadResource( TResourcePtr<T>& resourcePtr, ResourceRequesterID const& requesterID = ResourceRequesterID() ) { LoadResource( (ResourcePtr&) resourcePtr, requesterID ); }
+        inline void LoadResource( TResourcePtr<T>& resourcePtr, ResourceRequesterID const& requesterID = ResourceRequesterID(), Milliseconds deadline = 0 ) { LoadResource( (ResourcePtr&) resourcePtr, requesterID, deadline ); }
 
         template<typename T>
         inline void UnloadResource( TResourcePtr<T>& resourcePtr, ResourceRequesterID const& requesterID = ResourceRequesterID() ) { UnloadResource( (ResourcePtr&) resourcePtr, requesterID ); }
 
+        // Prefetching
+        //-------------------------------------------------------------------------
+        // Maps can have a recorded prefetch manifest, replaying it requests all the resources the map needs up-front instead of as they are discovered
+
+        // Request all the resources in the prefetch manifest for the specified map, does nothing if the map has no manifest
+        void PrefetchResources( ResourceID const& mapResourceID );
+
+        // Release the prefetch requests for a map, call this once the map has loaded (the map's own requests will keep the resources loaded)
+        void ReleasePrefetchedResources( ResourceID const& mapResourceID );
+
+        // Load Order Recording
+        //-------------------------------------------------------------------------
+        // When enabled, all resource loads during a map load are recorded and saved as that map's prefetch manifest
+
+        #if EE_DEVELOPMENT_TOOLS
+        inline bool IsLoadOrderRecordingEnabled() const { return m_isLoadOrderRecordingEnabled; }
+        void SetLoadOrderRecordingEnabled( bool isEnabled );
+
+        // Start recording the loads for the specified map, only a single map is recorded at a time
+        void BeginLoadOrderRecording( ResourceID const& mapResourceID );
+
+        // Stop recording the loads for the specified map, the manifest is only saved if the map loaded successfully
+        void EndLoadOrderRecording( ResourceID const& mapResourceID, bool wasSuccessful );
+        #endif
+
         // Hot Reload
         //-------------------------------------------------------------------------
 
+        // Hot-reload requests are batched and resolved during the next update, the resources to reload are ordered so that every resource comes before its dependents
+        // All the users of the batch are unloaded once, the updated resources are then reloaded in parallel and the dependents are reinstalled in dependency order
+
         #if EE_DEVELOPMENT_TOOLS
         void RequestResourceHotReload( ResourceID const& resourceID );
         inline bool RequiresHotReloading() const { return !m_externallyUpdatedResources.empty(); }
@@ -125,42 +209,79 @@ namespace EE::Resource
         ResourceSystem& operator=( const ResourceSystem& ) = delete;
         ResourceSystem& operator=( const ResourceSystem&& ) = delete;
 
-        ResourceRecord* FindOrCreateResourceRecord( ResourceID const& resourceID );
-        ResourceRecord* FindExistingResourceRecord( ResourceID const& resourceID );
+        // Record shards
+        inline RecordShard& GetRecordShard( uint32_t resourcePathID ) { return m_recordShards[resourcePathID % s_numRecordShards]; }
+        inline RecordShard const& GetRecordShard( uint32_t resourcePathID ) const { return m_recordShards[resourcePathID % s_numRecordShards]; }
+        Threading::Lock LockRecordShard( RecordShard const& shard ) const;
+
+        // The record shard lock needs to be held when calling these functions
+        ResourceRecord* FindOrCreateResourceRecord( RecordShard& shard, ResourceID const& resourceID );
+        ResourceRecord* FindExistingResourceRecord( RecordShard& shard, ResourceID const& resourceID );
+        ResourceRecord* TryFindResourceRecord( RecordShard const& shard, uint32_t resourcePathID ) const;
+
+        // Destroy an unused record, this will do nothing if the record is still referenced or has outstanding requests
+        void TryDestroyResourceRecord( ResourceID const& resourceID );
+
+        // Try to keep an unreferenced loaded resource resident instead of unloading it
+        bool TryKeepResident( ResourceRecord* pRecord );
+
+        // Create an unload request for an unreferenced resident resource, does nothing if the resource has been requested again in the meantime
+        void UnloadResidentResource( ResourceRecord* pRecord );
 
-        void AddPendingRequest( PendingRequest&& request );
-        ResourceRequest* TryFindActiveRequest( ResourceRecord const* pResourceRecord ) const;
+        // Unload any resident resources that are over budget (or stale due to a hot-reload)
+        void EvictResidentResources();
 
-        // Returns a list of all unique external references for the given resource
-        void GetUsersForResource( ResourceRecord const* pResourceRecord, TInlineVector<ResourceRequesterID, 20>& requesterIDs ) const;
+        // Unload all resident resources
+        void ClearResidencyCache();
 
-        // Returns a list of all unique external references for the given resource
-        void GetDependentResourcesForResource( ResourceRecord const* pResourceRecord, TInlineVector<ResourceID, 20>& dependentResources ) const;
+        // Pending requests are queued from any thread and then gathered (and collapsed per resource) on the main thread
+        void QueuePendingRequest( PendingRequest&& request );
+        void GatherPendingRequests();
+
+        // Order the active requests by priority/deadline and select the requests to update this frame
+        void ScheduleActiveRequests();
+
+        // Gather all the resources affected by the requested hot-reloads (using the reverse install dependency index) as well as all their unique external users
+        #if EE_DEVELOPMENT_TOOLS
+        void ResolveHotReloadRequests();
+        #endif
 
-        // Process all queued resource requests
-        void ProcessResourceRequests();
+        // Update a range of the active resource requests, this is run in parallel across multiple worker threads
+        void ProcessResourceRequests( TaskSetPartition const& range );
 
     private:
 
         TaskSystem&                                             m_taskSystem;
         ResourceProvider*                                       m_pResourceProvider = nullptr;
         THashMap<ResourceTypeID, ResourceLoader*>               m_resourceLoaders;
-        THashMap<ResourceID, ResourceRecord*>                   m_resourceRecords;
-        mutable Threading::RecursiveMutex                       m_accessLock;
+        RecordShard                                             m_recordShards[s_numRecordShards];
+        Threading::Mutex                                        m_providerLock; // Only used if the provider doesn't support concurrent requests
 
         // Requests
-        TVector<PendingRequest>                                 m_pendingRequests;
+        Threading::LockFreeQueue<PendingRequest>                m_queuedRequests;
+        TVector<PendingRequest>                                 m_pendingRequests; // Only accessed on the main thread
         TVector<ResourceRequest*>                               m_activeRequests;
         TVector<ResourceRequest*>                               m_completedRequests;
+        TVector<ResourceRequest*>                               m_scheduledRequests; // The prioritized active requests to update this frame
+        TVector<RequestSortKey>                                 m_requestSortKeys; // Only used when scheduling the active requests
+        ResourceResidencyCache                                  m_residencyCache;
+        bool                                                    m_isShuttingDown = false; // Nothing is kept resident once shutdown starts
+        THashMap<ResourceID, TVector<ResourcePtr>>              m_prefetchedResources; // Only accessed on the main thread
 
         // ASync
         AsyncTask                                               m_asyncProcessingTask;
         std::atomic<bool>                                       m_isAsyncTaskRunning = false;
+        std::atomic<int32_t>                                    m_numInFlightIORequests = 0;
+        FileSystem::AsyncFileReader                             m_fileReader;
+        FileSystem::ReadBufferPool                              m_readBufferPool;
 
         #if EE_DEVELOPMENT_TOOLS
+        TInlineVector<ResourceID, 20>                           m_hotReloadRequests; // The updated resources for this frame, resolved into the lists below in a single batch
         TInlineVector<ResourceRequesterID, 20>                  m_usersThatRequireReload;
-        TInlineVector<ResourceID, 20>                           m_externallyUpdatedResources;
+        TInlineVector<ResourceID, 20>                           m_externallyUpdatedResources; // In dependency order
         TVector<CompletedRequestLog>                            m_history;
+        ResourceLoadRecorder                                    m_loadOrderRecorder;
+        bool                                                    m_isLoadOrderRecordingEnabled = false;
         #endif
     };
 }
\ No newline at end of file
@@ -16,6 +16,7 @@ namespace EE::Resource
         //-------------------------------------------------------------------------
 
         m_compiledResourceDirectoryName = ini.GetStringOrDefault( "Resource:CompiledResourceDirectoryName", s_defaultCompiledResourceDirectoryName ); 
+        m_residencyBudgetsStr = ini.GetStringOrDefault( "Resource:ResidencyBudgets", s_defaultResidencyBudgets );
 
         #if EE_DEVELOPMENT_TOOLS
         {
@@ -31,7 +32,30 @@ namespace EE::Resource
 
         //-------------------------------------------------------------------------
 
-        return TryGeneratePaths();
+        return TryGeneratePaths() && TryParseResidencyBudgets();
+    }
+
+    bool ResourceGlobalSettings::TryParseResidencyBudgets()
+    {
+        m_residencyBudgets.clear();
+
+        TVector<String> budgets;
+        StringUtils::Split( m_residencyBudgetsStr, budgets, "," );
+        for ( auto const& budget : budgets )
+        {
+            TVector<String> tokens;
+            StringUtils::Split( budget, tokens, "= " );
+            if ( tokens.size() != 2 || !ResourceTypeID::IsValidResourceFourCC( tokens[0] ) )
+            {
+                EE_LOG_ERROR( "Resource", "Resource Settings", "Invalid residency budget: %s", budget.c_str() );
+                return false;
+            }
+
+            size_t const budgetMB = (size_t) std::strtoul( tokens[1].c_str(), nullptr, 10 );
+            m_residencyBudgets.emplace_back( ResourceTypeID( tokens[0] ), budgetMB * 1024 * 1024 );
+        }
+
+        return true;
     }
 
     bool ResourceGlobalSettings::TryGeneratePaths()
@@ -123,6 +147,7 @@ namespace EE::Resource
     {
         ini.CreateSection( "Resource" );
         ini.SetString( "Resource:CompiledResourceDirectoryName", m_compiledResourceDirectoryName );
+        ini.SetString( "Resource:ResidencyBudgets", m_residencyBudgetsStr );
 
         #if EE_DEVELOPMENT_TOOLS
         ini.SetString( "Resource:RawResourcePath", m_sourceDataDirectoryPathStr );
@@ -3,6 +3,7 @@
 #include "Base/_Module/API.h"
 #include "Base/Math/Math.h"
 #include "Base/FileSystem/FileSystemPath.h"
+#include "Base/Resource/ResourceTypeID.h"
 #include "Base/Settings/Settings.h"
 
 //-------------------------------------------------------------------------
@@ -33,6 +34,12 @@ namespace EE::Resource
         constexpr static char const * const s_defaultResourceServerAddress = "127.0.0.1";
         constexpr static uint16_t const s_defaultResourceServerPort = 5556;
 
+        // Residency Cache
+        //-------------------------------------------------------------------------
+        // Comma separated list of "fourCC=MB" pairs, the max size of unreferenced resources of each type that are kept loaded
+
+        constexpr static char const * const s_defaultResidencyBudgets = "txtr=64,msh=32,smsh=32,anim=16";
+
     public:
 
         ResourceGlobalSettings();
@@ -43,6 +50,7 @@ namespace EE::Resource
     private:
 
         bool TryGeneratePaths();
+        bool TryParseResidencyBudgets();
 
     public:
 
@@ -52,6 +60,7 @@ namespace EE::Resource
         //-------------------------------------------------------------------------
 
         String                  m_compiledResourceDirectoryName = s_defaultCompiledResourceDirectoryName;
+        String                  m_residencyBudgetsStr = s_defaultResidencyBudgets;
 
         #if EE_DEVELOPMENT_TOOLS
         String                  m_sourceDataDirectoryPathStr = s_defaultSourceDataPath;
@@ -67,6 +76,7 @@ namespace EE::Resource
         //-------------------------------------------------------------------------
 
         FileSystem::Path        m_compiledResourceDirectoryPath;
+        TVector<TPair<ResourceTypeID, size_t>> m_residencyBudgets; // In bytes
 
         #if EE_DEVELOPMENT_TOOLS
         FileSystem::Path        m_sourceDataDirectoryPath;
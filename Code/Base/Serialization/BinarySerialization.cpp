@@ -10,7 +10,7 @@ namespace EE::Serialization
 {
     int32_t GetBinarySerializationVersion()
     {
-        return 8;
+        return 9;
     }
 
     //-------------------------------------------------------------------------
@@ -161,6 +161,19 @@ namespace EE::Serialization
         mpack_done_bin( m_pReader );
     }
 
+    void BinaryReader::SkipAlignmentPadding()
+    {
+        size_t const paddingSize = mpack_expect_bin( m_pReader );
+        mpack_skip_bytes( m_pReader, paddingSize );
+        mpack_done_bin( m_pReader );
+    }
+
+    void BinaryReader::ReadAlignedBinaryData( void* pData, size_t size )
+    {
+        SkipAlignmentPadding();
+        ReadBinaryData( pData, size );
+    }
+
     //-------------------------------------------------------------------------
 
     static void MPackWriterError( mpack_writer_t* pWriter, mpack_error_t error )
@@ -293,6 +306,21 @@ namespace EE::Serialization
         mpack_write_bin( m_pWriter, (char*) pData, (uint32_t) size );
     }
 
+    void BinaryWriter::WriteAlignedBinaryData( void const* pData, size_t size, size_t alignment )
+    {
+        EE_ASSERT( pData != nullptr && size != 0 && size <= UINT32_MAX );
+        EE_ASSERT( alignment > 0 && alignment <= UINT8_MAX );
+
+        // The padding is written as a bin8 block so its header size is fixed, the data header size depends on the data size
+        size_t const dataHeaderSize = ( size <= UINT8_MAX ) ? MPACK_TAG_SIZE_BIN8 : ( size <= UINT16_MAX ) ? MPACK_TAG_SIZE_BIN16 : MPACK_TAG_SIZE_BIN32;
+        size_t const unpaddedDataOffset = mpack_writer_buffer_used( m_pWriter ) + MPACK_TAG_SIZE_BIN8 + dataHeaderSize;
+        size_t const paddingSize = ( alignment - ( unpaddedDataOffset % alignment ) ) % alignment;
+
+        char const padding[UINT8_MAX] = {};
+        mpack_write_bin( m_pWriter, padding, (uint32_t) paddingSize );
+        mpack_write_bin( m_pWriter, (char const*) pData, (uint32_t) size );
+    }
+
     //-------------------------------------------------------------------------
 
     BinaryInputArchive::~BinaryInputArchive()
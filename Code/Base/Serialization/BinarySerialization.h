@@ -63,6 +63,11 @@ namespace EE::Serialization
         void ReadValue( StringID& v);
 
         void ReadBinaryData( void* pData, size_t size );
+        void ReadAlignedBinaryData( void* pData, size_t size );
+
+    private:
+
+        void SkipAlignmentPadding();
 
     private:
 
@@ -109,6 +114,9 @@ namespace EE::Serialization
 
         void WriteBinaryData( void const* pData, size_t size );
 
+        // Writes a padding block before the data so that the data starts on the specified alignment (relative to the start of the written data)
+        void WriteAlignedBinaryData( void const* pData, size_t size, size_t alignment );
+
     private:
 
         mpack_writer_t*     m_pWriter = nullptr;
@@ -362,6 +370,27 @@ namespace EE::Serialization
                 return operator<<( const_cast<Blob&>( blob ) );
             }
 
+            // Serialize raw data
+            //-------------------------------------------------------------------------
+
+            // Serializes a block of binary data of a known size, the data will start on the specified alignment relative to the start of the archive
+            // When reading, the memory needs to be allocated by the caller
+            Archive& SerializeAlignedRawData( void* pData, size_t size, size_t alignment )
+            {
+                EE_ASSERT( pData != nullptr && size > 0 );
+
+                if constexpr ( std::is_same<Serializer, BinaryReader>::value )
+                {
+                    m_serializer.ReadAlignedBinaryData( pData, size );
+                }
+                else
+                {
+                    m_serializer.WriteAlignedBinaryData( pData, size, alignment );
+                }
+
+                return *this;
+            }
+
             // Fold expression to allow for the serialize macros to work
             //-------------------------------------------------------------------------
 
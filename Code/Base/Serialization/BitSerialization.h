@@ -27,6 +27,9 @@ namespace EE::Serialization
         inline bool IsReading() const { return m_isReading; }
         inline bool IsWriting() const { return !m_isReading; }
 
+        // Get the number of bits written/read so far
+        inline uint32_t GetNumProcessedBits() const { return m_bitPos; }
+
         // Write
         //-------------------------------------------------------------------------
 
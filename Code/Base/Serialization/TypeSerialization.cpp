@@ -33,7 +33,7 @@ namespace EE::Serialization
             va_end( args );
         };
 
-        auto ReadAndConvertPropertyValue = [&] ( TypeSystem::TypeRegistry const& typeRegistry, TypeSystem::TypeInfo const* pTypeInfo, pugi::xml_node propertyNode, TInlineVector<PropertyDescriptor, 6>& propertyDescs )
+        auto ReadAndConvertPropertyValue = [&] ( TypeSystem::TypeRegistry const& typeRegistry, TypeSystem::TypeInfo const* pTypeInfo, pugi::xml_node propertyNode, TypeDescriptor& typeDesc )
         {
             xml_attribute pathAttr = propertyNode.attribute( g_propertyPathAttrName );
             xml_attribute valueAttr = propertyNode.attribute( g_propertyValueAttrName );
@@ -63,7 +63,7 @@ namespace EE::Serialization
                 {
                     if ( TypeSystem::Conversion::ConvertStringToBinary( typeRegistry, GetCoreTypeID( CoreTypeID::Int32 ), TypeID(), propertyDesc.m_stringValue, propertyDesc.m_byteValue ) )
                     {
-                        propertyDescs.emplace_back( propertyDesc );
+                        typeDesc.AddPropertyValue( propertyDesc );
                     }
                     else
                     {
@@ -74,7 +74,7 @@ namespace EE::Serialization
                 {
                     if ( TypeSystem::Conversion::ConvertStringToBinary( typeRegistry, GetCoreTypeID( CoreTypeID::TypeID ), TypeID(), propertyDesc.m_stringValue, propertyDesc.m_byteValue ) )
                     {
-                        propertyDescs.emplace_back( propertyDesc );
+                        typeDesc.AddPropertyValue( propertyDesc );
                     }
                     else
                     {
@@ -88,7 +88,7 @@ namespace EE::Serialization
                         // If the value was successfully converted add it to the list of property descs
                         if ( TypeSystem::Conversion::ConvertStringToBinary( typeRegistry, *pPropertyInfo, propertyDesc.m_stringValue, propertyDesc.m_byteValue ) )
                         {
-                            propertyDescs.emplace_back( propertyDesc );
+                            typeDesc.AddPropertyValue( propertyDesc );
                         }
                         else
                         {
@@ -129,13 +129,13 @@ namespace EE::Serialization
         int32_t const numProperties = (int32_t) propertyNodes.size();
 
         // Reserve memory for all property and create an empty desc
-        outDesc.m_properties.reserve( numProperties );
+        outDesc.ReserveProperties( numProperties );
 
         // Read all properties
         for ( pugi::xml_node propertyNode : propertyNodes )
         {
             // Try to read the property value, some properties are allowed to gracefully fail while other are a fatal error
-            if ( !ReadAndConvertPropertyValue( typeRegistry, pTypeInfo, propertyNode, outDesc.m_properties ) )
+            if ( !ReadAndConvertPropertyValue( typeRegistry, pTypeInfo, propertyNode, outDesc ) )
             {
                 return false;
             }
@@ -153,7 +153,7 @@ namespace EE::Serialization
         xml_node typeNode = parentNode.append_child( g_typeNodeName );
         typeNode.append_attribute( g_typeIDAttrName ).set_value( typeDesc.m_typeID.c_str() );
 
-        for ( auto const& propertyDesc : typeDesc.m_properties )
+        for ( auto const& propertyDesc : typeDesc.GetProperties() )
         {
             xml_node propertyNode = typeNode.append_child( g_propertyNodeName );
             propertyNode.append_attribute( g_propertyPathAttrName ).set_value( propertyDesc.m_path.ToString().c_str() );
@@ -22,6 +22,7 @@ namespace EE
     using AsyncTask = enki::TaskSet;
     using TaskSetPartition = enki::TaskSetPartition;
     using TaskFunction = enki::TaskSetFunction;
+    using TaskDependency = enki::Dependency;
 
     //-------------------------------------------------------------------------
 
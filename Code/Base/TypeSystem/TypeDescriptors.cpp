@@ -2,6 +2,7 @@
 #include "TypeRegistry.h"
 #include "TypeInstance.h"
 #include "Base/Math/Math.h"
+#include "Base/Math/Matrix.h"
 #include "Base/Resource/ResourcePtr.h"
 
 //-------------------------------------------------------------------------
@@ -110,6 +111,118 @@ namespace EE::TypeSystem
         }
     }
 
+    // Compilation
+    //-------------------------------------------------------------------------
+
+    namespace
+    {
+        // Can this core type be safely set via a memcpy of its native value
+        static bool IsCoreTypeTriviallyCopyable( CoreTypeID coreType )
+        {
+            switch ( coreType )
+            {
+                case CoreTypeID::Bool:
+                case CoreTypeID::Uint8:
+                case CoreTypeID::Int8:
+                case CoreTypeID::Uint16:
+                case CoreTypeID::Int16:
+                case CoreTypeID::Uint32:
+                case CoreTypeID::Int32:
+                case CoreTypeID::Uint64:
+                case CoreTypeID::Int64:
+                case CoreTypeID::Float:
+                case CoreTypeID::Double:
+                case CoreTypeID::UUID:
+                case CoreTypeID::StringID:
+                case CoreTypeID::TypeID:
+                case CoreTypeID::Color:
+                case CoreTypeID::Float2:
+                case CoreTypeID::Float3:
+                case CoreTypeID::Float4:
+                case CoreTypeID::Vector:
+                case CoreTypeID::Quaternion:
+                case CoreTypeID::Matrix:
+                case CoreTypeID::Transform:
+                case CoreTypeID::Microseconds:
+                case CoreTypeID::Milliseconds:
+                case CoreTypeID::Seconds:
+                case CoreTypeID::Percentage:
+                case CoreTypeID::Degrees:
+                case CoreTypeID::Radians:
+                case CoreTypeID::EulerAngles:
+                case CoreTypeID::IntRange:
+                case CoreTypeID::FloatRange:
+                case CoreTypeID::Tag2:
+                case CoreTypeID::Tag4:
+                case CoreTypeID::BitFlags:
+                case CoreTypeID::TBitFlags:
+                case CoreTypeID::ResourceTypeID:
+                return true;
+
+                default:
+                return false;
+            }
+        }
+
+        // Calculate the offset of a property from the start of the type
+        // Returns false if the property address can only be resolved with an actual instance (i.e. dynamic arrays or type instances)
+        static bool TryResolveStaticPropertyOffset( TypeRegistry const& typeRegistry, TypeInfo const* pTypeInfo, PropertyPath const& path, PropertyInfo const*& pOutPropertyInfo, uint32_t& outOffset )
+        {
+            TypeInfo const* pParentTypeInfo = pTypeInfo;
+            pOutPropertyInfo = nullptr;
+            outOffset = 0;
+
+            size_t const numPathElements = path.GetNumElements();
+            for ( size_t i = 0; i < numPathElements; i++ )
+            {
+                PropertyInfo const* pPropertyInfo = pParentTypeInfo->GetPropertyInfo( path[i].m_propertyID );
+                if ( pPropertyInfo == nullptr || pPropertyInfo->IsTypeInstanceProperty() || pPropertyInfo->IsDynamicArrayProperty() )
+                {
+                    return false;
+                }
+
+                // Static array elements are laid out contiguously
+                bool const isArrayElementPath = path[i].m_arrayElementIdx != InvalidIndex;
+                if ( pPropertyInfo->IsStaticArrayProperty() )
+                {
+                    if ( !isArrayElementPath || path[i].m_arrayElementIdx >= pPropertyInfo->m_arraySize )
+                    {
+                        return false;
+                    }
+
+                    outOffset += (uint32_t) ( pPropertyInfo->m_offset + ( pPropertyInfo->m_arrayElementSize * path[i].m_arrayElementIdx ) );
+                }
+                else if ( isArrayElementPath )
+                {
+                    return false;
+                }
+                else
+                {
+                    outOffset += (uint32_t) pPropertyInfo->m_offset;
+                }
+
+                // Step into structures
+                if ( i != ( numPathElements - 1 ) )
+                {
+                    if ( !pPropertyInfo->IsStructureProperty() )
+                    {
+                        return false;
+                    }
+
+                    pParentTypeInfo = typeRegistry.GetTypeInfo( pPropertyInfo->m_typeID );
+                    if ( pParentTypeInfo == nullptr )
+                    {
+                        return false;
+                    }
+                }
+
+                pOutPropertyInfo = pPropertyInfo;
+            }
+
+            return pOutPropertyInfo != nullptr;
+        }
+    }
+
     // Type Description
     //-------------------------------------------------------------------------
 
@@ -136,8 +249,7 @@ namespace EE::TypeSystem
                         // Describe array size
                         if ( propInfo.IsDynamicArrayProperty() && ( numArrayElements != numArrayElementsDefault ) )
                         {
-                            PropertyDescriptor& propertyDesc = typeDesc.m_properties.emplace_back( PropertyDescriptor() );
-                            propertyDesc.m_path = path;
+                            PropertyDescriptor& propertyDesc = typeDesc.AddPropertyValue( path );
                             propertyDesc.m_path.Append( propInfo.m_ID );
                             TypeSystem::Conversion::ConvertNativeTypeToString( typeRegistry, GetCoreTypeID( CoreTypeID::Int32 ), TypeID(), &numArrayElements, propertyDesc.m_stringValue );
                             TypeSystem::Conversion::ConvertNativeTypeToBinary( typeRegistry, GetCoreTypeID( CoreTypeID::Int32 ), TypeID(), &numArrayElements, propertyDesc.m_byteValue );
@@ -174,8 +286,7 @@ namespace EE::TypeSystem
                     auto pInstanceContainer = (TypeInstance const*) pPropertyInstance;
                     if ( !pParentTypeInfo->IsPropertyValueSetToDefault( pParentInstance, propertyInfo.m_ID.ToUint(), arrayElementIdx ) )
                     {
-                        PropertyDescriptor& propertyDesc = typeDesc.m_properties.emplace_back( PropertyDescriptor() );
-                        propertyDesc.m_path = path;
+                        PropertyDescriptor& propertyDesc = typeDesc.AddPropertyValue( path );
 
                         TypeID instanceTypeID = pInstanceContainer->GetInstanceTypeID();
                         if ( instanceTypeID.IsValid() )
@@ -195,8 +306,7 @@ namespace EE::TypeSystem
                 {
                     if ( !pParentTypeInfo->IsPropertyValueSetToDefault( pParentInstance, propertyInfo.m_ID.ToUint(), arrayElementIdx ) )
                     {
-                        PropertyDescriptor& propertyDesc = typeDesc.m_properties.emplace_back( PropertyDescriptor() );
-                        propertyDesc.m_path = path;
+                        PropertyDescriptor& propertyDesc = typeDesc.AddPropertyValue( path );
                         Conversion::ConvertNativeTypeToBinary( typeRegistry, propertyInfo, pPropertyInstance, propertyDesc.m_byteValue );
                         Conversion::ConvertNativeTypeToString( typeRegistry, propertyInfo, pPropertyInstance, propertyDesc.m_stringValue );
                     }
@@ -287,7 +397,7 @@ namespace EE::TypeSystem
     {
         // Reset descriptor
         outDesc.m_typeID = pTypeInstance->GetTypeID();
-        outDesc.m_properties.clear();
+        outDesc.ClearPropertyValues();
 
         // Fill property values
         PropertyPath path;
@@ -299,8 +409,101 @@ namespace EE::TypeSystem
         TypeDescriber::GetAllReferencedResources( typeRegistry, pTypeInstance->GetTypeInfo()->m_ID, pTypeInstance, outReferencedResources );
     }
 
+    void TypeDescriptor::CompiledProgram::Reset()
+    {
+        m_pTypeInfo = nullptr;
+        m_numProperties = 0;
+        m_operations.clear();
+        m_data.clear();
+        m_resourceIDs.clear();
+    }
+
+    void TypeDescriptor::Compile( TypeRegistry const& typeRegistry )
+    {
+        EE_ASSERT( IsValid() );
+
+        m_compiledProgram.Reset();
+
+        TypeInfo const* pTypeInfo = typeRegistry.GetTypeInfo( m_typeID );
+        if ( pTypeInfo == nullptr )
+        {
+            return;
+        }
+
+        //-------------------------------------------------------------------------
+
+        m_compiledProgram.m_operations.reserve( m_properties.size() );
+
+        int32_t const numProperties = (int32_t) m_properties.size();
+        for ( int32_t i = 0; i < numProperties; i++ )
+        {
+            PropertyDescriptor const& propertyDesc = m_properties[i];
+            EE_ASSERT( propertyDesc.IsValid() );
+
+            CompiledProgram::Operation operation;
+            operation.m_type = CompiledProgram::OperationType::Generic;
+            operation.m_dataIdx = (uint32_t) i;
+
+            PropertyInfo const* pPropertyInfo = nullptr;
+            uint32_t propertyOffset = 0;
+            if ( TryResolveStaticPropertyOffset( typeRegistry, pTypeInfo, propertyDesc.m_path, pPropertyInfo, propertyOffset ) )
+            {
+                uint32_t const propertySize = (uint32_t) ( pPropertyInfo->IsStaticArrayProperty() ? pPropertyInfo->m_arrayElementSize : pPropertyInfo->m_size );
+
+                // Resource ptrs need to be assigned, since the resource ID is not trivially copyable
+                if ( pPropertyInfo->IsResourcePtrProperty() )
+                {
+                    Resource::ResourcePtr resourcePtr;
+                    if ( Conversion::ConvertBinaryToNativeType( typeRegistry, *pPropertyInfo, propertyDesc.m_byteValue, &resourcePtr ) )
+                    {
+                        operation.m_type = CompiledProgram::OperationType::SetResourcePtr;
+                        operation.m_offset = propertyOffset;
+                        operation.m_dataIdx = (uint32_t) m_compiledProgram.m_resourceIDs.size();
+                        m_compiledProgram.m_resourceIDs.emplace_back( resourcePtr.GetResourceID() );
+                    }
+                }
+                // Convert the value once and store the native representation
+                else if ( !pPropertyInfo->IsStructureProperty() && ( pPropertyInfo->IsEnumProperty() || IsCoreTypeTriviallyCopyable( GetCoreType( pPropertyInfo->m_typeID ) ) ) )
+                {
+                    alignas( 16 ) uint8_t nativeValue[sizeof( Matrix )] = { 0 };
+                    EE_ASSERT( propertySize > 0 && propertySize <= sizeof( nativeValue ) );
+
+                    if ( Conversion::ConvertBinaryToNativeType( typeRegistry, *pPropertyInfo, propertyDesc.m_byteValue, nativeValue ) )
+                    {
+                        operation.m_type = CompiledProgram::OperationType::Copy;
+                        operation.m_offset = propertyOffset;
+                        operation.m_size = propertySize;
+                        operation.m_dataIdx = (uint32_t) m_compiledProgram.m_data.size();
+                        m_compiledProgram.m_data.insert( m_compiledProgram.m_data.end(), nativeValue, nativeValue + propertySize );
+                    }
+                }
+            }
+
+            // Merge contiguous copies (e.g. consecutive members of a structure)
+            if ( operation.m_type == CompiledProgram::OperationType::Copy && !m_compiledProgram.m_operations.empty() )
+            {
+                CompiledProgram::Operation& previousOperation = m_compiledProgram.m_operations.back();
+                if ( previousOperation.m_type == CompiledProgram::OperationType::Copy && ( previousOperation.m_offset + previousOperation.m_size ) == operation.m_offset && ( previousOperation.m_dataIdx + previousOperation.m_size ) == operation.m_dataIdx )
+                {
+                    previousOperation.m_size += operation.m_size;
+                    continue;
+                }
+            }
+
+            m_compiledProgram.m_operations.emplace_back( operation );
+        }
+
+        m_compiledProgram.m_pTypeInfo = pTypeInfo;
+        m_compiledProgram.m_numProperties = numProperties;
+    }
+
+    //-------------------------------------------------------------------------
+
     PropertyDescriptor* TypeDescriptor::GetProperty( PropertyPath const& path )
     {
+        // The caller might modify the property so we can no longer rely on the compiled program
+        m_compiledProgram.Reset();
+
         for ( auto& prop : m_properties )
         {
             if ( prop.m_path == path )
@@ -312,8 +515,31 @@ namespace EE::TypeSystem
         return nullptr;
     }
 
+    PropertyDescriptor& TypeDescriptor::AddPropertyValue( PropertyPath const& path )
+    {
+        m_compiledProgram.Reset();
+
+        PropertyDescriptor& propertyDesc = m_properties.emplace_back( PropertyDescriptor() );
+        propertyDesc.m_path = path;
+        return propertyDesc;
+    }
+
+    void TypeDescriptor::AddPropertyValue( PropertyDescriptor const& propertyDesc )
+    {
+        m_compiledProgram.Reset();
+        m_properties.emplace_back( propertyDesc );
+    }
+
+    void TypeDescriptor::ClearPropertyValues()
+    {
+        m_compiledProgram.Reset();
+        m_properties.clear();
+    }
+
     void TypeDescriptor::RemovePropertyValue( TypeSystem::PropertyPath const& path )
     {
+        m_compiledProgram.Reset();
+
         for ( int32_t i = (int32_t) m_properties.size() - 1; i >= 0; i-- )
         {
             if ( m_properties[i].m_path == path )
@@ -328,78 +554,117 @@ namespace EE::TypeSystem
         EE_ASSERT( pTypeInfo != nullptr );
         EE_ASSERT( IsValid() && pTypeInfo->m_ID == m_typeID );
 
+        // Run the compiled program if we have one
+        //-------------------------------------------------------------------------
+
+        if ( m_compiledProgram.m_pTypeInfo == pTypeInfo && m_compiledProgram.m_numProperties == (int32_t) m_properties.size() )
+        {
+            uint8_t* const pTypeAddress = reinterpret_cast<uint8_t*>( pTypeInstance );
+            for ( auto const& operation : m_compiledProgram.m_operations )
+            {
+                switch ( operation.m_type )
+                {
+                    case CompiledProgram::OperationType::Copy:
+                    {
+                        memcpy( pTypeAddress + operation.m_offset, m_compiledProgram.m_data.data() + operation.m_dataIdx, operation.m_size );
+                    }
+                    break;
+
+                    case CompiledProgram::OperationType::SetResourcePtr:
+                    {
+                        auto pResourcePtr = reinterpret_cast<Resource::ResourcePtr*>( pTypeAddress + operation.m_offset );
+                        *pResourcePtr = Resource::ResourcePtr( m_compiledProgram.m_resourceIDs[operation.m_dataIdx] );
+                    }
+                    break;
+
+                    case CompiledProgram::OperationType::Generic:
+                    {
+                        RestorePropertyValue( typeRegistry, pTypeInfo, pTypeInstance, m_properties[operation.m_dataIdx] );
+                    }
+                    break;
+                }
+            }
+
+            return pTypeInstance;
+        }
+
         // Restore property state
         //-------------------------------------------------------------------------
 
         for ( auto const& propertyDesc : m_properties )
         {
-            EE_ASSERT( propertyDesc.IsValid() );
+            RestorePropertyValue( typeRegistry, pTypeInfo, pTypeInstance, propertyDesc );
+        }
 
-            // Resolve a property path for a given instance
-            auto resolvedPath = ResolvePropertyPath( typeRegistry, pTypeInstance, propertyDesc.m_path );
-            if ( !resolvedPath.IsValid() )
-            {
-                EE_LOG_ERROR( "TypeSystem", "Type Descriptor", "Tried to set the value for an invalid property (%s) for type (%s)", propertyDesc.m_path.ToString().c_str(), pTypeInfo->m_ID.ToStringID().c_str() );
-                continue;
-            }
+        return pTypeInstance;
+    }
 
-            //-------------------------------------------------------------------------
+    void TypeDescriptor::RestorePropertyValue( TypeRegistry const& typeRegistry, TypeInfo const* pTypeInfo, IReflectedType* pTypeInstance, PropertyDescriptor const& propertyDesc ) const
+    {
+        EE_ASSERT( propertyDesc.IsValid() );
+
+        // Resolve a property path for a given instance
+        auto resolvedPath = ResolvePropertyPath( typeRegistry, pTypeInstance, propertyDesc.m_path );
+        if ( !resolvedPath.IsValid() )
+        {
+            EE_LOG_ERROR( "TypeSystem", "Type Descriptor", "Tried to set the value for an invalid property (%s) for type (%s)", propertyDesc.m_path.ToString().c_str(), pTypeInfo->m_ID.ToStringID().c_str() );
+            return;
+        }
+
+        //-------------------------------------------------------------------------
 
-            ResolvedPropertyPathElement const& resolvedProperty = resolvedPath.m_pathElements.back();
+        ResolvedPropertyPathElement const& resolvedProperty = resolvedPath.m_pathElements.back();
 
-            if ( resolvedProperty.IsDynamicArray() && !resolvedProperty.IsArrayElement() )
+        if ( resolvedProperty.IsDynamicArray() && !resolvedProperty.IsArrayElement() )
+        {
+            int32_t numElements = 0;
+            if ( TypeSystem::Conversion::ConvertBinaryToNativeType( typeRegistry, GetCoreTypeID( CoreTypeID::Int32 ), TypeID(), propertyDesc.m_byteValue, &numElements ) )
             {
-                int32_t numElements = 0;
-                if ( TypeSystem::Conversion::ConvertBinaryToNativeType( typeRegistry, GetCoreTypeID( CoreTypeID::Int32 ), TypeID(), propertyDesc.m_byteValue, &numElements ) )
-                {
-                    EE_ASSERT( numElements >= 0 && numElements < 100000 );
-                    auto pParentTypeInfo = typeRegistry.GetTypeInfo( resolvedProperty.m_pPropertyInfo->m_parentTypeID );
-                    EE_ASSERT( pParentTypeInfo != nullptr );
-                    pParentTypeInfo->SetArraySize( resolvedProperty.m_pParentInstance, resolvedProperty.m_pPropertyInfo->m_ID.ToUint(), numElements );
-                }
-                else
-                {
-                    EE_LOG_ERROR( "TypeSystem", "Type Descriptor", "Failed to convert array size value for property (%s) on type: %s", propertyDesc.m_path.ToString().c_str(), pTypeInfo->m_ID.ToStringID().c_str() );
-                }
+                EE_ASSERT( numElements >= 0 && numElements < 100000 );
+                auto pParentTypeInfo = typeRegistry.GetTypeInfo( resolvedProperty.m_pPropertyInfo->m_parentTypeID );
+                EE_ASSERT( pParentTypeInfo != nullptr );
+                pParentTypeInfo->SetArraySize( resolvedProperty.m_pParentInstance, resolvedProperty.m_pPropertyInfo->m_ID.ToUint(), numElements );
             }
-            else if ( resolvedProperty.IsTypeInstance() )
+            else
             {
-                TypeID instanceTypeID;
-                if ( TypeSystem::Conversion::ConvertBinaryToNativeType( typeRegistry, GetCoreTypeID( CoreTypeID::TypeID ), TypeID(), propertyDesc.m_byteValue, &instanceTypeID ) )
-                {
-                    auto pInstanceContainer = (TypeInstance*) resolvedProperty.m_pPropertyAddress;
-
-                    if ( instanceTypeID.IsValid() )
-                    {
-                        TypeInfo const* pInstanceTypeInfo = typeRegistry.GetTypeInfo( instanceTypeID );
-                        if ( pInstanceTypeInfo == nullptr )
-                        {
-                            EE_LOG_ERROR( "TypeSystem", "Type Descriptor", "Invalid instance type (%s) for an property (%s) for type (%s)", instanceTypeID.c_str(), propertyDesc.m_path.ToString().c_str(), pTypeInfo->m_ID.ToStringID().c_str() );
-                            continue;
-                        }
+                EE_LOG_ERROR( "TypeSystem", "Type Descriptor", "Failed to convert array size value for property (%s) on type: %s", propertyDesc.m_path.ToString().c_str(), pTypeInfo->m_ID.ToStringID().c_str() );
+            }
+        }
+        else if ( resolvedProperty.IsTypeInstance() )
+        {
+            TypeID instanceTypeID;
+            if ( TypeSystem::Conversion::ConvertBinaryToNativeType( typeRegistry, GetCoreTypeID( CoreTypeID::TypeID ), TypeID(), propertyDesc.m_byteValue, &instanceTypeID ) )
+            {
+                auto pInstanceContainer = (TypeInstance*) resolvedProperty.m_pPropertyAddress;
 
-                        pInstanceContainer->CreateInstance( pInstanceTypeInfo );
-                    }
-                    else
+                if ( instanceTypeID.IsValid() )
+                {
+                    TypeInfo const* pInstanceTypeInfo = typeRegistry.GetTypeInfo( instanceTypeID );
+                    if ( pInstanceTypeInfo == nullptr )
                     {
-                        pInstanceContainer->DestroyInstance();
+                        EE_LOG_ERROR( "TypeSystem", "Type Descriptor", "Invalid instance type (%s) for an property (%s) for type (%s)", instanceTypeID.c_str(), propertyDesc.m_path.ToString().c_str(), pTypeInfo->m_ID.ToStringID().c_str() );
+                        return;
                     }
+
+                    pInstanceContainer->CreateInstance( pInstanceTypeInfo );
                 }
                 else
                 {
-                    EE_LOG_ERROR( "TypeSystem", "Type Descriptor", "Failed to read type instance ID value for property (%s) on type: %s", propertyDesc.m_path.ToString().c_str(), pTypeInfo->m_ID.ToStringID().c_str() );
+                    pInstanceContainer->DestroyInstance();
                 }
             }
-            else // Set actual property value
+            else
             {
-                if ( !Conversion::ConvertBinaryToNativeType( typeRegistry, *resolvedProperty.m_pPropertyInfo, propertyDesc.m_byteValue, resolvedProperty.m_pPropertyAddress ) )
-                {
-                    EE_LOG_ERROR( "TypeSystem", "Type Descriptor", "Failed to convert property value for property (%s) on type: %s", propertyDesc.m_path.ToString().c_str(), pTypeInfo->m_ID.ToStringID().c_str() );
-                }
+                EE_LOG_ERROR( "TypeSystem", "Type Descriptor", "Failed to read type instance ID value for property (%s) on type: %s", propertyDesc.m_path.ToString().c_str(), pTypeInfo->m_ID.ToStringID().c_str() );
+            }
+        }
+        else // Set actual property value
+        {
+            if ( !Conversion::ConvertBinaryToNativeType( typeRegistry, *resolvedProperty.m_pPropertyInfo, propertyDesc.m_byteValue, resolvedProperty.m_pPropertyAddress ) )
+            {
+                EE_LOG_ERROR( "TypeSystem", "Type Descriptor", "Failed to convert property value for property (%s) on type: %s", propertyDesc.m_path.ToString().c_str(), pTypeInfo->m_ID.ToStringID().c_str() );
             }
         }
-
-        return pTypeInstance;
     }
 
     //-------------------------------------------------------------------------
@@ -437,7 +702,7 @@ namespace EE::TypeSystem
 
         uintptr_t predictedMemoryOffset = 0;
 
-        for ( auto const& typeDesc : m_descriptors )
+        for ( auto& typeDesc : m_descriptors )
         {
             auto pTypeInfo = typeRegistry.GetTypeInfo( typeDesc.m_typeID );
             EE_ASSERT( pTypeInfo != nullptr );
@@ -451,6 +716,8 @@ namespace EE::TypeSystem
             m_typeInfos.emplace_back( pTypeInfo );
             m_typeSizes.emplace_back( pTypeInfo->m_size );
             m_typePaddings.emplace_back( (uint32_t) requiredPadding );
+
+            typeDesc.Compile( typeRegistry );
         }
 
         m_totalRequiredSize = (uint32_t) predictedMemoryOffset;
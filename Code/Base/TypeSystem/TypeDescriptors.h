@@ -43,6 +43,50 @@ namespace EE::TypeSystem
     {
         EE_SERIALIZE( m_typeID, m_properties );
 
+        // A flat list of operations to set all the described property values, created from the property descriptors
+        // Properties at a fixed offset from the type (i.e. not inside dynamic arrays or type instances) are pre-converted to
+        // their native values so that instantiation is a simple set of memcpys and resource ptr assignments
+        // All other properties fall back to the generic path (resolve property path + binary conversion)
+        struct CompiledProgram
+        {
+            enum class OperationType : uint8_t
+            {
+                Copy,           // Copy the pre-converted native value from the data blob
+                SetResourcePtr, // Set a resource ptr from the resource ID list
+                Generic,        // Use the generic path for the property descriptor
+            };
+
+            struct Operation
+            {
+                uint32_t                                            m_offset = 0; // Byte offset of the property from the start of the type
+                uint32_t                                            m_size = 0; // Byte size of the native value to copy
+                uint32_t                                            m_dataIdx = 0; // Offset in the data blob, index into the resource ID list or index of the property descriptor
+                OperationType                                       m_type = OperationType::Generic;
+            };
+
+        public:
+
+            CompiledProgram() = default;
+            CompiledProgram( CompiledProgram&& ) = default;
+            CompiledProgram& operator=( CompiledProgram&& ) = default;
+
+            // Programs are only valid for the exact property list they were compiled from, copies need to be recompiled
+            CompiledProgram( CompiledProgram const& ) {}
+            CompiledProgram& operator=( CompiledProgram const& ) { Reset(); return *this; }
+
+            inline bool IsValid() const { return m_pTypeInfo != nullptr; }
+
+            void Reset();
+
+        public:
+
+            TypeInfo const*                                         m_pTypeInfo = nullptr;
+            int32_t                                                 m_numProperties = 0; // Guards against the property list being replaced by deserialization
+            TVector<Operation>                                      m_operations;
+            Blob                                                    m_data;
+            TVector<ResourceID>                                     m_resourceIDs;
+        };
+
     public:
 
         // Create a type descriptor from a given reflected instance
@@ -125,21 +169,42 @@ namespace EE::TypeSystem
             T* pCreatedType = CreateTypeInPlace<T>( typeRegistry, pTypeInfo, pTypeInstance );
         }
 
+        // Compilation
+        //-------------------------------------------------------------------------
+
+        // Pre-resolve all the property descriptors into a flat program, this makes all future instantiations significantly cheaper
+        // This should be done once at load time, any modifications to the property descriptors will discard the compiled program
+        void Compile( TypeRegistry const& typeRegistry );
+
+        inline bool IsCompiled() const { return m_compiledProgram.IsValid(); }
+
         // Properties
         //-------------------------------------------------------------------------
+        // All non-const property accessors discard the compiled program
+
+        inline TInlineVector<PropertyDescriptor, 6> const& GetProperties() const { return m_properties; }
+        inline void ReserveProperties( int32_t numProperties ) { m_properties.reserve( numProperties ); }
 
         PropertyDescriptor* GetProperty( PropertyPath const& path );
         inline PropertyDescriptor const* GetProperty( PropertyPath const& path ) const { return const_cast<TypeDescriptor*>( this )->GetProperty( path ); }
+        PropertyDescriptor& AddPropertyValue( PropertyPath const& path );
+        void AddPropertyValue( PropertyDescriptor const& propertyDesc );
         void RemovePropertyValue( PropertyPath const& path );
+        void ClearPropertyValues();
 
     private:
 
         void* RestorePropertyState( TypeRegistry const& typeRegistry, TypeInfo const* pTypeInfo, IReflectedType* pTypeInstance ) const;
+        void RestorePropertyValue( TypeRegistry const& typeRegistry, TypeInfo const* pTypeInfo, IReflectedType* pTypeInstance, PropertyDescriptor const& propertyDesc ) const;
 
     public:
 
         TypeID                                                      m_typeID;
+
+    private:
+
         TInlineVector<PropertyDescriptor, 6>                        m_properties;
+        CompiledProgram                                             m_compiledProgram; // Not serialized
     };
 
     //-------------------------------------------------------------------------
@@ -212,6 +277,7 @@ namespace EE::TypeSystem
         void Reset();
 
         // Calculates all the necessary information needed to instantiate this collection statically (aka in a single immutable block)
+        // This also compiles all the descriptors
         void CalculateCollectionRequirements( TypeRegistry const& typeRegistry );
 
     public:
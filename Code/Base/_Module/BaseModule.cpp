@@ -3,6 +3,7 @@
 #include "Base/Network/NetworkSystem.h"
 #include "Base/Resource/ResourceProviders/NetworkResourceProvider.h"
 #include "Base/Resource/ResourceProviders/PackagedResourceProvider.h"
+#include "Base/Resource/ResourceProviders/ArchiveResourceProvider.h"
 #include "Base/Resource/Settings/GlobalSettings_Resource.h"
 #include "Base/Render/Settings/GlobalSettings_Render.h"
 
@@ -116,7 +117,15 @@ namespace EE
         }
         #else
         {
-            m_pResourceProvider = EE::New<Resource::PackagedResourceProvider>( *pResourceSettings );
+            // Prefer packed archives, loose compiled files are only used if no archives were created when packaging
+            if ( Resource::ArchiveResourceProvider::AreArchivesAvailable( *pResourceSettings ) )
+            {
+                m_pResourceProvider = EE::New<Resource::ArchiveResourceProvider>( *pResourceSettings );
+            }
+            else
+            {
+                m_pResourceProvider = EE::New<Resource::PackagedResourceProvider>( *pResourceSettings );
+            }
         }
         #endif
 
@@ -67,7 +67,7 @@ namespace EE::AI
 
         for ( auto pSpawnPoint : m_spawnPoints )
         {
-            pPersistentMap->AddEntityCollection( pTaskSystem, *pTypeRegistry, *pSpawnPoint->GetEntityCollectionDesc(), pSpawnPoint->GetWorldTransform() );
+            pPersistentMap->AddEntityCollectionFromTemplate( pTaskSystem, *pTypeRegistry, *pSpawnPoint->GetEntityCollectionDesc(), pSpawnPoint->GetWorldTransform() );
         }
 
         return true;
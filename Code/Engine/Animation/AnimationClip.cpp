@@ -7,6 +7,112 @@
 
 namespace EE::Animation
 {
+    void CompressedPoseData::Initialize( TVector<TrackCompressionSettings> const& trackSettings, TVector<uint32_t> const& poseOffsets, TVector<uint16_t> const& poseData )
+    {
+        Release();
+
+        size_t const trackSettingsSize = Math::RoundUpToNearestMultiple64( sizeof( TrackCompressionSettings ) * trackSettings.size(), s_blockAlignment );
+        size_t const poseOffsetsSize = Math::RoundUpToNearestMultiple64( sizeof( uint32_t ) * poseOffsets.size(), s_blockAlignment );
+        size_t const poseDataSize = Math::RoundUpToNearestMultiple64( sizeof( uint16_t ) * poseData.size(), s_blockAlignment );
+        size_t const blockSize = sizeof( Header ) + trackSettingsSize + poseOffsetsSize + poseDataSize;
+        EE_ASSERT( blockSize <= UINT32_MAX );
+
+        uint8_t* pBlock = Allocate( (uint32_t) blockSize );
+        memset( pBlock, 0, m_blockSize );
+
+        Header* pHeader = reinterpret_cast<Header*>( pBlock );
+        pHeader->m_numTracks = (uint32_t) trackSettings.size();
+        pHeader->m_numPoses = (uint32_t) poseOffsets.size();
+        pHeader->m_numPoseDataValues = (uint32_t) poseData.size();
+
+        uint8_t* pSection = pBlock + sizeof( Header );
+        if ( !trackSettings.empty() )
+        {
+            memcpy( pSection, trackSettings.data(), sizeof( TrackCompressionSettings ) * trackSettings.size() );
+        }
+
+        pSection += trackSettingsSize;
+        if ( !poseOffsets.empty() )
+        {
+            memcpy( pSection, poseOffsets.data(), sizeof( uint32_t ) * poseOffsets.size() );
+        }
+
+        pSection += poseOffsetsSize;
+        if ( !poseData.empty() )
+        {
+            memcpy( pSection, poseData.data(), sizeof( uint16_t ) * poseData.size() );
+        }
+
+        UpdateSectionPtrs();
+    }
+
+    uint8_t* CompressedPoseData::Allocate( uint32_t blockSize )
+    {
+        EE_ASSERT( m_pBlock == nullptr && blockSize >= sizeof( Header ) );
+        uint8_t* pBlock = (uint8_t*) EE::Alloc( blockSize, s_blockAlignment );
+        m_pBlock = pBlock;
+        m_blockSize = blockSize;
+        return pBlock;
+    }
+
+    void CompressedPoseData::Release()
+    {
+        if ( m_pBlock != nullptr )
+        {
+            void* pBlock = const_cast<uint8_t*>( m_pBlock );
+            EE::Free( pBlock );
+        }
+
+        m_pBlock = nullptr;
+        m_blockSize = 0;
+        m_pHeader = nullptr;
+        m_pTrackSettings = nullptr;
+        m_pPoseOffsets = nullptr;
+        m_pPoseData = nullptr;
+    }
+
+    void CompressedPoseData::CopyFrom( CompressedPoseData const& rhs )
+    {
+        EE_ASSERT( m_pBlock == nullptr );
+
+        if ( rhs.m_pBlock != nullptr )
+        {
+            memcpy( Allocate( rhs.m_blockSize ), rhs.m_pBlock, rhs.m_blockSize );
+            UpdateSectionPtrs();
+        }
+    }
+
+    void CompressedPoseData::Swap( CompressedPoseData& rhs )
+    {
+        eastl::swap( m_pBlock, rhs.m_pBlock );
+        eastl::swap( m_blockSize, rhs.m_blockSize );
+        eastl::swap( m_pHeader, rhs.m_pHeader );
+        eastl::swap( m_pTrackSettings, rhs.m_pTrackSettings );
+        eastl::swap( m_pPoseOffsets, rhs.m_pPoseOffsets );
+        eastl::swap( m_pPoseData, rhs.m_pPoseData );
+    }
+
+    void CompressedPoseData::UpdateSectionPtrs()
+    {
+        EE_ASSERT( m_pBlock != nullptr && m_blockSize >= sizeof( Header ) );
+
+        m_pHeader = reinterpret_cast<Header const*>( m_pBlock );
+
+        size_t const trackSettingsSize = Math::RoundUpToNearestMultiple64( sizeof( TrackCompressionSettings ) * m_pHeader->m_numTracks, s_blockAlignment );
+        size_t const poseOffsetsSize = Math::RoundUpToNearestMultiple64( sizeof( uint32_t ) * m_pHeader->m_numPoses, s_blockAlignment );
+        size_t const poseDataSize = Math::RoundUpToNearestMultiple64( sizeof( uint16_t ) * m_pHeader->m_numPoseDataValues, s_blockAlignment );
+        EE_ASSERT( m_blockSize == sizeof( Header ) + trackSettingsSize + poseOffsetsSize + poseDataSize );
+
+        uint8_t const* pSection = m_pBlock + sizeof( Header );
+        m_pTrackSettings = reinterpret_cast<TrackCompressionSettings const*>( pSection );
+        pSection += trackSettingsSize;
+        m_pPoseOffsets = reinterpret_cast<uint32_t const*>( pSection );
+        pSection += poseOffsetsSize;
+        m_pPoseData = reinterpret_cast<uint16_t const*>( pSection );
+    }
+
+    //-------------------------------------------------------------------------
+
     void AnimationClip::GetPose( FrameTime const& frameTime, Pose* pOutPose, Skeleton::LOD lod ) const
     {
         EE_ASSERT( IsValid() );
@@ -21,12 +127,12 @@ namespace EE::Animation
 
         auto ReadCompressedPose = [&] ( int32_t poseIdx, Transform outTransforms[] )
         {
-            uint16_t const* pReadPtr = m_compressedPoseData.data() + m_compressedPoseOffsets[poseIdx];
+            uint16_t const* pReadPtr = m_poseData.GetPoseData( poseIdx );
 
             // Read rotations
             for ( auto i = 0; i < numBones; i++ )
             {
-                TrackCompressionSettings const& trackSettings = m_trackCompressionSettings[i];
+                TrackCompressionSettings const& trackSettings = m_poseData.GetTrackSettings( i );
 
                 //-------------------------------------------------------------------------
 
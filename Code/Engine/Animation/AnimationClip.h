@@ -4,6 +4,7 @@
 #include "AnimationSyncTrack.h"
 #include "AnimationEvent.h"
 #include "AnimationRootMotion.h"
+#include "AnimationRootMotionTrajectory.h"
 #include "AnimationSkeleton.h"
 #include "Base/Resource/ResourcePtr.h"
 #include "Base/Math/NumericRange.h"
@@ -80,12 +81,113 @@ namespace EE::Animation
         bool                                    m_isScaleStatic = false;
     };
 
+    //-------------------------------------------------------------------------
+    // Compressed Pose Data
+    //-------------------------------------------------------------------------
+    // All the compressed pose data for a clip stored in a single 16 byte aligned memory block
+    // This is stored raw (and aligned) in the compiled resource so that it can be used in-place from the loaded resource data
+    // If the archive's source data isn't retained (or isn't aligned), the block is copied out into its own allocation instead
+    //
+    // Layout (each section starts on a 16 byte boundary):
+    //  * Header
+    //  * TrackCompressionSettings x numTracks
+    //  * uint32_t pose offsets x numPoses
+    //  * uint16_t compressed pose data x numPoseDataValues
+
+    class EE_ENGINE_API CompressedPoseData
+    {
+        EE_CUSTOM_SERIALIZE_READ_FUNCTION( archive )
+        {
+            Release();
+
+            uint32_t blockSize = 0;
+            archive << blockSize;
+            if ( blockSize > 0 )
+            {
+                // The block is read with a single copy into an exact size allocation, so that the (pooled) resource data doesnt need to be kept around
+                archive.SerializeAlignedRawData( Allocate( blockSize ), blockSize, s_blockAlignment );
+                UpdateSectionPtrs();
+            }
+            return archive;
+        }
+
+        EE_CUSTOM_SERIALIZE_WRITE_FUNCTION( archive )
+        {
+            archive << m_blockSize;
+            if ( m_blockSize > 0 )
+            {
+                archive.SerializeAlignedRawData( const_cast<uint8_t*>( m_pBlock ), m_blockSize, s_blockAlignment );
+            }
+            return archive;
+        }
+
+        constexpr static size_t const s_blockAlignment = 16;
+
+        struct Header
+        {
+            uint32_t                            m_numTracks = 0;
+            uint32_t                            m_numPoses = 0;
+            uint32_t                            m_numPoseDataValues = 0;
+            uint32_t                            m_padding = 0;
+        };
+
+        static_assert( sizeof( Header ) == 16, "Header needs to preserve the alignment of the following sections" );
+        static_assert( std::is_trivially_copyable<TrackCompressionSettings>::value, "Track compression settings are stored raw" );
+
+    public:
+
+        CompressedPoseData() = default;
+        CompressedPoseData( CompressedPoseData const& rhs ) { CopyFrom( rhs ); }
+        CompressedPoseData( CompressedPoseData&& rhs ) { Swap( rhs ); }
+        ~CompressedPoseData() { Release(); }
+
+        CompressedPoseData& operator=( CompressedPoseData const& rhs ) { if ( this != &rhs ) { Release(); CopyFrom( rhs ); } return *this; }
+        CompressedPoseData& operator=( CompressedPoseData&& rhs ) { Swap( rhs ); return *this; }
+
+        // Create the data block from the supplied compression data (only used by the compiler)
+        void Initialize( TVector<TrackCompressionSettings> const& trackSettings, TVector<uint32_t> const& poseOffsets, TVector<uint16_t> const& poseData );
+
+        inline bool IsValid() const { return m_pBlock != nullptr; }
+        inline int32_t GetNumTracks() const { return m_pHeader != nullptr ? (int32_t) m_pHeader->m_numTracks : 0; }
+        inline int32_t GetNumPoses() const { return m_pHeader != nullptr ? (int32_t) m_pHeader->m_numPoses : 0; }
+        inline size_t GetMemoryUsage() const { return m_blockSize; }
+
+        EE_FORCE_INLINE TrackCompressionSettings const& GetTrackSettings( int32_t trackIdx ) const
+        {
+            EE_ASSERT( trackIdx >= 0 && trackIdx < GetNumTracks() );
+            return m_pTrackSettings[trackIdx];
+        }
+
+        EE_FORCE_INLINE uint16_t const* GetPoseData( int32_t poseIdx ) const
+        {
+            EE_ASSERT( poseIdx >= 0 && poseIdx < GetNumPoses() );
+            return m_pPoseData + m_pPoseOffsets[poseIdx];
+        }
+
+    private:
+
+        uint8_t* Allocate( uint32_t blockSize );
+        void Release();
+        void CopyFrom( CompressedPoseData const& rhs );
+        void Swap( CompressedPoseData& rhs );
+        void UpdateSectionPtrs();
+
+    private:
+
+        uint8_t const*                          m_pBlock = nullptr;
+        uint32_t                                m_blockSize = 0;
+        Header const*                           m_pHeader = nullptr;
+        TrackCompressionSettings const*         m_pTrackSettings = nullptr;
+        uint32_t const*                         m_pPoseOffsets = nullptr;
+        uint16_t const*                         m_pPoseData = nullptr;
+    };
+
     //-------------------------------------------------------------------------
 
     class EE_ENGINE_API AnimationClip : public Resource::IResource
     {
-        EE_RESOURCE( 'anim', "Animation Clip", 57, false );
-        EE_SERIALIZE( m_skeleton, m_numFrames, m_duration, m_compressedPoseData, m_compressedPoseOffsets, m_trackCompressionSettings, m_rootMotion, m_isAdditive );
+        EE_RESOURCE( 'anim', "Animation Clip", 60, false );
+        EE_SERIALIZE( m_skeleton, m_numFrames, m_duration, m_rootMotion, m_rootMotionTrajectory, m_isAdditive, m_poseData );
 
         friend class AnimationClipCompiler;
         friend class AnimationClipLoader;
@@ -115,7 +217,7 @@ namespace EE::Animation
 
         AnimationClip() = default;
 
-        virtual bool IsValid() const final { return m_skeleton != nullptr && m_skeleton.IsLoaded() && m_numFrames > 0; }
+        virtual bool IsValid() const final { return m_skeleton != nullptr && m_skeleton.IsLoaded() && m_numFrames > 0 && m_poseData.IsValid(); }
         inline Skeleton const* GetSkeleton() const { return m_skeleton.GetPtr(); }
         inline int32_t GetNumBones() const { EE_ASSERT( m_skeleton != nullptr ); return m_skeleton->GetNumBones(); }
 
@@ -221,19 +323,30 @@ namespace EE::Animation
         // Get the rotation delta for this animation
         EE_FORCE_INLINE Quaternion const& GetRotationDelta() const { return m_rootMotion.m_totalDelta.GetRotation(); }
 
+        // Root motion prediction
+        //-------------------------------------------------------------------------
+
+        // Get the precomputed root motion trajectory
+        EE_FORCE_INLINE RootMotionTrajectory const& GetRootMotionTrajectory() const { return m_rootMotionTrajectory; }
+
+        // Predict the root motion deltas from the start time to each of the supplied time offsets (in seconds from the start time)
+        inline void PredictRootMotion( Percentage startTime, Seconds const* pTimeOffsets, int32_t numSamples, Transform* pOutDeltas, bool isLooping = true ) const
+        {
+            m_rootMotionTrajectory.SampleDeltas( startTime, m_duration, isLooping, pTimeOffsets, numSamples, pOutDeltas );
+        }
+
     private:
 
         TResourcePtr<Skeleton>                  m_skeleton;
         int32_t                                 m_numFrames = 0;
         Seconds                                 m_duration = 0.0f;
-        TVector<uint16_t>                       m_compressedPoseData;
-        TVector<TrackCompressionSettings>       m_trackCompressionSettings;
-        TVector<uint32_t>                       m_compressedPoseOffsets;
+        CompressedPoseData                      m_poseData;
         TVector<Event*>                         m_events;
         TInlineVector<AnimationClip const*,1>   m_secondaryAnimations;
         SyncTrack                               m_syncTrack;
         bool                                    m_isAdditive = false;
         RootMotionData                          m_rootMotion;
+        RootMotionTrajectory                    m_rootMotionTrajectory;
     };
 }
 
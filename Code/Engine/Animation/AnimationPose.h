@@ -20,6 +20,8 @@ namespace EE::Animation
     {
         friend class Blender;
         friend class AnimationClip;
+        friend class QuantizedPose;
+        friend class PoseSnapshot;
 
     public:
 
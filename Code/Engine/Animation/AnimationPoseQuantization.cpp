@@ -0,0 +1,184 @@
+#include "AnimationPoseQuantization.h"
+#include "Base/Encoding/Quantization.h"
+#include "Base/Math/SIMD.h"
+
+//-------------------------------------------------------------------------
+
+namespace EE::Animation
+{
+    static Vector const g_maxEncodedValue( float( 0xFFFF ) );
+    static Vector const g_inverseMaxEncodedValue( 1.0f / float( 0xFFFF ) );
+
+    //-------------------------------------------------------------------------
+
+    void QuantizedPose::EncodeTransforms( Transform const* pTransforms, int32_t numTransforms, Transform const* pReferencePose, Vector const& rangeStart, Vector const& rangeLength, uint16_t* pOutData )
+    {
+        EE_ASSERT( pTransforms != nullptr && pOutData != nullptr );
+
+        Vector const vEncodeMultiplier = g_maxEncodedValue / rangeLength;
+        uint16_t* pWritePtr = pOutData;
+
+        for ( int32_t i = 0; i < numTransforms; i++ )
+        {
+            Quantization::EncodedQuaternion const encodedRotation( pTransforms[i].GetRotation() );
+            pWritePtr[0] = encodedRotation.GetData0();
+            pWritePtr[1] = encodedRotation.GetData1();
+            pWritePtr[2] = encodedRotation.GetData2();
+
+            Vector translationScale = pTransforms[i].GetTranslationAndScale();
+            if ( pReferencePose != nullptr )
+            {
+                translationScale -= pReferencePose[i].GetTranslationAsVector();
+            }
+
+            // Normalize, scale to 16bit range and round - then pack the 4 x 32bit ints into 4 x 16bit values
+            Vector vScaled = Vector::MultiplyAdd( translationScale - rangeStart, vEncodeMultiplier, Vector::Half );
+            vScaled = Vector::Min( Vector::Max( vScaled, Vector::Zero ), g_maxEncodedValue );
+            __m128i const vEncoded = _mm_packus_epi32( _mm_cvttps_epi32( vScaled ), _mm_setzero_si128() );
+            _mm_storel_epi64( reinterpret_cast<__m128i*>( pWritePtr + 3 ), vEncoded );
+
+            pWritePtr += s_numValuesPerBone;
+        }
+    }
+
+    void QuantizedPose::DecodeTransforms( uint16_t const* pData, int32_t numTransforms, Transform const* pReferencePose, Vector const& rangeStart, Vector const& rangeLength, Transform* pOutTransforms )
+    {
+        EE_ASSERT( pData != nullptr && pOutTransforms != nullptr );
+
+        Vector const vDecodeMultiplier = rangeLength * g_inverseMaxEncodedValue;
+        uint16_t const* pReadPtr = pData;
+
+        for ( int32_t i = 0; i < numTransforms; i++ )
+        {
+            Quantization::EncodedQuaternion const encodedRotation( pReadPtr[0], pReadPtr[1], pReadPtr[2] );
+
+            // Load the 4 x 16bit translation/scale values and widen to 4 x 32bit floats
+            __m128i const vEncoded = _mm_cvtepu16_epi32( _mm_loadl_epi64( reinterpret_cast<__m128i const*>( pReadPtr + 3 ) ) );
+            Vector translationScale = Vector::MultiplyAdd( _mm_cvtepi32_ps( vEncoded ), vDecodeMultiplier, rangeStart );
+            if ( pReferencePose != nullptr )
+            {
+                translationScale += pReferencePose[i].GetTranslationAsVector();
+            }
+
+            Transform::DirectlySetRotation( pOutTransforms[i], encodedRotation.ToQuaternion() );
+            Transform::DirectlySetTranslationScale( pOutTransforms[i], translationScale );
+
+            pReadPtr += s_numValuesPerBone;
+        }
+    }
+
+    //-------------------------------------------------------------------------
+
+    QuantizedPose::QuantizedPose( Skeleton const* pSkeleton )
+        : m_pSkeleton( pSkeleton )
+    {
+        EE_ASSERT( pSkeleton != nullptr );
+    }
+
+    void QuantizedPose::ChangeSkeleton( Skeleton const* pSkeleton )
+    {
+        EE_ASSERT( pSkeleton != nullptr );
+
+        if ( m_pSkeleton == pSkeleton )
+        {
+            return;
+        }
+
+        m_pSkeleton = pSkeleton;
+        m_encodedData.clear();
+        m_state = Pose::State::Unset;
+    }
+
+    //-------------------------------------------------------------------------
+
+    void QuantizedPose::Encode( Pose const& pose )
+    {
+        EE_ASSERT( pose.GetSkeleton() == m_pSkeleton );
+
+        m_state = pose.m_state;
+
+        // Reference/zero/unset poses dont need any data stored
+        if ( m_state != Pose::State::Pose && m_state != Pose::State::AdditivePose )
+        {
+            return;
+        }
+
+        //-------------------------------------------------------------------------
+
+        int32_t const numBones = m_pSkeleton->GetNumBones();
+        TVector<Transform> const& referencePose = m_pSkeleton->GetParentSpaceReferencePose();
+        bool const isAdditive = ( m_state == Pose::State::AdditivePose );
+
+        // Calculate the translation/scale ranges
+        //-------------------------------------------------------------------------
+
+        Vector vMin( Math::Infinity );
+        Vector vMax( -Math::Infinity );
+
+        for ( int32_t boneIdx = 0; boneIdx < numBones; boneIdx++ )
+        {
+            Vector translationScale = pose.m_parentSpaceTransforms[boneIdx].GetTranslationAndScale();
+            if ( !isAdditive )
+            {
+                translationScale -= referencePose[boneIdx].GetTranslationAsVector();
+            }
+
+            vMin = Vector::Min( vMin, translationScale );
+            vMax = Vector::Max( vMax, translationScale );
+        }
+
+        // Avoid a divide by zero for constant channels
+        Vector const vLength = Vector::Max( vMax - vMin, Vector::Epsilon );
+
+        m_rangeStart = vMin.ToFloat4();
+        m_rangeLength = vLength.ToFloat4();
+
+        // Encode
+        //-------------------------------------------------------------------------
+
+        m_encodedData.resize( numBones * s_numValuesPerBone );
+        EncodeTransforms( pose.m_parentSpaceTransforms.data(), numBones, isAdditive ? nullptr : referencePose.data(), vMin, vLength, m_encodedData.data() );
+    }
+
+    void QuantizedPose::Decode( Pose& outPose ) const
+    {
+        EE_ASSERT( outPose.GetSkeleton() == m_pSkeleton );
+
+        outPose.ClearModelSpaceTransforms();
+
+        switch ( m_state )
+        {
+            case Pose::State::Unset:
+            {
+                outPose.Reset( Pose::Type::None );
+            }
+            return;
+
+            case Pose::State::ReferencePose:
+            {
+                outPose.Reset( Pose::Type::ReferencePose );
+            }
+            return;
+
+            case Pose::State::ZeroPose:
+            {
+                outPose.Reset( Pose::Type::ZeroPose );
+            }
+            return;
+
+            default:
+            break;
+        }
+
+        //-------------------------------------------------------------------------
+
+        int32_t const numBones = m_pSkeleton->GetNumBones();
+        EE_ASSERT( m_encodedData.size() == numBones * s_numValuesPerBone );
+
+        TVector<Transform> const& referencePose = m_pSkeleton->GetParentSpaceReferencePose();
+        bool const isAdditive = ( m_state == Pose::State::AdditivePose );
+        DecodeTransforms( m_encodedData.data(), numBones, isAdditive ? nullptr : referencePose.data(), Vector( m_rangeStart ), Vector( m_rangeLength ), outPose.m_parentSpaceTransforms.data() );
+
+        outPose.m_state = m_state;
+    }
+}
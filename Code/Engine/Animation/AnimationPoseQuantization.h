@@ -0,0 +1,61 @@
+#pragma once
+
+#include "AnimationPose.h"
+
+//-------------------------------------------------------------------------
+
+namespace EE::Animation
+{
+    //-------------------------------------------------------------------------
+    // Quantized Pose
+    //-------------------------------------------------------------------------
+    // Compact storage for a set of parent-space transforms, this is lossy!
+    //
+    // Each bone is stored as 7 x uint16_t (14 bytes vs 32 bytes for a transform):
+    //  * Rotation - 48bit encoded quaternion
+    //  * Translation - 3 x 16bit offsets from the reference pose translation (absolute for additive poses)
+    //  * Scale - 16bit
+    //
+    // The translation/scale quantization ranges are calculated per-pose when encoding
+
+    class EE_ENGINE_API QuantizedPose
+    {
+    public:
+
+        constexpr static int32_t const s_numValuesPerBone = 7;
+
+        // Quantize a set of transforms using the supplied translation/scale range, values outside the range are clamped
+        // If a reference pose is supplied, translations are stored relative to it
+        static void EncodeTransforms( Transform const* pTransforms, int32_t numTransforms, Transform const* pReferencePose, Vector const& rangeStart, Vector const& rangeLength, uint16_t* pOutData );
+
+        // Decode a set of quantized transforms, the range and reference pose need to match those used for encoding
+        static void DecodeTransforms( uint16_t const* pData, int32_t numTransforms, Transform const* pReferencePose, Vector const& rangeStart, Vector const& rangeLength, Transform* pOutTransforms );
+
+    public:
+
+        QuantizedPose( Skeleton const* pSkeleton );
+
+        inline Skeleton const* GetSkeleton() const { return m_pSkeleton; }
+        void ChangeSkeleton( Skeleton const* pSkeleton );
+
+        inline bool IsPoseSet() const { return m_state != Pose::State::Unset; }
+        inline void Reset() { m_state = Pose::State::Unset; }
+
+        // Quantize the supplied pose, the pose must use the same skeleton
+        void Encode( Pose const& pose );
+
+        // Decode the stored pose into the supplied pose, the pose must use the same skeleton
+        void Decode( Pose& outPose ) const;
+
+        // Get the memory currently allocated for the quantized data
+        inline size_t GetMemoryUsage() const { return m_encodedData.capacity() * sizeof( uint16_t ); }
+
+    private:
+
+        Skeleton const*             m_pSkeleton = nullptr;
+        TVector<uint16_t>           m_encodedData;
+        Float4                      m_rangeStart = Float4::Zero;    // XYZ = translation, W = scale
+        Float4                      m_rangeLength = Float4::Zero;   // XYZ = translation, W = scale
+        Pose::State                 m_state = Pose::State::Unset;
+    };
+}
@@ -0,0 +1,361 @@
+#include "AnimationPoseSnapshot.h"
+#include "AnimationPoseQuantization.h"
+
+//-------------------------------------------------------------------------
+// Serialized Format
+//-------------------------------------------------------------------------
+// Header:
+//  * 3 bits    - pose state
+//  * 1 bit     - was a baseline used
+//  * 16 bits   - number of bones (only for set poses)
+//
+// Per bone (only for set poses):
+//  * 1 bit     - has the bone changed from the baseline (only with a baseline)
+//  * 3 bits    - have the rotation/translation/scale changed from the baseline (only with a baseline, and only for changed bones)
+//  * 47 bits   - encoded rotation (the top bit of the last component is always unused)
+//  * 48 bits   - 3 x 16bit translation
+//  * 16 bits   - scale
+
+namespace EE::Animation
+{
+    constexpr static uint32_t const g_numStateBits = 3;
+    constexpr static uint32_t const g_numBoneCountBits = 16;
+    constexpr static uint32_t const g_numHeaderBits = g_numStateBits + 1 + g_numBoneCountBits;
+    constexpr static uint32_t const g_numRotationBits = 47;
+    constexpr static uint32_t const g_numTranslationBits = 48;
+    constexpr static uint32_t const g_numScaleBits = 16;
+    constexpr static uint32_t const g_maxBitsPerBone = 1 + 3 + g_numRotationBits + g_numTranslationBits + g_numScaleBits;
+
+    //-------------------------------------------------------------------------
+
+    PoseSnapshot::PoseSnapshot( Skeleton const* pSkeleton, float translationRange, float maxScale )
+        : m_pSkeleton( pSkeleton )
+        , m_rangeStart( -translationRange, -translationRange, -translationRange, -maxScale )
+        , m_rangeLength( translationRange * 2, translationRange * 2, translationRange * 2, maxScale * 2 )
+    {
+        EE_ASSERT( pSkeleton != nullptr );
+        EE_ASSERT( translationRange > 0.0f && maxScale > 0.0f );
+    }
+
+    uint32_t PoseSnapshot::GetMaxSerializedSizeInBits( Skeleton const* pSkeleton )
+    {
+        EE_ASSERT( pSkeleton != nullptr );
+        return g_numHeaderBits + ( pSkeleton->GetNumBones() * g_maxBitsPerBone );
+    }
+
+    //-------------------------------------------------------------------------
+
+    void PoseSnapshot::Capture( Pose const& pose )
+    {
+        EE_ASSERT( pose.GetSkeleton() == m_pSkeleton );
+
+        m_state = pose.m_state;
+
+        // Reference/zero/unset poses dont need any data stored
+        if ( m_state != Pose::State::Pose && m_state != Pose::State::AdditivePose )
+        {
+            m_encodedData.clear();
+            return;
+        }
+
+        int32_t const numBones = m_pSkeleton->GetNumBones();
+        bool const isAdditive = ( m_state == Pose::State::AdditivePose );
+        Transform const* pReferencePose = isAdditive ? nullptr : m_pSkeleton->GetParentSpaceReferencePose().data();
+
+        m_encodedData.resize( numBones * QuantizedPose::s_numValuesPerBone );
+        QuantizedPose::EncodeTransforms( pose.m_parentSpaceTransforms.data(), numBones, pReferencePose, Vector( m_rangeStart ), Vector( m_rangeLength ), m_encodedData.data() );
+    }
+
+    void PoseSnapshot::Apply( Pose& outPose ) const
+    {
+        EE_ASSERT( outPose.GetSkeleton() == m_pSkeleton );
+
+        outPose.ClearModelSpaceTransforms();
+
+        switch ( m_state )
+        {
+            case Pose::State::Unset:
+            {
+                outPose.Reset( Pose::Type::None );
+            }
+            return;
+
+            case Pose::State::ReferencePose:
+            {
+                outPose.Reset( Pose::Type::ReferencePose );
+            }
+            return;
+
+            case Pose::State::ZeroPose:
+            {
+                outPose.Reset( Pose::Type::ZeroPose );
+            }
+            return;
+
+            default:
+            break;
+        }
+
+        //-------------------------------------------------------------------------
+
+        int32_t const numBones = m_pSkeleton->GetNumBones();
+        EE_ASSERT( m_encodedData.size() == numBones * QuantizedPose::s_numValuesPerBone );
+
+        bool const isAdditive = ( m_state == Pose::State::AdditivePose );
+        Transform const* pReferencePose = isAdditive ? nullptr : m_pSkeleton->GetParentSpaceReferencePose().data();
+
+        QuantizedPose::DecodeTransforms( m_encodedData.data(), numBones, pReferencePose, Vector( m_rangeStart ), Vector( m_rangeLength ), outPose.m_parentSpaceTransforms.data() );
+        outPose.m_state = m_state;
+    }
+
+    //-------------------------------------------------------------------------
+
+    bool PoseSnapshot::IsCompatibleBaseline( PoseSnapshot const* pBaseline ) const
+    {
+        if ( pBaseline == nullptr || pBaseline == this )
+        {
+            return false;
+        }
+
+        if ( pBaseline->m_pSkeleton != m_pSkeleton || pBaseline->m_rangeStart != m_rangeStart || pBaseline->m_rangeLength != m_rangeLength )
+        {
+            return false;
+        }
+
+        // Only snapshots with the same kind of data can be used as baselines
+        return pBaseline->m_state == m_state && pBaseline->m_encodedData.size() == m_encodedData.size();
+    }
+
+    bool PoseSnapshot::Serialize( Blob& outData, PoseSnapshot const* pBaseline ) const
+    {
+        if ( GetMaxSerializedSizeInBits( m_pSkeleton ) >= s_maxSerializedBits )
+        {
+            EE_LOG_ERROR( "Animation", "Pose Snapshot", "Skeleton (%s) has too many bones to be serialized as a pose snapshot!", m_pSkeleton->GetResourceID().c_str() );
+            return false;
+        }
+
+        //-------------------------------------------------------------------------
+
+        bool const isPoseSet = ( m_state == Pose::State::Pose || m_state == Pose::State::AdditivePose );
+        bool const useBaseline = isPoseSet && IsCompatibleBaseline( pBaseline );
+
+        Archive archive;
+        archive.WriteUInt( (uint8_t) m_state, g_numStateBits );
+        archive.WriteBool( useBaseline );
+
+        if ( isPoseSet )
+        {
+            int32_t const numBones = m_pSkeleton->GetNumBones();
+            archive.WriteUInt( numBones, g_numBoneCountBits );
+
+            uint16_t const* pData = m_encodedData.data();
+            uint16_t const* pBaselineData = useBaseline ? pBaseline->m_encodedData.data() : nullptr;
+
+            for ( int32_t boneIdx = 0; boneIdx < numBones; boneIdx++ )
+            {
+                bool writeRotation = true;
+                bool writeTranslation = true;
+                bool writeScale = true;
+
+                if ( useBaseline )
+                {
+                    writeRotation = pData[0] != pBaselineData[0] || pData[1] != pBaselineData[1] || pData[2] != pBaselineData[2];
+                    writeTranslation = pData[3] != pBaselineData[3] || pData[4] != pBaselineData[4] || pData[5] != pBaselineData[5];
+                    writeScale = pData[6] != pBaselineData[6];
+
+                    bool const hasBoneChanged = writeRotation || writeTranslation || writeScale;
+                    archive.WriteBool( hasBoneChanged );
+                    if ( hasBoneChanged )
+                    {
+                        archive.WriteBool( writeRotation );
+                        archive.WriteBool( writeTranslation );
+                        archive.WriteBool( writeScale );
+                    }
+
+                    pBaselineData += QuantizedPose::s_numValuesPerBone;
+                }
+
+                //-------------------------------------------------------------------------
+
+                if ( writeRotation )
+                {
+                    archive.WriteUInt( pData[0], 16 );
+                    archive.WriteUInt( pData[1], 16 );
+                    archive.WriteUInt( pData[2], 15 );
+                }
+
+                if ( writeTranslation )
+                {
+                    archive.WriteUInt( pData[3], 16 );
+                    archive.WriteUInt( pData[4], 16 );
+                    archive.WriteUInt( pData[5], 16 );
+                }
+
+                if ( writeScale )
+                {
+                    archive.WriteUInt( pData[6], 16 );
+                }
+
+                pData += QuantizedPose::s_numValuesPerBone;
+            }
+        }
+
+        archive.GetWrittenData( outData );
+        return true;
+    }
+
+    bool PoseSnapshot::Deserialize( Blob const& inData, PoseSnapshot const* pBaseline )
+    {
+        if ( inData.empty() || inData.size() >= ( s_maxSerializedBits / 8 ) )
+        {
+            return false;
+        }
+
+        // The archive is backed by a fixed size buffer, so we need to ensure we never read past the end of the supplied data
+        Archive archive( inData );
+        uint32_t const numAvailableBits = (uint32_t) inData.size() * 8;
+        auto HasBitsRemaining = [&archive, numAvailableBits] ( uint32_t numBits ) { return ( archive.GetNumProcessedBits() + numBits ) <= numAvailableBits; };
+
+        // The data must end in the final byte, any extra bytes means the data is malformed
+        auto IsFullyConsumed = [&archive, &inData] () { return Math::CeilingToInt( archive.GetNumProcessedBits() / 8.0f ) == (int32_t) inData.size(); };
+
+        //-------------------------------------------------------------------------
+
+        uint64_t const stateValue = archive.ReadUInt( g_numStateBits );
+        if ( stateValue > (uint64_t) Pose::State::AdditivePose )
+        {
+            return false;
+        }
+
+        Pose::State const state = (Pose::State) stateValue;
+        bool const usedBaseline = archive.ReadBool();
+
+        if ( state != Pose::State::Pose && state != Pose::State::AdditivePose )
+        {
+            if ( usedBaseline || !IsFullyConsumed() )
+            {
+                return false;
+            }
+
+            m_state = state;
+            m_encodedData.clear();
+            return true;
+        }
+
+        //-------------------------------------------------------------------------
+
+        if ( !HasBitsRemaining( g_numBoneCountBits ) )
+        {
+            return false;
+        }
+
+        int32_t const numBones = (int32_t) archive.ReadUInt( g_numBoneCountBits );
+        if ( numBones != m_pSkeleton->GetNumBones() )
+        {
+            return false;
+        }
+
+        // Without a baseline every bone is written in full, so we know the exact size up-front
+        if ( !usedBaseline && !HasBitsRemaining( numBones * ( g_numRotationBits + g_numTranslationBits + g_numScaleBits ) ) )
+        {
+            return false;
+        }
+
+        // The baseline needs to be validated against the incoming pose state/size before we overwrite our own data
+        if ( usedBaseline )
+        {
+            if ( pBaseline == nullptr || pBaseline == this || pBaseline->m_pSkeleton != m_pSkeleton || pBaseline->m_state != state || pBaseline->m_encodedData.size() != numBones * QuantizedPose::s_numValuesPerBone )
+            {
+                return false;
+            }
+
+            if ( pBaseline->m_rangeStart != m_rangeStart || pBaseline->m_rangeLength != m_rangeLength )
+            {
+                return false;
+            }
+        }
+
+        //-------------------------------------------------------------------------
+
+        // Decode into a temporary buffer so that malformed data leaves this snapshot untouched
+        TVector<uint16_t> encodedData;
+        encodedData.resize( numBones * QuantizedPose::s_numValuesPerBone );
+
+        uint16_t* pData = encodedData.data();
+        uint16_t const* pBaselineData = usedBaseline ? pBaseline->m_encodedData.data() : nullptr;
+
+        for ( int32_t boneIdx = 0; boneIdx < numBones; boneIdx++ )
+        {
+            bool readRotation = true;
+            bool readTranslation = true;
+            bool readScale = true;
+
+            if ( usedBaseline )
+            {
+                if ( !HasBitsRemaining( 1 ) )
+                {
+                    return false;
+                }
+
+                bool const hasBoneChanged = archive.ReadBool();
+                if ( hasBoneChanged )
+                {
+                    if ( !HasBitsRemaining( 3 ) )
+                    {
+                        return false;
+                    }
+
+                    readRotation = archive.ReadBool();
+                    readTranslation = archive.ReadBool();
+                    readScale = archive.ReadBool();
+                }
+                else
+                {
+                    readRotation = readTranslation = readScale = false;
+                }
+
+                uint32_t const numBitsToRead = ( readRotation ? g_numRotationBits : 0 ) + ( readTranslation ? g_numTranslationBits : 0 ) + ( readScale ? g_numScaleBits : 0 );
+                if ( !HasBitsRemaining( numBitsToRead ) )
+                {
+                    return false;
+                }
+
+                // Start from the baseline values, any changed values will be overwritten below
+                memcpy( pData, pBaselineData, sizeof( uint16_t ) * QuantizedPose::s_numValuesPerBone );
+                pBaselineData += QuantizedPose::s_numValuesPerBone;
+            }
+
+            //-------------------------------------------------------------------------
+
+            if ( readRotation )
+            {
+                pData[0] = (uint16_t) archive.ReadUInt( 16 );
+                pData[1] = (uint16_t) archive.ReadUInt( 16 );
+                pData[2] = (uint16_t) archive.ReadUInt( 15 );
+            }
+
+            if ( readTranslation )
+            {
+                pData[3] = (uint16_t) archive.ReadUInt( 16 );
+                pData[4] = (uint16_t) archive.ReadUInt( 16 );
+                pData[5] = (uint16_t) archive.ReadUInt( 16 );
+            }
+
+            if ( readScale )
+            {
+                pData[6] = (uint16_t) archive.ReadUInt( 16 );
+            }
+
+            pData += QuantizedPose::s_numValuesPerBone;
+        }
+
+        if ( !IsFullyConsumed() )
+        {
+            return false;
+        }
+
+        m_state = state;
+        m_encodedData.swap( encodedData );
+        return true;
+    }
+}
@@ -0,0 +1,67 @@
+#pragma once
+
+#include "AnimationPose.h"
+#include "Base/Serialization/BitSerialization.h"
+
+//-------------------------------------------------------------------------
+// Pose Snapshot
+//-------------------------------------------------------------------------
+// A compact, quantized copy of a pose's parent-space transforms that can be transmitted or persisted
+// This is the fallback for when a pose cannot be recreated from the serialized task list (i.e. physics tasks)
+//
+// Transforms are quantized against the skeleton's reference pose using fixed ranges (see QuantizedPose)
+// When serializing, a previously transmitted snapshot can be supplied as a baseline and only bones whose
+// quantized values differ from the baseline will be written. The reader needs to supply the same baseline!
+
+namespace EE::Animation
+{
+    class EE_ENGINE_API PoseSnapshot
+    {
+    public:
+
+        constexpr static size_t const s_maxSerializedBits = 65536;
+        constexpr static float const s_defaultTranslationRange = 5.0f; // +/- meters from the reference pose
+        constexpr static float const s_defaultMaxScale = 4.0f;
+
+        using Archive = Serialization::BitArchive<s_maxSerializedBits>;
+
+    public:
+
+        PoseSnapshot( Skeleton const* pSkeleton, float translationRange = s_defaultTranslationRange, float maxScale = s_defaultMaxScale );
+
+        inline Skeleton const* GetSkeleton() const { return m_pSkeleton; }
+        inline bool IsSet() const { return m_state != Pose::State::Unset; }
+        inline void Reset() { m_state = Pose::State::Unset; }
+
+        // Quantize the supplied pose into this snapshot
+        void Capture( Pose const& pose );
+
+        // Decode this snapshot into the supplied pose
+        void Apply( Pose& outPose ) const;
+
+        // Serialization
+        //-------------------------------------------------------------------------
+
+        // Serialize this snapshot, optionally only writing the bones that differ from the supplied baseline
+        // Returns false if the snapshot doesnt fit in the archive
+        bool Serialize( Blob& outData, PoseSnapshot const* pBaseline = nullptr ) const;
+
+        // Deserialize a snapshot, the baseline must match the one used to serialize the data
+        bool Deserialize( Blob const& inData, PoseSnapshot const* pBaseline = nullptr );
+
+        // Get the worst case (no baseline) number of bits needed to serialize a snapshot for the specified skeleton
+        static uint32_t GetMaxSerializedSizeInBits( Skeleton const* pSkeleton );
+
+    private:
+
+        bool IsCompatibleBaseline( PoseSnapshot const* pBaseline ) const;
+
+    private:
+
+        Skeleton const*             m_pSkeleton = nullptr;
+        TVector<uint16_t>           m_encodedData;
+        Float4                      m_rangeStart;
+        Float4                      m_rangeLength;
+        Pose::State                 m_state = Pose::State::Unset;
+    };
+}
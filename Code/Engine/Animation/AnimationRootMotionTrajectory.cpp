@@ -0,0 +1,248 @@
+#include "AnimationRootMotionTrajectory.h"
+#include "AnimationClip.h"
+#include "Base/Encoding/Quantization.h"
+
+//-------------------------------------------------------------------------
+
+namespace EE::Animation
+{
+    constexpr static int32_t const g_numValuesPerSample = 4;
+
+    //-------------------------------------------------------------------------
+
+    // Get the root position (XYZ) and yaw (W), the yaw will be unwrapped relative to the previous yaw
+    static Float4 GetRootPoint( Transform const& transform, float const* pPreviousYaw )
+    {
+        Vector const xAxis = transform.GetRotation().RotateVector( Vector::UnitX );
+        float yaw = Math::ATan2( xAxis.GetY(), xAxis.GetX() );
+
+        if ( pPreviousYaw != nullptr )
+        {
+            while ( ( yaw - *pPreviousYaw ) > Math::Pi )
+            {
+                yaw -= Math::TwoPi;
+            }
+
+            while ( ( yaw - *pPreviousYaw ) < -Math::Pi )
+            {
+                yaw += Math::TwoPi;
+            }
+        }
+
+        Vector const& translation = transform.GetTranslation();
+        return Float4( translation.GetX(), translation.GetY(), translation.GetZ(), yaw );
+    }
+
+    // Calculate the delta from point A to point B, in the space of point A
+    static Float4 CalculateDelta( Float4 const& a, Float4 const& b )
+    {
+        float const sinYaw = Math::Sin( -a.m_w );
+        float const cosYaw = Math::Cos( -a.m_w );
+        float const dx = b.m_x - a.m_x;
+        float const dy = b.m_y - a.m_y;
+        return Float4( dx * cosYaw - dy * sinYaw, dx * sinYaw + dy * cosYaw, b.m_z - a.m_z, b.m_w - a.m_w );
+    }
+
+    // Apply delta B after delta A
+    static Float4 CombineDeltas( Float4 const& a, Float4 const& b )
+    {
+        float const sinYaw = Math::Sin( a.m_w );
+        float const cosYaw = Math::Cos( a.m_w );
+        return Float4( a.m_x + b.m_x * cosYaw - b.m_y * sinYaw, a.m_y + b.m_x * sinYaw + b.m_y * cosYaw, a.m_z + b.m_z, a.m_w + b.m_w );
+    }
+
+    static Transform DeltaToTransform( Float4 const& delta )
+    {
+        return Transform( Quaternion( Vector::UnitZ, Radians( delta.m_w ) ), Vector( delta.m_x, delta.m_y, delta.m_z ) );
+    }
+
+    //-------------------------------------------------------------------------
+
+    void RootMotionTrajectory::Create( RootMotionData const& rootMotion, Seconds duration )
+    {
+        m_encodedSamples.clear();
+        m_rangeStart = Float4::Zero;
+        m_rangeLength = Float4::Zero;
+        m_numSamples = 0;
+
+        if ( !rootMotion.IsValid() )
+        {
+            return;
+        }
+
+        // Resample the root motion
+        //-------------------------------------------------------------------------
+
+        bool const hasRootMotion = !rootMotion.m_transforms.empty() && duration > 0.0f;
+        m_numSamples = hasRootMotion ? Math::Max( 2, Math::CeilingToInt( duration.ToFloat() * s_sampleRate ) + 1 ) : 1;
+
+        TVector<Float4> points;
+        points.reserve( m_numSamples );
+
+        Vector vMin( Math::Infinity );
+        Vector vMax( -Math::Infinity );
+
+        for ( int32_t i = 0; i < m_numSamples; i++ )
+        {
+            Transform const rootTransform = hasRootMotion ? rootMotion.GetTransform( Percentage( float( i ) / ( m_numSamples - 1 ) ) ) : Transform::Identity;
+            Float4 const& point = points.emplace_back( GetRootPoint( rootTransform, ( i > 0 ) ? &points[i - 1].m_w : nullptr ) );
+
+            vMin = Vector::Min( vMin, Vector( point ) );
+            vMax = Vector::Max( vMax, Vector( point ) );
+        }
+
+        // Quantize
+        //-------------------------------------------------------------------------
+
+        m_rangeStart = vMin.ToFloat4();
+        m_rangeLength = Vector::Max( vMax - vMin, Vector::Epsilon ).ToFloat4();
+
+        m_encodedSamples.reserve( m_numSamples * g_numValuesPerSample );
+        for ( Float4 const& point : points )
+        {
+            m_encodedSamples.emplace_back( Quantization::EncodeFloat( point.m_x, m_rangeStart.m_x, m_rangeLength.m_x ) );
+            m_encodedSamples.emplace_back( Quantization::EncodeFloat( point.m_y, m_rangeStart.m_y, m_rangeLength.m_y ) );
+            m_encodedSamples.emplace_back( Quantization::EncodeFloat( point.m_z, m_rangeStart.m_z, m_rangeLength.m_z ) );
+            m_encodedSamples.emplace_back( Quantization::EncodeFloat( point.m_w, m_rangeStart.m_w, m_rangeLength.m_w ) );
+        }
+    }
+
+    //-------------------------------------------------------------------------
+
+    Float4 RootMotionTrajectory::GetPoint( Percentage time ) const
+    {
+        EE_ASSERT( IsValid() );
+
+        auto DecodeSample = [this] ( int32_t sampleIdx )
+        {
+            uint16_t const* pData = m_encodedSamples.data() + ( sampleIdx * g_numValuesPerSample );
+            float const x = Quantization::DecodeFloat( pData[0], m_rangeStart.m_x, m_rangeLength.m_x );
+            float const y = Quantization::DecodeFloat( pData[1], m_rangeStart.m_y, m_rangeLength.m_y );
+            float const z = Quantization::DecodeFloat( pData[2], m_rangeStart.m_z, m_rangeLength.m_z );
+            float const w = Quantization::DecodeFloat( pData[3], m_rangeStart.m_w, m_rangeLength.m_w );
+            return Vector( x, y, z, w );
+        };
+
+        if ( m_numSamples == 1 )
+        {
+            return DecodeSample( 0 ).ToFloat4();
+        }
+
+        float const samplePosition = Math::Clamp( time.ToFloat(), 0.0f, 1.0f ) * ( m_numSamples - 1 );
+        int32_t const lowerSampleIdx = Math::Min( (int32_t) samplePosition, m_numSamples - 2 );
+        float const percentageThrough = samplePosition - lowerSampleIdx;
+
+        return Vector::Lerp( DecodeSample( lowerSampleIdx ), DecodeSample( lowerSampleIdx + 1 ), percentageThrough ).ToFloat4();
+    }
+
+    void RootMotionTrajectory::SampleDeltasInternal( Percentage startTime, Seconds duration, bool isLooping, Seconds const* pTimeOffsets, int32_t numSamples, Float4* pOutDeltas ) const
+    {
+        EE_ASSERT( IsValid() );
+        EE_ASSERT( pTimeOffsets != nullptr && pOutDeltas != nullptr );
+
+        // No root motion
+        if ( m_numSamples == 1 || duration <= 0.0f )
+        {
+            for ( int32_t i = 0; i < numSamples; i++ )
+            {
+                pOutDeltas[i] = Float4::Zero;
+            }
+            return;
+        }
+
+        //-------------------------------------------------------------------------
+
+        Float4 const startPoint = GetPoint( startTime );
+        Float4 const firstPoint = GetPoint( 0.0f );
+        Float4 const lastPoint = GetPoint( 1.0f );
+        Float4 const deltaToEnd = CalculateDelta( startPoint, lastPoint );
+        Float4 const loopDelta = CalculateDelta( firstPoint, lastPoint );
+
+        float const durationSeconds = duration.ToFloat();
+        float const startTimeSeconds = startTime.ToFloat() * durationSeconds;
+
+        for ( int32_t i = 0; i < numSamples; i++ )
+        {
+            EE_ASSERT( pTimeOffsets[i] >= 0.0f );
+            float const sampleTime = startTimeSeconds + pTimeOffsets[i].ToFloat();
+
+            if ( !isLooping || sampleTime <= durationSeconds )
+            {
+                pOutDeltas[i] = CalculateDelta( startPoint, GetPoint( Math::Min( sampleTime / durationSeconds, 1.0f ) ) );
+            }
+            else // Accumulate the root motion of each loop
+            {
+                int32_t const numLoops = (int32_t) Math::Floor( sampleTime / durationSeconds );
+                float const timeInLoop = sampleTime - ( numLoops * durationSeconds );
+
+                Float4 delta = deltaToEnd;
+                for ( int32_t loopIdx = 1; loopIdx < numLoops; loopIdx++ )
+                {
+                    delta = CombineDeltas( delta, loopDelta );
+                }
+
+                pOutDeltas[i] = CombineDeltas( delta, CalculateDelta( firstPoint, GetPoint( timeInLoop / durationSeconds ) ) );
+            }
+        }
+    }
+
+    void RootMotionTrajectory::SampleDeltas( Percentage startTime, Seconds duration, bool isLooping, Seconds const* pTimeOffsets, int32_t numSamples, Transform* pOutDeltas ) const
+    {
+        EE_ASSERT( pOutDeltas != nullptr );
+
+        TInlineVector<Float4, 32> deltas;
+        deltas.resize( numSamples );
+        SampleDeltasInternal( startTime, duration, isLooping, pTimeOffsets, numSamples, deltas.data() );
+
+        for ( int32_t i = 0; i < numSamples; i++ )
+        {
+            pOutDeltas[i] = DeltaToTransform( deltas[i] );
+        }
+    }
+
+    void RootMotionTrajectory::SampleBlendedDeltas( BlendSource const* pSources, int32_t numSources, Seconds const* pTimeOffsets, int32_t numSamples, Transform* pOutDeltas )
+    {
+        EE_ASSERT( pSources != nullptr && numSources > 0 );
+        EE_ASSERT( pOutDeltas != nullptr );
+
+        float totalWeight = 0.0f;
+        for ( int32_t sourceIdx = 0; sourceIdx < numSources; sourceIdx++ )
+        {
+            EE_ASSERT( pSources[sourceIdx].m_pClip != nullptr && pSources[sourceIdx].m_weight >= 0.0f );
+            totalWeight += pSources[sourceIdx].m_weight;
+        }
+
+        //-------------------------------------------------------------------------
+
+        TInlineVector<Vector, 32> blendedDeltas;
+        blendedDeltas.resize( numSamples, Vector::Zero );
+
+        if ( totalWeight > 0.0f )
+        {
+            TInlineVector<Float4, 32> sourceDeltas;
+            sourceDeltas.resize( numSamples );
+
+            for ( int32_t sourceIdx = 0; sourceIdx < numSources; sourceIdx++ )
+            {
+                BlendSource const& source = pSources[sourceIdx];
+                if ( source.m_weight == 0.0f )
+                {
+                    continue;
+                }
+
+                source.m_pClip->GetRootMotionTrajectory().SampleDeltasInternal( source.m_startTime, source.m_pClip->GetDuration(), source.m_isLooping, pTimeOffsets, numSamples, sourceDeltas.data() );
+
+                Vector const weight( source.m_weight / totalWeight );
+                for ( int32_t i = 0; i < numSamples; i++ )
+                {
+                    blendedDeltas[i] = Vector::MultiplyAdd( Vector( sourceDeltas[i] ), weight, blendedDeltas[i] );
+                }
+            }
+        }
+
+        for ( int32_t i = 0; i < numSamples; i++ )
+        {
+            pOutDeltas[i] = DeltaToTransform( blendedDeltas[i].ToFloat4() );
+        }
+    }
+}
@@ -0,0 +1,71 @@
+#pragma once
+
+#include "Engine/_Module/API.h"
+#include "AnimationRootMotion.h"
+#include "Base/Time/Time.h"
+#include "Base/Types/Percentage.h"
+
+//-------------------------------------------------------------------------
+
+namespace EE::Animation
+{
+    class AnimationClip;
+
+    //-------------------------------------------------------------------------
+    // Root Motion Trajectory
+    //-------------------------------------------------------------------------
+    // A compact, precomputed copy of a clip's root motion used to predict where the character will end up
+    // The root motion is resampled at a fixed rate and each sample is quantized to 4 x 16bits (XYZ position + yaw)
+    //
+    // Only the rotation around the up axis is stored, so this is only valid for character movement!
+
+    class EE_ENGINE_API RootMotionTrajectory
+    {
+        EE_SERIALIZE( m_encodedSamples, m_rangeStart, m_rangeLength, m_numSamples );
+
+    public:
+
+        constexpr static float const s_sampleRate = 15.0f; // Samples per second
+
+        // A clip contributing to a blended trajectory query
+        struct BlendSource
+        {
+            AnimationClip const*                m_pClip = nullptr;
+            Percentage                          m_startTime = 0.0f;
+            float                               m_weight = 1.0f;
+            bool                                m_isLooping = true;
+        };
+
+    public:
+
+        inline bool IsValid() const { return m_numSamples > 0; }
+        inline int32_t GetNumSamples() const { return m_numSamples; }
+        inline size_t GetMemoryUsage() const { return m_encodedSamples.size() * sizeof( uint16_t ); }
+
+        // Build the trajectory from a clip's root motion
+        void Create( RootMotionData const& rootMotion, Seconds duration );
+
+        // Get the root motion deltas from the start time to each of the supplied time offsets (relative to the start time)
+        // Looping clips will wrap around and accumulate the root motion, non-looping clips will clamp at the end of the clip
+        void SampleDeltas( Percentage startTime, Seconds duration, bool isLooping, Seconds const* pTimeOffsets, int32_t numSamples, Transform* pOutDeltas ) const;
+
+        // Get the root motion deltas for a weighted blend of clips, the weights will be normalized
+        // The per-clip deltas are blended directly, so this is an approximation of what a blend node would produce over time
+        static void SampleBlendedDeltas( BlendSource const* pSources, int32_t numSources, Seconds const* pTimeOffsets, int32_t numSamples, Transform* pOutDeltas );
+
+    private:
+
+        // Get the decoded root position (XYZ) and unwrapped yaw (W) at the given time
+        Float4 GetPoint( Percentage time ) const;
+
+        // Get the deltas as position (XYZ) and yaw (W) so that they can be blended
+        void SampleDeltasInternal( Percentage startTime, Seconds duration, bool isLooping, Seconds const* pTimeOffsets, int32_t numSamples, Float4* pOutDeltas ) const;
+
+    private:
+
+        TVector<uint16_t>                       m_encodedSamples;
+        Float4                                  m_rangeStart = Float4::Zero;
+        Float4                                  m_rangeLength = Float4::Zero;
+        int32_t                                 m_numSamples = 0;
+    };
+}
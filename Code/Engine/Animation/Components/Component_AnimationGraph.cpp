@@ -22,6 +22,8 @@ namespace EE::Animation
 
         EE_ASSERT( m_graphDefinition.IsLoaded() );
         m_pGraphInstance = EE::New<GraphInstance>( m_graphDefinition.GetPtr(), GetEntityID().m_value );
+        m_pGraphInstance->SetCachedPoseStorageMode( m_quantizeCachedPoses ? CachedPoseStorageMode::Quantized : CachedPoseStorageMode::FullPrecision );
+        m_pGraphInstance->SetCachedPoseMemoryBudget( size_t( m_cachedPoseMemoryBudgetKB ) * 1024 );
 
         if ( !m_secondarySkeletons.empty() )
         {
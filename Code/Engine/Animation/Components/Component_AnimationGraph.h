@@ -171,6 +171,12 @@ namespace EE::Animation
         EE_REFLECT();
         bool                                                    m_applyRootMotionToEntity = false; // Should we apply the root motion delta automatically to the character once we evaluate the graph. (Note: only works if we dont require a manual update)
 
+        EE_REFLECT();
+        bool                                                    m_quantizeCachedPoses = false; // Should cached poses (used for forced transitions) be stored quantized. Lossy but uses less than half the memory.
+
+        EE_REFLECT();
+        uint32_t                                                m_cachedPoseMemoryBudgetKB = 0; // The memory budget for cached poses, this is only used for reporting (0 = no budget)
+
         bool                                                    m_graphStateResetRequested = false;
     };
 }
\ No newline at end of file
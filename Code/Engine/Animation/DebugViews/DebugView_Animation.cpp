@@ -126,6 +126,25 @@ namespace EE::Animation
             return;
         }
 
+        // Cached pose memory
+        //-------------------------------------------------------------------------
+
+        size_t const cachedPoseMemoryUsage = pTaskSystem->GetCachedPoseMemoryUsage();
+        size_t const cachedPoseMemoryBudget = pTaskSystem->GetCachedPoseMemoryBudget();
+        char const* const pStorageModeName = ( pTaskSystem->GetCachedPoseStorageMode() == CachedPoseStorageMode::Quantized ) ? "Quantized" : "Full Precision";
+
+        if ( cachedPoseMemoryBudget > 0 )
+        {
+            Color const textColor = ( cachedPoseMemoryUsage > cachedPoseMemoryBudget ) ? Colors::Red : Colors::Lime;
+            ImGui::TextColored( textColor.ToFloat4(), "Cached Poses (%s): %.2fKB / %.2fKB", pStorageModeName, cachedPoseMemoryUsage / 1024.0f, cachedPoseMemoryBudget / 1024.0f );
+        }
+        else
+        {
+            ImGui::Text( "Cached Poses (%s): %.2fKB", pStorageModeName, cachedPoseMemoryUsage / 1024.0f );
+        }
+
+        //-------------------------------------------------------------------------
+
         if ( !pTaskSystem->HasTasks() )
         {
             ImGui::Text( "No Active Tasks" );
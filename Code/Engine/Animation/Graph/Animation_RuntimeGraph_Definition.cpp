@@ -0,0 +1,222 @@
+#include "Animation_RuntimeGraph_Definition.h"
+#include "Base/Profiling.h"
+#include "EASTL/sort.h"
+
+//-------------------------------------------------------------------------
+
+namespace EE::Animation
+{
+    GraphDefinition::~GraphDefinition()
+    {
+        DestroyInstanceTemplate();
+    }
+
+    //-------------------------------------------------------------------------
+    // Instantiation Template
+    //-------------------------------------------------------------------------
+    // We instantiate the graph twice into two separate zeroed memory blocks and then compare the results.
+    // Any pointer-sized value that differs by exactly the distance between the two blocks and points into the first block is a node ptr that needs to be relocated.
+    // Any other difference means the node contains instance specific data (i.e. heap allocations) and so cannot be safely copied.
+
+    void GraphDefinition::CreateInstanceTemplate()
+    {
+        EE_PROFILE_FUNCTION_ANIMATION();
+        EE_ASSERT( m_pInstanceTemplate == nullptr );
+        EE_ASSERT( m_instanceRequiredAlignment >= alignof( uintptr_t ) );
+
+        int16_t const numNodes = (int16_t) m_instanceNodeStartOffsets.size();
+        EE_ASSERT( m_nodeDefinitions.size() == numNodes );
+
+        if ( numNodes == 0 || m_instanceRequiredMemory == 0 )
+        {
+            return;
+        }
+
+        // Referenced graph nodes point to their own child instances so we always need to instantiate them per instance
+        //-------------------------------------------------------------------------
+
+        TVector<bool> shouldInstantiateNode;
+        shouldInstantiateNode.resize( numNodes, true );
+
+        for ( ReferencedGraphSlot const& referencedGraphSlot : m_referencedGraphSlots )
+        {
+            shouldInstantiateNode[referencedGraphSlot.m_nodeIdx] = false;
+        }
+
+        TVector<bool> isNodeTemplated = shouldInstantiateNode;
+
+        // Calculate the memory range for each node
+        //-------------------------------------------------------------------------
+
+        TVector<int16_t> nodesSortedByOffset;
+        nodesSortedByOffset.resize( numNodes );
+        for ( int16_t i = 0; i < numNodes; i++ )
+        {
+            nodesSortedByOffset[i] = i;
+        }
+
+        eastl::sort( nodesSortedByOffset.begin(), nodesSortedByOffset.end(), [this] ( int16_t a, int16_t b ) { return m_instanceNodeStartOffsets[a] < m_instanceNodeStartOffsets[b]; } );
+
+        TVector<uint32_t> nodeEndOffsets;
+        nodeEndOffsets.resize( numNodes, m_instanceRequiredMemory );
+        for ( int16_t i = 0; i < numNodes - 1; i++ )
+        {
+            nodeEndOffsets[nodesSortedByOffset[i]] = m_instanceNodeStartOffsets[nodesSortedByOffset[i + 1]];
+        }
+
+        // Instantiate the graph into two separate images
+        //-------------------------------------------------------------------------
+
+        uint8_t* pImages[2] = { nullptr, nullptr };
+        TVector<GraphNode*> nodePtrs[2];
+        TInlineVector<GraphInstance*, 20> const referencedGraphInstances( m_referencedGraphSlots.size(), nullptr );
+
+        #if EE_DEVELOPMENT_TOOLS
+        TVector<GraphLogEntry> log;
+        #endif
+
+        for ( int32_t imageIdx = 0; imageIdx < 2; imageIdx++ )
+        {
+            pImages[imageIdx] = reinterpret_cast<uint8_t*>( EE::Alloc( m_instanceRequiredMemory, m_instanceRequiredAlignment ) );
+            memset( pImages[imageIdx], 0, m_instanceRequiredMemory );
+
+            nodePtrs[imageIdx].reserve( numNodes );
+            for ( uint32_t const nodeOffset : m_instanceNodeStartOffsets )
+            {
+                nodePtrs[imageIdx].emplace_back( reinterpret_cast<GraphNode*>( pImages[imageIdx] + nodeOffset ) );
+            }
+
+            // Use a different user ID per image so that any nodes that store it are detected as instance specific
+            InstantiationContext instantiationContext = { (int16_t) InvalidIndex, nodePtrs[imageIdx], referencedGraphInstances, m_skeleton.GetPtr(), m_parameterLookupMap, &m_resources, (uint64_t) imageIdx };
+
+            #if EE_DEVELOPMENT_TOOLS
+            instantiationContext.m_pLog = &log;
+            #endif
+
+            for ( int16_t i = 0; i < numNodes; i++ )
+            {
+                if ( !shouldInstantiateNode[i] )
+                {
+                    continue;
+                }
+
+                #if EE_DEVELOPMENT_TOOLS
+                size_t const numLogEntries = log.size();
+                #endif
+
+                instantiationContext.m_currentNodeIdx = i;
+                m_nodeDefinitions[i]->InstantiateNode( instantiationContext, InstantiationOptions::CreateNode );
+
+                // Any instantiation warnings need to be reported to each graph instance
+                #if EE_DEVELOPMENT_TOOLS
+                if ( log.size() != numLogEntries )
+                {
+                    isNodeTemplated[i] = false;
+                }
+                #endif
+            }
+        }
+
+        // Find all the relocations and any nodes that cannot be copied
+        //-------------------------------------------------------------------------
+
+        uintptr_t const imageStart = reinterpret_cast<uintptr_t>( pImages[0] );
+        uintptr_t const imageEnd = imageStart + m_instanceRequiredMemory;
+        uintptr_t const imageDelta = reinterpret_cast<uintptr_t>( pImages[1] ) - imageStart;
+
+        TInlineVector<uint32_t, 20> nodeRelocations;
+
+        for ( int16_t i = 0; i < numNodes; i++ )
+        {
+            if ( !isNodeTemplated[i] )
+            {
+                continue;
+            }
+
+            nodeRelocations.clear();
+
+            uint32_t offset = m_instanceNodeStartOffsets[i];
+            EE_ASSERT( ( offset % alignof( uintptr_t ) ) == 0 );
+
+            for ( ; offset + sizeof( uintptr_t ) <= nodeEndOffsets[i]; offset += sizeof( uintptr_t ) )
+            {
+                uintptr_t const value0 = *reinterpret_cast<uintptr_t const*>( pImages[0] + offset );
+                uintptr_t const value1 = *reinterpret_cast<uintptr_t const*>( pImages[1] + offset );
+
+                if ( value0 == value1 )
+                {
+                    continue;
+                }
+
+                if ( ( value1 - value0 ) == imageDelta && value0 >= imageStart && value0 < imageEnd )
+                {
+                    nodeRelocations.emplace_back( offset );
+                }
+                else
+                {
+                    isNodeTemplated[i] = false;
+                    break;
+                }
+            }
+
+            // Compare any trailing bytes
+            if ( isNodeTemplated[i] && offset < nodeEndOffsets[i] )
+            {
+                isNodeTemplated[i] = ( memcmp( pImages[0] + offset, pImages[1] + offset, nodeEndOffsets[i] - offset ) == 0 );
+            }
+
+            if ( isNodeTemplated[i] )
+            {
+                m_instanceTemplateRelocations.insert( m_instanceTemplateRelocations.end(), nodeRelocations.begin(), nodeRelocations.end() );
+            }
+        }
+
+        // Create the template image
+        //-------------------------------------------------------------------------
+
+        m_pInstanceTemplate = reinterpret_cast<uint8_t*>( EE::Alloc( m_instanceRequiredMemory, m_instanceRequiredAlignment ) );
+        memcpy( m_pInstanceTemplate, pImages[0], m_instanceRequiredMemory );
+
+        for ( uint32_t const relocationOffset : m_instanceTemplateRelocations )
+        {
+            *reinterpret_cast<uintptr_t*>( m_pInstanceTemplate + relocationOffset ) -= imageStart;
+        }
+
+        for ( int16_t i = 0; i < numNodes; i++ )
+        {
+            if ( !isNodeTemplated[i] )
+            {
+                m_nonTemplatedNodeIndices.emplace_back( i );
+                memset( m_pInstanceTemplate + m_instanceNodeStartOffsets[i], 0, nodeEndOffsets[i] - m_instanceNodeStartOffsets[i] );
+            }
+        }
+
+        // Destroy the temporary images
+        //-------------------------------------------------------------------------
+
+        for ( int32_t imageIdx = 0; imageIdx < 2; imageIdx++ )
+        {
+            for ( int16_t i = 0; i < numNodes; i++ )
+            {
+                if ( shouldInstantiateNode[i] )
+                {
+                    nodePtrs[imageIdx][i]->~GraphNode();
+                }
+            }
+
+            EE::Free( pImages[imageIdx] );
+        }
+    }
+
+    void GraphDefinition::DestroyInstanceTemplate()
+    {
+        // The template nodes are never destroyed since only nodes without any instance specific data are stored in the template
+        if ( m_pInstanceTemplate != nullptr )
+        {
+            EE::Free( m_pInstanceTemplate );
+        }
+
+        m_instanceTemplateRelocations.clear();
+        m_nonTemplatedNodeIndices.clear();
+    }
+}
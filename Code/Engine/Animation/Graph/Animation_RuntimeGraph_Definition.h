@@ -48,6 +48,8 @@ namespace EE::Animation
 
     public:
 
+        ~GraphDefinition();
+
         virtual bool IsValid() const override
         {
             return m_variationID.IsValid() && m_skeleton.IsLoaded() && m_rootNodeIdx != InvalidIndex;
@@ -86,6 +88,16 @@ namespace EE::Animation
             return nullptr;
         }
 
+    private:
+
+        // Instantiate all the nodes once into a template image that new graph instances can be copied from
+        // Node ptrs within the template are stored as offsets from the start of the image and need to be fixed up after copying
+        void CreateInstanceTemplate();
+        void DestroyInstanceTemplate();
+
+        // Does this definition have a valid instantiation template
+        inline bool HasInstanceTemplate() const { return m_pInstanceTemplate != nullptr; }
+
     protected:
 
         StringID                                    m_variationID;
@@ -112,6 +124,11 @@ namespace EE::Animation
         THashMap<StringID, int16_t>                 m_parameterLookupMap; // Filled by the animation graph loader
         TVector<GraphNode::Definition*>             m_nodeDefinitions; // Filled by the animation graph loader
 
+        // Instantiation template - created by the animation graph loader
+        uint8_t*                                    m_pInstanceTemplate = nullptr;
+        TVector<uint32_t>                           m_instanceTemplateRelocations; // The offsets of all the node ptrs within the template that need to be fixed up
+        TVector<int16_t>                            m_nonTemplatedNodeIndices; // Nodes that cannot be copied and need to be individually instantiated for each graph instance
+
         // Dataset
         //-------------------------------------------------------------------------
 
@@ -112,10 +112,31 @@ namespace EE::Animation
         instantiationContext.m_pLog = &m_log;
         #endif
 
-        for ( int16_t i = 0; i < numNodes; i++ )
+        if ( m_pGraphDefinition->HasInstanceTemplate() )
         {
-            instantiationContext.m_currentNodeIdx = i;
-            m_pGraphDefinition->m_nodeDefinitions[i]->InstantiateNode( instantiationContext, InstantiationOptions::CreateNode );
+            // Copy the template and fix up all the node ptrs
+            memcpy( m_pAllocatedInstanceMemory, m_pGraphDefinition->m_pInstanceTemplate, m_pGraphDefinition->m_instanceRequiredMemory );
+
+            uintptr_t const instanceMemoryStart = reinterpret_cast<uintptr_t>( m_pAllocatedInstanceMemory );
+            for ( uint32_t const relocationOffset : m_pGraphDefinition->m_instanceTemplateRelocations )
+            {
+                *reinterpret_cast<uintptr_t*>( m_pAllocatedInstanceMemory + relocationOffset ) += instanceMemoryStart;
+            }
+
+            // Instantiate any nodes that could not be templated
+            for ( int16_t nodeIdx : m_pGraphDefinition->m_nonTemplatedNodeIndices )
+            {
+                instantiationContext.m_currentNodeIdx = nodeIdx;
+                m_pGraphDefinition->m_nodeDefinitions[nodeIdx]->InstantiateNode( instantiationContext, InstantiationOptions::CreateNode );
+            }
+        }
+        else
+        {
+            for ( int16_t i = 0; i < numNodes; i++ )
+            {
+                instantiationContext.m_currentNodeIdx = i;
+                m_pGraphDefinition->m_nodeDefinitions[i]->InstantiateNode( instantiationContext, InstantiationOptions::CreateNode );
+            }
         }
 
         // Set up graph context
@@ -228,10 +249,17 @@ namespace EE::Animation
         return m_pTaskSystem->RequiresUpdate();
     }
 
-    void GraphInstance::SerializeTaskList( Blob& outBlob ) const
+    bool GraphInstance::SerializeTaskList( Blob& outBlob ) const
     {
         EE_ASSERT( !DoesTaskSystemNeedUpdate() );
-        m_pTaskSystem->SerializeTasks( m_resourceMappings, outBlob );
+        return m_pTaskSystem->SerializeTasks( m_resourceMappings, outBlob );
+    }
+
+    void GraphInstance::CapturePoseSnapshot( PoseSnapshot& outSnapshot ) const
+    {
+        EE_ASSERT( m_isStandaloneGraph );
+        EE_ASSERT( !DoesTaskSystemNeedUpdate() );
+        outSnapshot.Capture( *m_pTaskSystem->GetPrimaryPose() );
     }
 
     //-------------------------------------------------------------------------
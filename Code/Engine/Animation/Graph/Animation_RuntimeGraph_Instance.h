@@ -4,6 +4,7 @@
 #include "Animation_RuntimeGraph_Context.h"
 #include "Nodes/Animation_RuntimeGraphNode_Parameters.h"
 #include "Engine/Animation/TaskSystem/Animation_TaskSystem.h"
+#include "Engine/Animation/AnimationPoseSnapshot.h"
 #include "Base/Types/PointerID.h"
 
 //-------------------------------------------------------------------------
@@ -115,11 +116,38 @@ namespace EE::Animation
         bool DoesTaskSystemNeedUpdate() const;
 
         // Serialize the currently registered pose tasks. Note: This can only be done after the task system has executed!
-        void SerializeTaskList( Blob& outBlob ) const;
+        // Returns false if the task list contains tasks that cannot be serialized (i.e. physics tasks)
+        bool SerializeTaskList( Blob& outBlob ) const;
+
+        // Capture a quantized snapshot of the final primary pose. Use this as a fallback when the task list cannot be serialized
+        // Note: This can only be done after the task system has executed!
+        void CapturePoseSnapshot( PoseSnapshot& outSnapshot ) const;
 
         // Get generated resource mappings
         ResourceMappings const &GetResourceMappings() const { return m_resourceMappings; }
 
+        // Cached Poses
+        //-------------------------------------------------------------------------
+        // Cached poses are used by transitions to store source poses for forced transitions
+
+        // Get how cached poses are stored
+        inline CachedPoseStorageMode GetCachedPoseStorageMode() const { EE_ASSERT( m_isStandaloneGraph ); return m_pTaskSystem->GetCachedPoseStorageMode(); }
+
+        // Set how cached poses are stored - quantized storage is lossy but uses less than half the memory
+        inline void SetCachedPoseStorageMode( CachedPoseStorageMode storageMode ) { EE_ASSERT( m_isStandaloneGraph ); m_pTaskSystem->SetCachedPoseStorageMode( storageMode ); }
+
+        // Get the memory budget for this instance's cached poses (0 = no budget)
+        inline size_t GetCachedPoseMemoryBudget() const { EE_ASSERT( m_isStandaloneGraph ); return m_pTaskSystem->GetCachedPoseMemoryBudget(); }
+
+        // Set the memory budget for this instance's cached poses (0 = no budget)
+        inline void SetCachedPoseMemoryBudget( size_t budgetInBytes ) { EE_ASSERT( m_isStandaloneGraph ); m_pTaskSystem->SetCachedPoseMemoryBudget( budgetInBytes ); }
+
+        // Get the memory currently used by this instance's cached poses
+        inline size_t GetCachedPoseMemoryUsage() const { EE_ASSERT( m_isStandaloneGraph ); return m_pTaskSystem->GetCachedPoseMemoryUsage(); }
+
+        // Are we using more memory for cached poses than our budget allows
+        inline bool IsOverCachedPoseMemoryBudget() const { size_t const budget = GetCachedPoseMemoryBudget(); return budget > 0 && GetCachedPoseMemoryUsage() > budget; }
+
         // Graph State
         //-------------------------------------------------------------------------
 
@@ -18,7 +18,7 @@ namespace EE::Animation
         m_pTypeRegistry = pTypeRegistry;
     }
 
-    Resource::ResourceLoader::LoadResult AnimationClipLoader::Load( ResourceID const& resourceID, FileSystem::Path const& resourcePath, Resource::ResourceRecord* pResourceRecord, Serialization::BinaryInputArchive& archive ) const
+    Resource::ResourceLoader::LoadResult AnimationClipLoader::Load( ResourceID const& resourceID, FileSystem::Path const& resourcePath, Resource::ResourceRecord* pResourceRecord, Serialization::BinaryInputArchive& archive, Blob& rawResourceData ) const
     {
         EE_ASSERT(  m_pTypeRegistry != nullptr );
 
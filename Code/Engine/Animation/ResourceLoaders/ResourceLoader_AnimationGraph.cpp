@@ -12,7 +12,7 @@ namespace EE::Animation
         m_loadableTypes.push_back( GraphDefinition::GetStaticResourceTypeID() );
     }
 
-    Resource::ResourceLoader::LoadResult GraphLoader::Load( ResourceID const& resourceID, FileSystem::Path const& resourcePath, Resource::ResourceRecord* pResourceRecord, Serialization::BinaryInputArchive& archive ) const
+    Resource::ResourceLoader::LoadResult GraphLoader::Load( ResourceID const& resourceID, FileSystem::Path const& resourcePath, Resource::ResourceRecord* pResourceRecord, Serialization::BinaryInputArchive& archive, Blob& rawResourceData ) const
     {
         auto const resourceTypeID = resourceID.GetResourceTypeID();
 
@@ -107,6 +107,12 @@ namespace EE::Animation
             }
         }
 
+        // Create instantiation template
+        //-------------------------------------------------------------------------
+        // This needs to be done after all the resources have been set since nodes will cache resource ptrs
+
+        pGraphDefinition->CreateInstanceTemplate();
+
         //-------------------------------------------------------------------------
 
         return ResourceLoader::Install( resourceID, installDependencies, pResourceRecord );
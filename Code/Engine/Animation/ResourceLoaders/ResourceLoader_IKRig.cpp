@@ -11,7 +11,7 @@ namespace EE::Animation
         m_loadableTypes.push_back( IKRigDefinition::GetStaticResourceTypeID() );
     }
 
-    Resource::ResourceLoader::LoadResult IKRigLoader::Load( ResourceID const& resourceID, FileSystem::Path const& resourcePath, Resource::ResourceRecord* pResourceRecord, Serialization::BinaryInputArchive& archive ) const
+    Resource::ResourceLoader::LoadResult IKRigLoader::Load( ResourceID const& resourceID, FileSystem::Path const& resourcePath, Resource::ResourceRecord* pResourceRecord, Serialization::BinaryInputArchive& archive, Blob& rawResourceData ) const
     {
         IKRigDefinition* pDefinition = EE::New<IKRigDefinition>();
         archive << *pDefinition;
@@ -85,15 +85,171 @@ namespace EE::Animation
     // Cached Pose Buffer
     //-------------------------------------------------------------------------
 
-    void CachedPoseBuffer::Release( Pose::Type poseType )
+    CachedPoseBuffer::CachedPoseBuffer( Skeleton const* pSkeleton, SecondarySkeletonList const& secondarySkeletons, CachedPoseStorageMode storageMode )
+        : m_storageMode( storageMode )
     {
-        PoseBuffer::Release( poseType );
+        EE_ASSERT( pSkeleton != nullptr );
+
+        if ( IsQuantized() )
+        {
+            m_quantizedPoses.emplace_back( pSkeleton );
+            for ( Skeleton const* pSecondarySkeleton : secondarySkeletons )
+            {
+                m_quantizedPoses.emplace_back( pSecondarySkeleton );
+            }
+        }
+        else
+        {
+            m_poses.emplace_back( pSkeleton );
+            for ( Skeleton const* pSecondarySkeleton : secondarySkeletons )
+            {
+                m_poses.emplace_back( pSecondarySkeleton );
+            }
+        }
+    }
+
+    void CachedPoseBuffer::CopyFrom( PoseBuffer const& source )
+    {
+        int32_t const numSourcePoses = (int32_t) source.m_poses.size();
+
+        // The set of secondary skeletons can change while we are cached, so always match the source buffer
+        auto MatchSourceSkeletons = [&source, numSourcePoses] ( auto& poses )
+        {
+            while ( poses.size() > numSourcePoses )
+            {
+                poses.pop_back();
+            }
+
+            for ( int32_t poseIdx = 0; poseIdx < numSourcePoses; poseIdx++ )
+            {
+                Skeleton const* pSkeleton = source.m_poses[poseIdx].GetSkeleton();
+                if ( poseIdx < poses.size() )
+                {
+                    poses[poseIdx].ChangeSkeleton( pSkeleton );
+                }
+                else
+                {
+                    poses.emplace_back( pSkeleton );
+                }
+            }
+        };
+
+        //-------------------------------------------------------------------------
+
+        if ( IsQuantized() )
+        {
+            MatchSourceSkeletons( m_quantizedPoses );
+            for ( int32_t poseIdx = 0; poseIdx < numSourcePoses; poseIdx++ )
+            {
+                m_quantizedPoses[poseIdx].Encode( source.m_poses[poseIdx] );
+            }
+        }
+        else
+        {
+            MatchSourceSkeletons( m_poses );
+            for ( int32_t poseIdx = 0; poseIdx < numSourcePoses; poseIdx++ )
+            {
+                m_poses[poseIdx].CopyFrom( source.m_poses[poseIdx] );
+            }
+        }
+    }
+
+    void CachedPoseBuffer::CopyTo( PoseBuffer& destination ) const
+    {
+        int32_t const numDestinationPoses = (int32_t) destination.m_poses.size();
+        int32_t const numStoredPoses = IsQuantized() ? (int32_t) m_quantizedPoses.size() : (int32_t) m_poses.size();
+
+        for ( int32_t poseIdx = 0; poseIdx < numDestinationPoses; poseIdx++ )
+        {
+            Pose& destinationPose = destination.m_poses[poseIdx];
+
+            // Secondary skeleton set might have changed since we cached this pose
+            if ( poseIdx >= numStoredPoses )
+            {
+                destinationPose.Reset( Pose::Type::None );
+                continue;
+            }
+
+            if ( IsQuantized() )
+            {
+                EE_ASSERT( m_quantizedPoses[poseIdx].GetSkeleton() == destinationPose.GetSkeleton() );
+                m_quantizedPoses[poseIdx].Decode( destinationPose );
+            }
+            else
+            {
+                EE_ASSERT( m_poses[poseIdx].GetSkeleton() == destinationPose.GetSkeleton() );
+                destinationPose.CopyFrom( m_poses[poseIdx] );
+            }
+        }
+    }
+
+    size_t CachedPoseBuffer::GetMemoryUsage() const
+    {
+        size_t memoryUsage = 0;
+
+        for ( Pose const& pose : m_poses )
+        {
+            memoryUsage += ( pose.GetTransforms().capacity() + pose.GetModelSpaceTransforms().capacity() ) * sizeof( Transform );
+        }
+
+        for ( QuantizedPose const& quantizedPose : m_quantizedPoses )
+        {
+            memoryUsage += quantizedPose.GetMemoryUsage();
+        }
+
+        return memoryUsage;
+    }
+
+    void CachedPoseBuffer::Release()
+    {
+        for ( Pose& pose : m_poses )
+        {
+            pose.Reset( Pose::Type::None );
+        }
+
+        for ( QuantizedPose& quantizedPose : m_quantizedPoses )
+        {
+            quantizedPose.Reset();
+        }
+
         m_ID.Clear();
+        m_isUsed = false;
         m_isLifetimeInternallyManaged = false;
         m_wasAccessed = false;
         m_shouldBeReset = false;
     }
 
+    void CachedPoseBuffer::SetStorageMode( CachedPoseStorageMode storageMode )
+    {
+        if ( m_storageMode == storageMode )
+        {
+            return;
+        }
+
+        //-------------------------------------------------------------------------
+
+        if ( storageMode == CachedPoseStorageMode::Quantized )
+        {
+            for ( Pose const& pose : m_poses )
+            {
+                m_quantizedPoses.emplace_back( pose.GetSkeleton() ).Encode( pose );
+            }
+
+            m_poses.clear();
+        }
+        else
+        {
+            for ( QuantizedPose const& quantizedPose : m_quantizedPoses )
+            {
+                quantizedPose.Decode( m_poses.emplace_back( quantizedPose.GetSkeleton() ) );
+            }
+
+            m_quantizedPoses.clear();
+        }
+
+        m_storageMode = storageMode;
+    }
+
     //-------------------------------------------------------------------------
     // Pose Buffer Pool
     //-------------------------------------------------------------------------
@@ -113,7 +269,7 @@ namespace EE::Animation
         for ( auto i = 0; i < s_numInitialBuffers; i++ )
         {
             m_poseBuffers.emplace_back( PoseBuffer( m_pPrimarySkeleton, m_secondarySkeletons ) );
-            m_cachedBuffers.emplace_back( CachedPoseBuffer( m_pPrimarySkeleton, m_secondarySkeletons ) );
+            m_cachedBuffers.emplace_back( CachedPoseBuffer( m_pPrimarySkeleton, m_secondarySkeletons, m_cachedPoseStorageMode ) );
 
             #if EE_DEVELOPMENT_TOOLS
             m_debugPoseBuffers.emplace_back( PoseBuffer( m_pPrimarySkeleton, m_secondarySkeletons ) );
@@ -277,7 +433,7 @@ namespace EE::Animation
         {
             for ( auto i = 0; i < s_bufferGrowAmount; i++ )
             {
-                pCachedPoseBuffer = &m_cachedBuffers.emplace_back( CachedPoseBuffer( m_pPrimarySkeleton, m_secondarySkeletons ) );
+                pCachedPoseBuffer = &m_cachedBuffers.emplace_back( CachedPoseBuffer( m_pPrimarySkeleton, m_secondarySkeletons, m_cachedPoseStorageMode ) );
             }
 
             EE_ASSERT( m_cachedBuffers.size() < 255 );
@@ -404,7 +560,7 @@ namespace EE::Animation
         return pFoundCachedPoseBuffer;
     }
 
-    PoseBuffer* PoseBufferPool::GetOrCreateCachedPoseBuffer( CachedPoseID cachedPoseID, bool isLifetimeManagedByPosePool )
+    CachedPoseBuffer* PoseBufferPool::GetOrCreateCachedPoseBuffer( CachedPoseID cachedPoseID, bool isLifetimeManagedByPosePool )
     {
         CachedPoseBuffer* pBuffer = GetCachedPoseBufferInternal( cachedPoseID );
         if ( pBuffer == nullptr )
@@ -417,6 +573,33 @@ namespace EE::Animation
 
     //-------------------------------------------------------------------------
 
+    void PoseBufferPool::SetCachedPoseStorageMode( CachedPoseStorageMode storageMode )
+    {
+        if ( m_cachedPoseStorageMode == storageMode )
+        {
+            return;
+        }
+
+        m_cachedPoseStorageMode = storageMode;
+
+        for ( auto& cachedBuffer : m_cachedBuffers )
+        {
+            cachedBuffer.SetStorageMode( m_cachedPoseStorageMode );
+        }
+    }
+
+    size_t PoseBufferPool::GetCachedPoseMemoryUsage() const
+    {
+        size_t memoryUsage = 0;
+        for ( auto const& cachedBuffer : m_cachedBuffers )
+        {
+            memoryUsage += cachedBuffer.GetMemoryUsage();
+        }
+        return memoryUsage;
+    }
+
+    //-------------------------------------------------------------------------
+
     #if EE_DEVELOPMENT_TOOLS
     void PoseBufferPool::ValidateSetOfSecondarySkeletons( Skeleton const* pPrimarySkeleton, SecondarySkeletonList const& secondarySkeletons )
     {
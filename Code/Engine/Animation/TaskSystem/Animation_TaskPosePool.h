@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Engine/Animation/AnimationPose.h"
+#include "Engine/Animation/AnimationPoseQuantization.h"
 
 //-------------------------------------------------------------------------
 
@@ -84,17 +85,43 @@ namespace EE::Animation
 
     //-------------------------------------------------------------------------
 
-    struct EE_ENGINE_API CachedPoseBuffer : public PoseBuffer
+    // How should we store cached poses
+    enum class CachedPoseStorageMode : uint8_t
+    {
+        FullPrecision = 0,
+        Quantized, // Lossy but significantly smaller, see QuantizedPose
+    };
+
+    //-------------------------------------------------------------------------
+
+    struct EE_ENGINE_API CachedPoseBuffer
     {
         friend class PoseBufferPool;
 
     public:
 
-        using PoseBuffer::PoseBuffer;
+        CachedPoseBuffer( Skeleton const* pSkeleton, SecondarySkeletonList const& secondarySkeletons, CachedPoseStorageMode storageMode );
+
+        inline bool IsQuantized() const { return m_storageMode == CachedPoseStorageMode::Quantized; }
+        inline bool IsPoseSet() const { return IsQuantized() ? m_quantizedPoses[0].IsPoseSet() : m_poses[0].IsPoseSet(); }
+
+        // Store a copy of the supplied pose buffer
+        void CopyFrom( PoseBuffer const& source );
+        inline void CopyFrom( PoseBuffer const* pSource ) { CopyFrom( *pSource ); }
+
+        // Copy the stored poses into the supplied pose buffer
+        void CopyTo( PoseBuffer& destination ) const;
+        inline void CopyTo( PoseBuffer* pDestination ) const { CopyTo( *pDestination ); }
+
+        // Get the memory currently allocated for pose storage
+        size_t GetMemoryUsage() const;
 
     private:
 
-        void Release( Pose::Type poseType = Pose::Type::None );
+        void Release();
+
+        // Switch the storage mode, this will convert any existing stored pose
+        void SetStorageMode( CachedPoseStorageMode storageMode );
 
     public:
 
@@ -102,6 +129,13 @@ namespace EE::Animation
         bool                                m_isLifetimeInternallyManaged = false; // Is the lifetime of this buffer controlled by the pose pool
         bool                                m_wasAccessed = false; // Did we either read or write to this buffer in a given update
         bool                                m_shouldBeReset = false;
+
+    private:
+
+        TInlineVector<Pose, 3>              m_poses;            // Full precision storage
+        TInlineVector<QuantizedPose, 3>     m_quantizedPoses;   // Quantized storage
+        CachedPoseStorageMode               m_storageMode = CachedPoseStorageMode::FullPrecision;
+        bool                                m_isUsed = false;
     };
 
     //-------------------------------------------------------------------------
@@ -166,11 +200,31 @@ namespace EE::Animation
         void ResetCachedPoseBuffer( CachedPoseID cachedPoseID );
 
         // Try to get a pose-buffer with the specified ID, returns null if it cant find a buffer with the specified ID
-        PoseBuffer* GetCachedPoseBuffer( CachedPoseID cachedPoseID ) { return GetCachedPoseBufferInternal( cachedPoseID ); }
+        CachedPoseBuffer* GetCachedPoseBuffer( CachedPoseID cachedPoseID ) { return GetCachedPoseBufferInternal( cachedPoseID ); }
 
         // Get a pose-buffer with the specified ID.
         // NOTE! This will create a buffer if one does not exist!!!
-        PoseBuffer* GetOrCreateCachedPoseBuffer( CachedPoseID cachedPoseID, bool isLifetimeManagedByPosePool = false );
+        CachedPoseBuffer* GetOrCreateCachedPoseBuffer( CachedPoseID cachedPoseID, bool isLifetimeManagedByPosePool = false );
+
+        // Cached Pose Storage
+        //-------------------------------------------------------------------------
+
+        inline CachedPoseStorageMode GetCachedPoseStorageMode() const { return m_cachedPoseStorageMode; }
+
+        // Change how cached poses are stored, existing cached poses will be converted
+        void SetCachedPoseStorageMode( CachedPoseStorageMode storageMode );
+
+        // Get the memory budget for cached pose storage (0 = no budget)
+        inline size_t GetCachedPoseMemoryBudget() const { return m_cachedPoseMemoryBudget; }
+
+        // Set the memory budget for cached pose storage (0 = no budget)
+        inline void SetCachedPoseMemoryBudget( size_t budgetInBytes ) { m_cachedPoseMemoryBudget = budgetInBytes; }
+
+        // Get the memory currently allocated by all cached pose buffers
+        size_t GetCachedPoseMemoryUsage() const;
+
+        // Are we currently using more memory for cached poses than our budget allows
+        inline bool IsOverCachedPoseMemoryBudget() const { return m_cachedPoseMemoryBudget > 0 && GetCachedPoseMemoryUsage() > m_cachedPoseMemoryBudget; }
 
         // Debug
         //-------------------------------------------------------------------------
@@ -196,6 +250,8 @@ namespace EE::Animation
         int8_t                                      m_firstFreeCachedBuffer = 0;
         int8_t                                      m_firstFreeBuffer = 0;
         uint8_t                                     m_nextCachedPoseID = 0;
+        CachedPoseStorageMode                       m_cachedPoseStorageMode = CachedPoseStorageMode::FullPrecision;
+        size_t                                      m_cachedPoseMemoryBudget = 0;
 
         Skeleton const*                             m_pPrimarySkeleton = nullptr;
         SecondarySkeletonList                       m_secondarySkeletons;
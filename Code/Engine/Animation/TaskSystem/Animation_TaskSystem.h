@@ -114,6 +114,21 @@ namespace EE::Animation
         void EnsureCachedPoseExists( CachedPoseID cachedPoseID );
         #endif
 
+        // Get how cached poses are stored
+        inline CachedPoseStorageMode GetCachedPoseStorageMode() const { return m_posePool.GetCachedPoseStorageMode(); }
+
+        // Set how cached poses are stored - existing cached poses will be converted
+        inline void SetCachedPoseStorageMode( CachedPoseStorageMode storageMode ) { m_posePool.SetCachedPoseStorageMode( storageMode ); }
+
+        // Get the memory budget for cached poses (0 = no budget)
+        inline size_t GetCachedPoseMemoryBudget() const { return m_posePool.GetCachedPoseMemoryBudget(); }
+
+        // Set the memory budget for cached poses (0 = no budget)
+        inline void SetCachedPoseMemoryBudget( size_t budgetInBytes ) { m_posePool.SetCachedPoseMemoryBudget( budgetInBytes ); }
+
+        // Get the memory currently used for cached pose storage
+        inline size_t GetCachedPoseMemoryUsage() const { return m_posePool.GetCachedPoseMemoryUsage(); }
+
         // Task Registration
         //-------------------------------------------------------------------------
 
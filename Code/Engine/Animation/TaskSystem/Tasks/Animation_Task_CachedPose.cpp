@@ -23,7 +23,7 @@ namespace EE::Animation::Tasks
         EE_ASSERT( pPoseBuffer->IsPoseSet() );
 
         // Get a cached buffer so we can copy the current pose
-        PoseBuffer* pCachedPoseBuffer = nullptr;
+        CachedPoseBuffer* pCachedPoseBuffer = nullptr;
         if ( m_isDeserializedTask )
         {
             pCachedPoseBuffer = context.m_posePool.GetOrCreateCachedPoseBuffer( m_cachedPoseID, true );
@@ -33,7 +33,7 @@ namespace EE::Animation::Tasks
             pCachedPoseBuffer = context.m_posePool.GetCachedPoseBuffer( m_cachedPoseID );
         }
 
-        // Make a copy of the transferred buffer
+        // Make a copy of the transferred buffer (this will quantize the pose if required)
         EE_ASSERT( pCachedPoseBuffer != nullptr );
         pCachedPoseBuffer->CopyFrom( pPoseBuffer );
         EE_ASSERT( pCachedPoseBuffer->IsPoseSet() );
@@ -78,10 +78,10 @@ namespace EE::Animation::Tasks
             EE_ASSERT( pCachedPoseBuffer != nullptr );
         }
 
-        // If the cached buffer contains a valid pose copy it
+        // If the cached buffer contains a valid pose copy it (this will decode the pose if required)
         if ( pCachedPoseBuffer != nullptr && pCachedPoseBuffer->IsPoseSet() )
         {
-            pPoseBuffer->CopyFrom( pCachedPoseBuffer );
+            pCachedPoseBuffer->CopyTo( pPoseBuffer );
         }
         else // Clear the result buffer
         {
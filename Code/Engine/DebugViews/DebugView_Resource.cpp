@@ -1,5 +1,7 @@
 #include "DebugView_Resource.h"
 #include "Base/Resource/ResourceSystem.h"
+#include "Base/Resource/Settings/GlobalSettings_Resource.h"
+#include "Base/FileSystem/AsyncFileReaderBenchmark.h"
 #include "Base/Systems.h"
 #include "Base/Imgui/ImguiX.h"
 
@@ -86,6 +88,10 @@ namespace EE::Resource
                     {
                         ImGui::TextColored( Colors::Coral.ToFloat4(), "Install Dependency: %u", requesterID.GetInstallDependencyResourcePathID() );
                     }
+                    else if ( requesterID.IsDependencyPrefetchRequest() )
+                    {
+                        ImGui::TextColored( Colors::Coral.ToFloat4(), "Dependency Prefetch: %u", requesterID.GetInstallDependencyResourcePathID() );
+                    }
                     else // Normal request
                     {
                         ImGui::TextColored( Colors::Green.ToFloat4(), "Entity: %u", requesterID.GetID() );
@@ -120,7 +126,73 @@ namespace EE::Resource
 
         //-------------------------------------------------------------------------
 
-        ImGui::Text( "Num Resources Loaded: %d", pResourceSystem->m_resourceRecords.size() );
+        size_t numResourceRecords = 0;
+        for ( auto const& shard : pResourceSystem->m_recordShards )
+        {
+            auto lock = pResourceSystem->LockRecordShard( shard );
+            numResourceRecords += shard.m_records.size();
+        }
+
+        ImGui::Text( "Num Resources Loaded: %d", (int32_t) numResourceRecords );
+
+        auto const lockStats = pResourceSystem->GetLockContentionStats();
+        ImGui::Text( "Record Locks: %llu (contended: %llu, total wait: %.3fms)", lockStats.m_numLocks, lockStats.m_numContendedLocks, lockStats.m_contendedWaitTime.ToMilliseconds().ToFloat() );
+
+        auto const readBufferStats = pResourceSystem->m_readBufferPool.GetStats();
+        ImGui::Text( "Read Buffers: %.2fMB retained (peak: %.2fMB, max: %.2fMB) - Hits: %llu, Misses: %llu, Discards: %llu", readBufferStats.m_retainedBytes / ( 1024.0f * 1024.0f ), readBufferStats.m_peakRetainedBytes / ( 1024.0f * 1024.0f ), pResourceSystem->m_readBufferPool.GetMaxRetainedBytes() / ( 1024.0f * 1024.0f ), readBufferStats.m_numHits, readBufferStats.m_numMisses, readBufferStats.m_numDiscards );
+
+        bool isLoadOrderRecordingEnabled = pResourceSystem->IsLoadOrderRecordingEnabled();
+        if ( ImGui::Checkbox( "Record Map Load Order", &isLoadOrderRecordingEnabled ) )
+        {
+            pResourceSystem->SetLoadOrderRecordingEnabled( isLoadOrderRecordingEnabled );
+        }
+        ImGuiX::ItemTooltip( "Record the resources requested during the next map load and save them as that map's prefetch manifest" );
+
+        if ( pResourceSystem->m_loadOrderRecorder.IsRecording() )
+        {
+            ImGui::SameLine();
+            ImGui::TextColored( Colors::Red.ToFloat4(), "Recording: %s (%d resources)", pResourceSystem->m_loadOrderRecorder.GetRecordedResourceID().c_str(), pResourceSystem->m_loadOrderRecorder.GetNumRecordedResources() );
+        }
+
+        TVector<ResourceResidencyCache::TypeStats> residencyStats;
+        pResourceSystem->GetResidencyStats( residencyStats );
+        if ( !residencyStats.empty() && ImGui::BeginTable( "Resource Residency Table", 6, ImGuiTableFlags_Borders | ImGuiTableFlags_Resizable ) )
+        {
+            ImGui::TableSetupColumn( "Type", ImGuiTableColumnFlags_WidthFixed | ImGuiTableColumnFlags_NoResize, 30 );
+            ImGui::TableSetupColumn( "Budget", ImGuiTableColumnFlags_WidthStretch );
+            ImGui::TableSetupColumn( "Resident", ImGuiTableColumnFlags_WidthFixed | ImGuiTableColumnFlags_NoResize, 60 );
+            ImGui::TableSetupColumn( "Hit Rate", ImGuiTableColumnFlags_WidthFixed | ImGuiTableColumnFlags_NoResize, 60 );
+            ImGui::TableSetupColumn( "Hits/Misses", ImGuiTableColumnFlags_WidthFixed | ImGuiTableColumnFlags_NoResize, 100 );
+            ImGui::TableSetupColumn( "Evictions", ImGuiTableColumnFlags_WidthFixed | ImGuiTableColumnFlags_NoResize, 60 );
+            ImGui::TableHeadersRow();
+
+            for ( auto const& typeStats : residencyStats )
+            {
+                ImGui::TableNextRow();
+
+                ImGui::TableNextColumn();
+                ImGui::Text( "%s", typeStats.m_resourceTypeID.ToString().c_str() );
+
+                ImGui::TableNextColumn();
+                float const budgetUsage = ( typeStats.m_budget > 0 ) ? float( typeStats.m_usedBytes ) / typeStats.m_budget : 0.0f;
+                InlineString const budgetStr( InlineString::CtorSprintf(), "%.2fMB / %.2fMB", typeStats.m_usedBytes / ( 1024.0f * 1024.0f ), typeStats.m_budget / ( 1024.0f * 1024.0f ) );
+                ImGui::ProgressBar( budgetUsage, ImVec2( -1, 0 ), budgetStr.c_str() );
+
+                ImGui::TableNextColumn();
+                ImGui::Text( "%d", typeStats.m_numResident );
+
+                ImGui::TableNextColumn();
+                ImGui::Text( "%.1f%%", typeStats.GetHitRate() * 100.0f );
+
+                ImGui::TableNextColumn();
+                ImGui::Text( "%llu / %llu", typeStats.m_numHits, typeStats.m_numMisses );
+
+                ImGui::TableNextColumn();
+                ImGui::Text( "%llu", typeStats.m_numEvictions );
+            }
+
+            ImGui::EndTable();
+        }
 
         ImGui::Separator();
 
@@ -141,11 +213,14 @@ namespace EE::Resource
 
             //-------------------------------------------------------------------------
 
-            auto const& resourceRecords = pResourceSystem->m_resourceRecords;
-            for ( auto const& recordTuple : resourceRecords )
+            for ( auto const& shard : pResourceSystem->m_recordShards )
             {
-                ResourceRecord const* pRecord = recordTuple.second;
-                DrawRow( pRecord );
+                auto lock = pResourceSystem->LockRecordShard( shard );
+                for ( auto const& recordTuple : shard.m_records )
+                {
+                    ResourceRecord const* pRecord = recordTuple.second;
+                    DrawRow( pRecord );
+                }
             }
 
             ImGui::EndTable();
@@ -253,6 +328,13 @@ namespace EE::Resource
         {
             m_windows[1].m_isOpen = true;
         }
+
+        ImGui::SeparatorText( "File IO" );
+
+        if ( ImGui::MenuItem( "Run File Read Benchmark" ) )
+        {
+            FileSystem::RunAsyncFileReaderBenchmark( m_pResourceSystem->GetSettings().m_compiledResourceDirectoryPath ).Log();
+        }
     }
 }
 #endif
\ No newline at end of file
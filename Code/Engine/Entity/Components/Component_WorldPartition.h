@@ -0,0 +1,51 @@
+#pragma once
+
+#include "Engine/Entity/EntityComponent.h"
+#include "Engine/Entity/EntityDescriptors.h"
+
+//-------------------------------------------------------------------------
+// World Partition Component
+//-------------------------------------------------------------------------
+// Adding this component to a map will cause the map compiler to split all the spatial entities in the map into a grid of
+// streaming cells. The entity containing this component is always kept in the map itself.
+
+namespace EE::EntityModel
+{
+    class EE_ENGINE_API WorldPartitionComponent : public EntityComponent
+    {
+        EE_SINGLETON_ENTITY_COMPONENT( WorldPartitionComponent );
+
+    public:
+
+        inline EntityMapStreamingSettings GetStreamingSettings() const
+        {
+            EntityMapStreamingSettings settings;
+            settings.m_cellSize = m_cellSize;
+            settings.m_loadRadius = m_loadRadius;
+            settings.m_unloadRadius = m_unloadRadius;
+            settings.m_maxConcurrentCellLoads = m_maxConcurrentCellLoads;
+            settings.m_maxEntitiesInstantiatedPerFrame = m_maxEntitiesInstantiatedPerFrame;
+            return settings;
+        }
+
+    private:
+
+        // The size of each streaming cell in meters
+        EE_REFLECT( Category = "Partitioning" );
+        float                                   m_cellSize = 64.0f;
+
+        // Cells closer than this to any streaming source will be loaded
+        EE_REFLECT( Category = "Streaming" );
+        float                                   m_loadRadius = 128.0f;
+
+        // Cells further than this from all streaming sources will be unloaded, this needs to be larger than the load radius
+        EE_REFLECT( Category = "Streaming" );
+        float                                   m_unloadRadius = 160.0f;
+
+        EE_REFLECT( Category = "Budget" );
+        int32_t                                 m_maxConcurrentCellLoads = 4;
+
+        EE_REFLECT( Category = "Budget" );
+        int32_t                                 m_maxEntitiesInstantiatedPerFrame = 256;
+    };
+}
@@ -6,12 +6,96 @@
 #include "Engine/UpdateContext.h"
 #include "Engine/Entity/EntityWorldManager.h"
 #include "Engine/Entity/EntityWorldUpdateContext.h"
+#include "Base/Math/AABBTreeBenchmark.h"
 
 //-------------------------------------------------------------------------
 
 #if EE_DEVELOPMENT_TOOLS
 namespace EE
 {
+    void EntityDebugView::Initialize( SystemRegistry const& systemRegistry, EntityWorld const* pWorld )
+    {
+        DebugView::Initialize( systemRegistry, pWorld );
+        m_windows.emplace_back( "Entity Initialization", [this] ( EntityWorldUpdateContext const& context, bool isFocused, uint64_t ) { DrawInitializationStatsWindow( context ); } );
+    }
+
+    void EntityDebugView::Update( EntityWorldUpdateContext const& context )
+    {
+        EntityModel::InitializationStats const& stats = m_pWorld->GetEntityInitializationStats();
+        float const frameCost = stats.m_initializationTime.ToFloat() + stats.m_registrationTime.ToFloat();
+
+        m_initializationTimeHistory[m_historyFrameIdx] = frameCost;
+        m_historyFrameIdx = ( m_historyFrameIdx + 1 ) % s_numHistoryFrames;
+        m_peakInitializationTime = Math::Max( m_peakInitializationTime, frameCost );
+        m_peakPendingEntities = Math::Max( m_peakPendingEntities, stats.m_numEntitiesPendingInitialization );
+
+        float const timeBudget = m_pWorld->GetEntityInitializationTimeBudget().ToFloat();
+        if ( m_pWorld->IsGameWorld() && timeBudget > 0.0f && frameCost > timeBudget )
+        {
+            m_numFramesOverBudget++;
+        }
+    }
+
+    void EntityDebugView::DrawMenu( EntityWorldUpdateContext const& context )
+    {
+        if ( ImGui::MenuItem( "Show Initialization Stats" ) )
+        {
+            m_windows[0].m_isOpen = true;
+        }
+
+        ImGui::SeparatorText( "Initialization Budget" );
+
+        EntityWorld* pWorld = const_cast<EntityWorld*>( m_pWorld );
+        float timeBudget = pWorld->GetEntityInitializationTimeBudget().ToFloat();
+        int32_t maxEntities = pWorld->GetMaxEntitiesInitializedPerFrame();
+
+        bool budgetChanged = false;
+        budgetChanged |= ImGui::SliderFloat( "Time (ms)", &timeBudget, 0.0f, 16.0f, "%.1f" );
+        budgetChanged |= ImGui::SliderInt( "Max Entities", &maxEntities, 0, 1024 );
+        ImGui::SameLine();
+        ImGuiX::HelpMarker( "Zero disables the limit. Only applies to game worlds." );
+
+        if ( budgetChanged )
+        {
+            pWorld->SetEntityInitializationBudget( timeBudget, maxEntities );
+        }
+
+        ImGui::SeparatorText( "Spatial Index" );
+
+        if ( ImGui::MenuItem( "Run AABB Tree Benchmark" ) )
+        {
+            Math::RunAABBTreeBenchmark().Log();
+        }
+    }
+
+    void EntityDebugView::DrawInitializationStatsWindow( EntityWorldUpdateContext const& context )
+    {
+        EntityModel::InitializationStats const& stats = m_pWorld->GetEntityInitializationStats();
+
+        ImGui::Text( "Entities Initialized: %d", stats.m_numEntitiesInitialized );
+        ImGui::Text( "Entities Pending Initialization: %d (Peak: %d)", stats.m_numEntitiesPendingInitialization, m_peakPendingEntities );
+        ImGui::Text( "Components Registered: %d", stats.m_numComponentsRegistered );
+        ImGui::Text( "Components Unregistered: %d", stats.m_numComponentsUnregistered );
+
+        ImGui::Separator();
+
+        ImGui::Text( "Initialization Time: %.2fms", stats.m_initializationTime.ToFloat() );
+        ImGui::Text( "Registration Time: %.2fms", stats.m_registrationTime.ToFloat() );
+        ImGui::Text( "Peak Frame Cost: %.2fms", m_peakInitializationTime );
+        ImGui::Text( "Frames Over Budget: %d", m_numFramesOverBudget );
+
+        ImGui::PlotLines( "##InitializationCost", m_initializationTimeHistory, s_numHistoryFrames, m_historyFrameIdx, "Initialization Cost (ms)", 0.0f, Math::Max( m_peakInitializationTime, 1.0f ), ImVec2( -1, 80 ) );
+
+        if ( ImGui::Button( "Reset Peaks", ImVec2( -1, 0 ) ) )
+        {
+            m_peakInitializationTime = 0.0f;
+            m_peakPendingEntities = 0;
+            m_numFramesOverBudget = 0;
+        }
+    }
+
+    //-------------------------------------------------------------------------
+
     //EntityDebugView::EntityDebugView()
     //{
     //    m_menus.emplace_back( Menu( "Engine/World", [this] ( EntityWorldUpdateContext const& context ) { DrawMenu( context ); } ) );
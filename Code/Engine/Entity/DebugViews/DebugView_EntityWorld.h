@@ -1,46 +1,39 @@
 #pragma once
 
-//#include "Engine/Entity/EntityWorldDebugView.h"
+#include "Engine/_Module/API.h"
+#include "Engine/DebugViews/DebugView.h"
 
 //-------------------------------------------------------------------------
 
 #if EE_DEVELOPMENT_TOOLS
 namespace EE
 {
-    //class EntityWorldManager;
-    //class Entity;
-    //class EntityComponent;
-    //class SpatialEntityComponent;
+    class EE_ENGINE_API EntityDebugView : public DebugView
+    {
+        EE_REFLECT_TYPE( EntityDebugView );
 
-    ////-------------------------------------------------------------------------
+        constexpr static int32_t const s_numHistoryFrames = 120;
 
-    //class EntityDebugView : public DebugView
-    //{
-    //    EE_REFLECT_TYPE( EntityDebugView );
+    public:
 
-    //public:
+        EntityDebugView() : DebugView( "Engine/Entity" ) {}
 
-    //    EntityDebugView();
+    private:
 
-    //private:
+        virtual void Initialize( SystemRegistry const& systemRegistry, EntityWorld const* pWorld ) override;
+        virtual void Update( EntityWorldUpdateContext const& context ) override;
+        virtual void DrawMenu( EntityWorldUpdateContext const& context ) override;
 
-    //    virtual void DrawWindows( EntityWorldUpdateContext const& context, ImGuiWindowClass* pWindowClass ) override;
+        void DrawInitializationStatsWindow( EntityWorldUpdateContext const& context );
 
-    //    void DrawMenu( EntityWorldUpdateContext const& context );
-    //    void DrawWorldBrowser( EntityWorldUpdateContext const& context );
-    //    void DrawMapLoader( EntityWorldUpdateContext const& context );
+    private:
 
-    //    void DrawComponentEntry( EntityComponent const* pComponent );
-    //    void DrawSpatialComponentTree( SpatialEntityComponent const* pComponent );
-
-    //private:
-
-    //    bool                    m_isWorldBrowserOpen = false;
-    //    bool                    m_isMapLoaderOpen = false;
-
-    //    // Browser Data
-    //    TVector<Entity*>        m_entities;
-    //    Entity*                 m_pSelectedEntity = nullptr;
-    //};
+        // Per-frame initialization cost (initialization + registration) in ms
+        float                   m_initializationTimeHistory[s_numHistoryFrames] = { 0 };
+        int32_t                 m_historyFrameIdx = 0;
+        float                   m_peakInitializationTime = 0.0f;
+        int32_t                 m_peakPendingEntities = 0;
+        int32_t                 m_numFramesOverBudget = 0;
+    };
 }
 #endif
\ No newline at end of file
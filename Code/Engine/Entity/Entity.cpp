@@ -3,6 +3,7 @@
 #include "EntityInitializationContext.h"
 #include "EntityDescriptors.h"
 #include "EntityLog.h"
+#include "EntityObjectPools.h"
 #include "Base/Resource/ResourceRequesterID.h"
 #include "Base/TypeSystem/TypeRegistry.h"
 #include <eastl/sort.h>
@@ -45,8 +46,8 @@ namespace EE
             // All other actions can be ignored
             if ( action.m_type == EntityInternalStateAction::Type::AddComponent )
             {
-                auto pComponent = reinterpret_cast<EntityComponent const*>( action.m_ptr );
-                EE::Delete( pComponent );
+                auto pComponent = reinterpret_cast<EntityComponent*>( const_cast<void*>( action.m_ptr ) );
+                EntityModel::EntityObjectPools::DestroyObject( pComponent );
             }
         }
         m_deferredActions.clear();
@@ -54,7 +55,7 @@ namespace EE
         // Destroy Systems
         for ( auto& pSystem : m_systems )
         {
-            EE::Delete( pSystem );
+            EntityModel::EntityObjectPools::DestroyObject( pSystem );
         }
 
         m_systems.clear();
@@ -62,7 +63,7 @@ namespace EE
         // Destroy components
         for ( auto& pComponent : m_components )
         {
-            EE::Delete( pComponent );
+            EntityModel::EntityObjectPools::DestroyObject( pComponent );
         }
 
         m_components.clear();
@@ -789,7 +790,7 @@ namespace EE
         #endif
 
         // Create the new system and add it
-        auto pSystem = (EntitySystem*) pSystemTypeInfo->CreateType();
+        auto pSystem = EntityModel::EntityObjectPools::CreateObject<EntitySystem>( pSystemTypeInfo );
         m_systems.emplace_back( pSystem );
 
         // If the entity is already initialized, then initialize the system
@@ -895,7 +896,7 @@ namespace EE
         }
 
         // Destroy the system
-        EE::Delete( pSystem );
+        EntityModel::EntityObjectPools::DestroyObject( pSystem );
         m_systems.erase_unsorted( m_systems.begin() + systemIdx );
     }
     
@@ -906,7 +907,7 @@ namespace EE
     void Entity::CreateComponent( TypeSystem::TypeInfo const* pComponentTypeInfo, ComponentID const& parentSpatialComponentID )
     {
         EE_ASSERT( pComponentTypeInfo != nullptr && pComponentTypeInfo->IsDerivedFrom<EntityComponent>() );
-        EntityComponent* pComponent = Cast<EntityComponent>( pComponentTypeInfo->CreateType() );
+        EntityComponent* pComponent = EntityModel::EntityObjectPools::CreateObject<EntityComponent>( pComponentTypeInfo );
 
         #if EE_DEVELOPMENT_TOOLS
         pComponent->m_name = StringID( pComponentTypeInfo->GetFriendlyTypeName() );
@@ -1081,7 +1082,7 @@ namespace EE
         //-------------------------------------------------------------------------
 
         m_components.erase_unsorted( m_components.begin() + componentIdx );
-        EE::Delete( pComponent );
+        EntityModel::EntityObjectPools::DestroyObject( pComponent );
     }
 
     void Entity::RemoveComponentFromSpatialHierarchy( SpatialEntityComponent* pSpatialComponent )
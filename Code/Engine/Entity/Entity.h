@@ -4,6 +4,7 @@
 #include "EntitySystem.h"
 #include "Engine/UpdateStage.h"
 #include "Base/Threading/Threading.h"
+#include "Base/Time/Time.h"
 #include "Base/Types/Event.h"
 
 //-------------------------------------------------------------------------
@@ -37,6 +38,7 @@ namespace EE
         struct InitializationContext;
         struct EntityDescriptor;
         class EntityCollection;
+        class EntityCollectionTemplate;
         struct LoadingContext;
 
         #if EE_DEVELOPMENT_TOOLS
@@ -52,12 +54,16 @@ namespace EE
 
         friend EntityModel::EntityDescriptor;
         friend EntityModel::EntityMap;
+        friend EntityModel::EntityCollectionTemplate;
 
         #if EE_DEVELOPMENT_TOOLS
         friend EntityModel::EntityEditor;
         #endif
 
-        using SystemUpdateList = TVector<EntitySystem*>;
+        using SystemUpdateList = TInlineVector<EntitySystem*, 2>;
+
+        // How much weight to give each new update cost measurement
+        constexpr static float const s_updateCostSmoothingFactor = 0.1f;
 
         // Entity internal state change actions
         struct EntityInternalStateAction
@@ -183,7 +189,21 @@ namespace EE
         inline bool HasAttachedEntities() const { return !m_attachedEntities.empty(); }
 
         // Get all attached entities
-        TVector<Entity*> const& GetAttachedEntities() const { return m_attachedEntities; }
+        TInlineVector<Entity*, 2> const& GetAttachedEntities() const { return m_attachedEntities; }
+
+        // Update Cost
+        //-------------------------------------------------------------------------
+
+        // Get the estimated time needed to update this entity and all its attached entities for the specified stage
+        // This is a moving average of the measured update times and is only tracked for entities without a spatial parent
+        inline Microseconds GetEstimatedUpdateCost( UpdateStage stage ) const { return m_estimatedUpdateCosts[(int8_t) stage]; }
+
+        // Add a measured update time to the moving average for the specified stage
+        inline void RecordUpdateCost( UpdateStage stage, Microseconds measuredCost )
+        {
+            float& estimatedCost = m_estimatedUpdateCosts[(int8_t) stage];
+            estimatedCost = ( estimatedCost <= 0.0f ) ? measuredCost.ToFloat() : estimatedCost + ( measuredCost.ToFloat() - estimatedCost ) * s_updateCostSmoothingFactor;
+        }
 
         // Status
         //-------------------------------------------------------------------------
@@ -203,7 +223,7 @@ namespace EE
         // Get the number of components this entity owns
         inline uint32_t GetNumComponents() const { return (uint32_t) m_components.size(); }
 
-        inline TVector<EntityComponent*> const& GetComponents() const { return m_components; }
+        inline TInlineVector<EntityComponent*, 8> const& GetComponents() const { return m_components; }
 
         inline EntityComponent const* FindComponent( ComponentID const& componentID ) const
         {
@@ -231,7 +251,7 @@ namespace EE
         inline uint32_t GetNumSystems() const { return (uint32_t) m_systems.size(); }
 
         // Get all systems
-        inline TVector<EntitySystem*> const& GetSystems() const { return m_systems; }
+        inline TInlineVector<EntitySystem*, 4> const& GetSystems() const { return m_systems; }
 
         // Run Entity Systems
         void UpdateSystems( EntityWorldUpdateContext const& context );
@@ -362,15 +382,16 @@ namespace EE
         Status                                              m_status = Status::Unloaded;
         UpdateRegistrationStatus                            m_updateRegistrationStatus = UpdateRegistrationStatus::Unregistered;    // Is this entity registered for frame updates
 
-        TVector<EntitySystem*>                              m_systems;
-        TVector<EntityComponent*>                           m_components;
+        TInlineVector<EntitySystem*, 4>                     m_systems;
+        TInlineVector<EntityComponent*, 8>                  m_components;
         SystemUpdateList                                    m_systemUpdateLists[(int8_t) UpdateStage::NumStages];
 
         SpatialEntityComponent*                             m_pRootSpatialComponent = nullptr;                                      // This spatial component defines our world position
-        TVector<Entity*>                                    m_attachedEntities;                                                     // The list of entities that are attached to this entity
+        TInlineVector<Entity*, 2>                           m_attachedEntities;                                                     // The list of entities that are attached to this entity
         Entity*                                             m_pParentSpatialEntity = nullptr;                                       // The parent entity we are attached to
         EE_REFLECT() StringID                               m_parentAttachmentSocketID;                                             // The socket that we are attached to on the parent
         bool                                                m_isSpatialAttachmentCreated = false;                                   // Has the actual component-to-component attachment been created
+        float                                               m_estimatedUpdateCosts[(int8_t) UpdateStage::NumStages] = { 0 };        // Moving average of the update time (in microseconds) of this entity's attachment chain per stage
 
         TVector<EntityInternalStateAction>                  m_deferredActions;                                                      // The set of internal entity state changes that need to be executed
         Threading::RecursiveMutex                           m_internalStateMutex;                                                   // A mutex that needs to be lock due to internal state changes
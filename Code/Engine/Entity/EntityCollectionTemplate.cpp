@@ -0,0 +1,265 @@
+#include "EntityCollectionTemplate.h"
+#include "EntityDescriptors.h"
+#include "EntityObjectPools.h"
+#include "EntitySpatialComponent.h"
+#include "EntitySystem.h"
+#include "Entity.h"
+#include "Base/TypeSystem/TypeInfo.h"
+#include "Base/Threading/TaskSystem.h"
+#include "Base/Profiling.h"
+
+//-------------------------------------------------------------------------
+
+namespace EE::EntityModel
+{
+    EntityCollectionTemplate::EntityCollectionTemplate( TypeSystem::TypeRegistry const& typeRegistry, EntityCollection const& collection )
+        : m_sourceCollectionVersion( collection.GetVersion() )
+    {
+        EE_PROFILE_SCOPE_ENTITY( "Create Entity Collection Template" );
+
+        TVector<EntityDescriptor> const& entityDescriptors = collection.GetEntityDescriptors();
+        int32_t const numEntities = (int32_t) entityDescriptors.size();
+
+        // Create the template entities, this is the only time we need to go through the property descriptors
+        //-------------------------------------------------------------------------
+        // We intentionally dont use the collection's CreateEntities since we dont want to create any attachments between the template entities
+
+        m_templateEntities.resize( numEntities );
+        for ( int32_t i = 0; i < numEntities; i++ )
+        {
+            m_templateEntities[i] = entityDescriptors[i].CreateEntity( typeRegistry );
+        }
+
+        // Cache the spatial hierarchies by index so that clones dont need any name lookups
+        //-------------------------------------------------------------------------
+
+        m_templateEntityInfo.resize( numEntities );
+        for ( int32_t i = 0; i < numEntities; i++ )
+        {
+            Entity const* pTemplateEntity = m_templateEntities[i];
+            TemplateEntityInfo& entityInfo = m_templateEntityInfo[i];
+
+            int32_t const numComponents = (int32_t) pTemplateEntity->m_components.size();
+            entityInfo.m_spatialParentComponentIndices.resize( numComponents, InvalidIndex );
+
+            for ( int32_t c = 0; c < numComponents; c++ )
+            {
+                auto pSpatialComponent = TryCast<SpatialEntityComponent>( pTemplateEntity->m_components[c] );
+                if ( pSpatialComponent == nullptr )
+                {
+                    continue;
+                }
+
+                if ( pSpatialComponent == pTemplateEntity->m_pRootSpatialComponent )
+                {
+                    entityInfo.m_rootComponentIdx = c;
+                }
+                else if ( pSpatialComponent->m_pSpatialParent != nullptr )
+                {
+                    entityInfo.m_spatialParentComponentIndices[c] = VectorFindIndex( pTemplateEntity->m_components, static_cast<EntityComponent*>( pSpatialComponent->m_pSpatialParent ) );
+                    EE_ASSERT( entityInfo.m_spatialParentComponentIndices[c] != InvalidIndex );
+                }
+            }
+        }
+
+        for ( auto const& attachmentInfo : collection.GetEntitySpatialAttachmentInfo() )
+        {
+            TemplateEntityInfo& entityInfo = m_templateEntityInfo[attachmentInfo.m_entityIdx];
+            entityInfo.m_parentEntityIdx = attachmentInfo.m_parentEntityIdx;
+            entityInfo.m_attachmentSocketID = entityDescriptors[attachmentInfo.m_entityIdx].m_attachmentSocketID;
+        }
+    }
+
+    EntityCollectionTemplate::~EntityCollectionTemplate()
+    {
+        ReleasePrewarmedInstances();
+
+        for ( auto pTemplateEntity : m_templateEntities )
+        {
+            EE::Delete( pTemplateEntity );
+        }
+    }
+
+    //-------------------------------------------------------------------------
+
+    TVector<Entity*> EntityCollectionTemplate::CreateEntities( TaskSystem* pTaskSystem )
+    {
+        if ( !m_prewarmedInstances.empty() )
+        {
+            TVector<Entity*> createdEntities = eastl::move( m_prewarmedInstances.back() );
+            m_prewarmedInstances.pop_back();
+            return createdEntities;
+        }
+
+        return CloneEntities( pTaskSystem );
+    }
+
+    void EntityCollectionTemplate::PrewarmInstances( int32_t numInstances, TaskSystem* pTaskSystem )
+    {
+        EE_PROFILE_SCOPE_ENTITY( "Prewarm Entity Collection Instances" );
+        EE_ASSERT( numInstances >= 0 );
+
+        m_prewarmedInstances.reserve( m_prewarmedInstances.size() + numInstances );
+        for ( int32_t i = 0; i < numInstances; i++ )
+        {
+            m_prewarmedInstances.emplace_back( CloneEntities( pTaskSystem ) );
+        }
+    }
+
+    void EntityCollectionTemplate::ReleasePrewarmedInstances()
+    {
+        for ( auto& instance : m_prewarmedInstances )
+        {
+            // Destroy attached entities first, since entities clear their attachments on destruction
+            for ( int32_t i = (int32_t) instance.size() - 1; i >= 0; i-- )
+            {
+                EE::Delete( instance[i] );
+            }
+        }
+
+        m_prewarmedInstances.clear();
+    }
+
+    //-------------------------------------------------------------------------
+
+    Entity* EntityCollectionTemplate::CloneEntity( int32_t entityIdx ) const
+    {
+        Entity const* pTemplateEntity = m_templateEntities[entityIdx];
+        TemplateEntityInfo const& entityInfo = m_templateEntityInfo[entityIdx];
+
+        auto pEntity = reinterpret_cast<Entity*>( Entity::s_pTypeInfo->CreateType() );
+        pEntity->m_name = pTemplateEntity->m_name;
+
+        // Clone components
+        //-------------------------------------------------------------------------
+
+        int32_t const numComponents = (int32_t) pTemplateEntity->m_components.size();
+        pEntity->m_components.reserve( numComponents );
+
+        for ( int32_t c = 0; c < numComponents; c++ )
+        {
+            EntityComponent const* pTemplateComponent = pTemplateEntity->m_components[c];
+            TypeSystem::TypeInfo const* pTypeInfo = pTemplateComponent->GetTypeInfo();
+
+            auto pComponent = EntityObjectPools::CreateObject<EntityComponent>( pTypeInfo );
+            pTypeInfo->CopyProperties( pComponent, pTemplateComponent );
+            pComponent->m_name = pTemplateComponent->m_name;
+            pComponent->m_entityID = pEntity->m_ID;
+            pEntity->m_components.push_back( pComponent );
+
+            if ( auto pTemplateSpatialComponent = TryCast<SpatialEntityComponent>( pTemplateComponent ) )
+            {
+                auto pSpatialComponent = reinterpret_cast<SpatialEntityComponent*>( pComponent );
+                pSpatialComponent->m_parentAttachmentSocketID = pTemplateSpatialComponent->m_parentAttachmentSocketID;
+            }
+        }
+
+        // Rebuild spatial hierarchy
+        //-------------------------------------------------------------------------
+
+        if ( entityInfo.m_rootComponentIdx != InvalidIndex )
+        {
+            pEntity->m_pRootSpatialComponent = reinterpret_cast<SpatialEntityComponent*>( pEntity->m_components[entityInfo.m_rootComponentIdx] );
+
+            for ( int32_t c = 0; c < numComponents; c++ )
+            {
+                int32_t const parentComponentIdx = entityInfo.m_spatialParentComponentIndices[c];
+                if ( parentComponentIdx == InvalidIndex )
+                {
+                    continue;
+                }
+
+                auto pSpatialComponent = reinterpret_cast<SpatialEntityComponent*>( pEntity->m_components[c] );
+                auto pParentSpatialComponent = reinterpret_cast<SpatialEntityComponent*>( pEntity->m_components[parentComponentIdx] );
+                pSpatialComponent->m_pSpatialParent = pParentSpatialComponent;
+                pParentSpatialComponent->m_spatialChildren.emplace_back( pSpatialComponent );
+            }
+
+            pEntity->m_pRootSpatialComponent->CalculateWorldTransform( false );
+        }
+
+        // Create systems
+        //-------------------------------------------------------------------------
+
+        pEntity->m_systems.reserve( pTemplateEntity->m_systems.size() );
+        for ( auto pTemplateSystem : pTemplateEntity->m_systems )
+        {
+            auto pSystem = EntityObjectPools::CreateObject<EntitySystem>( pTemplateSystem->GetTypeInfo() );
+            EE_ASSERT( pSystem != nullptr );
+            pEntity->m_systems.push_back( pSystem );
+        }
+
+        return pEntity;
+    }
+
+    TVector<Entity*> EntityCollectionTemplate::CloneEntities( TaskSystem* pTaskSystem ) const
+    {
+        EE_PROFILE_SCOPE_ENTITY( "Clone Entity Collection Template" );
+
+        int32_t const numEntitiesToCreate = (int32_t) m_templateEntities.size();
+        TVector<Entity*> createdEntities;
+        createdEntities.resize( numEntitiesToCreate );
+
+        //-------------------------------------------------------------------------
+
+        // For small number of entities, just create them inline!
+        if ( pTaskSystem == nullptr || numEntitiesToCreate <= 5 )
+        {
+            for ( auto i = 0; i < numEntitiesToCreate; i++ )
+            {
+                createdEntities[i] = CloneEntity( i );
+            }
+        }
+        else // Go wide and clone all entities in parallel
+        {
+            struct EntityCloneTask : public ITaskSet
+            {
+                EntityCloneTask( EntityCollectionTemplate const* pTemplate, TVector<Entity*>& createdEntities )
+                    : m_pTemplate( pTemplate )
+                    , m_createdEntities( createdEntities )
+                {
+                    m_SetSize = (uint32_t) createdEntities.size();
+                    m_MinRange = 10;
+                }
+
+                virtual void ExecuteRange( TaskSetPartition range, uint32_t threadnum ) override final
+                {
+                    EE_PROFILE_SCOPE_ENTITY( "Entity Clone Task" );
+                    for ( uint64_t i = range.start; i < range.end; ++i )
+                    {
+                        m_createdEntities[i] = m_pTemplate->CloneEntity( (int32_t) i );
+                    }
+                }
+
+            private:
+
+                EntityCollectionTemplate const*                     m_pTemplate;
+                TVector<Entity*>&                                   m_createdEntities;
+            };
+
+            //-------------------------------------------------------------------------
+
+            EntityCloneTask cloneTask( this, createdEntities );
+            pTaskSystem->ScheduleTask( &cloneTask );
+            pTaskSystem->WaitForTask( &cloneTask );
+        }
+
+        // Resolve spatial connections
+        //-------------------------------------------------------------------------
+        // Entities are sorted so that parents are always created before their attached entities
+
+        for ( int32_t i = 0; i < numEntitiesToCreate; i++ )
+        {
+            TemplateEntityInfo const& entityInfo = m_templateEntityInfo[i];
+            if ( entityInfo.m_parentEntityIdx != InvalidIndex )
+            {
+                EE_ASSERT( entityInfo.m_parentEntityIdx < i );
+                createdEntities[i]->SetSpatialParent( createdEntities[entityInfo.m_parentEntityIdx], entityInfo.m_attachmentSocketID, Entity::SpatialAttachmentRule::KeepLocalTranform );
+            }
+        }
+
+        //-------------------------------------------------------------------------
+
+        return createdEntities;
+    }
+}
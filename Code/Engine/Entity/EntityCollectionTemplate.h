@@ -0,0 +1,82 @@
+#pragma once
+
+#include "Engine/_Module/API.h"
+#include "Base/Types/Arrays.h"
+#include "Base/Types/StringID.h"
+
+//-------------------------------------------------------------------------
+
+namespace EE
+{
+    class Entity;
+    class TaskSystem;
+    namespace TypeSystem { class TypeRegistry; }
+}
+
+//-------------------------------------------------------------------------
+// Entity Collection Template
+//-------------------------------------------------------------------------
+// A fully constructed copy of all the entities in a collection. The template entities are never loaded or added to a map.
+//
+// Creating entities from descriptors requires resolving every property descriptor through the type system, this is
+// expensive for collections that are spawned repeatedly. Instead we create the entities once and then clone them by
+// copying the reflected properties of each component directly. Clones get new entity and component IDs.
+//
+// Instances can also be pre-created (pre-warmed) so that a later spawn only needs to hand out the ready-made entities.
+//-------------------------------------------------------------------------
+
+namespace EE::EntityModel
+{
+    class EntityCollection;
+
+    //-------------------------------------------------------------------------
+
+    class EE_ENGINE_API EntityCollectionTemplate
+    {
+        struct TemplateEntityInfo
+        {
+            TInlineVector<int32_t, 8>                       m_spatialParentComponentIndices; // For each component, InvalidIndex for non-spatial and root components
+            int32_t                                         m_rootComponentIdx = InvalidIndex;
+            int32_t                                         m_parentEntityIdx = InvalidIndex;
+            StringID                                        m_attachmentSocketID;
+        };
+
+    public:
+
+        EntityCollectionTemplate( TypeSystem::TypeRegistry const& typeRegistry, EntityCollection const& collection );
+        ~EntityCollectionTemplate();
+
+        EntityCollectionTemplate( EntityCollectionTemplate const& ) = delete;
+        EntityCollectionTemplate& operator=( EntityCollectionTemplate const& ) = delete;
+
+        // The version of the collection this template was created from
+        inline uint64_t GetSourceCollectionVersion() const { return m_sourceCollectionVersion; }
+
+        inline int32_t GetNumEntities() const { return (int32_t) m_templateEntities.size(); }
+
+        // Get the number of instances that are ready to be handed out
+        inline int32_t GetNumPrewarmedInstances() const { return (int32_t) m_prewarmedInstances.size(); }
+
+        // Create a new instance of the collection, this will use a pre-warmed instance if available
+        // The entities are in the same state as if they were created from the collection directly (i.e. unloaded with spatial attachments resolved)
+        TVector<Entity*> CreateEntities( TaskSystem* pTaskSystem = nullptr );
+
+        // Create instances ahead of time so that future requests dont need to construct anything
+        void PrewarmInstances( int32_t numInstances, TaskSystem* pTaskSystem = nullptr );
+
+        // Destroy all pre-warmed instances
+        void ReleasePrewarmedInstances();
+
+    private:
+
+        TVector<Entity*> CloneEntities( TaskSystem* pTaskSystem ) const;
+        Entity* CloneEntity( int32_t entityIdx ) const;
+
+    private:
+
+        uint64_t                                            m_sourceCollectionVersion = 0;
+        TVector<Entity*>                                    m_templateEntities;
+        TVector<TemplateEntityInfo>                         m_templateEntityInfo;
+        TVector<TVector<Entity*>>                           m_prewarmedInstances;
+    };
+}
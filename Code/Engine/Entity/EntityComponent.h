@@ -14,6 +14,7 @@ namespace EE
     {
         class EntityMapEditor;
         class EntityCollection;
+        class EntityCollectionTemplate;
         class EntityMap;
         struct EntityDescriptor;
     }
@@ -28,6 +29,7 @@ namespace EE
         friend class EntityWorld;
         friend EntityModel::EntityDescriptor;
         friend EntityModel::EntityCollection;
+        friend EntityModel::EntityCollectionTemplate;
         friend EntityModel::EntityMap;
 
     public:
@@ -1,10 +1,12 @@
 #include "EntityDescriptors.h"
 
 #include "Entity.h"
+#include "EntityObjectPools.h"
 #include "Base/TypeSystem/TypeRegistry.h"
 #include "Base/Profiling.h"
 #include "Base/Threading/TaskSystem.h"
 #include "EASTL/sort.h"
+#include <atomic>
 
 //-------------------------------------------------------------------------
 
@@ -68,7 +70,16 @@ namespace EE::EntityModel
                 continue;
             }
 
-            auto pEntityComponent = componentDesc.CreateType<EntityComponent>( typeRegistry );
+            // Try to allocate the component from the pools
+            EntityComponent* pEntityComponent = nullptr;
+            if ( void* pComponentMemory = EntityObjectPools::AllocateObjectMemory( pTypeInfo ) )
+            {
+                pEntityComponent = componentDesc.CreateTypeInPlace<EntityComponent>( typeRegistry, pTypeInfo, reinterpret_cast<IReflectedType*>( pComponentMemory ) );
+            }
+            else
+            {
+                pEntityComponent = componentDesc.CreateType<EntityComponent>( typeRegistry, pTypeInfo );
+            }
             EE_ASSERT( pEntityComponent != nullptr );
 
             // Set IDs and add to component lists
@@ -149,7 +160,7 @@ namespace EE::EntityModel
                 continue;
             }
 
-            auto pEntitySystem = reinterpret_cast<EntitySystem*>( pTypeInfo->CreateType() );
+            auto pEntitySystem = EntityObjectPools::CreateObject<EntitySystem>( pTypeInfo );
             EE_ASSERT( pEntitySystem != nullptr );
             pEntity->m_systems.push_back( pEntitySystem );
         }
@@ -298,6 +309,26 @@ namespace EE::EntityModel
         return createdEntities;
     }
 
+    static std::atomic<uint64_t> g_collectionVersion = 1;
+
+    uint64_t EntityCollection::GenerateVersion()
+    {
+        return g_collectionVersion++;
+    }
+
+    void EntityCollection::CompileComponentDescriptors( TypeSystem::TypeRegistry const& typeRegistry )
+    {
+        m_version = GenerateVersion();
+
+        for ( auto& entityDesc : m_entityDescriptors )
+        {
+            for ( auto& componentDesc : entityDesc.m_components )
+            {
+                componentDesc.Compile( typeRegistry );
+            }
+        }
+    }
+
     void EntityCollection::RebuildLookupMap()
     {
         m_entityLookupMap.clear();
@@ -317,6 +348,7 @@ namespace EE::EntityModel
         m_entityDescriptors.clear();
         m_entityLookupMap.clear();
         m_entitySpatialAttachmentInfo.clear();
+        m_version = GenerateVersion();
     }
 
     void EntityCollection::SetCollectionData( TVector<EntityDescriptor>&& entityDescriptors )
@@ -325,8 +357,12 @@ namespace EE::EntityModel
         //-------------------------------------------------------------------------
 
         m_entityDescriptors.swap( entityDescriptors );
+        m_version = GenerateVersion();
         int32_t const numEntities = (int32_t) m_entityDescriptors.size();
 
+        // The lookup map is needed to resolve spatial parents below
+        RebuildLookupMap();
+
         // Generate spatial hierarchy depths
         //-------------------------------------------------------------------------
 
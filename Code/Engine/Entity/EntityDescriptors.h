@@ -3,6 +3,7 @@
 #include "EntityIDs.h"
 #include "Base/Resource/IResource.h"
 #include "Base/TypeSystem/TypeDescriptors.h"
+#include "Base/Math/Math.h"
 
 //-------------------------------------------------------------------------
 
@@ -156,6 +157,14 @@ namespace EE::EntityModel
 
         TVector<Entity*> CreateEntities( TypeSystem::TypeRegistry const& typeRegistry, TaskSystem* pTaskSystem = nullptr ) const;
 
+        // Unique for every loaded instance of a collection and updated whenever the collection data changes
+        // Use this rather than the collection's address to detect reloads since a reloaded collection might be allocated at the same address
+        inline uint64_t GetVersion() const { return m_version; }
+
+        // Pre-resolve all component property descriptors, this makes creating the components significantly cheaper
+        // This is done by the loader, any modifications to the collection afterwards require recompilation
+        void CompileComponentDescriptors( TypeSystem::TypeRegistry const& typeRegistry );
+
         // Entity Access
         //-------------------------------------------------------------------------
 
@@ -246,6 +255,8 @@ namespace EE::EntityModel
 
     protected:
 
+        static uint64_t GenerateVersion();
+
         void RebuildLookupMap();
 
     protected:
@@ -253,6 +264,7 @@ namespace EE::EntityModel
         TVector<EntityDescriptor>                       m_entityDescriptors;
         THashMap<StringID, int32_t>                     m_entityLookupMap;
         TVector<SpatialAttachmentInfo>                  m_entitySpatialAttachmentInfo;
+        uint64_t                                        m_version = GenerateVersion(); // Not serialized
     };
 }
 
@@ -267,14 +279,65 @@ namespace EE::EntityModel
 {
     struct LoadingContext;
 
+    //-------------------------------------------------------------------------
+    // World Partition
+    //-------------------------------------------------------------------------
+    // Maps that contain a world partition component are split into a grid of cells (on the XY plane) when compiled
+    // Each cell is compiled as a separate entity collection (a sub-resource of the map) that is streamed in and out at runtime
+    // The map itself only contains the entities that need to always be present (non-spatial entities, etc...)
+
+    struct EE_ENGINE_API EntityMapStreamingSettings
+    {
+        EE_SERIALIZE( m_cellSize, m_loadRadius, m_unloadRadius, m_maxConcurrentCellLoads, m_maxEntitiesInstantiatedPerFrame );
+
+    public:
+
+        inline bool IsValid() const { return m_cellSize > 0.0f && m_loadRadius > 0.0f && m_unloadRadius >= m_loadRadius && m_maxConcurrentCellLoads > 0 && m_maxEntitiesInstantiatedPerFrame > 0; }
+
+    public:
+
+        float                                                       m_cellSize = 64.0f;
+        float                                                       m_loadRadius = 128.0f; // Cells closer than this to any streaming source are loaded
+        float                                                       m_unloadRadius = 160.0f; // Cells further than this from all streaming sources are unloaded
+        int32_t                                                     m_maxConcurrentCellLoads = 4; // The max number of cell collections we can be waiting on at any one time
+        int32_t                                                     m_maxEntitiesInstantiatedPerFrame = 256; // Soft limit, we always instantiate at least one cell per frame
+    };
+
+    //-------------------------------------------------------------------------
+
+    struct EE_ENGINE_API EntityMapCellDescriptor
+    {
+        EE_SERIALIZE( m_collectionID, m_coordinates, m_numEntities );
+
+    public:
+
+        ResourceID                                                  m_collectionID;
+        Int2                                                        m_coordinates = Int2( 0 );
+        int32_t                                                     m_numEntities = 0;
+    };
+
     //-------------------------------------------------------------------------
 
     class EE_ENGINE_API EntityMapDescriptor final : public EntityCollection
     {
-        EE_RESOURCE( 'map', "Map", 4, false );
-        EE_SERIALIZE( EE_SERIALIZE_BASE( EntityCollection ) );
+        EE_RESOURCE( 'map', "Map", 5, false );
+        EE_SERIALIZE( EE_SERIALIZE_BASE( EntityCollection ), m_streamingSettings, m_cells );
 
         friend class EntityCollectionCompiler;
         friend class EntityCollectionLoader;
+        friend class EntityMapCompiler;
+
+    public:
+
+        // Is this map split into streaming cells?
+        inline bool IsPartitioned() const { return !m_cells.empty(); }
+
+        inline EntityMapStreamingSettings const& GetStreamingSettings() const { return m_streamingSettings; }
+        inline TVector<EntityMapCellDescriptor> const& GetCells() const { return m_cells; }
+
+    protected:
+
+        EntityMapStreamingSettings                                  m_streamingSettings;
+        TVector<EntityMapCellDescriptor>                            m_cells;
     };
 }
\ No newline at end of file
@@ -3,10 +3,14 @@
 #include "EntityInitializationContext.h"
 #include "EntityLoadingContext.h"
 #include "EntityWorldSystem.h"
+#include "EntityCollectionTemplate.h"
+#include "EntityObjectPools.h"
 #include "Entity.h"
 #include "Base/Resource/ResourceSystem.h"
 #include "Base/TypeSystem/TypeRegistry.h"
 #include "Base/Profiling.h"
+#include "Base/Time/Timers.h"
+#include <eastl/sort.h>
 
 //-------------------------------------------------------------------------
 
@@ -39,6 +43,7 @@ namespace EE::EntityModel
         EE_ASSERT( IsUnloaded() );
         EE_ASSERT( m_entities.empty() && m_entityIDLookupMap.empty() );
         EE_ASSERT( m_entitiesToLoad.empty() && m_entitiesToRemove.empty() );
+        EE_ASSERT( m_collectionTemplates.empty() );
 
         #if EE_DEVELOPMENT_TOOLS
         EE_ASSERT( m_entitiesToHotReload.empty() );
@@ -75,6 +80,12 @@ namespace EE::EntityModel
         m_entityIDLookupMap.swap( map.m_entityIDLookupMap );
         m_pMapDesc = eastl::move( map.m_pMapDesc );
         m_entitiesCurrentlyLoading = eastl::move( map.m_entitiesCurrentlyLoading );
+        m_entitiesPendingInitialization = eastl::move( map.m_entitiesPendingInitialization );
+        m_priorityInitializationEntityIDs = eastl::move( map.m_priorityInitializationEntityIDs );
+        m_streamingSettings = map.m_streamingSettings;
+        m_streamingCells.swap( map.m_streamingCells );
+        m_hasUpdatedCellStreaming = map.m_hasUpdatedCellStreaming;
+        m_collectionTemplates.swap( map.m_collectionTemplates );
         m_status = map.m_status;
         const_cast<bool&>( m_isTransientMap ) = map.m_isTransientMap;
 
@@ -162,6 +173,82 @@ namespace EE::EntityModel
         AddEntities( createdEntities, offsetTransform );
     }
 
+    void EntityMap::AddEntityCollectionFromTemplate( TaskSystem* pTaskSystem, TypeSystem::TypeRegistry const& typeRegistry, EntityCollection const& entityCollectionDesc, Transform const& offsetTransform, TVector<Entity*>* pOutCreatedEntities )
+    {
+        // We can only cache collections that are uniquely identifiable
+        if ( !entityCollectionDesc.GetResourceID().IsValid() )
+        {
+            AddEntityCollection( pTaskSystem, typeRegistry, entityCollectionDesc, offsetTransform, pOutCreatedEntities );
+            return;
+        }
+
+        //-------------------------------------------------------------------------
+
+        TVector<Entity*> scratchVector;
+        TVector<Entity*>& createdEntities = ( pOutCreatedEntities != nullptr ) ? *pOutCreatedEntities : scratchVector;
+
+        Threading::RecursiveScopeLock lock( m_mutex );
+
+        EntityCollectionTemplate* pTemplate = GetOrCreateCollectionTemplate( typeRegistry, entityCollectionDesc );
+        createdEntities = pTemplate->CreateEntities( pTaskSystem );
+        AddEntities( createdEntities, offsetTransform );
+    }
+
+    void EntityMap::PrewarmEntityCollection( TypeSystem::TypeRegistry const& typeRegistry, EntityCollection const& entityCollectionDesc, int32_t numInstances, TaskSystem* pTaskSystem )
+    {
+        EE_ASSERT( numInstances >= 0 );
+
+        if ( !entityCollectionDesc.GetResourceID().IsValid() )
+        {
+            EE_LOG_WARNING( "Entity", "Entity Map", "Cannot prewarm entity collections without a valid resource ID!" );
+            return;
+        }
+
+        Threading::RecursiveScopeLock lock( m_mutex );
+
+        EntityCollectionTemplate* pTemplate = GetOrCreateCollectionTemplate( typeRegistry, entityCollectionDesc );
+        int32_t const numInstancesToCreate = numInstances - pTemplate->GetNumPrewarmedInstances();
+        if ( numInstancesToCreate > 0 )
+        {
+            pTemplate->PrewarmInstances( numInstancesToCreate, pTaskSystem );
+        }
+    }
+
+    EntityCollectionTemplate* EntityMap::GetOrCreateCollectionTemplate( TypeSystem::TypeRegistry const& typeRegistry, EntityCollection const& entityCollectionDesc )
+    {
+        EE_ASSERT( entityCollectionDesc.GetResourceID().IsValid() );
+
+        auto foundIter = m_collectionTemplates.find( entityCollectionDesc.GetResourceID() );
+        if ( foundIter != m_collectionTemplates.end() )
+        {
+            // The collection might have been reloaded since we created the template
+            if ( foundIter->second->GetSourceCollectionVersion() == entityCollectionDesc.GetVersion() )
+            {
+                return foundIter->second;
+            }
+
+            EE::Delete( foundIter->second );
+            m_collectionTemplates.erase( foundIter );
+        }
+
+        EE_PROFILE_SCOPE_ENTITY( "Create Collection Template" );
+        auto pTemplate = EE::New<EntityCollectionTemplate>( typeRegistry, entityCollectionDesc );
+        m_collectionTemplates.insert( TPair<ResourceID, EntityCollectionTemplate*>( entityCollectionDesc.GetResourceID(), pTemplate ) );
+        return pTemplate;
+    }
+
+    void EntityMap::DestroyCollectionTemplates()
+    {
+        Threading::RecursiveScopeLock lock( m_mutex );
+
+        for ( auto& templatePair : m_collectionTemplates )
+        {
+            EE::Delete( templatePair.second );
+        }
+
+        m_collectionTemplates.clear();
+    }
+
     Entity* EntityMap::RemoveEntityInternal( EntityID entityID, bool destroyEntityOnceRemoved )
     {
         Threading::RecursiveScopeLock lock( m_mutex );
@@ -262,6 +349,23 @@ namespace EE::EntityModel
             {
                 m_entitiesCurrentlyLoading.emplace_back( pEntity );
             }
+
+            // The entity needs to go through the loading update again before it can be initialized
+            m_entitiesPendingInitialization.erase_first_unsorted( pEntity );
+        }
+    }
+
+    void EntityMap::RequestPriorityInitialization( TVector<Entity*> const& entities )
+    {
+        Threading::RecursiveScopeLock lock( m_mutex );
+
+        for ( auto pEntity : entities )
+        {
+            EE_ASSERT( pEntity != nullptr && pEntity->GetMapID() == m_ID );
+            if ( !pEntity->IsInitialized() )
+            {
+                VectorEmplaceBackUnique( m_priorityInitializationEntityIDs, pEntity->GetID() );
+            }
         }
     }
 
@@ -335,6 +439,19 @@ namespace EE::EntityModel
                 AddEntity( pEntity );
             }
 
+            // Create the streaming cells, no cell data is loaded until requested by a streaming update
+            if ( m_pMapDesc->IsPartitioned() )
+            {
+                EE_ASSERT( m_pMapDesc->GetStreamingSettings().IsValid() );
+                m_streamingSettings = m_pMapDesc->GetStreamingSettings();
+
+                m_streamingCells.reserve( m_pMapDesc->GetCells().size() );
+                for ( auto const& cellDesc : m_pMapDesc->GetCells() )
+                {
+                    m_streamingCells.emplace_back( cellDesc );
+                }
+            }
+
             m_status = Status::Loaded;
         }
         else // Invalid map data is treated as a failed load
@@ -362,8 +479,16 @@ namespace EE::EntityModel
         //-------------------------------------------------------------------------
 
         m_entitiesCurrentlyLoading.clear();
+        m_entitiesPendingInitialization.clear();
+        m_priorityInitializationEntityIDs.clear();
         m_entitiesToLoad.clear();
 
+        // All cell entities are destroyed along with the rest of the map entities below
+        ResetStreamingCells( loadingContext );
+
+        // Templates (and their pre-warmed instances) were never added to the map, so can be destroyed immediately
+        DestroyCollectionTemplates();
+
         // Shutdown all entities
         //-------------------------------------------------------------------------
 
@@ -439,6 +564,9 @@ namespace EE::EntityModel
         m_entityNameLookupMap.clear();
         #endif
 
+        // Return any pool memory freed by the map's components and systems
+        EntityObjectPools::ReleaseUnusedMemory();
+
         // Unload the map resource
         //-------------------------------------------------------------------------
 
@@ -450,6 +578,238 @@ namespace EE::EntityModel
         m_status = Status::Unloaded;
     }
 
+    //-------------------------------------------------------------------------
+    // World Partition
+    //-------------------------------------------------------------------------
+
+    int32_t EntityMap::GetNumStreamedInCells() const
+    {
+        int32_t numStreamedInCells = 0;
+        for ( auto const& cell : m_streamingCells )
+        {
+            if ( cell.m_status == StreamingCell::Status::Loaded )
+            {
+                numStreamedInCells++;
+            }
+        }
+
+        return numStreamedInCells;
+    }
+
+    bool EntityMap::HasPendingCellLoads() const
+    {
+        if ( m_streamingCells.empty() )
+        {
+            return false;
+        }
+
+        if ( !m_hasUpdatedCellStreaming )
+        {
+            return true;
+        }
+
+        for ( auto const& cell : m_streamingCells )
+        {
+            if ( cell.m_status == StreamingCell::Status::Loading )
+            {
+                return true;
+            }
+
+            if ( cell.m_status == StreamingCell::Status::Unloaded && cell.m_distanceToClosestSource <= m_streamingSettings.m_loadRadius )
+            {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    void EntityMap::UpdateCellStreaming( LoadingContext const& loadingContext, TInlineVector<Vector, 4> const& streamingSourcePositions, bool streamInAllCells )
+    {
+        EE_PROFILE_SCOPE_ENTITY( "Map Cell Streaming" );
+        EE_ASSERT( Threading::IsMainThread() && loadingContext.IsValid() );
+
+        if ( m_status != Status::Loaded || m_streamingCells.empty() )
+        {
+            return;
+        }
+
+        Threading::RecursiveScopeLock lock( m_mutex );
+
+        // Calculate the distance (on the XY plane) from each cell to its closest streaming source
+        //-------------------------------------------------------------------------
+
+        float const cellSize = m_streamingSettings.m_cellSize;
+        for ( auto& cell : m_streamingCells )
+        {
+            if ( streamInAllCells )
+            {
+                cell.m_distanceToClosestSource = 0.0f;
+                continue;
+            }
+
+            Float2 const cellMin( cell.m_coordinates.m_x * cellSize, cell.m_coordinates.m_y * cellSize );
+            Float2 const cellMax( cellMin.m_x + cellSize, cellMin.m_y + cellSize );
+
+            float closestDistanceSq = FLT_MAX;
+            for ( Vector const& sourcePosition : streamingSourcePositions )
+            {
+                float const dx = Math::Max( Math::Max( cellMin.m_x - sourcePosition.GetX(), sourcePosition.GetX() - cellMax.m_x ), 0.0f );
+                float const dy = Math::Max( Math::Max( cellMin.m_y - sourcePosition.GetY(), sourcePosition.GetY() - cellMax.m_y ), 0.0f );
+                closestDistanceSq = Math::Min( closestDistanceSq, ( dx * dx ) + ( dy * dy ) );
+            }
+
+            cell.m_distanceToClosestSource = ( closestDistanceSq == FLT_MAX ) ? FLT_MAX : Math::Sqrt( closestDistanceSq );
+        }
+
+        m_hasUpdatedCellStreaming = true;
+
+        // Release out of range cells and find any cells that can be instantiated or need to be requested
+        //-------------------------------------------------------------------------
+
+        TInlineVector<int32_t, 16> cellsToInstantiate;
+        TInlineVector<int32_t, 16> cellsToLoad;
+        int32_t numCellsInFlight = 0;
+
+        int32_t const numCells = (int32_t) m_streamingCells.size();
+        for ( int32_t i = 0; i < numCells; i++ )
+        {
+            StreamingCell& cell = m_streamingCells[i];
+            bool const isOutOfRange = cell.m_distanceToClosestSource > m_streamingSettings.m_unloadRadius;
+
+            switch ( cell.m_status )
+            {
+                case StreamingCell::Status::Unloaded:
+                {
+                    if ( cell.m_distanceToClosestSource <= m_streamingSettings.m_loadRadius )
+                    {
+                        cellsToLoad.emplace_back( i );
+                    }
+                }
+                break;
+
+                case StreamingCell::Status::Loading:
+                {
+                    if ( isOutOfRange )
+                    {
+                        loadingContext.m_pResourceSystem->UnloadResource( cell.m_pCollection );
+                        cell.m_status = StreamingCell::Status::Unloaded;
+                    }
+                    else
+                    {
+                        if ( cell.m_pCollection.IsLoaded() || cell.m_pCollection.HasLoadingFailed() )
+                        {
+                            cellsToInstantiate.emplace_back( i );
+                        }
+
+                        numCellsInFlight++;
+                    }
+                }
+                break;
+
+                case StreamingCell::Status::Loaded:
+                {
+                    if ( isOutOfRange )
+                    {
+                        DestroyCellEntities( cell );
+                        cell.m_status = StreamingCell::Status::Unloaded;
+                    }
+                }
+                break;
+            }
+        }
+
+        auto ClosestCellComparator = [this] ( int32_t const& cellIdxA, int32_t const& cellIdxB )
+        {
+            return m_streamingCells[cellIdxA].m_distanceToClosestSource < m_streamingCells[cellIdxB].m_distanceToClosestSource;
+        };
+
+        // Instantiate loaded cells, closest first, until we run out of budget
+        //-------------------------------------------------------------------------
+        // We always instantiate at least one cell per update so that large cells cant stall streaming
+
+        eastl::sort( cellsToInstantiate.begin(), cellsToInstantiate.end(), ClosestCellComparator );
+
+        int32_t numEntitiesInstantiated = 0;
+        for ( int32_t cellIdx : cellsToInstantiate )
+        {
+            StreamingCell& cell = m_streamingCells[cellIdx];
+            if ( numEntitiesInstantiated > 0 && ( numEntitiesInstantiated + cell.m_numEntities ) > m_streamingSettings.m_maxEntitiesInstantiatedPerFrame )
+            {
+                break;
+            }
+
+            if ( cell.m_pCollection.IsLoaded() && cell.m_pCollection->IsValid() )
+            {
+                TVector<Entity*> const createdEntities = cell.m_pCollection->CreateEntities( *loadingContext.m_pTypeRegistry, loadingContext.m_pTaskSystem );
+                AddEntities( createdEntities );
+
+                cell.m_createdEntities.reserve( createdEntities.size() );
+                for ( auto pCreatedEntity : createdEntities )
+                {
+                    cell.m_createdEntities.emplace_back( pCreatedEntity->GetID() );
+                }
+
+                numEntitiesInstantiated += (int32_t) createdEntities.size();
+            }
+            else // Failed cells are treated as empty, so that we dont keep retrying them
+            {
+                EE_LOG_ERROR( "Entity", "World Partition", "Failed to load map cell: %s", cell.m_pCollection.GetResourceID().c_str() );
+            }
+
+            // The collection is not needed once the entities have been created
+            loadingContext.m_pResourceSystem->UnloadResource( cell.m_pCollection );
+            cell.m_status = StreamingCell::Status::Loaded;
+            numCellsInFlight--;
+        }
+
+        // Request the closest cells that are in range
+        //-------------------------------------------------------------------------
+
+        eastl::sort( cellsToLoad.begin(), cellsToLoad.end(), ClosestCellComparator );
+
+        for ( int32_t cellIdx : cellsToLoad )
+        {
+            if ( numCellsInFlight >= m_streamingSettings.m_maxConcurrentCellLoads )
+            {
+                break;
+            }
+
+            StreamingCell& cell = m_streamingCells[cellIdx];
+            loadingContext.m_pResourceSystem->LoadResource( cell.m_pCollection );
+            cell.m_status = StreamingCell::Status::Loading;
+            numCellsInFlight++;
+        }
+    }
+
+    void EntityMap::DestroyCellEntities( StreamingCell& cell )
+    {
+        // Cell entities can be destroyed independently of the cell, so only destroy the ones that still exist
+        for ( EntityID const& entityID : cell.m_createdEntities )
+        {
+            if ( ContainsEntity( entityID ) )
+            {
+                DestroyEntity( entityID );
+            }
+        }
+
+        cell.m_createdEntities.clear();
+    }
+
+    void EntityMap::ResetStreamingCells( LoadingContext const& loadingContext )
+    {
+        for ( auto& cell : m_streamingCells )
+        {
+            if ( cell.m_status == StreamingCell::Status::Loading )
+            {
+                loadingContext.m_pResourceSystem->UnloadResource( cell.m_pCollection );
+            }
+        }
+
+        m_streamingCells.clear();
+        m_hasUpdatedCellStreaming = false;
+    }
+
     //-------------------------------------------------------------------------
 
     void EntityMap::ProcessEntityShutdownRequests( InitializationContext& initializationContext )
@@ -479,6 +839,8 @@ namespace EE::EntityModel
 
             // Remove from currently loading list
             m_entitiesCurrentlyLoading.erase_first_unsorted( pEntityToRemove );
+            m_entitiesPendingInitialization.erase_first_unsorted( pEntityToRemove );
+            m_priorityInitializationEntityIDs.erase_first_unsorted( pEntityToRemove->GetID() );
 
             // Unload entity
             pEntityToRemove->UnloadComponents( loadingContext );
@@ -495,7 +857,7 @@ namespace EE::EntityModel
         }
     }
 
-    void EntityMap::ProcessEntityLoadingAndInitialization( LoadingContext const& loadingContext, InitializationContext& initializationContext )
+    void EntityMap::ProcessEntityLoadingAndInitialization( LoadingContext const& loadingContext, InitializationContext& initializationContext, InitializationBudget const& initializationBudget )
     {
         EE_PROFILE_SCOPE_ENTITY( "Entity Loading/Initialization" );
 
@@ -528,7 +890,7 @@ namespace EE::EntityModel
 
             virtual void ExecuteRange( TaskSetPartition range, uint32_t threadnum ) override final
             {
-                EE_PROFILE_SCOPE_ENTITY( "Load and Initialize Entities" );
+                EE_PROFILE_SCOPE_ENTITY( "Load Entities" );
                 for ( uint32_t i = range.start; i < range.end; ++i )
                 {
                     auto pEntity = m_entitiesToLoad[i];
@@ -541,23 +903,11 @@ namespace EE::EntityModel
                         }
                         #endif
 
-                        // Initialize any entities that loaded successfully
+                        // Queue any entities that loaded successfully for initialization
                         if ( pEntity->IsLoaded() )
                         {
-                            // Prevent us from initializing entities whose parents are not yet initialized, this ensures that our attachment chains have a consistent initialized state
-                            if ( pEntity->HasSpatialParent() )
-                            {
-                                // We need to recheck the initialization state of this entity since while waiting for the lock, it could have been initialized by the parent
-                                Threading::RecursiveScopeLock parentLock( pEntity->GetSpatialParent()->m_internalStateMutex );
-                                if ( !pEntity->IsInitialized() && pEntity->GetSpatialParent()->IsInitialized() )
-                                {
-                                    pEntity->Initialize( m_initializationContext );
-                                }
-                            }
-                            else
-                            {
-                                pEntity->Initialize( m_initializationContext );
-                            }
+                            bool result = m_entitiesReadyForInitialization.enqueue( pEntity );
+                            EE_ASSERT( result );
                         }
                     }
                     else // Entity is still loading
@@ -571,6 +921,7 @@ namespace EE::EntityModel
         public:
 
             Threading::LockFreeQueue<Entity*>       m_stillLoadingEntities;
+            Threading::LockFreeQueue<Entity*>       m_entitiesReadyForInitialization;
 
         private:
 
@@ -594,7 +945,170 @@ namespace EE::EntityModel
             m_entitiesCurrentlyLoading.resize( numEntitiesStillLoading );
             size_t numDequeued = loadingTask.m_stillLoadingEntities.try_dequeue_bulk( m_entitiesCurrentlyLoading.data(), numEntitiesStillLoading );
             EE_ASSERT( numEntitiesStillLoading == numDequeued );
+
+            // Add all newly loaded entities to the initialization list
+            size_t const numEntitiesReadyForInitialization = loadingTask.m_entitiesReadyForInitialization.size_approx();
+            size_t const numEntitiesAlreadyPending = m_entitiesPendingInitialization.size();
+            m_entitiesPendingInitialization.resize( numEntitiesAlreadyPending + numEntitiesReadyForInitialization );
+            numDequeued = loadingTask.m_entitiesReadyForInitialization.try_dequeue_bulk( m_entitiesPendingInitialization.data() + numEntitiesAlreadyPending, numEntitiesReadyForInitialization );
+            EE_ASSERT( numEntitiesReadyForInitialization == numDequeued );
+        }
+
+        //-------------------------------------------------------------------------
+
+        if ( !m_entitiesPendingInitialization.empty() )
+        {
+            ProcessEntityInitialization( initializationContext, initializationBudget );
+        }
+    }
+
+    void EntityMap::ProcessEntityInitialization( InitializationContext& initializationContext, InitializationBudget const& initializationBudget )
+    {
+        EE_PROFILE_SCOPE_ENTITY( "Entity Initialization" );
+
+        struct EntityInitializationTask : public ITaskSet
+        {
+            EntityInitializationTask( InitializationContext& initializationContext, Entity* const* pEntitiesToInitialize, int32_t numEntitiesToInitialize )
+                : m_initializationContext( initializationContext )
+                , m_pEntitiesToInitialize( pEntitiesToInitialize )
+            {
+                m_SetSize = (uint32_t) numEntitiesToInitialize;
+            }
+
+            virtual void ExecuteRange( TaskSetPartition range, uint32_t threadnum ) override final
+            {
+                EE_PROFILE_SCOPE_ENTITY( "Initialize Entities" );
+                for ( uint32_t i = range.start; i < range.end; ++i )
+                {
+                    auto pEntity = m_pEntitiesToInitialize[i];
+                    EE_ASSERT( pEntity->IsLoaded() || pEntity->IsInitialized() );
+
+                    // Prevent us from initializing entities whose parents are not yet initialized, this ensures that our attachment chains have a consistent initialized state
+                    if ( pEntity->HasSpatialParent() )
+                    {
+                        // We need to recheck the initialization state of this entity since while waiting for the lock, it could have been initialized by the parent
+                        Threading::RecursiveScopeLock parentLock( pEntity->GetSpatialParent()->m_internalStateMutex );
+                        if ( !pEntity->IsInitialized() && pEntity->GetSpatialParent()->IsInitialized() )
+                        {
+                            pEntity->Initialize( m_initializationContext );
+                        }
+                    }
+                    else
+                    {
+                        pEntity->Initialize( m_initializationContext );
+                    }
+                }
+            }
+
+        private:
+
+            InitializationContext&                  m_initializationContext;
+            Entity* const*                          m_pEntitiesToInitialize;
+        };
+
+        //-------------------------------------------------------------------------
+
+        int32_t const numPendingEntities = (int32_t) m_entitiesPendingInitialization.size();
+
+        // Initialize everything in one go if we are not budgeted
+        if ( initializationBudget.IsUnlimited() )
+        {
+            Timer<PlatformClock> timer;
+            EntityInitializationTask initializationTask( initializationContext, m_entitiesPendingInitialization.data(), numPendingEntities );
+            initializationContext.m_pTaskSystem->ScheduleTask( &initializationTask );
+            initializationContext.m_pTaskSystem->WaitForTask( &initializationTask );
+            m_initializationStats.m_initializationTime += timer.GetElapsedTimeMilliseconds();
+            m_initializationStats.m_numEntitiesInitialized += numPendingEntities;
+
+            m_entitiesPendingInitialization.clear();
+            m_priorityInitializationEntityIDs.clear();
+            return;
+        }
+
+        // Sort pending entities by priority
+        //-------------------------------------------------------------------------
+        // Explicitly prioritized entities come first, followed by non-spatial entities (these are usually world-wide managers) and then all spatial entities by distance
+
+        {
+            EE_PROFILE_SCOPE_ENTITY( "Sort Entities By Priority" );
+
+            TVector<TPair<float, Entity*>> prioritizedEntities;
+            prioritizedEntities.reserve( numPendingEntities );
+
+            for ( auto pEntity : m_entitiesPendingInitialization )
+            {
+                float priority = 0.0f;
+                if ( VectorContains( m_priorityInitializationEntityIDs, pEntity->GetID() ) )
+                {
+                    priority = -1.0f;
+                }
+                else if ( pEntity->IsSpatialEntity() && !initializationBudget.m_priorityPositions.empty() )
+                {
+                    Vector const entityPosition = pEntity->GetWorldTransform().GetTranslation();
+                    priority = FLT_MAX;
+                    for ( auto const& priorityPosition : initializationBudget.m_priorityPositions )
+                    {
+                        priority = Math::Min( priority, entityPosition.GetDistanceSquared3( priorityPosition ) );
+                    }
+                }
+
+                prioritizedEntities.emplace_back( priority, pEntity );
+            }
+
+            auto PriorityComparator = [] ( TPair<float, Entity*> const& a, TPair<float, Entity*> const& b ) { return a.first < b.first; };
+            eastl::sort( prioritizedEntities.begin(), prioritizedEntities.end(), PriorityComparator );
+
+            for ( int32_t i = 0; i < numPendingEntities; i++ )
+            {
+                m_entitiesPendingInitialization[i] = prioritizedEntities[i].second;
+            }
         }
+
+        // Initialize entities in batches until we run out of budget
+        //-------------------------------------------------------------------------
+        // Component registration is done after each batch so that it is also covered by the time budget
+        // We always initialize at least one batch to guarantee progress
+
+        int32_t const batchSize = Math::Max( (int32_t) initializationContext.m_pTaskSystem->GetNumWorkers(), 1 ) * 4;
+        int32_t const maxEntitiesToInitialize = ( initializationBudget.m_maxEntitiesPerFrame > 0 ) ? Math::Min( initializationBudget.m_maxEntitiesPerFrame, numPendingEntities ) : numPendingEntities;
+
+        Timer<PlatformClock> budgetTimer;
+        int32_t numInitializedEntities = 0;
+        while ( numInitializedEntities < maxEntitiesToInitialize )
+        {
+            int32_t const numEntitiesInBatch = Math::Min( batchSize, maxEntitiesToInitialize - numInitializedEntities );
+
+            {
+                Timer<PlatformClock> timer;
+                EntityInitializationTask initializationTask( initializationContext, m_entitiesPendingInitialization.data() + numInitializedEntities, numEntitiesInBatch );
+                initializationContext.m_pTaskSystem->ScheduleTask( &initializationTask );
+                initializationContext.m_pTaskSystem->WaitForTask( &initializationTask );
+                m_initializationStats.m_initializationTime += timer.GetElapsedTimeMilliseconds();
+            }
+
+            numInitializedEntities += numEntitiesInBatch;
+            ProcessEntityRegistrationRequests( initializationContext );
+
+            if ( initializationBudget.m_maxTimePerFrame.ToFloat() > 0.0f && budgetTimer.GetElapsedTimeMilliseconds() >= initializationBudget.m_maxTimePerFrame )
+            {
+                break;
+            }
+        }
+
+        // Remove initialized entities
+        //-------------------------------------------------------------------------
+
+        if ( !m_priorityInitializationEntityIDs.empty() )
+        {
+            for ( int32_t i = 0; i < numInitializedEntities; i++ )
+            {
+                m_priorityInitializationEntityIDs.erase_first_unsorted( m_entitiesPendingInitialization[i]->GetID() );
+            }
+        }
+
+        m_entitiesPendingInitialization.erase( m_entitiesPendingInitialization.begin(), m_entitiesPendingInitialization.begin() + numInitializedEntities );
+        m_initializationStats.m_numEntitiesInitialized += numInitializedEntities;
+        m_initializationStats.m_numEntitiesPendingInitialization = (int32_t) m_entitiesPendingInitialization.size();
     }
 
     //-------------------------------------------------------------------------
@@ -603,6 +1117,8 @@ namespace EE::EntityModel
     {
         EE_ASSERT( Threading::IsMainThread() );
 
+        Timer<PlatformClock> timer;
+
         //-------------------------------------------------------------------------
         // Entity Registrations
         //-------------------------------------------------------------------------
@@ -758,12 +1274,17 @@ namespace EE::EntityModel
                 }
                 #endif
             }
+
+            m_initializationStats.m_numComponentsRegistered += (int32_t) numComponentsToRegister;
+            m_initializationStats.m_numComponentsUnregistered += (int32_t) numComponentsToUnregister;
         }
+
+        m_initializationStats.m_registrationTime += timer.GetElapsedTimeMilliseconds();
     }
 
     //-------------------------------------------------------------------------
 
-    bool EntityMap::UpdateLoadingAndStateChanges( LoadingContext const& loadingContext, InitializationContext& initializationContext )
+    bool EntityMap::UpdateLoadingAndStateChanges( LoadingContext const& loadingContext, InitializationContext& initializationContext, InitializationBudget const& initializationBudget )
     {
         EE_PROFILE_SCOPE_ENTITY( "Map State Update" );
         EE_ASSERT( Threading::IsMainThread() && loadingContext.IsValid() && initializationContext.IsValid() );
@@ -777,6 +1298,8 @@ namespace EE::EntityModel
 
         Threading::RecursiveScopeLock lock( m_mutex );
 
+        m_initializationStats.Reset();
+
         //-------------------------------------------------------------------------
 
         switch ( m_status )
@@ -807,13 +1330,13 @@ namespace EE::EntityModel
         // Update entity load states
         //-------------------------------------------------------------------------
 
-        ProcessEntityLoadingAndInitialization( loadingContext, initializationContext );
+        ProcessEntityLoadingAndInitialization( loadingContext, initializationContext, initializationBudget );
         ProcessEntityRegistrationRequests( initializationContext );
 
         // Return status
         //-------------------------------------------------------------------------
 
-        if ( m_status == Status::Loading || !m_entitiesCurrentlyLoading.empty() )
+        if ( m_status == Status::Loading || !m_entitiesCurrentlyLoading.empty() || !m_entitiesPendingInitialization.empty() )
         {
             return false;
         }
@@ -921,6 +1444,7 @@ namespace EE::EntityModel
 
         pEntity->UnloadComponents( loadingContext );
         m_entitiesCurrentlyLoading.erase_first_unsorted( pEntity );
+        m_entitiesPendingInitialization.erase_first_unsorted( pEntity );
         m_editedEntities.emplace_back( pEntity );
     }
 
@@ -956,6 +1480,9 @@ namespace EE::EntityModel
         EE_ASSERT( initializationContext.m_registerForEntityUpdate.size_approx() == 0 && initializationContext.m_unregisterForEntityUpdate.size_approx() == 0 );
         EE_ASSERT( initializationContext.m_componentsToRegister.size_approx() == 0 && initializationContext.m_componentsToUnregister.size_approx() == 0 );
 
+        // Collection resources might be reloaded so throw away all templates, they will be recreated on demand
+        DestroyCollectionTemplates();
+
         // Generate list of entities to be reloaded
         for ( auto const& requesterID : usersToReload )
         {
@@ -989,8 +1516,9 @@ namespace EE::EntityModel
         {
             EE_ASSERT( !pEntityToHotReload->IsInitialized() );
 
-            // We might still be loading this entity so remove it from the loading requests
+            // We might still be loading or waiting to initialize this entity so remove it from the loading requests
             m_entitiesCurrentlyLoading.erase_first_unsorted( pEntityToHotReload );
+            m_entitiesPendingInitialization.erase_first_unsorted( pEntityToHotReload );
 
             // Request unload of the components (client system needs to ensure that all resource requests are processed)
             pEntityToHotReload->UnloadComponents( loadingContext );
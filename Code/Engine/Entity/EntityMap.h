@@ -6,6 +6,7 @@
 #include "Base/Threading/Threading.h"
 #include "Base/Resource/ResourcePtr.h"
 #include "Base/Math/Transform.h"
+#include "Base/Time/Time.h"
 
 //-------------------------------------------------------------------------
 // Entity Map
@@ -28,6 +29,48 @@ namespace EE
         struct LoadingContext;
         struct InitializationContext;
         class EntityCollection;
+        class EntityCollectionTemplate;
+
+        //-------------------------------------------------------------------------
+
+        // Limits the amount of entity initialization (including world system registration) done by a map per frame
+        // Entities that dont fit in the budget stay loaded and are initialized on subsequent frames
+        struct InitializationBudget
+        {
+            inline bool IsUnlimited() const { return m_maxEntitiesPerFrame <= 0 && m_maxTimePerFrame.ToFloat() <= 0.0f; }
+
+        public:
+
+            TInlineVector<Vector, 4>                    m_priorityPositions; // Spatial entities closest to these positions are initialized first
+            Milliseconds                                m_maxTimePerFrame = 0.0f; // Zero means no time limit
+            int32_t                                     m_maxEntitiesPerFrame = 0; // Zero means no count limit
+        };
+
+        // Initialization work done by a map in a single frame
+        struct InitializationStats
+        {
+            inline void Reset() { *this = InitializationStats(); }
+
+            inline InitializationStats& operator+=( InitializationStats const& rhs )
+            {
+                m_numEntitiesInitialized += rhs.m_numEntitiesInitialized;
+                m_numEntitiesPendingInitialization += rhs.m_numEntitiesPendingInitialization;
+                m_numComponentsRegistered += rhs.m_numComponentsRegistered;
+                m_numComponentsUnregistered += rhs.m_numComponentsUnregistered;
+                m_initializationTime += rhs.m_initializationTime;
+                m_registrationTime += rhs.m_registrationTime;
+                return *this;
+            }
+
+        public:
+
+            int32_t                                     m_numEntitiesInitialized = 0;
+            int32_t                                     m_numEntitiesPendingInitialization = 0; // Loaded entities that were deferred due to the budget
+            int32_t                                     m_numComponentsRegistered = 0;
+            int32_t                                     m_numComponentsUnregistered = 0;
+            Milliseconds                                m_initializationTime = 0.0f;
+            Milliseconds                                m_registrationTime = 0.0f;
+        };
 
         //-------------------------------------------------------------------------
 
@@ -50,6 +93,30 @@ namespace EE
                 bool        m_shouldDestroy = false;
             };
 
+            // A world partition cell, this tracks the entities we created for the cell so that we can remove them when the cell is streamed out
+            struct StreamingCell
+            {
+                enum class Status : uint8_t
+                {
+                    Unloaded = 0,
+                    Loading,
+                    Loaded,
+                };
+
+                StreamingCell( EntityMapCellDescriptor const& cellDesc ) 
+                    : m_pCollection( cellDesc.m_collectionID )
+                    , m_coordinates( cellDesc.m_coordinates )
+                    , m_numEntities( cellDesc.m_numEntities )
+                {}
+
+                TResourcePtr<EntityCollection>  m_pCollection;
+                TVector<EntityID>               m_createdEntities;
+                Int2                            m_coordinates;
+                int32_t                         m_numEntities = 0;
+                float                           m_distanceToClosestSource = FLT_MAX;
+                Status                          m_status = Status::Unloaded;
+            };
+
         public:
 
             EntityMap(); // Default constructor creates a transient map
@@ -78,7 +145,14 @@ namespace EE
             //-------------------------------------------------------------------------
 
             // Updates map loading and entity state, returns true if all loading/state changes are complete, false otherwise
-            bool UpdateLoadingAndStateChanges( LoadingContext const& loadingContext, InitializationContext& initializationContext );
+            // Entity initialization is limited by the supplied budget, by default all loaded entities are initialized immediately
+            bool UpdateLoadingAndStateChanges( LoadingContext const& loadingContext, InitializationContext& initializationContext, InitializationBudget const& initializationBudget = InitializationBudget() );
+
+            // Get the initialization work done by this map during the last loading update
+            inline InitializationStats const& GetInitializationStats() const { return m_initializationStats; }
+
+            // Initialize these entities before any others once they are loaded, regardless of their distance to the budget's priority positions (e.g. the player)
+            void RequestPriorityInitialization( TVector<Entity*> const& entities );
 
             // Do we have any pending entity addition or removal requests?
             bool HasPendingAddOrRemoveRequests() const;
@@ -88,6 +162,24 @@ namespace EE
             inline bool IsUnloaded() const { return m_status == Status::Unloaded; }
             inline bool HasLoadingFailed() const { return m_status == Status::LoadFailed; }
 
+            // World Partition
+            //-------------------------------------------------------------------------
+
+            // Is this map split into streaming cells? This is only known once the map has loaded
+            inline bool IsPartitioned() const { return !m_streamingCells.empty(); }
+
+            // Get the number of cells whose entities have been created
+            int32_t GetNumStreamedInCells() const;
+
+            // Are there any cells in range of the streaming sources whose entities have not been created yet?
+            // This is always true for partitioned maps until the first streaming update has run
+            bool HasPendingCellLoads() const;
+
+            // Request or release cells based on their distance to the supplied streaming sources, this needs to be called before the loading update
+            // Cell loads are prioritized by distance and limited by the budgets in the map's streaming settings
+            // If 'streamInAllCells' is set, all cells will be loaded regardless of their distance (i.e. for tools worlds)
+            void UpdateCellStreaming( LoadingContext const& loadingContext, TInlineVector<Vector, 4> const& streamingSourcePositions, bool streamInAllCells = false );
+
             //-------------------------------------------------------------------------
             // Entity API
             //-------------------------------------------------------------------------
@@ -119,6 +211,14 @@ namespace EE
             // Takes 1 frame to be fully added
             void AddEntityCollection( TaskSystem* pTaskSystem, TypeSystem::TypeRegistry const& typeRegistry, EntityCollection const& entityCollectionDesc, Transform const& offsetTransform = Transform::Identity, TVector<Entity*>* pOutCreatedEntities = nullptr );
 
+            // Instantiates and adds an entity collection to the map by cloning a cached template of the collection
+            // This is significantly cheaper than 'AddEntityCollection' for collections that are spawned repeatedly (e.g. AI, projectiles)
+            // The template is created on first use and is kept until the map is unloaded, collections without a resource ID are not cached
+            void AddEntityCollectionFromTemplate( TaskSystem* pTaskSystem, TypeSystem::TypeRegistry const& typeRegistry, EntityCollection const& entityCollectionDesc, Transform const& offsetTransform = Transform::Identity, TVector<Entity*>* pOutCreatedEntities = nullptr );
+
+            // Create instances of a collection ahead of time so that subsequent 'AddEntityCollectionFromTemplate' calls only need to add them to the map
+            void PrewarmEntityCollection( TypeSystem::TypeRegistry const& typeRegistry, EntityCollection const& entityCollectionDesc, int32_t numInstances, TaskSystem* pTaskSystem = nullptr );
+
             // Add a newly created entity to the map - Transfers ownership of the entity to the map
             void AddEntity( Entity* pEntity );
 
@@ -209,11 +309,26 @@ namespace EE
             void ProcessEntityRegistrationRequests( InitializationContext& initializationContext );
             void ProcessEntityShutdownRequests( InitializationContext& initializationContext );
             void ProcessEntityRemovalRequests( LoadingContext const& loadingContext );
-            void ProcessEntityLoadingAndInitialization( LoadingContext const& loadingContext, InitializationContext& initializationContext );
+            void ProcessEntityLoadingAndInitialization( LoadingContext const& loadingContext, InitializationContext& initializationContext, InitializationBudget const& initializationBudget );
+
+            // Initialize the highest priority loaded entities that fit within the budget and register them with the world systems
+            void ProcessEntityInitialization( InitializationContext& initializationContext, InitializationBudget const& initializationBudget );
+
+            // Get (or create) the cached template for a collection
+            EntityCollectionTemplate* GetOrCreateCollectionTemplate( TypeSystem::TypeRegistry const& typeRegistry, EntityCollection const& entityCollectionDesc );
+
+            // Destroy all cached collection templates (and any pre-warmed instances)
+            void DestroyCollectionTemplates();
 
             // Remove entity
             Entity* RemoveEntityInternal( EntityID entityID, bool destroyEntityOnceRemoved );
 
+            // Destroy all entities created for a cell that still exist in this map
+            void DestroyCellEntities( StreamingCell& cell );
+
+            // Release any outstanding cell resources and clear all cell state
+            void ResetStreamingCells( LoadingContext const& loadingContext );
+
         private:
 
             EntityMapID                                 m_ID = EntityMapID::GenerateID(); // ID is always regenerated at creation time, do not rely on the ID being the same for a map on different runs
@@ -222,9 +337,16 @@ namespace EE
             TVector<Entity*>                            m_entities;
             THashMap<EntityID, Entity*>                 m_entityIDLookupMap;
             TVector<Entity*>                            m_entitiesCurrentlyLoading;
+            TVector<Entity*>                            m_entitiesPendingInitialization; // Loaded entities waiting on the initialization budget
+            TVector<EntityID>                           m_priorityInitializationEntityIDs;
+            InitializationStats                         m_initializationStats;
             TInlineVector<Entity*, 5>                   m_entitiesToLoad;
             TInlineVector<RemovalRequest, 5>            m_entitiesToRemove;
             EventBindingID                              m_entityUpdateEventBindingID;
+            EntityMapStreamingSettings                  m_streamingSettings;
+            TVector<StreamingCell>                      m_streamingCells;
+            bool                                        m_hasUpdatedCellStreaming = false; // Cell distances are only valid once this is set
+            THashMap<ResourceID, EntityCollectionTemplate*> m_collectionTemplates;
             Status                                      m_status = Status::Unloaded;
             bool const                                  m_isTransientMap = false; // If this is set, then this is a transient map i.e.created and managed at runtime and not loaded from disk
 
@@ -0,0 +1,336 @@
+#include "EntityObjectPools.h"
+#include "Base/Threading/Threading.h"
+#include "Base/Types/HashMap.h"
+#include "Base/Math/Math.h"
+
+//-------------------------------------------------------------------------
+
+namespace EE::EntityModel
+{
+    namespace
+    {
+        // All slabs are the same size and are aligned to their size with the slab header stored at the start of the slab
+        // This matches the allocator's span size: every heap allocation lives in an aligned span that starts with the allocator's own header,
+        // so masking the address of any heap allocated object always yields readable memory and the cookie tells us if it is one of our slabs
+        static constexpr size_t const g_slabSize = 64 * 1024;
+        static constexpr size_t const g_maxPooledObjectSize = 4 * 1024;
+        static constexpr uint64_t const g_slabCookie = 0x45454F424A534C42; // Never a valid allocator span header
+
+        struct TypePool;
+
+        struct Slab
+        {
+            uint64_t                                m_cookie = g_slabCookie;
+            TypePool*                               m_pPool = nullptr;
+            void*                                   m_pFreeList = nullptr; // Intrusive list, the first bytes of each free object point to the next free object
+            int32_t                                 m_numAllocatedObjects = 0;
+        };
+
+        struct TypePool
+        {
+            TypePool( TypeSystem::TypeInfo const* pTypeInfo )
+                : m_pTypeInfo( pTypeInfo )
+            {
+                EE_ASSERT( pTypeInfo->m_size > 0 && pTypeInfo->m_alignment > 0 );
+                m_objectStride = Math::Max( (uint32_t) sizeof( void* ), (uint32_t) pTypeInfo->m_size );
+                m_objectStride += (uint32_t) Memory::CalculatePaddingForAlignment( m_objectStride, pTypeInfo->m_alignment );
+                m_firstObjectOffset = (uint32_t) ( sizeof( Slab ) + Memory::CalculatePaddingForAlignment( sizeof( Slab ), pTypeInfo->m_alignment ) );
+                m_numObjectsPerSlab = (int32_t) ( ( g_slabSize - m_firstObjectOffset ) / m_objectStride );
+                EE_ASSERT( m_numObjectsPerSlab > 1 );
+            }
+
+        public:
+
+            TypeSystem::TypeInfo const*             m_pTypeInfo = nullptr;
+            uint32_t                                m_objectStride = 0;
+            uint32_t                                m_firstObjectOffset = 0;
+            int32_t                                 m_numObjectsPerSlab = 0;
+            Threading::Mutex                        m_mutex;
+            TVector<Slab*>                          m_slabs;
+            TVector<Slab*>                          m_slabsWithFreeSpace;
+            int32_t                                 m_numEmptySlabs = 0;
+        };
+
+        //-------------------------------------------------------------------------
+
+        struct PoolRegistry
+        {
+            ~PoolRegistry()
+            {
+                for ( auto& poolPair : m_pools )
+                {
+                    EE_ASSERT( poolPair.second->m_slabs.empty() );
+                    EE::Delete( poolPair.second );
+                }
+            }
+
+            TypePool* GetOrCreatePool( TypeSystem::TypeInfo const* pTypeInfo )
+            {
+                {
+                    Threading::ScopeLockRead readLock( m_poolsMutex );
+                    auto foundIter = m_pools.find( pTypeInfo );
+                    if ( foundIter != m_pools.end() )
+                    {
+                        return foundIter->second;
+                    }
+                }
+
+                //-------------------------------------------------------------------------
+
+                Threading::ScopeLockWrite writeLock( m_poolsMutex );
+                auto foundIter = m_pools.find( pTypeInfo );
+                if ( foundIter == m_pools.end() )
+                {
+                    foundIter = m_pools.insert( TPair<TypeSystem::TypeInfo const*, TypePool*>( pTypeInfo, EE::New<TypePool>( pTypeInfo ) ) ).first;
+                }
+
+                return foundIter->second;
+            }
+
+            // Lock free, a slab header is only ever written by the pool that owns it and pooled objects are only freed by their owners
+            static Slab* FindSlab( void* pObject )
+            {
+                auto pSlab = reinterpret_cast<Slab*>( reinterpret_cast<uintptr_t>( pObject ) & ~uintptr_t( g_slabSize - 1 ) );
+                return ( pSlab->m_cookie == g_slabCookie ) ? pSlab : nullptr;
+            }
+
+            //-------------------------------------------------------------------------
+
+            // Needs to be called with the pool lock held
+            Slab* CreateSlab( TypePool* pPool )
+            {
+                uint8_t* pSlabMemory = (uint8_t*) EE::Alloc( g_slabSize, g_slabSize );
+                auto pSlab = new ( pSlabMemory ) Slab();
+                pSlab->m_pPool = pPool;
+
+                // Build the free list, in address order
+                uint8_t* pFirstObjectMemory = pSlabMemory + pPool->m_firstObjectOffset;
+                void** ppNext = &pSlab->m_pFreeList;
+                for ( int32_t i = 0; i < pPool->m_numObjectsPerSlab; i++ )
+                {
+                    void* pObjectMemory = pFirstObjectMemory + ( i * pPool->m_objectStride );
+                    *ppNext = pObjectMemory;
+                    ppNext = reinterpret_cast<void**>( pObjectMemory );
+                }
+                *ppNext = nullptr;
+
+                pPool->m_slabs.emplace_back( pSlab );
+                pPool->m_slabsWithFreeSpace.emplace_back( pSlab );
+                pPool->m_numEmptySlabs++;
+
+                return pSlab;
+            }
+
+            // Needs to be called with the pool lock held
+            void DestroySlab( Slab* pSlab )
+            {
+                TypePool* pPool = pSlab->m_pPool;
+                EE_ASSERT( pSlab->m_numAllocatedObjects == 0 );
+
+                pPool->m_slabs.erase_first_unsorted( pSlab );
+                pPool->m_slabsWithFreeSpace.erase_first_unsorted( pSlab );
+                pPool->m_numEmptySlabs--;
+
+                // Clear the cookie since the allocator might reuse this memory for something else
+                pSlab->m_cookie = 0;
+                pSlab->~Slab();
+                EE::Free( pSlab );
+            }
+
+            //-------------------------------------------------------------------------
+
+            void* Allocate( TypePool* pPool )
+            {
+                Threading::ScopeLock lock( pPool->m_mutex );
+
+                Slab* pSlab = pPool->m_slabsWithFreeSpace.empty() ? CreateSlab( pPool ) : pPool->m_slabsWithFreeSpace.back();
+                EE_ASSERT( pSlab->m_pFreeList != nullptr );
+
+                void* pObjectMemory = pSlab->m_pFreeList;
+                pSlab->m_pFreeList = *reinterpret_cast<void**>( pObjectMemory );
+
+                if ( pSlab->m_numAllocatedObjects == 0 )
+                {
+                    pPool->m_numEmptySlabs--;
+                }
+
+                pSlab->m_numAllocatedObjects++;
+                if ( pSlab->m_numAllocatedObjects == pPool->m_numObjectsPerSlab )
+                {
+                    EE_ASSERT( pSlab->m_pFreeList == nullptr );
+                    pPool->m_slabsWithFreeSpace.erase_first_unsorted( pSlab );
+                }
+
+                return pObjectMemory;
+            }
+
+            void Free( Slab* pSlab, void* pObjectMemory )
+            {
+                TypePool* pPool = pSlab->m_pPool;
+                Threading::ScopeLock lock( pPool->m_mutex );
+
+                EE_ASSERT( pSlab->m_numAllocatedObjects > 0 );
+                if ( pSlab->m_numAllocatedObjects == pPool->m_numObjectsPerSlab )
+                {
+                    pPool->m_slabsWithFreeSpace.emplace_back( pSlab );
+                }
+
+                *reinterpret_cast<void**>( pObjectMemory ) = pSlab->m_pFreeList;
+                pSlab->m_pFreeList = pObjectMemory;
+                pSlab->m_numAllocatedObjects--;
+
+                // Only keep a single empty slab around
+                if ( pSlab->m_numAllocatedObjects == 0 )
+                {
+                    pPool->m_numEmptySlabs++;
+                    if ( pPool->m_numEmptySlabs > 1 )
+                    {
+                        DestroySlab( pSlab );
+                    }
+                }
+            }
+
+            void ReleaseUnusedMemory()
+            {
+                Threading::ScopeLockRead readLock( m_poolsMutex );
+
+                for ( auto& poolPair : m_pools )
+                {
+                    TypePool* pPool = poolPair.second;
+                    Threading::ScopeLock lock( pPool->m_mutex );
+
+                    for ( int32_t i = (int32_t) pPool->m_slabs.size() - 1; i >= 0; i-- )
+                    {
+                        if ( pPool->m_slabs[i]->m_numAllocatedObjects == 0 )
+                        {
+                            DestroySlab( pPool->m_slabs[i] );
+                        }
+                    }
+                }
+            }
+
+        public:
+
+            Threading::ReadWriteMutex                               m_poolsMutex;
+            THashMap<TypeSystem::TypeInfo const*, TypePool*>        m_pools;
+        };
+
+        static PoolRegistry* g_pPoolRegistry = nullptr;
+    }
+
+    //-------------------------------------------------------------------------
+
+    void EntityObjectPools::Initialize()
+    {
+        EE_ASSERT( g_pPoolRegistry == nullptr );
+
+        // Finding the slab for an object relies on the allocator's aligned spans, so we can only pool objects with the custom allocator
+        #if EE_USE_CUSTOM_ALLOCATOR
+        g_pPoolRegistry = EE::New<PoolRegistry>();
+        #endif
+    }
+
+    void EntityObjectPools::Shutdown()
+    {
+        if ( g_pPoolRegistry == nullptr )
+        {
+            return;
+        }
+
+        g_pPoolRegistry->ReleaseUnusedMemory();
+
+        // If there are still live pooled objects, we cannot release the pools
+        Stats const stats = GetStats();
+        if ( stats.m_numSlabs > 0 )
+        {
+            EE_LOG_WARNING( "Entity", "Object Pools", "Pooled entity objects were leaked (%d slabs still in use)!", stats.m_numSlabs );
+            return;
+        }
+
+        EE::Delete( g_pPoolRegistry );
+    }
+
+    //-------------------------------------------------------------------------
+
+    void* EntityObjectPools::AllocateObjectMemory( TypeSystem::TypeInfo const* pTypeInfo )
+    {
+        EE_ASSERT( pTypeInfo != nullptr );
+
+        if ( g_pPoolRegistry == nullptr || pTypeInfo->m_size <= 0 || pTypeInfo->m_size > g_maxPooledObjectSize || pTypeInfo->m_alignment <= 0 || pTypeInfo->m_alignment > g_maxPooledObjectSize )
+        {
+            return nullptr;
+        }
+
+        TypePool* pPool = g_pPoolRegistry->GetOrCreatePool( pTypeInfo );
+        return g_pPoolRegistry->Allocate( pPool );
+    }
+
+    IReflectedType* EntityObjectPools::CreateObject( TypeSystem::TypeInfo const* pTypeInfo )
+    {
+        void* pObjectMemory = AllocateObjectMemory( pTypeInfo );
+        if ( pObjectMemory == nullptr )
+        {
+            return pTypeInfo->CreateType();
+        }
+
+        auto pObject = reinterpret_cast<IReflectedType*>( pObjectMemory );
+        pTypeInfo->CreateTypeInPlace( pObject );
+        return pObject;
+    }
+
+    void EntityObjectPools::DestroyObject( IReflectedType* pObject )
+    {
+        if ( pObject == nullptr )
+        {
+            return;
+        }
+
+        Slab* pSlab = ( g_pPoolRegistry != nullptr ) ? PoolRegistry::FindSlab( pObject ) : nullptr;
+        if ( pSlab == nullptr )
+        {
+            EE::Delete( pObject );
+            return;
+        }
+
+        EE_ASSERT( pSlab->m_pPool->m_pTypeInfo == pObject->GetTypeInfo() );
+        pObject->~IReflectedType();
+        g_pPoolRegistry->Free( pSlab, pObject );
+    }
+
+    void EntityObjectPools::ReleaseUnusedMemory()
+    {
+        if ( g_pPoolRegistry == nullptr )
+        {
+            return;
+        }
+
+        g_pPoolRegistry->ReleaseUnusedMemory();
+    }
+
+    EntityObjectPools::Stats EntityObjectPools::GetStats()
+    {
+        Stats stats;
+        if ( g_pPoolRegistry == nullptr )
+        {
+            return stats;
+        }
+
+        Threading::ScopeLockRead readLock( g_pPoolRegistry->m_poolsMutex );
+        stats.m_numPools = (int32_t) g_pPoolRegistry->m_pools.size();
+
+        for ( auto& poolPair : g_pPoolRegistry->m_pools )
+        {
+            TypePool* pPool = poolPair.second;
+            Threading::ScopeLock lock( pPool->m_mutex );
+
+            stats.m_numSlabs += (int32_t) pPool->m_slabs.size();
+            stats.m_totalSlabMemory += pPool->m_slabs.size() * g_slabSize;
+            for ( auto pSlab : pPool->m_slabs )
+            {
+                stats.m_numAllocatedObjects += pSlab->m_numAllocatedObjects;
+            }
+        }
+
+        return stats;
+    }
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include "Engine/_Module/API.h"
+#include "Base/TypeSystem/ReflectedType.h"
+#include "Base/TypeSystem/TypeInfo.h"
+
+//-------------------------------------------------------------------------
+// Entity Object Pools
+//-------------------------------------------------------------------------
+// Components and systems are allocated from per-type slab pools instead of individually from the heap
+//
+// * Each type has its own pool of fixed size slabs, objects of the same type are tightly packed
+// * Freed objects are recycled by subsequent allocations of the same type
+// * Slabs are aligned to their size and start with their header, so freeing an object only locks its type's pool
+// * Slabs that become empty are returned to the heap (we keep a single empty slab per type to avoid thrashing)
+// * Destroying an object that was not allocated from a pool is safe, it will simply be deleted
+// * If the pools are not initialized (e.g. in the resource compilers) all objects are allocated from the heap
+//
+// All functions are threadsafe
+//-------------------------------------------------------------------------
+
+namespace EE::EntityModel
+{
+    class EE_ENGINE_API EntityObjectPools
+    {
+    public:
+
+        struct Stats
+        {
+            int32_t                 m_numPools = 0;
+            int32_t                 m_numSlabs = 0;
+            int32_t                 m_numAllocatedObjects = 0;
+            size_t                  m_totalSlabMemory = 0;
+        };
+
+    public:
+
+        static void Initialize();
+        static void Shutdown();
+
+        // Allocate uninitialized memory for an instance of the specified type, returns nullptr if the type cannot be pooled
+        [[nodiscard]] static void* AllocateObjectMemory( TypeSystem::TypeInfo const* pTypeInfo );
+
+        // Create a new default constructed instance of the specified type
+        [[nodiscard]] static IReflectedType* CreateObject( TypeSystem::TypeInfo const* pTypeInfo );
+
+        template<typename T>
+        [[nodiscard]] inline static T* CreateObject( TypeSystem::TypeInfo const* pTypeInfo )
+        {
+            EE_ASSERT( pTypeInfo->IsDerivedFrom<T>() );
+            return reinterpret_cast<T*>( CreateObject( pTypeInfo ) );
+        }
+
+        // Destroy an object, this is safe to call for objects that were not created from a pool
+        static void DestroyObject( IReflectedType* pObject );
+
+        // Release all empty slabs back to the heap
+        static void ReleaseUnusedMemory();
+
+        static Stats GetStats();
+    };
+}
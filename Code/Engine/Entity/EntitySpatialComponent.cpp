@@ -1,5 +1,6 @@
 #include "EntitySpatialComponent.h"
 #include "EntityLog.h"
+#include "Engine/Entity/Systems/WorldSystem_SpatialIndex.h"
 
 //-------------------------------------------------------------------------
 
@@ -139,6 +140,90 @@ namespace EE
         }
     }
 
+    //-------------------------------------------------------------------------
+
+    void SpatialEntityComponent::SetTransformUpdatesDeferred( bool deferUpdates )
+    {
+        if ( !deferUpdates && m_isTransformDirty )
+        {
+            PropagateDeferredTransforms( false, false );
+        }
+
+        m_deferTransformUpdates = deferUpdates;
+    }
+
+    void SpatialEntityComponent::MarkTransformDirty( bool isWorldSpaceChange, bool triggerCallback )
+    {
+        m_isTransformDirty = true;
+        m_isDirtyTransformInWorldSpace = isWorldSpaceChange;
+        m_triggerCallbackOnPropagation |= triggerCallback;
+
+        // A hierarchy is only ever modified by a single thread (see the entity update) so this is safe
+        SpatialEntityComponent* pParent = m_pSpatialParent;
+        while ( pParent != nullptr && !pParent->m_hasDirtyChildren )
+        {
+            pParent->m_hasDirtyChildren = true;
+            pParent = pParent->m_pSpatialParent;
+        }
+
+        if ( !m_isQueuedForDeferredTransformUpdate )
+        {
+            m_isQueuedForDeferredTransformUpdate = true;
+            m_pSpatialIndex->QueueDeferredTransformUpdate( this );
+        }
+    }
+
+    void SpatialEntityComponent::PropagateDeferredTransforms( bool wasParentUpdated, bool triggerCallback )
+    {
+        bool const shouldUpdate = wasParentUpdated || m_isTransformDirty;
+        if ( shouldUpdate )
+        {
+            if ( m_isTransformDirty )
+            {
+                triggerCallback = ( wasParentUpdated && triggerCallback ) || m_triggerCallbackOnPropagation;
+            }
+
+            // World space changes keep the set world transform, so we need to calculate the new local transform
+            if ( m_isTransformDirty && m_isDirtyTransformInWorldSpace )
+            {
+                m_transform = ( m_pSpatialParent != nullptr ) ? Transform::Delta( m_pSpatialParent->GetAttachmentSocketTransform( m_parentAttachmentSocketID ), m_worldTransform ) : m_worldTransform;
+            }
+            else
+            {
+                m_worldTransform = ( m_pSpatialParent != nullptr ) ? m_transform * m_pSpatialParent->GetAttachmentSocketTransform( m_parentAttachmentSocketID ) : m_transform;
+            }
+
+            m_worldBounds = m_bounds.GetTransformed( m_worldTransform );
+            NotifyWorldBoundsChanged();
+            m_isTransformDirty = false;
+            m_triggerCallbackOnPropagation = false;
+        }
+
+        //-------------------------------------------------------------------------
+
+        if ( shouldUpdate || m_hasDirtyChildren )
+        {
+            m_hasDirtyChildren = false;
+
+            for ( auto pChild : m_spatialChildren )
+            {
+                pChild->PropagateDeferredTransforms( shouldUpdate, triggerCallback );
+            }
+        }
+
+        if ( shouldUpdate && triggerCallback )
+        {
+            OnWorldTransformUpdated();
+        }
+    }
+
+    void SpatialEntityComponent::QueueSpatialIndexUpdate()
+    {
+        m_pSpatialIndex->QueueBoundsUpdate( this );
+    }
+
+    //-------------------------------------------------------------------------
+
     void SpatialEntityComponent::Initialize()
     {
         EntityComponent::Initialize();
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "EntityComponent.h"
+#include "EntityWorldSystem.h"
 #include "Base/Math/BoundingVolumes.h"
 #include "Base/Math/Transform.h"
 
@@ -15,6 +16,26 @@ namespace EE
     }
     #endif
 
+    namespace EntityModel
+    {
+        class SpatialIndexWorldSystem;
+        class EntityCollectionTemplate;
+    }
+
+    //-------------------------------------------------------------------------
+    // Spatial Query Layers
+    //-------------------------------------------------------------------------
+    // Each spatial component belongs to a set of layers, spatial index queries can be filtered to only return components on certain layers
+
+    namespace SpatialQueryLayer
+    {
+        constexpr static uint32_t const Default = 1 << 0;
+        constexpr static uint32_t const Render = 1 << 1;
+        constexpr static uint32_t const Interaction = 1 << 2;
+
+        constexpr static uint32_t const All = 0xFFFFFFFF;
+    }
+
     //-------------------------------------------------------------------------
 
     class EE_ENGINE_API SpatialEntityComponent : public EntityComponent
@@ -26,6 +47,8 @@ namespace EE
         friend EntityModel::EntityDescriptor;
         friend EntityModel::EntityMapEditor;
         friend EntityModel::EntityCollection;
+        friend EntityModel::EntityCollectionTemplate;
+        friend EntityModel::SpatialIndexWorldSystem;
 
         #if EE_DEVELOPMENT_TOOLS
         friend EntityModel::EntityEditor;
@@ -47,17 +70,17 @@ namespace EE
         // Are we the root component for this entity? 
         inline bool IsRootComponent() const { return m_pSpatialParent == nullptr || m_pSpatialParent->m_entityID != m_entityID; }
 
-        inline Transform const& GetLocalTransform() const { return m_transform; }
-        inline OBB const& GetLocalBounds() const { return m_bounds; }
+        inline Transform const& GetLocalTransform() const { EE_VALIDATE_COMPONENT_READ( this ); return m_transform; }
+        inline OBB const& GetLocalBounds() const { EE_VALIDATE_COMPONENT_READ( this ); return m_bounds; }
 
-        inline Transform const& GetWorldTransform() const { return m_worldTransform; }
-        inline OBB const& GetWorldBounds() const { return m_worldBounds; }
+        inline Transform const& GetWorldTransform() const { EE_VALIDATE_COMPONENT_READ( this ); return m_worldTransform; }
+        inline OBB const& GetWorldBounds() const { EE_VALIDATE_COMPONENT_READ( this ); return m_worldBounds; }
 
         // Get world space position
-        inline Vector const& GetPosition() const { return m_worldTransform.GetTranslation(); }
+        inline Vector const& GetPosition() const { EE_VALIDATE_COMPONENT_READ( this ); return m_worldTransform.GetTranslation(); }
 
         // Get world space orientation
-        inline Quaternion const& GetOrientation() const { return m_worldTransform.GetRotation(); }
+        inline Quaternion const& GetOrientation() const { EE_VALIDATE_COMPONENT_READ( this ); return m_worldTransform.GetRotation(); }
         
         // Get world space forward vector
         inline Vector GetForwardVector() const { return m_worldTransform.GetForwardVector(); }
@@ -71,13 +94,23 @@ namespace EE
         // Call to update the local transform - this will also update the world transform for this component and all children
         inline void SetLocalTransform( Transform const& newTransform )
         {
+            EE_VALIDATE_COMPONENT_WRITE( this );
             m_transform = newTransform;
-            CalculateWorldTransform();
+
+            if ( ShouldDeferTransformUpdates() )
+            {
+                MarkTransformDirty( false, true );
+            }
+            else
+            {
+                CalculateWorldTransform();
+            }
         }
 
         // Call to update the world transform - this will also updated the local transform for this component and all children's world transforms
         inline void SetWorldTransform( Transform const& newTransform )
         {
+            EE_VALIDATE_COMPONENT_WRITE( this );
             SetWorldTransformDirectly( newTransform );
         }
 
@@ -89,6 +122,32 @@ namespace EE
             SetWorldTransform( newWorldTransform );
         }
 
+        // Deferred Transform Updates
+        //-------------------------------------------------------------------------
+        // When enabled, transform changes only mark this component as dirty and the world transforms and bounds for it and all its children
+        // are calculated by the world rather than on every change. This happens once the entity update completes (before the world systems
+        // are updated) and again at the end of each update stage. Changes are only deferred once the component is in a world.
+        //
+        // Until then: local transform changes are not reflected in the world transform, and world transform changes are only reflected on
+        // this component and not on its children. If multiple changes are made, the last one wins.
+
+        inline bool AreTransformUpdatesDeferred() const { return m_deferTransformUpdates; }
+
+        // Enable/disable deferred transform updates, disabling will immediately update any pending changes
+        void SetTransformUpdatesDeferred( bool deferUpdates );
+
+        // Does this component have a pending deferred transform update?
+        inline bool IsTransformDirty() const { return m_isTransformDirty; }
+
+        // Spatial Index
+        //-------------------------------------------------------------------------
+
+        // Get the layers this component is on, this is only read when the component is added to the spatial index
+        virtual uint32_t GetSpatialQueryLayers() const { return SpatialQueryLayer::Default; }
+
+        // Has this component been added to the world's spatial index
+        inline bool IsInSpatialIndex() const { return m_pSpatialIndex != nullptr; }
+
         // Parenting
         //-------------------------------------------------------------------------
 
@@ -166,6 +225,7 @@ namespace EE
             EE_DEVELOPMENT_TOOLS_ONLY( m_boundsValidationGuard = true );
             m_bounds = CalculateLocalBounds();
             m_worldBounds = m_bounds.GetTransformed( m_worldTransform );
+            NotifyWorldBoundsChanged();
         }
 
         // Try to find and return the world space transform for the specified socket
@@ -188,6 +248,16 @@ namespace EE
         // This must be used with care and so not be exposed externally.
         inline void SetWorldTransformDirectly( Transform newWorldTransform, bool triggerCallback = true )
         {
+            // Only record the change, the local transform and children will be updated by the propagation pass
+            if ( ShouldDeferTransformUpdates() )
+            {
+                m_worldTransform = newWorldTransform;
+                m_worldBounds = m_bounds.GetTransformed( m_worldTransform );
+                NotifyWorldBoundsChanged();
+                MarkTransformDirty( true, triggerCallback );
+                return;
+            }
+
             // Only update the transform if we have a parent, if we dont have a parent it means we are the root transform
             if ( m_pSpatialParent != nullptr )
             {
@@ -203,6 +273,7 @@ namespace EE
 
             // Calculate world bounds
             m_worldBounds = m_bounds.GetTransformed( m_worldTransform );
+            NotifyWorldBoundsChanged();
 
             // Propagate the world transforms on the children - children will always have their callbacks fired!
             for ( auto pChild : m_spatialChildren )
@@ -223,6 +294,27 @@ namespace EE
 
     private:
 
+        // Deferred updates need the spatial index to track the dirty components
+        inline bool ShouldDeferTransformUpdates() const { return m_deferTransformUpdates && m_pSpatialIndex != nullptr; }
+
+        // Flag this component as needing a transform update and let all our parents know that they need to visit us in the propagation pass
+        void MarkTransformDirty( bool isWorldSpaceChange, bool triggerCallback );
+
+        // Resolve any deferred transform changes for this component and all its children, in hierarchy order
+        void PropagateDeferredTransforms( bool wasParentUpdated, bool triggerCallback );
+
+        // Queue the new world bounds to be updated in the spatial index, this is done at most once per spatial index update
+        inline void NotifyWorldBoundsChanged()
+        {
+            if ( m_pSpatialIndex != nullptr && !m_isQueuedForSpatialIndexUpdate )
+            {
+                m_isQueuedForSpatialIndexUpdate = true;
+                QueueSpatialIndexUpdate();
+            }
+        }
+
+        void QueueSpatialIndexUpdate();
+
         // Called whenever the local transform is modified
         inline void CalculateWorldTransform( bool triggerCallback = true )
         {
@@ -239,6 +331,7 @@ namespace EE
 
             // Calculate world bounds
             m_worldBounds = m_bounds.GetTransformed( m_worldTransform );
+            NotifyWorldBoundsChanged();
 
             // Propagate the world transforms on the children
             for ( auto pChild : m_spatialChildren )
@@ -269,6 +362,22 @@ namespace EE
 
         //-------------------------------------------------------------------------
 
+        EE_REFLECT();
+        bool                                                                m_deferTransformUpdates = false;        // Should transform changes be deferred until the propagation pass
+        bool                                                                m_isTransformDirty = false;             // Do we have a pending deferred transform change
+        bool                                                                m_isDirtyTransformInWorldSpace = false; // Was the last deferred change made to the world transform
+        bool                                                                m_triggerCallbackOnPropagation = false; // Should the deferred change fire the transform updated callback
+        bool                                                                m_hasDirtyChildren = false;             // Do any of our children (direct or indirect) have pending deferred changes
+        bool                                                                m_isQueuedForDeferredTransformUpdate = false;
+
+        //-------------------------------------------------------------------------
+
+        EntityModel::SpatialIndexWorldSystem*                               m_pSpatialIndex = nullptr;              // The spatial index we are registered with (managed by the spatial index system)
+        int32_t                                                             m_spatialIndexProxyIdx = InvalidIndex;  // Our proxy in the spatial index
+        bool                                                                m_isQueuedForSpatialIndexUpdate = false;
+
+        //-------------------------------------------------------------------------
+
         #if EE_DEVELOPMENT_TOOLS
         bool                                                                m_boundsValidationGuard = false;
         #endif
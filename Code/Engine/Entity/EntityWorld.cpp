@@ -1,9 +1,11 @@
 #include "EntityWorld.h"
 #include "EntityWorldUpdateContext.h"
 #include "EntityWorldSettings.h"
+#include "Engine/Entity/Systems/WorldSystem_SpatialIndex.h"
 #include "Base/Resource/ResourceSystem.h"
 #include "Base/Profiling.h"
 #include "Base/TypeSystem/TypeRegistry.h"
+#include "Base/Time/Timers.h"
 #include <eastl/sort.h>
 
 //-------------------------------------------------------------------------
@@ -17,13 +19,14 @@ namespace EE
 
     EntityWorld::~EntityWorld()
     {
-        EE_ASSERT( m_maps.empty());
+        EE_ASSERT( m_maps.empty() && m_initialMapLoads.empty() );
         EE_ASSERT( m_worldSystems.empty() );
         EE_ASSERT( m_entityUpdateList.empty() );
 
         for ( int8_t i = 0; i < (int8_t) UpdateStage::NumStages; i++ )
         {
             EE_ASSERT( m_systemUpdateLists[i].empty() );
+            EE_ASSERT( m_systemUpdateSchedules[i].IsEmpty() );
         }
 
         //-------------------------------------------------------------------------
@@ -89,6 +92,14 @@ namespace EE
             }
         }
 
+        // Build the update schedules
+        for ( int8_t i = 0; i < (int8_t) UpdateStage::NumStages; i++ )
+        {
+            m_systemUpdateSchedules[i].Build( (UpdateStage) i, m_systemUpdateLists[i] );
+        }
+
+        m_pSpatialIndex = GetWorldSystem<EntityModel::SpatialIndexWorldSystem>();
+
         // Create World Settings
         //-------------------------------------------------------------------------
 
@@ -140,6 +151,13 @@ namespace EE
         // Shutdown all world systems
         //-------------------------------------------------------------------------
 
+        for ( int8_t i = 0; i < (int8_t) UpdateStage::NumStages; i++ )
+        {
+            m_systemUpdateSchedules[i].Clear();
+        }
+
+        m_pSpatialIndex = nullptr;
+
         for( auto pWorldSystem : m_worldSystems )
         {
             // Remove from update lists
@@ -192,17 +210,95 @@ namespace EE
     {
         EE_PROFILE_SCOPE_ENTITY( "World Loading" );
 
+        // Stream partitioned map cells
+        //-------------------------------------------------------------------------
+        // This needs to happen before the map loading update so that any newly created cell entities get their load requested this frame
+        // Tools worlds have no meaningful streaming sources so they always have all cells loaded
+
+        TInlineVector<Vector, 4> streamingSourcePositions;
+        streamingSourcePositions.emplace_back( m_viewport.GetViewPosition() );
+        for ( auto const& source : m_streamingSources )
+        {
+            streamingSourcePositions.emplace_back( source.m_position );
+        }
+
+        for ( auto pMap : m_maps )
+        {
+            if ( pMap->IsPartitioned() )
+            {
+                pMap->UpdateCellStreaming( m_loadingContext, streamingSourcePositions, !IsGameWorld() );
+            }
+        }
+
         // Update all maps internal loading state
         //-------------------------------------------------------------------------
         // This will fill the world initialization/registration lists used below
         // This will also handle all hot-reload unload/load requests
 
+        EntityModel::InitializationBudget initializationBudget;
+        if ( IsGameWorld() )
+        {
+            initializationBudget.m_priorityPositions = streamingSourcePositions;
+            initializationBudget.m_maxTimePerFrame = m_entityInitializationTimeBudget;
+            initializationBudget.m_maxEntitiesPerFrame = m_maxEntitiesInitializedPerFrame;
+        }
+
+        m_entityInitializationStats.Reset();
+
         for ( int32_t i = (int32_t) m_maps.size() - 1; i >= 0; i-- )
         {
-            if ( m_maps[i]->UpdateLoadingAndStateChanges( m_loadingContext, m_initializationContext ) )
+            bool const isMapUpToDate = m_maps[i]->UpdateLoadingAndStateChanges( m_loadingContext, m_initializationContext, initializationBudget );
+            m_entityInitializationStats += m_maps[i]->GetInitializationStats();
+
+            // The budget is shared by all maps, each map will always initialize at least a few entities so that no map is ever starved
+            EntityModel::InitializationStats const& mapStats = m_maps[i]->GetInitializationStats();
+            if ( initializationBudget.m_maxEntitiesPerFrame > 0 )
+            {
+                initializationBudget.m_maxEntitiesPerFrame = Math::Max( initializationBudget.m_maxEntitiesPerFrame - mapStats.m_numEntitiesInitialized, 1 );
+            }
+
+            if ( initializationBudget.m_maxTimePerFrame.ToFloat() > 0.0f )
+            {
+                float const remainingTime = initializationBudget.m_maxTimePerFrame.ToFloat() - mapStats.m_initializationTime.ToFloat() - mapStats.m_registrationTime.ToFloat();
+                initializationBudget.m_maxTimePerFrame = Math::Max( remainingTime, 0.001f );
+            }
+
+            if ( isMapUpToDate )
             {
+                // Once a map and its initially streamed cells have finished loading, its entities hold all the resources it needs
+                if ( !m_maps[i]->IsTransientMap() )
+                {
+                    ResourceID const& mapResourceID = m_maps[i]->GetMapResourceID();
+                    if ( m_maps[i]->HasLoadingFailed() )
+                    {
+                        CompleteInitialMapLoad( mapResourceID, false );
+                    }
+                    else if ( m_maps[i]->IsLoaded() )
+                    {
+                        auto const foundIter = VectorFind( m_initialMapLoads, mapResourceID, [] ( InitialMapLoad const& initialLoad, ResourceID const& mapResourceID ) { return initialLoad.m_mapResourceID == mapResourceID; } );
+                        if ( foundIter != m_initialMapLoads.end() )
+                        {
+                            bool const hasTimedOut = foundIter->m_timer.GetElapsedTimeSeconds() > InitialMapLoad::s_timeout;
+                            if ( hasTimedOut )
+                            {
+                                EE_LOG_WARNING( "Entity", "Map Loading", "Timed out waiting for the initial cells of map (%s) to stream in", mapResourceID.c_str() );
+                            }
+
+                            if ( hasTimedOut || !m_maps[i]->HasPendingCellLoads() )
+                            {
+                                CompleteInitialMapLoad( mapResourceID, true );
+                            }
+                        }
+                    }
+                }
+
                 if ( m_maps[i]->IsUnloaded() )
                 {
+                    if ( !m_maps[i]->IsTransientMap() )
+                    {
+                        CompleteInitialMapLoad( m_maps[i]->GetMapResourceID(), false );
+                    }
+
                     EE::Delete( m_maps[i] );
                     m_maps.erase_unsorted( m_maps.begin() + i );
                 }
@@ -217,11 +313,11 @@ namespace EE
 
         struct EntityUpdateTask final : public ITaskSet
         {
-            EntityUpdateTask( EntityWorldUpdateContext const& context, TVector<Entity*>& updateList )
+            EntityUpdateTask( EntityWorldUpdateContext const& context, TVector<TVector<Entity*>> const& partitions )
                 : m_context( context )
-                , m_updateList( updateList )
+                , m_partitions( partitions )
             {
-                m_SetSize = (uint32_t) updateList.size();
+                m_SetSize = (uint32_t) partitions.size();
             }
 
             // Only used for spatial dependency chain updates
@@ -237,27 +333,30 @@ namespace EE
 
             virtual void ExecuteRange( TaskSetPartition range, uint32_t threadnum ) override final
             {
+                UpdateStage const updateStage = m_context.GetUpdateStage();
+
                 for ( uint64_t i = range.start; i < range.end; ++i )
                 {
-                    auto pEntity = m_updateList[i];
-
-                    // Ignore any entities with spatial parents, these will be updated by their parents
-                    if ( pEntity->HasSpatialParent() )
+                    for ( auto pEntity : m_partitions[i] )
                     {
-                        continue;
-                    }
-
-                    //-------------------------------------------------------------------------
-
-                    if ( pEntity->HasAttachedEntities() )
-                    {
-                        EE_PROFILE_SCOPE_ENTITY( "Update Entity Chain" );
-                        RecursiveEntityUpdate( pEntity );
-                    }
-                    else // Direct entity update
-                    {
-                        EE_PROFILE_SCOPE_ENTITY( "Update Entity" );
-                        pEntity->UpdateSystems( m_context );
+                        // Entities with spatial parents are updated by their parents
+                        EE_ASSERT( !pEntity->HasSpatialParent() );
+
+                        Timer<PlatformClock> timer;
+
+                        if ( pEntity->HasAttachedEntities() )
+                        {
+                            EE_PROFILE_SCOPE_ENTITY( "Update Entity Chain" );
+                            RecursiveEntityUpdate( pEntity );
+                        }
+                        else // Direct entity update
+                        {
+                            EE_PROFILE_SCOPE_ENTITY( "Update Entity" );
+                            pEntity->UpdateSystems( m_context );
+                        }
+
+                        // Each root entity is only ever updated by a single task so this is safe
+                        pEntity->RecordUpdateCost( updateStage, timer.GetElapsedTimeMicroseconds() );
                     }
                 }
             }
@@ -265,7 +364,7 @@ namespace EE
         private:
 
             EntityWorldUpdateContext const&              m_context;
-            TVector<Entity*>&                            m_updateList;
+            TVector<TVector<Entity*>> const&             m_partitions;
         };
 
         //-------------------------------------------------------------------------
@@ -289,31 +388,85 @@ namespace EE
 
         EntityWorldUpdateContext entityWorldUpdateContext( context, this );
 
-        // Update entities
+        // Update entities and systems
         //-------------------------------------------------------------------------
+        // The schedule will run the entity update and any world systems that can overlap with it, the remaining world systems
+        // are then run according to their dependencies. Exclusive world systems are always run on the main thread.
+        //
+        // Any deferred spatial transform changes made by the entities are resolved as soon as the entity update completes, so that
+        // the world systems see the final transforms and bounds for this stage. Any changes made by the systems are resolved afterwards.
+
+        auto UpdateSpatialData = [this] ()
+        {
+            m_pSpatialIndex->ProcessDeferredTransformUpdates( m_pTaskSystem );
+            m_pSpatialIndex->ProcessBoundsUpdates();
+        };
 
-        EntityUpdateTask entityUpdateTask( entityWorldUpdateContext, m_entityUpdateList );
-        m_pTaskSystem->ScheduleTask( &entityUpdateTask );
-        m_pTaskSystem->WaitForTask( &entityUpdateTask );
+        BuildEntityUpdatePartitions( updateStage );
+        EntityUpdateTask entityUpdateTask( entityWorldUpdateContext, m_entityUpdatePartitions );
+        m_systemUpdateSchedules[(int8_t) updateStage].Execute( m_pTaskSystem, entityWorldUpdateContext, &entityUpdateTask, UpdateSpatialData );
 
         // Force execution on main thread for debugging purposes
-        //entityUpdateTask.ExecuteRange( { 0u, (uint32_t) m_entityUpdateList.size() }, 0 );
+        //entityUpdateTask.ExecuteRange( { 0u, (uint32_t) m_entityUpdatePartitions.size() }, 0 );
+
+        UpdateSpatialData();
 
-        // Update systems
         //-------------------------------------------------------------------------
 
-        for ( auto pSystem : m_systemUpdateLists[(int8_t) updateStage] )
+        if ( updateStage == UpdateStage::FrameEnd )
         {
-            EE_PROFILE_SCOPE_ENTITY( "Update World Systems" );
-            EE_ASSERT( pSystem->GetRequiredUpdatePriorities().IsStageEnabled( updateStage ) );
-            pSystem->UpdateSystem( entityWorldUpdateContext );
+            m_timeStepRequested = false;
         }
+    }
+
+    void EntityWorld::BuildEntityUpdatePartitions( UpdateStage updateStage )
+    {
+        EE_PROFILE_SCOPE_ENTITY( "Build Entity Update Partitions" );
 
+        // Sort the update list from most to least expensive, the list order is not relied upon anywhere else
         //-------------------------------------------------------------------------
 
-        if ( updateStage == UpdateStage::FrameEnd )
+        auto comparator = [updateStage] ( Entity* const& pEntityA, Entity* const& pEntityB )
         {
-            m_timeStepRequested = false;
+            return pEntityA->GetEstimatedUpdateCost( updateStage ) > pEntityB->GetEstimatedUpdateCost( updateStage );
+        };
+
+        eastl::sort( m_entityUpdateList.begin(), m_entityUpdateList.end(), comparator );
+
+        // Greedily assign each root entity to the cheapest partition (longest processing time first)
+        //-------------------------------------------------------------------------
+        // We create a partition per thread (workers + main thread)
+
+        int32_t const numPartitions = Math::Max( 1, Math::Min( (int32_t) m_pTaskSystem->GetNumWorkers() + 1, (int32_t) m_entityUpdateList.size() ) );
+        m_entityUpdatePartitions.resize( numPartitions );
+        for ( auto& partition : m_entityUpdatePartitions )
+        {
+            partition.clear();
+        }
+
+        TInlineVector<float, 32> partitionCosts;
+        partitionCosts.resize( numPartitions, 0.0f );
+
+        for ( auto pEntity : m_entityUpdateList )
+        {
+            if ( pEntity->HasSpatialParent() )
+            {
+                continue;
+            }
+
+            int32_t cheapestPartitionIdx = 0;
+            for ( int32_t i = 1; i < numPartitions; i++ )
+            {
+                if ( partitionCosts[i] < partitionCosts[cheapestPartitionIdx] )
+                {
+                    cheapestPartitionIdx = i;
+                }
+            }
+
+            m_entityUpdatePartitions[cheapestPartitionIdx].emplace_back( pEntity );
+
+            // Unmeasured entities are given a nominal cost so that they still get spread across the partitions
+            partitionCosts[cheapestPartitionIdx] += Math::Max( pEntity->GetEstimatedUpdateCost( updateStage ).ToFloat(), 1.0f );
         }
     }
 
@@ -429,6 +582,16 @@ namespace EE
         EE_ASSERT( mapResourceID.IsValid() && mapResourceID.GetResourceTypeID() == EntityModel::EntityMapDescriptor::GetStaticResourceTypeID() );
 
         EE_ASSERT( !HasMap( mapResourceID ) );
+
+        #if EE_DEVELOPMENT_TOOLS
+        m_loadingContext.m_pResourceSystem->BeginLoadOrderRecording( mapResourceID );
+        #endif
+
+        // Issue all the recorded reads for this map before we start discovering its resources
+        m_loadingContext.m_pResourceSystem->PrefetchResources( mapResourceID );
+
+        m_initialMapLoads.emplace_back( mapResourceID );
+
         auto pNewMap = m_maps.emplace_back( EE::New<EntityModel::EntityMap>( mapResourceID ) );
         pNewMap->Load( m_loadingContext, m_initializationContext );
         return pNewMap->GetID();
@@ -440,9 +603,50 @@ namespace EE
 
         auto const foundMapIter = VectorFind( m_maps, mapResourceID, [] ( EntityModel::EntityMap const* pMap, ResourceID const& mapResourceID ) { return pMap->GetMapResourceID() == mapResourceID; } );
         EE_ASSERT( foundMapIter != m_maps.end() );
+
+        // The map may be unloaded before it finished loading
+        CompleteInitialMapLoad( mapResourceID, false );
+
         ( *foundMapIter )->Unload( m_loadingContext, m_initializationContext );
     }
 
+    void EntityWorld::CompleteInitialMapLoad( ResourceID const& mapResourceID, bool wasSuccessful )
+    {
+        auto const foundIter = VectorFind( m_initialMapLoads, mapResourceID, [] ( InitialMapLoad const& initialLoad, ResourceID const& mapResourceID ) { return initialLoad.m_mapResourceID == mapResourceID; } );
+        if ( foundIter == m_initialMapLoads.end() )
+        {
+            return;
+        }
+
+        m_initialMapLoads.erase_unsorted( foundIter );
+        m_loadingContext.m_pResourceSystem->ReleasePrefetchedResources( mapResourceID );
+
+        #if EE_DEVELOPMENT_TOOLS
+        m_loadingContext.m_pResourceSystem->EndLoadOrderRecording( mapResourceID, wasSuccessful );
+        #endif
+    }
+
+    void EntityWorld::SetStreamingSource( uint64_t sourceID, Vector const& position )
+    {
+        for ( auto& source : m_streamingSources )
+        {
+            if ( source.m_ID == sourceID )
+            {
+                source.m_position = position;
+                return;
+            }
+        }
+
+        m_streamingSources.emplace_back( sourceID, position );
+    }
+
+    void EntityWorld::RemoveStreamingSource( uint64_t sourceID )
+    {
+        auto const foundSourceIter = VectorFind( m_streamingSources, sourceID, [] ( StreamingSource const& source, uint64_t sourceID ) { return source.m_ID == sourceID; } );
+        EE_ASSERT( foundSourceIter != m_streamingSources.end() );
+        m_streamingSources.erase_unsorted( foundSourceIter );
+    }
+
     //-------------------------------------------------------------------------
     // Editing / Hot Reload
     //-------------------------------------------------------------------------
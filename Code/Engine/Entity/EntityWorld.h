@@ -1,6 +1,7 @@
 #pragma once
 
 #include "EntityWorldSystem.h"
+#include "EntityWorldSystemSchedule.h"
 #include "EntityInitializationContext.h"
 #include "Entity.h"
 #include "EntityMap.h"
@@ -9,6 +10,7 @@
 #include "Base/Types/Arrays.h"
 #include "Base/Settings/SettingsRegistry.h"
 #include "Base/Drawing/DebugDrawingSystem.h"
+#include "Base/Time/Timers.h"
 
 //-------------------------------------------------------------------------
 
@@ -19,6 +21,7 @@ namespace EE
     class DebugView;
 
     namespace Settings { class SettingsRegistry; }
+    namespace EntityModel { class SpatialIndexWorldSystem; }
 
     //-------------------------------------------------------------------------
 
@@ -182,6 +185,31 @@ namespace EE
         EntityMapID LoadMap( ResourceID const& mapResourceID );
         void UnloadMap( ResourceID const& mapResourceID );
 
+        //-------------------------------------------------------------------------
+        // World Partition Streaming
+        //-------------------------------------------------------------------------
+        // Cells of partitioned maps are streamed in around the viewport as well as any additional streaming sources
+
+        // Add or move an additional streaming source
+        void SetStreamingSource( uint64_t sourceID, Vector const& position );
+
+        // Remove an additional streaming source
+        void RemoveStreamingSource( uint64_t sourceID );
+
+        //-------------------------------------------------------------------------
+        // Entity Initialization Budget
+        //-------------------------------------------------------------------------
+        // Limits the entity initialization and world system registration work done per frame in game worlds, tools worlds are never budgeted
+        // Entities are initialized closest to the viewport and streaming sources first, a zero limit disables that limit
+
+        inline void SetEntityInitializationBudget( Milliseconds maxTimePerFrame, int32_t maxEntitiesPerFrame ) { m_entityInitializationTimeBudget = maxTimePerFrame; m_maxEntitiesInitializedPerFrame = maxEntitiesPerFrame; }
+
+        inline Milliseconds GetEntityInitializationTimeBudget() const { return m_entityInitializationTimeBudget; }
+        inline int32_t GetMaxEntitiesInitializedPerFrame() const { return m_maxEntitiesInitializedPerFrame; }
+
+        // Get the initialization work done across all maps during the last loading update
+        inline EntityModel::InitializationStats const& GetEntityInitializationStats() const { return m_entityInitializationStats; }
+
         // Find an entity in the map
         inline Entity* FindEntity( EntityID entityID ) const
         {
@@ -311,6 +339,36 @@ namespace EE
         void HotReload_ReloadEntities( TInlineVector<Resource::ResourceRequesterID, 20> const& usersToReload );
         #endif
 
+    private:
+
+        struct StreamingSource
+        {
+            StreamingSource( uint64_t ID, Vector const& position ) : m_ID( ID ), m_position( position ) {}
+
+            uint64_t                                                            m_ID = 0;
+            Vector                                                              m_position;
+        };
+
+        // A map's initial load is only complete once the cells around the streaming sources have been streamed in
+        // The map's prefetch and load order recording are kept open until then (or until we time out)
+        struct InitialMapLoad
+        {
+            constexpr static float const s_timeout = 30.0f; // Seconds
+
+            InitialMapLoad( ResourceID const& mapResourceID ) : m_mapResourceID( mapResourceID ) { m_timer.Start(); }
+
+            ResourceID                                                          m_mapResourceID;
+            Timer<PlatformClock>                                                m_timer;
+        };
+
+    private:
+
+        // Release the prefetch and stop the load order recording for a map, does nothing if the map's initial load has already been completed
+        void CompleteInitialMapLoad( ResourceID const& mapResourceID, bool wasSuccessful );
+
+        // Split the root entities into partitions of roughly equal estimated cost, each partition is sorted from most to least expensive
+        void BuildEntityUpdatePartitions( UpdateStage updateStage );
+
     private:
 
         EntityWorldID                                                           m_worldID = EntityWorldID::Generate();
@@ -326,10 +384,18 @@ namespace EE
 
         // Maps
         TInlineVector<EntityModel::EntityMap*, 3>                               m_maps;
+        TInlineVector<StreamingSource, 4>                                       m_streamingSources;
+        TVector<InitialMapLoad>                                                 m_initialMapLoads;
+        EntityModel::InitializationStats                                        m_entityInitializationStats;
+        Milliseconds                                                            m_entityInitializationTimeBudget = 4.0f;
+        int32_t                                                                 m_maxEntitiesInitializedPerFrame = 0;
 
         // Entities
         TVector<Entity*>                                                        m_entityUpdateList;
+        TVector<TVector<Entity*>>                                               m_entityUpdatePartitions; // Cost balanced sets of root entities, rebuilt every update
         TVector<EntityWorldSystem*>                                             m_systemUpdateLists[(int8_t) UpdateStage::NumStages];
+        EntityModel::WorldSystemUpdateSchedule                                  m_systemUpdateSchedules[(int8_t) UpdateStage::NumStages];
+        EntityModel::SpatialIndexWorldSystem*                                   m_pSpatialIndex = nullptr;
 
         // Time Scaling + Pause
         float                                                                   m_timeScale = 1.0f; // <= 0 means that the world is paused
@@ -1,6 +1,7 @@
 #include "EntityWorldManager.h"
 #include "EntityWorld.h"
 #include "EntityLog.h"
+#include "EntityObjectPools.h"
 #include "Engine/Player/Systems/WorldSystem_PlayerManager.h"
 #include "Engine/Camera/Systems/WorldSystem_CameraManager.h"
 #include "Engine/Camera/Components/Component_Camera.h"
@@ -20,6 +21,7 @@ namespace EE
     void EntityWorldManager::Initialize( SystemRegistry const& systemsRegistry )
     {
         m_pSystemsRegistry = &systemsRegistry;
+        EntityModel::EntityObjectPools::Initialize();
 
         //-------------------------------------------------------------------------
 
@@ -46,6 +48,8 @@ namespace EE
 
         m_worldSystemTypeInfos.clear();
         m_pSystemsRegistry = nullptr;
+
+        EntityModel::EntityObjectPools::Shutdown();
     }
 
     //-------------------------------------------------------------------------
@@ -1,10 +1,61 @@
 #include "EntityWorldSystem.h"
 #include "EntityWorld.h"
+#include "EntityComponent.h"
 
 //-------------------------------------------------------------------------
 
 namespace EE
 {
+    template<typename T, eastl_size_t N>
+    static bool DoListsOverlap( TInlineVector<T, N> const& listA, TInlineVector<T, N> const& listB )
+    {
+        for ( auto const& item : listA )
+        {
+            if ( VectorContains( listB, item ) )
+            {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    bool WorldSystemUpdateDependencies::DoSystemsConflict( uint32_t systemA, WorldSystemUpdateDependencies const& dependenciesA, uint32_t systemB, WorldSystemUpdateDependencies const& dependenciesB )
+    {
+        // Each system writes to itself
+        if ( systemA == systemB || VectorContains( dependenciesB.m_systemReads, systemA ) || VectorContains( dependenciesB.m_systemWrites, systemA ) )
+        {
+            return true;
+        }
+
+        if ( VectorContains( dependenciesA.m_systemReads, systemB ) || VectorContains( dependenciesA.m_systemWrites, systemB ) )
+        {
+            return true;
+        }
+
+        // Shared systems
+        if ( DoListsOverlap( dependenciesA.m_systemWrites, dependenciesB.m_systemReads ) || DoListsOverlap( dependenciesA.m_systemWrites, dependenciesB.m_systemWrites ) || DoListsOverlap( dependenciesA.m_systemReads, dependenciesB.m_systemWrites ) )
+        {
+            return true;
+        }
+
+        // Entity maps
+        if ( dependenciesA.m_modifiesEntityMaps && dependenciesB.m_modifiesEntityMaps )
+        {
+            return true;
+        }
+
+        // Components
+        if ( DoListsOverlap( dependenciesA.m_componentWrites, dependenciesB.m_componentReads ) || DoListsOverlap( dependenciesA.m_componentWrites, dependenciesB.m_componentWrites ) || DoListsOverlap( dependenciesA.m_componentReads, dependenciesB.m_componentWrites ) )
+        {
+            return true;
+        }
+
+        return false;
+    }
+
+    //-------------------------------------------------------------------------
+
     bool EntityWorldSystem::IsInAGameWorld() const
     {
         return m_pWorld->GetWorldType() == EntityWorldType::Game;
@@ -14,4 +65,40 @@ namespace EE
     {
         return m_pWorld->GetWorldType() == EntityWorldType::Tools;
     }
-}
\ No newline at end of file
+}
+
+//-------------------------------------------------------------------------
+
+#if EE_DEVELOPMENT_TOOLS
+namespace EE::EntityModel
+{
+    static thread_local WorldSystemUpdateDependencies const* g_pUpdatingSystemDependencies = nullptr;
+
+    ScopedComponentAccessValidation::ScopedComponentAccessValidation( WorldSystemUpdateDependencies const* pDependencies )
+        : m_pPreviousDependencies( g_pUpdatingSystemDependencies )
+    {
+        g_pUpdatingSystemDependencies = pDependencies;
+    }
+
+    ScopedComponentAccessValidation::~ScopedComponentAccessValidation()
+    {
+        g_pUpdatingSystemDependencies = m_pPreviousDependencies;
+    }
+
+    void ValidateComponentAccess( EntityComponent const* pComponent, bool isWrite )
+    {
+        EE_ASSERT( pComponent != nullptr );
+
+        WorldSystemUpdateDependencies const* pDependencies = g_pUpdatingSystemDependencies;
+        if ( pDependencies == nullptr )
+        {
+            return;
+        }
+
+        // Conflicts are detected by exact type so declaring a base component type doesnt cover its derived types
+        TypeSystem::TypeID const componentTypeID = pComponent->GetTypeID();
+        bool const isAccessDeclared = VectorContains( pDependencies->m_componentWrites, componentTypeID ) || ( !isWrite && VectorContains( pDependencies->m_componentReads, componentTypeID ) );
+        EE_ASSERT( isAccessDeclared );
+    }
+}
+#endif
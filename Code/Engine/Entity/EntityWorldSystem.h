@@ -20,7 +20,39 @@ namespace EE
     class EntityWorldUpdateContext;
     class Entity;
     class EntityComponent;
-    namespace EntityModel { class EntityMap; }
+    namespace EntityModel { class EntityMap; class WorldSystemUpdateSchedule; }
+
+    //-------------------------------------------------------------------------
+    // World System Update Dependencies
+    //-------------------------------------------------------------------------
+    // Declares the data that a world system accesses during its update so that independent systems can be updated concurrently
+    // A system always implicitly writes to itself, so two systems only conflict if one of them writes data the other accesses
+    // Systems can only be run alongside the entity update if they explicitly opt in (i.e. they dont touch anything entity systems use
+    // or the spatial index, which is updated once the entity update completes)
+    // Component conflicts are detected by exact type, so systems need to declare the concrete component types they access
+    // Systems that add or remove entities need to declare it, these are serialized against each other and never overlap the entity update
+
+    struct EE_ENGINE_API WorldSystemUpdateDependencies
+    {
+        template<typename T> inline WorldSystemUpdateDependencies& ReadsSystem() { m_systemReads.emplace_back( T::s_entitySystemID ); return *this; }
+        template<typename T> inline WorldSystemUpdateDependencies& WritesSystem() { m_systemWrites.emplace_back( T::s_entitySystemID ); return *this; }
+        template<typename T> inline WorldSystemUpdateDependencies& ReadsComponent() { m_componentReads.emplace_back( T::GetStaticTypeID() ); return *this; }
+        template<typename T> inline WorldSystemUpdateDependencies& WritesComponent() { m_componentWrites.emplace_back( T::GetStaticTypeID() ); return *this; }
+        inline WorldSystemUpdateDependencies& ModifiesEntityMaps() { m_modifiesEntityMaps = true; return *this; }
+        inline WorldSystemUpdateDependencies& CanRunDuringEntityUpdate() { m_canRunDuringEntityUpdate = true; return *this; }
+
+        // Does the update of system A conflict with the update of system B, i.e. do they need to be run in priority order
+        static bool DoSystemsConflict( uint32_t systemA, WorldSystemUpdateDependencies const& dependenciesA, uint32_t systemB, WorldSystemUpdateDependencies const& dependenciesB );
+
+    public:
+
+        TInlineVector<uint32_t, 4>                  m_systemReads;
+        TInlineVector<uint32_t, 4>                  m_systemWrites;
+        TInlineVector<TypeSystem::TypeID, 4>        m_componentReads;
+        TInlineVector<TypeSystem::TypeID, 4>        m_componentWrites;
+        bool                                        m_modifiesEntityMaps = false;
+        bool                                        m_canRunDuringEntityUpdate = false;
+    };
 
     //-------------------------------------------------------------------------
 
@@ -30,6 +62,7 @@ namespace EE
 
         friend class EntityWorld;
         friend EntityModel::EntityMap;
+        friend EntityModel::WorldSystemUpdateSchedule;
 
     public:
 
@@ -46,6 +79,10 @@ namespace EE
         // Get the required update stages and priorities for this component
         virtual UpdatePriorityList const& GetRequiredUpdatePriorities() = 0;
 
+        // Get the data this system accesses during its update, this is used to update independent systems concurrently on worker threads
+        // Systems without any declared dependencies are exclusive: they are updated on the main thread with no other world systems running
+        virtual WorldSystemUpdateDependencies const* GetUpdateDependencies() const { return nullptr; }
+
         // Called when the system is registered with the world - using explicit "EntitySystem" name to allow for a standalone initialize function
         virtual void InitializeSystem( SystemRegistry const& systemRegistry ) {};
 
@@ -65,10 +102,47 @@ namespace EE
 
         EntityWorld*     m_pWorld = nullptr;
     };
+
+    //-------------------------------------------------------------------------
+    // Component Access Validation
+    //-------------------------------------------------------------------------
+    // Development only check that a world system updated on a worker thread only accesses the component types it declared
+    // Exclusive systems and code that isnt run as part of a world system update are not validated
+
+    #if EE_DEVELOPMENT_TOOLS
+    namespace EntityModel
+    {
+        // Sets the dependencies of the world system being updated on the calling thread for the lifetime of the scope
+        class EE_ENGINE_API [[nodiscard]] ScopedComponentAccessValidation
+        {
+        public:
+
+            ScopedComponentAccessValidation( WorldSystemUpdateDependencies const* pDependencies );
+            ~ScopedComponentAccessValidation();
+
+        private:
+
+            WorldSystemUpdateDependencies const*    m_pPreviousDependencies = nullptr;
+        };
+
+        // Asserts if the world system being updated on the calling thread has not declared access to this component's type
+        EE_ENGINE_API void ValidateComponentAccess( EntityComponent const* pComponent, bool isWrite );
+    }
+    #endif
 }
 
 //-------------------------------------------------------------------------
 
+#if EE_DEVELOPMENT_TOOLS
+    #define EE_VALIDATE_COMPONENT_READ( pComponent ) EE::EntityModel::ValidateComponentAccess( pComponent, false )
+    #define EE_VALIDATE_COMPONENT_WRITE( pComponent ) EE::EntityModel::ValidateComponentAccess( pComponent, true )
+#else
+    #define EE_VALIDATE_COMPONENT_READ( pComponent )
+    #define EE_VALIDATE_COMPONENT_WRITE( pComponent )
+#endif
+
+//-------------------------------------------------------------------------
+
 #define EE_ENTITY_WORLD_SYSTEM( Type, ... )\
     EE_REFLECT_TYPE( Type );\
     constexpr static uint32_t const s_entitySystemID = Hash::FNV1a::GetHash32( #Type );\
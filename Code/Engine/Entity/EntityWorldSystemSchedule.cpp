@@ -0,0 +1,230 @@
+#include "EntityWorldSystemSchedule.h"
+#include "EntityWorldSystem.h"
+#include "Base/Threading/TaskSystem.h"
+#include "Base/Profiling.h"
+
+//-------------------------------------------------------------------------
+
+namespace EE::EntityModel
+{
+    struct WorldSystemUpdateSchedule::SystemTask final : public ITaskSet
+    {
+        SystemTask( EntityWorldSystem* pSystem )
+            : m_pSystem( pSystem )
+        {
+            m_SetSize = 1;
+        }
+
+        virtual void ExecuteRange( TaskSetPartition range, uint32_t threadnum ) override final
+        {
+            EE_PROFILE_SCOPE_ENTITY( "Update World System" );
+            EE_ASSERT( m_pContext != nullptr );
+
+            #if EE_DEVELOPMENT_TOOLS
+            EntityModel::ScopedComponentAccessValidation const accessValidation( m_pSystem->GetUpdateDependencies() );
+            #endif
+
+            m_pSystem->UpdateSystem( *m_pContext );
+        }
+
+    public:
+
+        EntityWorldSystem*                          m_pSystem = nullptr;
+        EntityWorldUpdateContext const*             m_pContext = nullptr;
+        TaskDependency                              m_entityUpdateDependency;
+        int32_t                                     m_numSystemDependencies = 0;
+        bool                                        m_canRunDuringEntityUpdate = false;
+    };
+
+    // Only used to trigger the systems that need to wait for the entity update
+    struct EntityUpdateCompletedTask final : public ITaskSet
+    {
+        virtual void ExecuteRange( TaskSetPartition range, uint32_t threadnum ) override final {}
+    };
+
+    //-------------------------------------------------------------------------
+
+    WorldSystemUpdateSchedule::~WorldSystemUpdateSchedule()
+    {
+        EE_ASSERT( m_tasks.empty() && m_dependencies.empty() && m_pEntityUpdateCompletedTask == nullptr );
+    }
+
+    void WorldSystemUpdateSchedule::Build( UpdateStage stage, TVector<EntityWorldSystem*> const& systems )
+    {
+        Clear();
+
+        m_pEntityUpdateCompletedTask = EE::New<EntityUpdateCompletedTask>();
+
+        // Create tasks and split them into segments
+        //-------------------------------------------------------------------------
+
+        for ( EntityWorldSystem* pSystem : systems )
+        {
+            EE_ASSERT( pSystem->GetRequiredUpdatePriorities().IsStageEnabled( stage ) );
+
+            WorldSystemUpdateDependencies const* pDependencies = pSystem->GetUpdateDependencies();
+            bool const isExclusive = ( pDependencies == nullptr );
+
+            SystemTask* pTask = m_tasks.emplace_back( EE::New<SystemTask>( pSystem ) );
+            pTask->m_canRunDuringEntityUpdate = !isExclusive && pDependencies->m_canRunDuringEntityUpdate && !pDependencies->m_modifiesEntityMaps;
+
+            if ( isExclusive || m_segments.empty() || m_segments.back().m_isExclusive )
+            {
+                Segment& segment = m_segments.emplace_back();
+                segment.m_firstTaskIdx = (int32_t) m_tasks.size() - 1;
+                segment.m_isExclusive = isExclusive;
+            }
+
+            m_segments.back().m_numTasks++;
+        }
+
+        // Create the dependencies between conflicting systems in each parallel segment
+        //-------------------------------------------------------------------------
+
+        for ( Segment const& segment : m_segments )
+        {
+            if ( segment.m_isExclusive )
+            {
+                continue;
+            }
+
+            int32_t const segmentEndIdx = segment.m_firstTaskIdx + segment.m_numTasks;
+            for ( int32_t taskIdx = segment.m_firstTaskIdx + 1; taskIdx < segmentEndIdx; taskIdx++ )
+            {
+                SystemTask* pTask = m_tasks[taskIdx];
+                EntityWorldSystem const* pSystem = pTask->m_pSystem;
+
+                for ( int32_t prevTaskIdx = segment.m_firstTaskIdx; prevTaskIdx < taskIdx; prevTaskIdx++ )
+                {
+                    SystemTask* pPrevTask = m_tasks[prevTaskIdx];
+                    EntityWorldSystem const* pPrevSystem = pPrevTask->m_pSystem;
+
+                    if ( WorldSystemUpdateDependencies::DoSystemsConflict( pPrevSystem->GetSystemID(), *pPrevSystem->GetUpdateDependencies(), pSystem->GetSystemID(), *pSystem->GetUpdateDependencies() ) )
+                    {
+                        TaskDependency* pDependency = m_dependencies.emplace_back( EE::New<TaskDependency>() );
+                        pTask->SetDependency( *pDependency, pPrevTask );
+                        pTask->m_numSystemDependencies++;
+                    }
+                }
+            }
+        }
+    }
+
+    void WorldSystemUpdateSchedule::Clear()
+    {
+        // Dependencies need to be destroyed before the tasks they refer to
+        for ( auto& pDependency : m_dependencies )
+        {
+            EE::Delete( pDependency );
+        }
+        m_dependencies.clear();
+
+        for ( auto& pTask : m_tasks )
+        {
+            EE::Delete( pTask );
+        }
+        m_tasks.clear();
+
+        EE::Delete( m_pEntityUpdateCompletedTask );
+        m_segments.clear();
+    }
+
+    //-------------------------------------------------------------------------
+
+    void WorldSystemUpdateSchedule::Execute( TaskSystem* pTaskSystem, EntityWorldUpdateContext const& context, ITaskSet* pEntityUpdateTask, TFunction<void()> const& postEntityUpdateFunction )
+    {
+        EE_ASSERT( pTaskSystem != nullptr && pEntityUpdateTask != nullptr && m_pEntityUpdateCompletedTask != nullptr );
+
+        for ( SystemTask* pTask : m_tasks )
+        {
+            pTask->m_pContext = &context;
+        }
+
+        // Any systems in the first segment that have to wait for the entity update are triggered by the completion task
+        // These dependencies have to be set before anything is scheduled
+        //-------------------------------------------------------------------------
+
+        int32_t const numTasksOverlappingEntityUpdate = ( !m_segments.empty() && !m_segments[0].m_isExclusive ) ? m_segments[0].m_numTasks : 0;
+        for ( int32_t i = 0; i < numTasksOverlappingEntityUpdate; i++ )
+        {
+            if ( !m_tasks[i]->m_canRunDuringEntityUpdate )
+            {
+                m_tasks[i]->SetDependency( m_tasks[i]->m_entityUpdateDependency, m_pEntityUpdateCompletedTask );
+            }
+        }
+
+        pTaskSystem->ScheduleTask( pEntityUpdateTask );
+        bool isEntityUpdateComplete = false;
+
+        auto CompleteEntityUpdate = [&] ()
+        {
+            pTaskSystem->WaitForTask( pEntityUpdateTask );
+
+            if ( postEntityUpdateFunction )
+            {
+                postEntityUpdateFunction();
+            }
+
+            pTaskSystem->ScheduleTask( m_pEntityUpdateCompletedTask );
+            isEntityUpdateComplete = true;
+        };
+
+        // Run segments
+        //-------------------------------------------------------------------------
+
+        for ( Segment const& segment : m_segments )
+        {
+            if ( segment.m_isExclusive )
+            {
+                if ( !isEntityUpdateComplete )
+                {
+                    CompleteEntityUpdate();
+                }
+
+                EE_PROFILE_SCOPE_ENTITY( "Update World Systems" );
+                EE_ASSERT( segment.m_numTasks == 1 );
+                m_tasks[segment.m_firstTaskIdx]->m_pSystem->UpdateSystem( context );
+            }
+            else
+            {
+                int32_t const segmentEndIdx = segment.m_firstTaskIdx + segment.m_numTasks;
+
+                // Only schedule the root tasks, all other tasks will be scheduled once their dependencies complete
+                for ( int32_t taskIdx = segment.m_firstTaskIdx; taskIdx < segmentEndIdx; taskIdx++ )
+                {
+                    SystemTask* pTask = m_tasks[taskIdx];
+                    if ( pTask->m_numSystemDependencies == 0 && ( isEntityUpdateComplete || pTask->m_canRunDuringEntityUpdate ) )
+                    {
+                        pTaskSystem->ScheduleTask( pTask );
+                    }
+                }
+
+                // This will trigger the remaining root tasks in the first segment
+                if ( !isEntityUpdateComplete )
+                {
+                    CompleteEntityUpdate();
+                }
+
+                // Tasks are sorted by priority so we will always wait for a task's dependencies before waiting for it
+                for ( int32_t taskIdx = segment.m_firstTaskIdx; taskIdx < segmentEndIdx; taskIdx++ )
+                {
+                    pTaskSystem->WaitForTask( m_tasks[taskIdx] );
+                }
+            }
+        }
+
+        //-------------------------------------------------------------------------
+
+        if ( !isEntityUpdateComplete )
+        {
+            CompleteEntityUpdate();
+        }
+
+        pTaskSystem->WaitForTask( m_pEntityUpdateCompletedTask );
+
+        for ( int32_t i = 0; i < numTasksOverlappingEntityUpdate; i++ )
+        {
+            m_tasks[i]->m_entityUpdateDependency.ClearDependency();
+        }
+    }
+}
@@ -0,0 +1,71 @@
+#pragma once
+
+#include "Engine/_Module/API.h"
+#include "Engine/UpdateStage.h"
+#include "Base/Types/Arrays.h"
+#include "Base/Types/Function.h"
+
+//-------------------------------------------------------------------------
+
+namespace enki { class ITaskSet; class Dependency; }
+
+namespace EE
+{
+    class TaskSystem;
+    class EntityWorldSystem;
+    class EntityWorldUpdateContext;
+}
+
+//-------------------------------------------------------------------------
+// World System Update Schedule
+//-------------------------------------------------------------------------
+// The dependency graph for all world systems updated in a given stage, built once when the world is initialized
+//
+// The priority sorted system list is split into segments: each exclusive system (no declared dependencies) is its own segment and is
+// run on the main thread. Each run of non-exclusive systems between them forms a parallel segment, in which a system only depends on
+// the higher priority systems in that segment that it conflicts with. Segments are run in order so the exclusive systems act as barriers.
+//
+// The systems in the first parallel segment are kicked off together with the entity update, only those that opted in are
+// allowed to start before the entity update completes. All other systems are only started once the entity update and the supplied
+// post entity update function (run on the main thread) have completed.
+
+namespace EE::EntityModel
+{
+    class WorldSystemUpdateSchedule
+    {
+        struct SystemTask;
+
+        struct Segment
+        {
+            int32_t                                 m_firstTaskIdx = 0;
+            int32_t                                 m_numTasks = 0;
+            bool                                    m_isExclusive = false;
+        };
+
+    public:
+
+        WorldSystemUpdateSchedule() = default;
+        WorldSystemUpdateSchedule( WorldSystemUpdateSchedule const& ) = delete;
+        ~WorldSystemUpdateSchedule();
+
+        WorldSystemUpdateSchedule& operator=( WorldSystemUpdateSchedule const& ) = delete;
+
+        inline bool IsEmpty() const { return m_tasks.empty(); }
+
+        // Build the schedule for the supplied systems, the list needs to be sorted by priority
+        void Build( UpdateStage stage, TVector<EntityWorldSystem*> const& systems );
+
+        // Destroy the schedule
+        void Clear();
+
+        // Run the entity update task and all the world system updates, this will only return once everything has completed
+        void Execute( TaskSystem* pTaskSystem, EntityWorldUpdateContext const& context, enki::ITaskSet* pEntityUpdateTask, TFunction<void()> const& postEntityUpdateFunction );
+
+    private:
+
+        TVector<SystemTask*>                        m_tasks;
+        TVector<Segment>                            m_segments;
+        TVector<enki::Dependency*>                  m_dependencies;
+        enki::ITaskSet*                             m_pEntityUpdateCompletedTask = nullptr;  // Empty task that triggers all systems waiting for the entity update
+    };
+}
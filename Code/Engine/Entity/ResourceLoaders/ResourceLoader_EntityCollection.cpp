@@ -18,7 +18,7 @@ namespace EE::EntityModel
         m_pTypeRegistry = pTypeRegistry;
     }
 
-    Resource::ResourceLoader::LoadResult EntityCollectionLoader::Load( ResourceID const& resourceID, FileSystem::Path const& resourcePath, Resource::ResourceRecord* pResourceRecord, Serialization::BinaryInputArchive& archive ) const
+    Resource::ResourceLoader::LoadResult EntityCollectionLoader::Load( ResourceID const& resourceID, FileSystem::Path const& resourcePath, Resource::ResourceRecord* pResourceRecord, Serialization::BinaryInputArchive& archive, Blob& rawResourceData ) const
     {
         EE_ASSERT( m_pTypeRegistry != nullptr );
 
@@ -37,6 +37,10 @@ namespace EE::EntityModel
             pCollectionDesc = pEC;
         }
 
+        // Pre-compile all the component descriptors, since we will instantiate them at least once
+        EE_ASSERT( pCollectionDesc != nullptr );
+        pCollectionDesc->CompileComponentDescriptors( *m_pTypeRegistry );
+
         // Set loaded resource
         pResourceRecord->SetResourceData( pCollectionDesc );
         return Resource::ResourceLoader::LoadResult::Succeeded;
@@ -57,7 +57,7 @@ namespace EE::EntityModel
                     EE_ASSERT( pRecord != nullptr );
 
                     TVector<Entity*> createdEntities;
-                    pPersistentMap->AddEntityCollection( pTaskSystem, *pTypeRegistry, *pCollectionToSpawn->GetEntityCollectionDesc(), pCollectionToSpawn->GetWorldTransform(), &createdEntities );
+                    pPersistentMap->AddEntityCollectionFromTemplate( pTaskSystem, *pTypeRegistry, *pCollectionToSpawn->GetEntityCollectionDesc(), pCollectionToSpawn->GetWorldTransform(), &createdEntities );
 
                     for ( auto pCreatedEntity : createdEntities )
                     {
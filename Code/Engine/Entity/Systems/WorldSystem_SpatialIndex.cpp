@@ -0,0 +1,156 @@
+#include "WorldSystem_SpatialIndex.h"
+#include "Engine/Entity/Entity.h"
+#include "Base/Threading/TaskSystem.h"
+#include "Base/Profiling.h"
+#include <eastl/sort.h>
+
+//-------------------------------------------------------------------------
+
+namespace EE::EntityModel
+{
+    void SpatialIndexWorldSystem::ShutdownSystem()
+    {
+        EE_ASSERT( m_tree.IsEmpty() );
+        EE_ASSERT( m_boundsUpdateQueue.size_approx() == 0 );
+        EE_ASSERT( m_deferredTransformQueue.size_approx() == 0 );
+    }
+
+    void SpatialIndexWorldSystem::RegisterComponent( Entity const* pEntity, EntityComponent* pComponent )
+    {
+        if ( auto pSpatialComponent = TryCast<SpatialEntityComponent>( pComponent ) )
+        {
+            EE_ASSERT( pSpatialComponent->m_pSpatialIndex == nullptr && !pSpatialComponent->m_isQueuedForSpatialIndexUpdate );
+            pSpatialComponent->m_spatialIndexProxyIdx = m_tree.CreateProxy( AABB( pSpatialComponent->GetWorldBounds() ), pSpatialComponent, pSpatialComponent->GetSpatialQueryLayers(), s_proxyMargin );
+            pSpatialComponent->m_pSpatialIndex = this;
+        }
+    }
+
+    void SpatialIndexWorldSystem::UnregisterComponent( Entity const* pEntity, EntityComponent* pComponent )
+    {
+        if ( auto pSpatialComponent = TryCast<SpatialEntityComponent>( pComponent ) )
+        {
+            EE_ASSERT( pSpatialComponent->m_pSpatialIndex == this );
+
+            // We cant remove an item from the queues, so flush them before the component is released
+            if ( pSpatialComponent->m_isQueuedForDeferredTransformUpdate )
+            {
+                ProcessDeferredTransformUpdates();
+            }
+
+            if ( pSpatialComponent->m_isQueuedForSpatialIndexUpdate )
+            {
+                ProcessBoundsUpdates();
+            }
+
+            m_tree.DestroyProxy( pSpatialComponent->m_spatialIndexProxyIdx );
+            pSpatialComponent->m_spatialIndexProxyIdx = InvalidIndex;
+            pSpatialComponent->m_pSpatialIndex = nullptr;
+        }
+    }
+
+    //-------------------------------------------------------------------------
+
+    void SpatialIndexWorldSystem::ProcessBoundsUpdates()
+    {
+        EE_PROFILE_SCOPE_ENTITY( "Update Spatial Index" );
+
+        SpatialEntityComponent* components[64];
+        size_t numDequeued = 0;
+        while ( ( numDequeued = m_boundsUpdateQueue.try_dequeue_bulk( components, 64 ) ) > 0 )
+        {
+            for ( size_t i = 0; i < numDequeued; i++ )
+            {
+                SpatialEntityComponent* pComponent = components[i];
+                EE_ASSERT( pComponent->m_pSpatialIndex == this && pComponent->m_isQueuedForSpatialIndexUpdate );
+                m_tree.MoveProxy( pComponent->m_spatialIndexProxyIdx, AABB( pComponent->GetWorldBounds() ), s_proxyMargin );
+                pComponent->m_isQueuedForSpatialIndexUpdate = false;
+            }
+        }
+    }
+
+    void SpatialIndexWorldSystem::ProcessDeferredTransformUpdates( TaskSystem* pTaskSystem )
+    {
+        struct TransformPropagationTask final : public ITaskSet
+        {
+            TransformPropagationTask( TVector<SpatialEntityComponent*> const& roots )
+                : m_roots( roots )
+            {
+                m_SetSize = (uint32_t) roots.size();
+            }
+
+            virtual void ExecuteRange( TaskSetPartition range, uint32_t threadnum ) override final
+            {
+                EE_PROFILE_SCOPE_ENTITY( "Propagate Spatial Transforms" );
+
+                for ( uint64_t i = range.start; i < range.end; ++i )
+                {
+                    m_roots[i]->PropagateDeferredTransforms( false, false );
+                }
+            }
+
+        private:
+
+            TVector<SpatialEntityComponent*> const&             m_roots;
+        };
+
+        //-------------------------------------------------------------------------
+
+        EE_PROFILE_SCOPE_ENTITY( "Resolve Deferred Transforms" );
+
+        // Find the root of each dirty hierarchy
+        //-------------------------------------------------------------------------
+        // Hierarchies could have been modified since the component was queued, so we re-flag the path from the root to the component
+
+        m_deferredTransformRoots.clear();
+
+        SpatialEntityComponent* components[64];
+        size_t numDequeued = 0;
+        while ( ( numDequeued = m_deferredTransformQueue.try_dequeue_bulk( components, 64 ) ) > 0 )
+        {
+            for ( size_t i = 0; i < numDequeued; i++ )
+            {
+                SpatialEntityComponent* pComponent = components[i];
+                EE_ASSERT( pComponent->m_isQueuedForDeferredTransformUpdate );
+                pComponent->m_isQueuedForDeferredTransformUpdate = false;
+
+                // The change could have already been resolved (i.e. deferred updates were disabled)
+                if ( !pComponent->m_isTransformDirty )
+                {
+                    continue;
+                }
+
+                SpatialEntityComponent* pRoot = pComponent;
+                while ( pRoot->m_pSpatialParent != nullptr )
+                {
+                    pRoot = pRoot->m_pSpatialParent;
+                    pRoot->m_hasDirtyChildren = true;
+                }
+
+                m_deferredTransformRoots.emplace_back( pRoot );
+            }
+        }
+
+        if ( m_deferredTransformRoots.empty() )
+        {
+            return;
+        }
+
+        eastl::sort( m_deferredTransformRoots.begin(), m_deferredTransformRoots.end() );
+        m_deferredTransformRoots.erase( eastl::unique( m_deferredTransformRoots.begin(), m_deferredTransformRoots.end() ), m_deferredTransformRoots.end() );
+
+        // Propagate transforms
+        //-------------------------------------------------------------------------
+        // Each root is an independent hierarchy so they can be processed in parallel
+
+        TransformPropagationTask propagationTask( m_deferredTransformRoots );
+        if ( pTaskSystem != nullptr && m_deferredTransformRoots.size() > 1 )
+        {
+            pTaskSystem->ScheduleTask( &propagationTask );
+            pTaskSystem->WaitForTask( &propagationTask );
+        }
+        else
+        {
+            propagationTask.ExecuteRange( { 0u, (uint32_t) m_deferredTransformRoots.size() }, 0 );
+        }
+    }
+}
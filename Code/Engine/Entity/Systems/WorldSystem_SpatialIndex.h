@@ -0,0 +1,101 @@
+#pragma once
+
+#include "Engine/Entity/EntityWorldSystem.h"
+#include "Engine/Entity/EntitySpatialComponent.h"
+#include "Base/Math/WideAABBTree.h"
+#include "Base/Threading/Threading.h"
+
+//-------------------------------------------------------------------------
+
+namespace EE { class EntityWorld; class TaskSystem; }
+
+//-------------------------------------------------------------------------
+// Spatial Index
+//-------------------------------------------------------------------------
+// A dynamic 4-wide BVH of the world bounds of all spatial components in the world
+//
+// Components queue themselves for an update whenever their world bounds change, the queue is processed by the world once the entity
+// update completes (before any world systems that depend on it are run) and again at the end of each update stage. Queries are
+// read-only and can be run in parallel during the updates, but queries made during the entity update only reflect the bounds as of
+// the end of the previous stage.
+//
+// This system also tracks all components with deferred transform changes, these are resolved by the world immediately before the
+// bounds updates are processed.
+//
+// The indexed bounds are enlarged by a small margin to reduce the cost of small movements, so all query results are conservative.
+
+namespace EE::EntityModel
+{
+    class EE_ENGINE_API SpatialIndexWorldSystem final : public EntityWorldSystem
+    {
+        friend class EE::EntityWorld;
+        friend class EE::SpatialEntityComponent;
+
+    public:
+
+        EE_ENTITY_WORLD_SYSTEM( SpatialIndexWorldSystem );
+
+        // How much the indexed bounds are enlarged by
+        constexpr static float const s_proxyMargin = 0.1f;
+
+    public:
+
+        // Queries, only components on at least one of the layers in the mask are returned
+        //-------------------------------------------------------------------------
+
+        inline bool FindOverlaps( AABB const& queryBox, TVector<SpatialEntityComponent*>& outResults, uint32_t layerMask = SpatialQueryLayer::All ) const
+        {
+            return m_tree.FindOverlaps( queryBox, outResults, layerMask );
+        }
+
+        inline bool FindOverlaps( Vector const& sphereCenter, float sphereRadius, TVector<SpatialEntityComponent*>& outResults, uint32_t layerMask = SpatialQueryLayer::All ) const
+        {
+            return m_tree.FindOverlaps( sphereCenter, sphereRadius, outResults, layerMask );
+        }
+
+        inline bool FindOverlaps( Math::ViewVolume const& viewVolume, TVector<SpatialEntityComponent*>& outResults, uint32_t layerMask = SpatialQueryLayer::All ) const
+        {
+            return m_tree.FindOverlaps( viewVolume, outResults, layerMask );
+        }
+
+        inline bool FindIntersections( Ray const& ray, float maxDistance, TVector<SpatialEntityComponent*>& outResults, uint32_t layerMask = SpatialQueryLayer::All ) const
+        {
+            return m_tree.FindIntersections( ray, maxDistance, outResults, layerMask );
+        }
+
+        // Run multiple box queries with a single traversal, there needs to be a result array per query box
+        inline void FindOverlaps( AABB const* pQueryBoxes, int32_t numQueries, TVector<SpatialEntityComponent*>* pOutResults, uint32_t layerMask = SpatialQueryLayer::All ) const
+        {
+            m_tree.FindOverlaps( pQueryBoxes, numQueries, pOutResults, layerMask );
+        }
+
+        #if EE_DEVELOPMENT_TOOLS
+        inline void DrawDebug( Drawing::DrawContext& drawingContext ) const { m_tree.DrawDebug( drawingContext ); }
+        #endif
+
+    private:
+
+        virtual void ShutdownSystem() override final;
+        virtual void RegisterComponent( Entity const* pEntity, EntityComponent* pComponent ) override final;
+        virtual void UnregisterComponent( Entity const* pEntity, EntityComponent* pComponent ) override final;
+
+        // Called by spatial components whenever their world bounds change, this can be called from any thread
+        inline void QueueBoundsUpdate( SpatialEntityComponent* pComponent ) { m_boundsUpdateQueue.enqueue( pComponent ); }
+
+        // Update the index with the current bounds of all queued components
+        void ProcessBoundsUpdates();
+
+        // Called by spatial components whenever they get a deferred transform change, this can be called from any thread
+        inline void QueueDeferredTransformUpdate( SpatialEntityComponent* pComponent ) { m_deferredTransformQueue.enqueue( pComponent ); }
+
+        // Resolve all queued deferred transform changes, independent hierarchies are processed in parallel if a task system is supplied
+        void ProcessDeferredTransformUpdates( TaskSystem* pTaskSystem = nullptr );
+
+    private:
+
+        Math::WideAABBTree                                  m_tree;
+        Threading::LockFreeQueue<SpatialEntityComponent*>   m_boundsUpdateQueue;
+        Threading::LockFreeQueue<SpatialEntityComponent*>   m_deferredTransformQueue;
+        TVector<SpatialEntityComponent*>                    m_deferredTransformRoots;
+    };
+}
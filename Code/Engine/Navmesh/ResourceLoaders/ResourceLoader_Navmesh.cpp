@@ -11,7 +11,7 @@ namespace EE::Navmesh
         m_loadableTypes.push_back( NavmeshData::GetStaticResourceTypeID() );
     }
 
-    Resource::ResourceLoader::LoadResult NavmeshLoader::Load( ResourceID const& resourceID, FileSystem::Path const& resourcePath, Resource::ResourceRecord* pResourceRecord, Serialization::BinaryInputArchive& archive ) const
+    Resource::ResourceLoader::LoadResult NavmeshLoader::Load( ResourceID const& resourceID, FileSystem::Path const& resourcePath, Resource::ResourceRecord* pResourceRecord, Serialization::BinaryInputArchive& archive, Blob& rawResourceData ) const
     {
         auto pNavmeshData = EE::New<NavmeshData>();
         archive << *pNavmeshData;
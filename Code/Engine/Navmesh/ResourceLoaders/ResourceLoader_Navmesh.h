@@ -15,7 +15,7 @@ namespace EE::Navmesh
 
     private:
 
-        virtual Resource::ResourceLoader::LoadResult Load( ResourceID const& resourceID, FileSystem::Path const& resourcePath, Resource::ResourceRecord* pResourceRecord, Serialization::BinaryInputArchive& archive ) const override final;
+        virtual Resource::ResourceLoader::LoadResult Load( ResourceID const& resourceID, FileSystem::Path const& resourcePath, Resource::ResourceRecord* pResourceRecord, Serialization::BinaryInputArchive& archive, Blob& rawResourceData ) const override final;
         virtual void Unload( ResourceID const& resourceID, Resource::ResourceRecord* pResourceRecord ) const override final;
     };
 }
\ No newline at end of file
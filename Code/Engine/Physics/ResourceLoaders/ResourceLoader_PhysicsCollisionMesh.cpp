@@ -40,7 +40,7 @@ namespace EE::Physics
         m_loadableTypes.push_back( CollisionMesh::GetStaticResourceTypeID() );
     }
 
-    Resource::ResourceLoader::LoadResult CollisionMeshLoader::Load( ResourceID const& resourceID, FileSystem::Path const& resourcePath, Resource::ResourceRecord* pResourceRecord, Serialization::BinaryInputArchive& archive ) const
+    Resource::ResourceLoader::LoadResult CollisionMeshLoader::Load( ResourceID const& resourceID, FileSystem::Path const& resourcePath, Resource::ResourceRecord* pResourceRecord, Serialization::BinaryInputArchive& archive, Blob& rawResourceData ) const
     {
         // Create collision resource
         auto pCollision = EE::New<CollisionMesh>();
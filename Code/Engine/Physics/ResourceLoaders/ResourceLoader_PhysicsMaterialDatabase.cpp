@@ -14,7 +14,7 @@ namespace EE::Physics
         m_loadableTypes.push_back( MaterialDatabase::GetStaticResourceTypeID() );
     }
 
-    Resource::ResourceLoader::LoadResult PhysicsMaterialDatabaseLoader::Load( ResourceID const& resourceID, FileSystem::Path const& resourcePath, Resource::ResourceRecord* pResourceRecord, Serialization::BinaryInputArchive& archive ) const
+    Resource::ResourceLoader::LoadResult PhysicsMaterialDatabaseLoader::Load( ResourceID const& resourceID, FileSystem::Path const& resourcePath, Resource::ResourceRecord* pResourceRecord, Serialization::BinaryInputArchive& archive, Blob& rawResourceData ) const
     {
         MaterialDatabase* pPhysicsMaterialDB = EE::New<MaterialDatabase>();
         archive << *pPhysicsMaterialDB;
@@ -11,7 +11,7 @@ namespace EE::Physics
         m_loadableTypes.push_back( RagdollDefinition::GetStaticResourceTypeID() );
     }
 
-    Resource::ResourceLoader::LoadResult RagdollLoader::Load( ResourceID const& resourceID, FileSystem::Path const& resourcePath, Resource::ResourceRecord* pResourceRecord, Serialization::BinaryInputArchive& archive ) const
+    Resource::ResourceLoader::LoadResult RagdollLoader::Load( ResourceID const& resourceID, FileSystem::Path const& resourcePath, Resource::ResourceRecord* pResourceRecord, Serialization::BinaryInputArchive& archive, Blob& rawResourceData ) const
     {
         RagdollDefinition* pRagdoll = EE::New<RagdollDefinition>();
         archive << *pRagdoll;
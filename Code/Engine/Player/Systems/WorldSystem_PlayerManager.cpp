@@ -112,7 +112,11 @@ namespace EE
         //-------------------------------------------------------------------------
 
         // For now we only support a single spawn point
-        pPersistentMap->AddEntityCollection( pTaskSystem, *pTypeRegistry, *m_spawnPoints[0]->GetEntityCollectionDesc(), m_spawnPoints[0]->GetWorldTransform() );
+        TVector<Entity*> createdEntities;
+        pPersistentMap->AddEntityCollection( pTaskSystem, *pTypeRegistry, *m_spawnPoints[0]->GetEntityCollectionDesc(), m_spawnPoints[0]->GetWorldTransform(), &createdEntities );
+
+        // The player needs to be initialized before any other streamed in content
+        pPersistentMap->RequestPriorityInitialization( createdEntities );
         return true;
     }
 
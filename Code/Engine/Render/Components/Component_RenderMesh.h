@@ -20,6 +20,8 @@ namespace EE::Render
         // Does this component have a valid mesh set
         virtual bool HasMeshResourceSet() const = 0;
 
+        virtual uint32_t GetSpatialQueryLayers() const override { return SpatialQueryLayer::Render; }
+
         // Visibility
         //-------------------------------------------------------------------------
 
@@ -12,7 +12,7 @@ namespace EE::Render
         m_loadableTypes.push_back( Material::GetStaticResourceTypeID() );
     }
 
-    Resource::ResourceLoader::LoadResult MaterialLoader::Load( ResourceID const& resourceID, FileSystem::Path const& resourcePath, Resource::ResourceRecord* pResourceRecord, Serialization::BinaryInputArchive& archive ) const
+    Resource::ResourceLoader::LoadResult MaterialLoader::Load( ResourceID const& resourceID, FileSystem::Path const& resourcePath, Resource::ResourceRecord* pResourceRecord, Serialization::BinaryInputArchive& archive, Blob& rawResourceData ) const
     {
         // Create mesh resource
         Material* pMaterial = EE::New<Material>();
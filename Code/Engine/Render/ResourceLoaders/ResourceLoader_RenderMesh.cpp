@@ -15,7 +15,7 @@ namespace EE::Render
         m_loadableTypes.push_back( SkeletalMesh::GetStaticResourceTypeID() );
     }
 
-    Resource::ResourceLoader::LoadResult MeshLoader::Load( ResourceID const& resourceID, FileSystem::Path const& resourcePath, Resource::ResourceRecord* pResourceRecord, Serialization::BinaryInputArchive& archive ) const
+    Resource::ResourceLoader::LoadResult MeshLoader::Load( ResourceID const& resourceID, FileSystem::Path const& resourcePath, Resource::ResourceRecord* pResourceRecord, Serialization::BinaryInputArchive& archive, Blob& rawResourceData ) const
     {
         EE_ASSERT( m_pRenderDevice != nullptr );
 
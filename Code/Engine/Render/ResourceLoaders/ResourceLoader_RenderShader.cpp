@@ -5,7 +5,7 @@
 
 namespace EE::Render
 {
-    Resource::ResourceLoader::LoadResult ShaderLoader::Load( ResourceID const& resourceID, FileSystem::Path const& resourcePath, Resource::ResourceRecord* pResourceRecord, Serialization::BinaryInputArchive& archive ) const
+    Resource::ResourceLoader::LoadResult ShaderLoader::Load( ResourceID const& resourceID, FileSystem::Path const& resourcePath, Resource::ResourceRecord* pResourceRecord, Serialization::BinaryInputArchive& archive, Blob& rawResourceData ) const
     {
         EE_ASSERT( m_pRenderDevice != nullptr );
 
@@ -12,7 +12,7 @@ namespace EE::Render
         m_loadableTypes.push_back( CubemapTexture::GetStaticResourceTypeID() );
     }
 
-    Resource::ResourceLoader::LoadResult TextureLoader::Load( ResourceID const& resourceID, FileSystem::Path const& resourcePath, Resource::ResourceRecord* pResourceRecord, Serialization::BinaryInputArchive& archive ) const
+    Resource::ResourceLoader::LoadResult TextureLoader::Load( ResourceID const& resourceID, FileSystem::Path const& resourcePath, Resource::ResourceRecord* pResourceRecord, Serialization::BinaryInputArchive& archive, Blob& rawResourceData ) const
     {
         EE_ASSERT( m_pRenderDevice != nullptr );
 
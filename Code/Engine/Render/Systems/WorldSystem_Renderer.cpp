@@ -2,6 +2,7 @@
 #include "Engine/Entity/Entity.h"
 #include "Engine/Entity/EntityWorldUpdateContext.h"
 #include "Engine/Entity/EntityLog.h"
+#include "Engine/Entity/Systems/WorldSystem_SpatialIndex.h"
 #include "Engine/Render/Components/Component_StaticMesh.h"
 #include "Engine/Render/Components/Component_SkeletalMesh.h"
 #include "Engine/Render/Components/Component_Lights.h"
@@ -214,13 +215,26 @@ namespace EE::Render
 
         m_visibleStaticMeshComponents.clear();
 
-        for ( auto const& pMeshComponent : m_staticMeshComponents )
         {
             EE_PROFILE_SCOPE_RENDER( "Static Mesh Cull" );
 
-            if ( pMeshComponent->IsVisible() && viewBounds.Overlaps( pMeshComponent->GetWorldBounds() ) )
+            // The spatial index returns all render components that might be visible, so we still need to run the exact test
+            // We declare our update dependencies so that we are only run once the index has been updated with this stage's entity update
+            ctx.GetWorldSystem<EntityModel::SpatialIndexWorldSystem>()->FindOverlaps( viewBounds, m_cullingCandidates, SpatialQueryLayer::Render );
+
+            for ( auto pCandidate : m_cullingCandidates )
             {
-                m_visibleStaticMeshComponents.emplace_back( pMeshComponent );
+                StaticMeshComponent* const* ppMeshComponent = m_staticMeshComponents.FindItem( pCandidate->GetID() );
+                if ( ppMeshComponent == nullptr )
+                {
+                    continue;
+                }
+
+                StaticMeshComponent const* pMeshComponent = *ppMeshComponent;
+                if ( pMeshComponent->IsVisible() && viewBounds.Overlaps( pMeshComponent->GetWorldBounds() ) )
+                {
+                    m_visibleStaticMeshComponents.emplace_back( pMeshComponent );
+                }
             }
         }
 
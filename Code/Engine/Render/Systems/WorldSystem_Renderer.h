@@ -76,6 +76,7 @@ namespace EE::Render
         TIDVector<ComponentID, StaticMeshComponent*>                    m_registeredStaticMeshComponents;
         TIDVector<ComponentID, StaticMeshComponent*>                    m_staticMeshComponents;
         TVector<StaticMeshComponent const*>                             m_visibleStaticMeshComponents;
+        TVector<SpatialEntityComponent*>                                m_cullingCandidates;
 
         // Skeletal meshes
         TIDVector<ComponentID, SkeletalMeshComponent*>                  m_registeredSkeletalMeshComponents;
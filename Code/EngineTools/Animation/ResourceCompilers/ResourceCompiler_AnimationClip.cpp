@@ -231,6 +231,8 @@ namespace EE::Animation
             hdr.AddInstallDependency( resourceDescriptor.m_secondaryAnimations[i].m_skeleton.GetResourceID() );
         }
 
+        hdr.SetTransitiveInstallDependencies( ctx.m_transitiveInstallDependencies );
+
         Serialization::BinaryOutputArchive archive;
         archive << hdr << animClip;
         archive << eventData.m_syncEventMarkers;
@@ -569,6 +571,11 @@ namespace EE::Animation
             }
         }
 
+        // Create the root motion trajectory used for prediction queries
+        //-------------------------------------------------------------------------
+
+        animClip.m_rootMotionTrajectory.Create( rootMotionData, animClip.m_duration );
+
         //-------------------------------------------------------------------------
         // Calculate track data ranges
         //-------------------------------------------------------------------------
@@ -633,6 +640,10 @@ namespace EE::Animation
 
         static constexpr float const defaultQuantizationRangeLength = 0.1f;
 
+        TVector<TrackCompressionSettings> trackCompressionSettings;
+        TVector<uint32_t> compressedPoseOffsets;
+        TVector<uint16_t> compressedPoseData;
+
         for ( uint32_t boneIdx = 0; boneIdx < numBones; boneIdx++ )
         {
             TrackRangeData const& trackRangeData = trackRanges[boneIdx];
@@ -692,7 +703,7 @@ namespace EE::Animation
 
             //-------------------------------------------------------------------------
 
-            animClip.m_trackCompressionSettings.emplace_back( trackSettings );
+            trackCompressionSettings.emplace_back( trackSettings );
         }
 
         //-------------------------------------------------------------------------
@@ -709,12 +720,12 @@ namespace EE::Animation
                 actualFrameIdx = numOriginalFrames - 1;
             }
 
-            animClip.m_compressedPoseOffsets.emplace_back( (int32_t) animClip.m_compressedPoseData.size() );
+            compressedPoseOffsets.emplace_back( (uint32_t) compressedPoseData.size() );
 
             // Record all bone rotations
             for ( uint32_t boneIdx = 0; boneIdx < numBones; boneIdx++ )
             {
-                TrackCompressionSettings const& trackSettings = animClip.m_trackCompressionSettings[boneIdx];
+                TrackCompressionSettings const& trackSettings = trackCompressionSettings[boneIdx];
 
                 if ( !trackSettings.IsRotationTrackStatic() )
                 {
@@ -722,9 +733,9 @@ namespace EE::Animation
                     Quaternion const rotation = rawBoneTransform.GetRotation();
 
                     Quantization::EncodedQuaternion const encodedQuat( rotation );
-                    animClip.m_compressedPoseData.push_back( encodedQuat.GetData0() );
-                    animClip.m_compressedPoseData.push_back( encodedQuat.GetData1() );
-                    animClip.m_compressedPoseData.push_back( encodedQuat.GetData2() );
+                    compressedPoseData.push_back( encodedQuat.GetData0() );
+                    compressedPoseData.push_back( encodedQuat.GetData1() );
+                    compressedPoseData.push_back( encodedQuat.GetData2() );
                 }
 
                 if ( !trackSettings.IsTranslationTrackStatic() )
@@ -736,20 +747,22 @@ namespace EE::Animation
                     uint16_t const m_y = Quantization::EncodeFloat( translation.GetY(), trackSettings.m_translationRangeY.m_rangeStart, trackSettings.m_translationRangeY.m_rangeLength );
                     uint16_t const m_z = Quantization::EncodeFloat( translation.GetZ(), trackSettings.m_translationRangeZ.m_rangeStart, trackSettings.m_translationRangeZ.m_rangeLength );
 
-                    animClip.m_compressedPoseData.push_back( m_x );
-                    animClip.m_compressedPoseData.push_back( m_y );
-                    animClip.m_compressedPoseData.push_back( m_z );
+                    compressedPoseData.push_back( m_x );
+                    compressedPoseData.push_back( m_y );
+                    compressedPoseData.push_back( m_z );
                 }
 
                 if ( !trackSettings.IsScaleTrackStatic() )
                 {
                     Transform const& rawBoneTransform = rawTrackData[boneIdx].m_localTransforms[actualFrameIdx];
                     uint16_t const m_x = Quantization::EncodeFloat( rawBoneTransform.GetScale(), trackSettings.m_scaleRange.m_rangeStart, trackSettings.m_scaleRange.m_rangeLength );
-                    animClip.m_compressedPoseData.push_back( m_x );
+                    compressedPoseData.push_back( m_x );
                 }
             }
         }
 
+        animClip.m_poseData.Initialize( trackCompressionSettings, compressedPoseOffsets, compressedPoseData );
+
         return result;
     }
 
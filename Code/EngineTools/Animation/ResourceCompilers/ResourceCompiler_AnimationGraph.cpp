@@ -90,6 +90,8 @@ namespace EE::Animation
             hdr.AddInstallDependency( resourceID );
         }
 
+        hdr.SetTransitiveInstallDependencies( ctx.m_transitiveInstallDependencies );
+
         // Serialize
         //-------------------------------------------------------------------------
 
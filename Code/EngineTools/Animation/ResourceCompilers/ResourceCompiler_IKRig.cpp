@@ -40,6 +40,7 @@ namespace EE::Animation
 
         Resource::ResourceHeader hdr( IKRigDefinition::s_version, IKRigDefinition::GetStaticResourceTypeID(), ctx.m_sourceResourceHash, ctx.m_advancedUpToDateHash );
         hdr.AddInstallDependency( definition.m_skeleton.GetResourceID() );
+        hdr.SetTransitiveInstallDependencies( ctx.m_transitiveInstallDependencies );
 
         Serialization::BinaryOutputArchive archive;
         archive << hdr << definition;
@@ -0,0 +1,221 @@
+#include "EntityMapPartitioning.h"
+#include "Engine/Entity/Components/Component_WorldPartition.h"
+#include "Engine/Entity/EntitySpatialComponent.h"
+#include "Engine/Navmesh/Components/Component_Navmesh.h"
+#include "Base/TypeSystem/TypeRegistry.h"
+
+#include <eastl/sort.h>
+
+//-------------------------------------------------------------------------
+
+namespace EE::EntityModel
+{
+    void SanitizeEntityCollection( TypeSystem::TypeRegistry const& typeRegistry, EntityCollection& collection, bool isCompilingForPackagedBuild )
+    {
+        bool wereEntitiesRemoved = false;
+
+        TVector<EntityDescriptor>& descriptors = collection.GetMutableEntityDescriptors();
+        for ( int32_t e = int32_t( descriptors.size() ) - 1; e >= 0; e-- )
+        {
+            // Remove invalid and dev-only components
+            for ( int32_t c = int32_t( descriptors[e].m_components.size() ) - 1; c >= 0; c-- )
+            {
+                ComponentDescriptor& componentDesc = descriptors[e].m_components[c];
+                TypeSystem::TypeInfo const* pComponentTypeInfo = typeRegistry.GetTypeInfo( componentDesc.m_typeID );
+
+                if ( pComponentTypeInfo == nullptr || ( isCompilingForPackagedBuild && pComponentTypeInfo->m_isForDevelopmentUseOnly ) )
+                {
+                    descriptors[e].m_components.erase( descriptors[e].m_components.begin() + c );
+                }
+            }
+
+            // Remove invalid and dev-only systems
+            for ( int32_t s = int32_t( descriptors[e].m_systems.size() ) - 1; s >= 0; s-- )
+            {
+                SystemDescriptor& systemDesc = descriptors[e].m_systems[s];
+                TypeSystem::TypeInfo const* pSystemTypeInfo = typeRegistry.GetTypeInfo( systemDesc.m_typeID );
+                if ( pSystemTypeInfo == nullptr || ( isCompilingForPackagedBuild && pSystemTypeInfo->m_isForDevelopmentUseOnly ) )
+                {
+                    descriptors[e].m_systems.erase( descriptors[e].m_systems.begin() + s );
+                }
+            }
+
+            // Remove any empty entities
+            if ( ( descriptors[e].m_components.size() + descriptors[e].m_systems.size() ) == 0 )
+            {
+                descriptors.erase( descriptors.begin() + e );
+                wereEntitiesRemoved = true;
+            }
+        }
+
+        // Removing entities invalidates the lookup map and the attachment info
+        if ( wereEntitiesRemoved )
+        {
+            TVector<EntityDescriptor> remainingDescriptors = descriptors;
+            collection.SetCollectionData( eastl::move( remainingDescriptors ) );
+        }
+    }
+
+    //-------------------------------------------------------------------------
+
+    ResourceID GetEntityMapCellResourceID( ResourceID const& mapResourceID, Int2 const& cellCoordinates )
+    {
+        EE_ASSERT( mapResourceID.IsValid() && mapResourceID.GetResourceTypeID() == EntityMapDescriptor::GetStaticResourceTypeID() );
+        String const pathStr( String::CtorSprintf(), "%s%cCell_%d_%d.%s", mapResourceID.c_str(), DataPath::s_pathDelimiter, cellCoordinates.m_x, cellCoordinates.m_y, EntityCollection::GetStaticResourceTypeID().ToString().c_str() );
+        return ResourceID( pathStr );
+    }
+
+    //-------------------------------------------------------------------------
+
+    static bool ShouldEntityBeStreamed( TypeSystem::TypeRegistry const& typeRegistry, EntityDescriptor const& entityDesc )
+    {
+        if ( !entityDesc.IsSpatialEntity() )
+        {
+            return false;
+        }
+
+        // Map-wide entities always need to be present
+        for ( auto const& componentDesc : entityDesc.m_components )
+        {
+            if ( typeRegistry.IsTypeDerivedFrom( componentDesc.m_typeID, WorldPartitionComponent::GetStaticTypeID() ) || typeRegistry.IsTypeDerivedFrom( componentDesc.m_typeID, Navmesh::NavmeshComponent::GetStaticTypeID() ) )
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    static bool TryGetEntityPosition( TypeSystem::TypeRegistry const& typeRegistry, EntityDescriptor const& entityDesc, Vector& outPosition )
+    {
+        for ( auto const& componentDesc : entityDesc.m_components )
+        {
+            if ( !componentDesc.IsSpatialComponent() || !componentDesc.IsRootComponent() )
+            {
+                continue;
+            }
+
+            auto pRootComponent = componentDesc.CreateType<SpatialEntityComponent>( typeRegistry );
+            if ( pRootComponent == nullptr )
+            {
+                return false;
+            }
+
+            outPosition = pRootComponent->GetLocalTransform().GetTranslation();
+            EE::Delete( pRootComponent );
+            return true;
+        }
+
+        return false;
+    }
+
+    bool PartitionEntityMap( TypeSystem::TypeRegistry const& typeRegistry, EntityMapDescriptor const& map, EntityMapPartition& outPartition )
+    {
+        outPartition.m_persistentEntityIndices.clear();
+        outPartition.m_cells.clear();
+
+        // Get the partition settings
+        //-------------------------------------------------------------------------
+
+        auto const partitionComponents = map.GetComponentsOfType<WorldPartitionComponent>( typeRegistry, false );
+        if ( partitionComponents.empty() )
+        {
+            return false;
+        }
+
+        auto pPartitionComponent = partitionComponents[0].m_pComponent->CreateType<WorldPartitionComponent>( typeRegistry );
+        EE_ASSERT( pPartitionComponent != nullptr );
+        outPartition.m_settings = pPartitionComponent->GetStreamingSettings();
+        EE::Delete( pPartitionComponent );
+
+        if ( !outPartition.m_settings.IsValid() )
+        {
+            return true;
+        }
+
+        // Assign each root entity to a cell, attached entities always go with their root entity
+        //-------------------------------------------------------------------------
+
+        TVector<EntityDescriptor> const& entityDescriptors = map.GetEntityDescriptors();
+        int32_t const numEntities = (int32_t) entityDescriptors.size();
+
+        TVector<int32_t> entityCellIndices;
+        entityCellIndices.resize( numEntities, InvalidIndex );
+
+        THashMap<uint64_t, int32_t> cellLookupMap;
+
+        auto GetRootEntityIndex = [&] ( int32_t entityIdx )
+        {
+            // Limit the number of steps to avoid getting stuck on malformed (cyclic) hierarchies
+            for ( int32_t i = 0; i < numEntities; i++ )
+            {
+                EntityDescriptor const& entityDesc = entityDescriptors[entityIdx];
+                if ( !entityDesc.IsSpatialEntity() || !entityDesc.HasSpatialParent() )
+                {
+                    break;
+                }
+
+                int32_t const parentEntityIdx = map.FindEntityIndex( entityDesc.m_spatialParentName );
+                if ( parentEntityIdx == InvalidIndex )
+                {
+                    break;
+                }
+
+                entityIdx = parentEntityIdx;
+            }
+
+            return entityIdx;
+        };
+
+        for ( int32_t entityIdx = 0; entityIdx < numEntities; entityIdx++ )
+        {
+            int32_t const rootEntityIdx = GetRootEntityIndex( entityIdx );
+            EntityDescriptor const& rootEntityDesc = entityDescriptors[rootEntityIdx];
+
+            Vector rootEntityPosition;
+            if ( !ShouldEntityBeStreamed( typeRegistry, rootEntityDesc ) || !TryGetEntityPosition( typeRegistry, rootEntityDesc, rootEntityPosition ) )
+            {
+                outPartition.m_persistentEntityIndices.emplace_back( entityIdx );
+                continue;
+            }
+
+            Int2 const cellCoordinates( Math::FloorToInt( rootEntityPosition.GetX() / outPartition.m_settings.m_cellSize ), Math::FloorToInt( rootEntityPosition.GetY() / outPartition.m_settings.m_cellSize ) );
+            uint64_t const cellKey = ( uint64_t( uint32_t( cellCoordinates.m_x ) ) << 32 ) | uint64_t( uint32_t( cellCoordinates.m_y ) );
+
+            auto foundCellIter = cellLookupMap.find( cellKey );
+            if ( foundCellIter == cellLookupMap.end() )
+            {
+                foundCellIter = cellLookupMap.insert( TPair<uint64_t, int32_t>( cellKey, (int32_t) outPartition.m_cells.size() ) ).first;
+                outPartition.m_cells.emplace_back().m_coordinates = cellCoordinates;
+            }
+
+            outPartition.m_cells[foundCellIter->second].m_entityIndices.emplace_back( entityIdx );
+        }
+
+        // Sort cells so that the output is deterministic
+        //-------------------------------------------------------------------------
+
+        auto CellComparator = [] ( EntityMapPartition::Cell const& cellA, EntityMapPartition::Cell const& cellB )
+        {
+            return ( cellA.m_coordinates.m_x != cellB.m_coordinates.m_x ) ? ( cellA.m_coordinates.m_x < cellB.m_coordinates.m_x ) : ( cellA.m_coordinates.m_y < cellB.m_coordinates.m_y );
+        };
+
+        eastl::sort( outPartition.m_cells.begin(), outPartition.m_cells.end(), CellComparator );
+
+        return true;
+    }
+
+    TVector<EntityDescriptor> CopyEntityDescriptors( EntityCollection const& collection, TVector<int32_t> const& entityIndices )
+    {
+        TVector<EntityDescriptor> const& entityDescriptors = collection.GetEntityDescriptors();
+
+        TVector<EntityDescriptor> copiedDescriptors;
+        copiedDescriptors.reserve( entityIndices.size() );
+        for ( int32_t entityIdx : entityIndices )
+        {
+            copiedDescriptors.emplace_back( entityDescriptors[entityIdx] );
+        }
+
+        return copiedDescriptors;
+    }
+}
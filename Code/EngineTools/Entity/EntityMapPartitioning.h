@@ -0,0 +1,46 @@
+#pragma once
+#include "EngineTools/_Module/API.h"
+#include "Engine/Entity/EntityDescriptors.h"
+
+//-------------------------------------------------------------------------
+
+namespace EE::TypeSystem { class TypeRegistry; }
+
+//-------------------------------------------------------------------------
+// Entity Map Partitioning
+//-------------------------------------------------------------------------
+// Shared by the map and entity collection compilers: the map compiler strips all streamed entities from the map and the
+// collection compiler builds each cell collection (a sub-resource of the map) from the same partition
+
+namespace EE::EntityModel
+{
+    struct EntityMapPartition
+    {
+        struct Cell
+        {
+            Int2                                m_coordinates = Int2( 0 );
+            TVector<int32_t>                    m_entityIndices;
+        };
+
+    public:
+
+        EntityMapStreamingSettings              m_settings;
+        TVector<int32_t>                        m_persistentEntityIndices; // The entities that are kept in the map itself
+        TVector<Cell>                           m_cells; // Sorted by coordinates
+    };
+
+    //-------------------------------------------------------------------------
+
+    // Remove all invalid and dev-only components and systems from a collection, as well as any entities that are left empty
+    EE_ENGINETOOLS_API void SanitizeEntityCollection( TypeSystem::TypeRegistry const& typeRegistry, EntityCollection& collection, bool isCompilingForPackagedBuild );
+
+    // Get the resource ID for a map cell, e.g. data://maps/someMap.map/Cell_2_-1.ec
+    EE_ENGINETOOLS_API ResourceID GetEntityMapCellResourceID( ResourceID const& mapResourceID, Int2 const& cellCoordinates );
+
+    // Bucket all spatial entities in a map into streaming cells based on the position of their root spatial entity
+    // Returns false if the map doesnt contain a world partition component. No cells are created if the partition settings are invalid.
+    EE_ENGINETOOLS_API bool PartitionEntityMap( TypeSystem::TypeRegistry const& typeRegistry, EntityMapDescriptor const& map, EntityMapPartition& outPartition );
+
+    // Create the entity descriptor list for a set of entities in the map
+    EE_ENGINETOOLS_API TVector<EntityDescriptor> CopyEntityDescriptors( EntityCollection const& collection, TVector<int32_t> const& entityIndices );
+}
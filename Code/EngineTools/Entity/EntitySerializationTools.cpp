@@ -279,7 +279,7 @@ namespace EE::EntityModel
         // Try get name
         //-------------------------------------------------------------------------
 
-        for ( auto const& propertyDesc : outComponentDesc.m_properties )
+        for ( auto const& propertyDesc : outComponentDesc.GetProperties() )
         {
             if ( propertyDesc.m_path.ToString() == g_componentNamePropertyName )
             {
@@ -1,5 +1,6 @@
 #include "ResourceCompiler_EntityCollection.h"
 #include "EngineTools/Entity/EntitySerializationTools.h"
+#include "EngineTools/Entity/EntityMapPartitioning.h"
 #include "Engine/Entity/EntityDescriptors.h"
 #include "Base/TypeSystem/TypeRegistry.h"
 #include "Base/Serialization/BinarySerialization.h"
@@ -16,6 +17,14 @@ namespace EE::EntityModel
         AddOutputType<EntityCollection>();
     }
 
+    // Map cells are sub-resources of the map, i.e. data://maps/someMap.map/Cell_0_0.ec
+    static bool IsEntityMapCellResourceID( ResourceID const& resourceID )
+    {
+        return resourceID.IsSubResourceID() && resourceID.GetParentResourceTypeID() == EntityMapDescriptor::GetStaticResourceTypeID();
+    }
+
+    //-------------------------------------------------------------------------
+
     Resource::CompilationResult EntityCollectionCompiler::Compile( Resource::CompileContext const& ctx ) const
     {
         EntityCollection entityCollection;
@@ -28,7 +37,14 @@ namespace EE::EntityModel
         {
             ScopedTimer<PlatformClock> timer( elapsedTime );
 
-            if ( !ReadEntityCollectionFromFile( *m_pTypeRegistry, ctx.m_inputFilePath, entityCollection ) )
+            if ( IsEntityMapCellResourceID( ctx.m_resourceID ) )
+            {
+                if ( !ReadEntityMapCell( ctx.m_resourceID, ctx.m_inputFilePath, ctx.IsCompilingForPackagedBuild(), entityCollection ) )
+                {
+                    return CompilationFailed( ctx );
+                }
+            }
+            else if ( !ReadEntityCollectionFromFile( *m_pTypeRegistry, ctx.m_inputFilePath, entityCollection ) )
             {
                 return Resource::CompilationResult::Failure;
             }
@@ -59,10 +75,21 @@ namespace EE::EntityModel
         EntityModel::EntityCollection entityCollection;
 
         // Read map descriptor
-        FileSystem::Path const collectionFilePath = resourceID.GetFileSystemPath( m_sourceDataDirectoryPath );
-        if ( !ReadEntityCollectionFromFile( *m_pTypeRegistry, collectionFilePath, entityCollection ) )
+        if ( IsEntityMapCellResourceID( resourceID ) )
         {
-            return false;
+            FileSystem::Path const mapFilePath = resourceID.GetParentResourceFileSystemPath( m_sourceDataDirectoryPath );
+            if ( !ReadEntityMapCell( resourceID, mapFilePath, false, entityCollection ) )
+            {
+                return false;
+            }
+        }
+        else
+        {
+            FileSystem::Path const collectionFilePath = resourceID.GetFileSystemPath( m_sourceDataDirectoryPath );
+            if ( !ReadEntityCollectionFromFile( *m_pTypeRegistry, collectionFilePath, entityCollection ) )
+            {
+                return false;
+            }
         }
 
         // Get all referenced resources
@@ -77,4 +104,41 @@ namespace EE::EntityModel
 
         return true;
     }
+
+    //-------------------------------------------------------------------------
+
+    bool EntityCollectionCompiler::ReadEntityMapCell( ResourceID const& cellResourceID, FileSystem::Path const& mapFilePath, bool isCompilingForPackagedBuild, EntityCollection& outCollection ) const
+    {
+        EntityMapDescriptor map;
+        if ( !ReadMapDescriptorFromFile( *m_pTypeRegistry, mapFilePath, map ) )
+        {
+            Error( "Failed to read parent map for cell: %s", cellResourceID.c_str() );
+            return false;
+        }
+
+        // The map needs to be sanitized in the same way as the map compiler does it so that we end up with the same partition
+        SanitizeEntityCollection( *m_pTypeRegistry, map, isCompilingForPackagedBuild );
+
+        EntityMapPartition partition;
+        if ( !PartitionEntityMap( *m_pTypeRegistry, map, partition ) )
+        {
+            Error( "Parent map is not partitioned: %s", cellResourceID.c_str() );
+            return false;
+        }
+
+        ResourceID const mapResourceID = cellResourceID.GetParentResourceID();
+        for ( auto const& cell : partition.m_cells )
+        {
+            if ( GetEntityMapCellResourceID( mapResourceID, cell.m_coordinates ) == cellResourceID )
+            {
+                outCollection.SetCollectionData( CopyEntityDescriptors( map, cell.m_entityIndices ) );
+                return true;
+            }
+        }
+
+        // The map may have changed since the cell was requested, an empty cell is not an error
+        Warning( "Cell not found in the parent map partition: %s", cellResourceID.c_str() );
+        outCollection.Clear();
+        return true;
+    }
 }
\ No newline at end of file
@@ -6,6 +6,10 @@
 
 namespace EE::EntityModel
 {
+    class EntityCollection;
+
+    //-------------------------------------------------------------------------
+
     class EntityCollectionCompiler final : public Resource::Compiler
     {
         EE_REFLECT_TYPE( EntityCollectionCompiler );
@@ -15,5 +19,10 @@ namespace EE::EntityModel
         EntityCollectionCompiler();
         virtual Resource::CompilationResult Compile( Resource::CompileContext const& ctx ) const override;
         virtual bool GetInstallDependencies( ResourceID const& resourceID, TVector<ResourceID>& outReferencedResources ) const override;
+
+    private:
+
+        // Build the collection for a world partition cell from the source map
+        bool ReadEntityMapCell( ResourceID const& cellResourceID, FileSystem::Path const& mapFilePath, bool isCompilingForPackagedBuild, EntityCollection& outCollection ) const;
     };
 }
@@ -1,5 +1,6 @@
 #include "ResourceCompiler_Map.h"
 #include "EngineTools/Entity/EntitySerializationTools.h"
+#include "EngineTools/Entity/EntityMapPartitioning.h"
 #include "Engine/Entity/EntityDescriptors.h"
 #include "Engine/Navmesh/Components/Component_Navmesh.h"
 #include "Base/TypeSystem/TypeRegistry.h"
@@ -40,39 +41,7 @@ namespace EE::EntityModel
         // Sanitize collection
         //-------------------------------------------------------------------------
 
-        bool const isCompilingForPackagedBuild = ctx.IsCompilingForPackagedBuild();
-        TVector<EntityDescriptor>& descriptors = map.GetMutableEntityDescriptors();
-        for ( int32_t e = int32_t( descriptors.size() ) - 1; e >= 0; e-- )
-        {
-            // Remove invalid and dev-only components
-            for ( int32_t c = int32_t( descriptors[e].m_components.size() ) - 1; c >= 0; c-- )
-            {
-                ComponentDescriptor& componentDesc = descriptors[e].m_components[c];
-                TypeSystem::TypeInfo const* pComponentTypeInfo = m_pTypeRegistry->GetTypeInfo( componentDesc.m_typeID );
-
-                if ( pComponentTypeInfo == nullptr || ( isCompilingForPackagedBuild && pComponentTypeInfo->m_isForDevelopmentUseOnly ) )
-                {
-                    descriptors[e].m_components.erase( descriptors[e].m_components.begin() + c );
-                }
-            }
-
-            // Remove invalid and dev-only systems
-            for ( int32_t s = int32_t( descriptors[e].m_systems.size() ) - 1; s >= 0; s-- )
-            {
-                SystemDescriptor& systemDesc = descriptors[e].m_systems[s];
-                TypeSystem::TypeInfo const* pSystemTypeInfo = m_pTypeRegistry->GetTypeInfo( systemDesc.m_typeID );
-                if ( pSystemTypeInfo == nullptr || ( isCompilingForPackagedBuild && pSystemTypeInfo->m_isForDevelopmentUseOnly ) )
-                {
-                    descriptors[e].m_systems.erase( descriptors[e].m_systems.begin() + s );
-                }
-            }
-
-            // Remove any empty entities
-            if ( ( descriptors[e].m_components.size() + descriptors[e].m_systems.size() ) == 0 )
-            {
-                descriptors.erase( descriptors.begin() + e );
-            }
-        }
+        SanitizeEntityCollection( *m_pTypeRegistry, map, ctx.IsCompilingForPackagedBuild() );
 
         //-------------------------------------------------------------------------
         // Component Modifications
@@ -103,7 +72,38 @@ namespace EE::EntityModel
             navmeshPtrPropertyDesc.m_stringValue = navmeshResourcePath.GetString();
             TypeSystem::Conversion::ConvertStringToBinary( *m_pTypeRegistry, GetCoreTypeID( TypeSystem::CoreTypeID::TResourcePtr ), TypeSystem::TypeID(), navmeshResourcePath.GetString(), navmeshPtrPropertyDesc.m_byteValue );
 
-            pNavmeshComponentDesc->m_properties.emplace_back( navmeshPtrPropertyDesc );
+            pNavmeshComponentDesc->AddPropertyValue( navmeshPtrPropertyDesc );
+        }
+
+        //-------------------------------------------------------------------------
+        // World Partition
+        //-------------------------------------------------------------------------
+        // Streamed entities are removed from the map, each cell is compiled separately as a sub-resource of this map
+
+        EntityMapPartition partition;
+        if ( PartitionEntityMap( *m_pTypeRegistry, map, partition ) )
+        {
+            if ( !partition.m_settings.IsValid() )
+            {
+                Error( "Invalid world partition settings: the cell size and load radius need to be positive, the unload radius cant be smaller than the load radius and the budgets need to be non-zero!" );
+                return CompilationFailed( ctx );
+            }
+
+            map.m_streamingSettings = partition.m_settings;
+            map.m_cells.clear();
+            map.m_cells.reserve( partition.m_cells.size() );
+
+            for ( auto const& cell : partition.m_cells )
+            {
+                EntityMapCellDescriptor& cellDesc = map.m_cells.emplace_back();
+                cellDesc.m_collectionID = GetEntityMapCellResourceID( ctx.m_resourceID, cell.m_coordinates );
+                cellDesc.m_coordinates = cell.m_coordinates;
+                cellDesc.m_numEntities = (int32_t) cell.m_entityIndices.size();
+            }
+
+            map.SetCollectionData( CopyEntityDescriptors( map, partition.m_persistentEntityIndices ) );
+
+            Message( "Map partitioned into %u cells, %u entities remain in the map", (uint32_t) partition.m_cells.size(), (uint32_t) partition.m_persistentEntityIndices.size() );
         }
 
         //-------------------------------------------------------------------------
@@ -147,6 +147,18 @@ namespace EE::EntityModel
             VectorEmplaceBackUnique( outReferencedResources, referencedResourceID );
         }
 
+        // Streaming cells are not loaded with the map but still need to be packaged
+        SanitizeEntityCollection( *m_pTypeRegistry, map, false );
+
+        EntityMapPartition partition;
+        if ( PartitionEntityMap( *m_pTypeRegistry, map, partition ) )
+        {
+            for ( auto const& cell : partition.m_cells )
+            {
+                VectorEmplaceBackUnique( outReferencedResources, GetEntityMapCellResourceID( resourceID, cell.m_coordinates ) );
+            }
+        }
+
         return true;
     }
 }
\ No newline at end of file
@@ -41,6 +41,7 @@ namespace EE::Physics
 
         Resource::ResourceHeader hdr( RagdollDefinition::s_version, RagdollDefinition::GetStaticResourceTypeID(), ctx.m_sourceResourceHash, ctx.m_advancedUpToDateHash );
         hdr.AddInstallDependency( definition.m_skeleton.GetResourceID() );
+        hdr.SetTransitiveInstallDependencies( ctx.m_transitiveInstallDependencies );
 
         Serialization::BinaryOutputArchive archive;
         archive << hdr << definition;
@@ -67,6 +67,8 @@ namespace EE::Render
             hdr.m_installDependencies.push_back( material.m_pAOTexture.GetResourceID() );
         }
 
+        hdr.SetTransitiveInstallDependencies( ctx.m_transitiveInstallDependencies );
+
         // Serialize
         //-------------------------------------------------------------------------
 
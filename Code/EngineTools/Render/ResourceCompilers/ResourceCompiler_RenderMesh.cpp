@@ -277,6 +277,7 @@ namespace EE::Render
 
         Resource::ResourceHeader hdr( StaticMesh::s_version, StaticMesh::GetStaticResourceTypeID(), ctx.m_sourceResourceHash, ctx.m_advancedUpToDateHash );
         SetMeshInstallDependencies( staticMesh, hdr );
+        hdr.SetTransitiveInstallDependencies( ctx.m_transitiveInstallDependencies );
 
         Serialization::BinaryOutputArchive archive;
         archive << hdr << staticMesh;
@@ -352,6 +353,7 @@ namespace EE::Render
 
         Resource::ResourceHeader hdr( StaticMesh::s_version, SkeletalMesh::GetStaticResourceTypeID(), ctx.m_sourceResourceHash, ctx.m_advancedUpToDateHash );
         SetMeshInstallDependencies( skeletalMesh, hdr );
+        hdr.SetTransitiveInstallDependencies( ctx.m_transitiveInstallDependencies );
 
         Serialization::BinaryOutputArchive archive;
         archive << hdr << skeletalMesh;
@@ -51,6 +51,7 @@ namespace EE::Resource
 
         uint64_t                                        m_sourceResourceHash = 0; // The combined hash of the source resource and its dependencies
         uint64_t                                        m_advancedUpToDateHash = 0; // The optional advanced hash of the source source
+        TVector<ResourceID>                             m_transitiveInstallDependencies; // The install dependencies of this resource's install dependencies (all the way down)
     };
 
     // Resource Compiler
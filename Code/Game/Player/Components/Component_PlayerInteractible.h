@@ -17,6 +17,8 @@ namespace EE::Player
 
         Animation::GraphDefinition const* GetGraph() const { return m_pGraph.GetPtr(); }
 
+        virtual uint32_t GetSpatialQueryLayers() const override { return SpatialQueryLayer::Interaction; }
+
     private:
 
         EE_REFLECT() TResourcePtr<Animation::GraphDefinition> m_pGraph;
@@ -3,6 +3,7 @@
 #include "Game/Player/Components/Component_MainPlayer.h"
 #include "Engine/Entity/EntityWorldUpdateContext.h"
 #include "Engine/Entity/Entity.h"
+#include "Engine/Entity/Systems/WorldSystem_SpatialIndex.h"
 
 //-------------------------------------------------------------------------
 
@@ -15,7 +16,7 @@ namespace EE::Player
 
     void PlayerInteractionSystem::ShutdownSystem()
     {
-        EE_ASSERT( m_interactibles.empty() );
+        EE_ASSERT( m_players.empty() );
     }
 
     //-------------------------------------------------------------------------
@@ -27,11 +28,6 @@ namespace EE::Player
             RegisteredPlayer player = { pEntity, pPlayerComponent };
             m_players.emplace_back( player );
         }
-
-        if ( auto pInteractibleComponent = TryCast<PlayerInteractibleComponent>( pComponent ) )
-        {
-            m_interactibles.emplace_back( pInteractibleComponent );
-        }
     }
 
     void PlayerInteractionSystem::UnregisterComponent( Entity const* pEntity, EntityComponent* pComponent )
@@ -43,10 +39,6 @@ namespace EE::Player
         }
 
         // TODO: handle removing a component that is in use!!!
-        if ( auto pInteractibleComponent = TryCast<PlayerInteractibleComponent>( pComponent ) )
-        {
-            m_interactibles.erase_first( pInteractibleComponent );
-        }
     }
 
     //-------------------------------------------------------------------------
@@ -58,17 +50,32 @@ namespace EE::Player
             return;
         }
 
+        constexpr static float const interactionRange = 2.0f;
+
+        auto pSpatialIndex = ctx.GetWorldSystem<EntityModel::SpatialIndexWorldSystem>();
+        TVector<SpatialEntityComponent*> candidates;
+
         // HACK!!! just to test the external graphs feature!!
         for ( auto const& player : m_players )
         {
             Vector const playerPosition = player.m_pEntity->GetWorldTransform().GetTranslation();
             player.m_pPlayerComp->m_pAvailableInteraction = nullptr;
 
-            for ( auto pInteractible : m_interactibles )
+            // The interaction range is only checked in the XY plane, the box needs to contain the whole range circle
+            AABB const queryBox( playerPosition, Vector( interactionRange, interactionRange, Math::Infinity ) );
+            pSpatialIndex->FindOverlaps( queryBox, candidates, SpatialQueryLayer::Interaction );
+
+            for ( auto pCandidate : candidates )
             {
+                auto pInteractible = TryCast<PlayerInteractibleComponent>( pCandidate );
+                if ( pInteractible == nullptr )
+                {
+                    continue;
+                }
+
                 Vector const interactiblePosition = pInteractible->GetPosition();
 
-                if ( interactiblePosition.GetDistance2( playerPosition ) < 2.0f )
+                if ( interactiblePosition.GetDistance2( playerPosition ) < interactionRange )
                 {
                     player.m_pPlayerComp->m_pAvailableInteraction = pInteractible->GetGraph();
                 }
@@ -39,6 +39,5 @@ namespace EE::Player
     private:
 
         TVector<RegisteredPlayer>                   m_players;
-        TVector<PlayerInteractibleComponent*>       m_interactibles;
     };
 }
\ No newline at end of file